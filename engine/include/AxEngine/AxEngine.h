@@ -3,7 +3,10 @@
 #include "Foundation/AxTypes.h"
 #include "Foundation/AxPlatform.h"
 #include "AxEngine/AxSceneParser.h"
+#include "AxEngine/AxNodeHandle.h"
+#include "AxEngine/AxFrameStats.h"
 #include <string>
+#include <vector>
 
 struct AxAPIRegistry;
 struct AxWindowAPI;
@@ -14,6 +17,7 @@ struct AxPlatformAPI;
 struct AxWindow;
 class SceneTree;
 class AxRenderer;
+class WorkerPool;
 
 /**
  * AxEngineMode - Engine operating mode.
@@ -133,13 +137,15 @@ public:
 
     /**
      * Serialize the current scene tree to an in-memory string buffer
-     * using the .ats format. The snapshot is stored internally.
+     * using the .ats format. The snapshot is stored internally, together
+     * with every node's NodeHandle.
      */
     void SnapshotScene();
 
     /**
      * Unload the current scene and reload from the in-memory snapshot
-     * buffer. Restores the scene to its pre-play state.
+     * buffer. Restores the scene to its pre-play state; handles taken
+     * before the snapshot resolve to the restored nodes.
      */
     void RestoreSnapshot();
 
@@ -173,6 +179,22 @@ public:
     /** Get the current editor camera state (read-only). */
     const EditorCameraState& GetEditorCameraState() const { return (EditorCamera_); }
 
+    // === Frame Statistics ===
+
+    /**
+     * Phase timings and work counters of the last completed Tick(), with
+     * the scene tree's own phases and counters merged in. All zero in
+     * Shipping, where the instrumentation is compiled out.
+     */
+    const FrameStats& GetFrameStats() const { return (FrameStats_); }
+
+    /**
+     * The last FrameStatsHistory::Capacity completed frames, newest at age
+     * 0. Frames that end early (window close, ESC) are not recorded. Empty
+     * in Shipping.
+     */
+    const FrameStatsHistory& GetFrameHistory() const { return (FrameHistory_); }
+
 private:
     bool InitWindow();
     bool LoadPlugins();
@@ -207,17 +229,27 @@ private:
     AxRenderer* Renderer_{nullptr};
     SceneTree* SceneTree_{nullptr};
 
+    // Threads shared by scene trees for transform propagation
+    WorkerPool* WorkerPool_{nullptr};
+
     // Internal scene loading helper (creates SceneTree from file)
     SceneTree* LoadScene(const char* FilePath);
     void LoadSceneModels(SceneTree* Scene);
     void UnloadScene();
 
-    // Play mode scene snapshot (in-memory .ats string)
+    // Play mode scene snapshot (in-memory .ats string) and the handle of
+    // each node in serialization order
     std::string SceneSnapshot_;
+    std::vector<NodeHandle> SnapshotHandles_;
 
     // Editor camera state (separate from scene CameraNodes)
     EditorCameraState EditorCamera_;
 
+    // Frame statistics: the last frame, recent frames, frames ticked
+    FrameStats FrameStats_;
+    FrameStatsHistory FrameHistory_;
+    uint64_t FrameIndex_{0};
+
     // Game script DLL
     AxDLL GameDLL_;
 
@@ -29,6 +29,7 @@ typedef uint32_t AxEventType;
 /** Built-in event types for node lifecycle. */
 #define AX_EVENT_NODE_CREATED        1
 #define AX_EVENT_NODE_DESTROYED      2
+#define AX_EVENT_NODES_INSTANTIATED  3
 
 /** Starting value for user-defined event IDs. */
 #define AX_EVENT_USER_BASE           1000
@@ -51,6 +52,18 @@ struct AxEvent
   size_t DataSize;      // Size of the payload in bytes
 };
 
+/**
+ * Payload of AX_EVENT_NODES_INSTANTIATED, published once per
+ * SceneTree::InstantiateBatch instead of one NODE_CREATED per node. The
+ * sender is the parent the instances were added under.
+ */
+struct AxNodesInstantiatedEvent
+{
+  Node* const* Roots;         // InstanceCount instance roots
+  uint32_t InstanceCount;
+  uint32_t NodesPerInstance;
+};
+
 //=============================================================================
 // Callback Types
 //=============================================================================
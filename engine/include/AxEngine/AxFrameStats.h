@@ -0,0 +1,205 @@
+#pragma once
+
+/**
+ * AxFrameStats.h - Per-phase frame timings and work counters
+ *
+ * AxEngine::Tick times each phase of a frame (input, the fixed steps,
+ * Update, LateUpdate, render, resource releases) and SceneTree times the
+ * parts of its Update (transform flush, pending inits, script dispatch)
+ * and counts the work done: dirty roots, world matrices recomputed,
+ * scripts run per callback. AxEngine keeps the last frame's FrameStats and
+ * a FrameStatsHistory of recent frames.
+ *
+ * Instrumentation is compiled out in Shipping (AX_FRAME_STATS is 0):
+ * FramePhaseTimer is empty and no counter is touched. The types and
+ * accessors stay, so code reading them builds in every configuration and
+ * sees zeros.
+ */
+
+#include "Foundation/AxTypes.h"
+
+#include <array>
+#include <chrono>
+
+#if !defined(AX_FRAME_STATS)
+#if defined(AX_SHIPPING)
+#define AX_FRAME_STATS 0
+#else
+#define AX_FRAME_STATS 1
+#endif
+#endif
+
+/**
+ * Timed phases of a frame. Update covers the three phases after it, which
+ * SceneTree times separately.
+ */
+enum class FramePhase : uint32_t
+{
+  Input = 0,        // window events, AxInput, mouse delta
+  FixedUpdate,      // every fixed step taken this frame
+  Update,           // SceneTree::Update as a whole
+  TransformFlush,   //   dirty local matrices, world matrices, bounds refit
+  PendingInits,     //   OnInit of newly attached scripts
+  Scripts,          //   OnUpdate dispatch, timers, tweens, script tasks
+  LateUpdate,       // SceneTree::LateUpdate
+  Render,           // AxRenderer begin, scene, debug draw, end
+  Releases          // ResourceAPI::ProcessPendingReleases
+};
+
+/** Number of FramePhase values; Releases must stay the last enumerator. */
+static constexpr uint32_t FramePhaseCount = static_cast<uint32_t>(FramePhase::Releases) + 1;
+
+/** Display name of a phase ("TransformFlush"). */
+inline const char* GetFramePhaseName(FramePhase Phase)
+{
+  switch (Phase) {
+    case FramePhase::Input:          return ("Input");
+    case FramePhase::FixedUpdate:    return ("FixedUpdate");
+    case FramePhase::Update:         return ("Update");
+    case FramePhase::TransformFlush: return ("TransformFlush");
+    case FramePhase::PendingInits:   return ("PendingInits");
+    case FramePhase::Scripts:        return ("Scripts");
+    case FramePhase::LateUpdate:     return ("LateUpdate");
+    case FramePhase::Render:         return ("Render");
+    case FramePhase::Releases:       return ("Releases");
+    default:                         return ("Unknown");
+  }
+}
+
+/** Timings and work counters of one frame. */
+struct FrameStats
+{
+  /** AxEngine frame number (0 for stats gathered outside AxEngine::Tick). */
+  uint64_t FrameIndex = 0;
+
+  /** Variable timestep passed to Update and LateUpdate, in seconds. */
+  float DeltaT = 0.0f;
+
+  /** Wall time of the whole frame, in microseconds. */
+  float FrameMicros = 0.0f;
+
+  /** Wall time of each FramePhase, in microseconds. */
+  float PhaseMicros[FramePhaseCount] = {};
+
+  /** Fixed steps taken (FixedUpdate calls). */
+  uint32_t FixedSteps = 0;
+
+  /** Coalesced dirty roots the transform flush started from. */
+  uint32_t DirtyRoots = 0;
+
+  /** World matrices recomputed (dirty roots and their descendants). */
+  uint32_t NodesRecomputed = 0;
+
+  /** Scripts run per callback; FixedUpdate counts every step. */
+  uint32_t InitScripts = 0;
+  uint32_t FixedUpdateScripts = 0;
+  uint32_t UpdateScripts = 0;
+  uint32_t LateUpdateScripts = 0;
+
+  /** Resources destroyed by ProcessPendingReleases. */
+  uint32_t ResourcesReleased = 0;
+
+  float GetPhaseMicros(FramePhase Phase) const
+  {
+    return (PhaseMicros[static_cast<uint32_t>(Phase)]);
+  }
+
+  /** Add Other's phase times and counters (not its index, DeltaT or frame time). */
+  void Accumulate(const FrameStats& Other)
+  {
+    for (uint32_t i = 0; i < FramePhaseCount; ++i) {
+      PhaseMicros[i] += Other.PhaseMicros[i];
+    }
+    FixedSteps += Other.FixedSteps;
+    DirtyRoots += Other.DirtyRoots;
+    NodesRecomputed += Other.NodesRecomputed;
+    InitScripts += Other.InitScripts;
+    FixedUpdateScripts += Other.FixedUpdateScripts;
+    UpdateScripts += Other.UpdateScripts;
+    LateUpdateScripts += Other.LateUpdateScripts;
+    ResourcesReleased += Other.ResourcesReleased;
+  }
+};
+
+/**
+ * Adds the wall time between construction and destruction to one phase of
+ * a FrameStats. Empty when AX_FRAME_STATS is 0.
+ */
+class FramePhaseTimer
+{
+public:
+#if AX_FRAME_STATS
+  FramePhaseTimer(FrameStats& Stats, FramePhase Phase)
+    : Target_(Stats.PhaseMicros[static_cast<uint32_t>(Phase)])
+    , Start_(Clock::now())
+  {}
+
+  ~FramePhaseTimer()
+  {
+    Target_ += std::chrono::duration<float, std::micro>(Clock::now() - Start_).count();
+  }
+#else
+  FramePhaseTimer(FrameStats&, FramePhase) {}
+#endif
+
+  // Non-copyable
+  FramePhaseTimer(const FramePhaseTimer&) = delete;
+  FramePhaseTimer& operator=(const FramePhaseTimer&) = delete;
+
+#if AX_FRAME_STATS
+private:
+  using Clock = std::chrono::steady_clock;
+
+  float& Target_;
+  Clock::time_point Start_;
+#endif
+};
+
+/** The FrameStats of the last Capacity frames, oldest overwritten first. */
+class FrameStatsHistory
+{
+public:
+  static constexpr uint32_t Capacity = 120;
+
+  void Push(const FrameStats& Stats)
+  {
+    Frames_[Next_] = Stats;
+    Next_ = (Next_ + 1) % Capacity;
+    if (Count_ < Capacity) {
+      Count_++;
+    }
+  }
+
+  /** Frames stored, up to Capacity. */
+  uint32_t GetCount() const { return (Count_); }
+
+  /** A stored frame by age: 0 is the newest. Age must be below GetCount(). */
+  const FrameStats& Get(uint32_t Age) const
+  {
+    return (Frames_[(Next_ + Capacity - 1 - Age) % Capacity]);
+  }
+
+  /** Mean wall time of Phase over the stored frames, in microseconds. */
+  float GetAveragePhaseMicros(FramePhase Phase) const
+  {
+    if (Count_ == 0) {
+      return (0.0f);
+    }
+    float Sum = 0.0f;
+    for (uint32_t i = 0; i < Count_; ++i) {
+      Sum += Get(i).GetPhaseMicros(Phase);
+    }
+    return (Sum / static_cast<float>(Count_));
+  }
+
+  void Clear()
+  {
+    Next_ = 0;
+    Count_ = 0;
+  }
+
+private:
+  std::array<FrameStats, Capacity> Frames_{};
+  uint32_t Next_ = 0;
+  uint32_t Count_ = 0;
+};
@@ -5,8 +5,10 @@
  *
  * Nodes are lightweight scene tree elements with transforms, names, and ordered
  * children. They follow the Parent/FirstChild/NextSibling hierarchy pattern
- * as proper C++ classes. Typed node subclasses carry their data directly
- * (e.g. MeshInstance holds mesh path and model handle, CameraNode holds FOV and clip planes).
+ * as proper C++ classes; the sibling list is doubly linked with a tail
+ * pointer and a cached count, so appending and removing children is O(1).
+ * Typed node subclasses carry their data directly (e.g. MeshInstance holds
+ * mesh path and model handle, CameraNode holds FOV and clip planes).
  *
  * This is engine-level code (C++). Foundation types (AxTransform, AxHashTable,
  * AxAllocator) are C11 structs used here but not modified.
@@ -16,14 +18,25 @@
 #include "AxEngine/AxMathTypes.h"
 #include "AxEngine/AxTransformType.h"
 #include "AxEngine/AxSignal.h"
+#include "AxEngine/AxNodeHandle.h"
 #include <string>
 #include <string_view>
+#include <vector>
 
 struct AxHashTable;
 struct AxHashTableAPI;
 
 class ScriptBase;
 class SceneTree;
+class NodePath;
+class NodePool;
+
+/**
+ * Group identifier, issued per SceneTree by SceneTree::GetGroupId. Resolve
+ * a group name once and pass the ID on hot paths.
+ */
+using GroupId = uint32_t;
+static constexpr GroupId InvalidGroupId = 0xFFFFFFFFu;
 
 /**
  * Node type discriminator for the scene hierarchy.
@@ -49,12 +62,15 @@ enum class NodeType : uint32_t
   Sprite
 };
 
+/** Number of NodeType values; Sprite must stay the last enumerator. */
+static constexpr uint32_t NodeTypeCount = static_cast<uint32_t>(NodeType::Sprite) + 1;
+
 /**
  * Node - Base class for all scene hierarchy elements.
  *
- * Contains Parent/FirstChild/NextSibling pointers for efficient
- * hierarchy traversal. Each node holds a local transform relative
- * to its parent and a name.
+ * Contains Parent/FirstChild/LastChild and Prev/NextSibling pointers for
+ * O(1) structural edits and efficient hierarchy traversal. Each node holds
+ * a local transform relative to its parent and a name.
  *
  * Each node may have at most one behavioral script attached via
  * AttachScript. The node owns the script and destroys it on destruction.
@@ -73,10 +89,10 @@ public:
   // Hierarchy Manipulation
   //=========================================================================
 
-  /** Add a child node to the end of the child list. */
+  /** Add a child node to the end of the child list. O(1). */
   void AddChild(Node* Child);
 
-  /** Remove a direct child node from this node's child list. */
+  /** Remove a direct child node from this node's child list. O(1). */
   void RemoveChild(Node* Child);
 
   /**
@@ -85,11 +101,15 @@ public:
    */
   void SetParent(Node* NewParent);
 
-  /** Find a direct child by name. Returns nullptr if not found. */
+  /** Find a direct child by name. Returns nullptr if not found.
+   *  Uses the owning SceneTree's name index when the node is in a tree. */
   Node* FindChild(std::string_view ChildName);
 
-  /** Get the number of direct children. */
-  uint32_t GetChildCount() const;
+  /** Get the number of direct children (cached, O(1)). */
+  uint32_t GetChildCount() const { return (ChildCount_); }
+
+  /** Distance from the top of the hierarchy; a node without a parent is 0. */
+  uint32_t GetDepth() const { return (Depth_); }
 
   //=========================================================================
   // Children Iteration
@@ -137,6 +157,20 @@ public:
     return (nullptr);
   }
 
+  /** Resolve a precompiled path from this node (cached until the tree changes). */
+  Node* GetNode(const NodePath& Path);
+
+  /** Type-safe variant. Returns nullptr if the node exists but is the wrong type. */
+  template<typename T>
+  T* GetNode(const NodePath& Path)
+  {
+    Node* Found = GetNode(Path);
+    if (Found) {
+      return (Found->As<T>());
+    }
+    return (nullptr);
+  }
+
   /** Find the first direct child of the given type. */
   template<typename T>
   T* FindChildByType()
@@ -155,13 +189,24 @@ public:
 
   /** Add this node to a named group. No-op if already in the group or no OwningTree_. */
   void AddToGroup(std::string_view GroupName);
+  void AddToGroup(GroupId Group);
 
   /** Remove this node from a named group. No-op if not in the group or no OwningTree_. */
   void RemoveFromGroup(std::string_view GroupName);
+  void RemoveFromGroup(GroupId Group);
 
   /** Check if this node belongs to a named group. */
   bool IsInGroup(std::string_view GroupName) const;
 
+  /** Check membership by ID: one bit test for the first 64 groups of a tree. */
+  bool IsInGroup(GroupId Group) const;
+
+  /** Number of groups this node belongs to. */
+  uint32_t GetGroupCount() const
+  {
+    return (Cold_ ? static_cast<uint32_t>(Cold_->GroupEntries.size()) : 0);
+  }
+
   //=========================================================================
   // Lifecycle
   //=========================================================================
@@ -218,6 +263,13 @@ public:
   /** Connect a callback to a signal on this node. Returns a unique connection ID. */
   uint32_t Connect(std::string_view SignalName, SignalCallback Callback, Node* Receiver = nullptr);
 
+  /**
+   * Connect with the receiver given as a handle, resolved through this
+   * node's SceneTree. Returns 0 without connecting if the receiver no
+   * longer exists.
+   */
+  uint32_t Connect(std::string_view SignalName, SignalCallback Callback, NodeHandle Receiver);
+
   /** Disconnect a specific callback by signal name and connection ID. */
   void Disconnect(std::string_view SignalName, uint32_t ConnectionID);
 
@@ -226,6 +278,9 @@ public:
   //=========================================================================
 
   std::string_view GetName() const { return (Name_); }
+
+  /** Rename this node. Keeps the owning SceneTree's name index current. */
+  void SetName(std::string_view Name);
   NodeType GetType() const { return (Type_); }
 
   /** Safe downcast. Returns T* if this node's type matches T::StaticType, nullptr otherwise. */
@@ -249,11 +304,17 @@ public:
   }
 
   uint32_t GetNodeID() const { return (NodeID_); }
+
+  /** Generation-checked handle to this node; null when not in a SceneTree. */
+  NodeHandle GetHandle() const { return (Handle_); }
   void SetNodeID(uint32_t ID) { NodeID_ = ID; }
 
   bool IsInitialized() const { return (IsInitialized_); }
   bool IsActive() const { return (IsActive_); }
 
+  /** True if this node and every ancestor are active (cached, O(1)). */
+  bool IsActiveInHierarchy() const { return (ActiveInHierarchy_); }
+
   // Property dirty tracking -- set by Property<T>::operator=
   void MarkDirty() { PropertiesDirty_ = true; }
   bool IsPropertiesDirty() const { return (PropertiesDirty_); }
@@ -261,6 +322,8 @@ public:
 
   /**
    * Set the active state of this node.
+   * Updates IsActiveInHierarchy() for the whole subtree, which moves its
+   * scripts out of (or back into) the SceneTree's dispatch list.
    * Fires OnDisable on the script when transitioning to inactive (if initialized).
    * Fires OnEnable on the script when transitioning to active (if initialized).
    */
@@ -279,60 +342,201 @@ public:
 
   /**
    * Get the cached world transform matrix.
-   * This matrix is populated by SceneTree::UpdateNodeTransforms at the
-   * top of each Update() call.
-   * @return Reference to the cached world matrix.
+   * World matrices live in the owning SceneTree's TransformHierarchy and are
+   * recomputed at the top of each Update() call. Nodes outside a tree
+   * report identity.
+   * @return Reference to the cached world matrix, valid until the tree
+   *         next creates or destroys nodes.
    */
-  const Mat4& GetWorldTransform() const { return (WorldMatrix_); }
+  const Mat4& GetWorldTransform() const;
 
   Node* GetParent() const { return (Parent_); }
   Node* GetFirstChild() const { return (FirstChild_); }
+  Node* GetLastChild() const { return (LastChild_); }
   Node* GetNextSibling() const { return (NextSibling_); }
+  Node* GetPrevSibling() const { return (PrevSibling_); }
 
   /** Get the SceneTree that owns this node, or nullptr if standalone. */
   SceneTree* GetOwningTree() const { return (OwningTree_); }
 
+  /**
+   * Members are ordered hot to cold. Everything a hierarchy walk, dispatch
+   * check or transform flush reads on most nodes is declared first and fits
+   * in the first HotBytes (two cache lines, vtable pointer included); the
+   * local transform follows, then script bookkeeping, then data that is
+   * only read by name lookups, pools, signals and groups. Signals and group
+   * membership live out of line in ColdData, which most nodes never
+   * allocate. AxNode.cpp checks the boundaries at compile time.
+   */
+  static constexpr size_t HotBytes = 128;
+
 protected:
-  std::string Name_;
-  NodeType Type_;
-  Transform Transform_;
-  Mat4 WorldMatrix_;
-  uint32_t NodeID_;
+  //---------------------------------------------------------------------------
+  // Hot: hierarchy links, owner and script (first cache line)
+  //---------------------------------------------------------------------------
 
   Node* Parent_;
   Node* FirstChild_;
+  Node* LastChild_;
   Node* NextSibling_;
+  Node* PrevSibling_;
 
-  AxHashTableAPI* HashTableAPI_;
+private:
+  // Back-pointer to the owning SceneTree (set by SceneTree::CreateNode,
+  // cleared by SceneTree::DestroyNode). Enables Node to notify SceneTree
+  // of transform changes and script attach/detach without callers passing
+  // SceneTree explicitly.
+  SceneTree* OwningTree_;
 
+protected:
   // Script slot -- one behavioral script per node; node owns it
   ScriptBase* Script_;
 
+  //---------------------------------------------------------------------------
+  // Hot: type, counts, tree slots and flags (second cache line)
+  //---------------------------------------------------------------------------
+
+  NodeType Type_;
+  uint32_t ChildCount_;
+  uint32_t NodeID_;
+
+private:
+  // Value of the list slot fields below when the node is not in that list
+  static constexpr uint32_t NotInList = 0xFFFFFFFFu;
+
+  // Number of ancestors, kept current by AddChild/RemoveChild.
+  uint32_t Depth_;
+
+  // Slot in the owning SceneTree's TransformHierarchy, or
+  // TransformHierarchy::InvalidIndex when not placed in one.
+  uint32_t HierarchyIndex_;
+
+  // Index of this node in the SceneTree's TransformDirtyRoots_ list, or
+  // NotInList. Used for O(1) duplicate prevention and removal.
+  uint32_t DirtyListSlot_;
+
+  // Index in the owning SceneTree's typed-node array for this node's type,
+  // or NotInList for untyped nodes.
+  uint32_t TypedSlot_;
+
+  // Proxy in the owning SceneTree's SpatialIndex, or NotInList when the
+  // node has no bounds.
+  uint32_t SpatialProxy_;
+
+  // This node's slot in the owning SceneTree's handle table.
+  NodeHandle Handle_;
+
+  // Bit N mirrors membership of group N for N < 64 (see ColdData).
+  uint64_t GroupMask_;
+
+protected:
   // Flags
   bool IsInitialized_;
   bool IsActive_;
   bool PropertiesDirty_;
 
 private:
-  // Signal storage
-  std::vector<SignalSlot> Signals_;
-  uint32_t NextConnectionID_{1};
-  std::vector<OutgoingConnection> OutgoingConnections_;
+  // IsActive_ of this node and all its ancestors, kept current by SetActive
+  // and by AddChild/RemoveChild.
+  bool ActiveInHierarchy_;
+
+  // True if this node is currently registered for per-frame script dispatch.
+  bool InScriptList_;
+
+protected:
+  //---------------------------------------------------------------------------
+  // Warm: local transform (TRS first, then the cached matrix)
+  //---------------------------------------------------------------------------
+
+  Transform Transform_;
+
+private:
+  //---------------------------------------------------------------------------
+  // Warm: script registration, read when a script joins or leaves a list
+  //---------------------------------------------------------------------------
+
+  // Dispatch lists the node joined when registered (one bit per list), the
+  // tick group and script class group it joined them in, and its index in
+  // that group for each list (Update, FixedUpdate, LateUpdate, and the
+  // throttled and parallel Update lists). Unregistering uses these, so it
+  // is O(1) and works even if the script declared other callbacks or moved
+  // to another tick group.
+  uint8_t ScriptLists_;
+  uint32_t ScriptTickGroup_;
+  uint32_t ScriptClass_;
+  uint32_t ScriptListSlots_[6];
+
+  // Index in the SceneTree's pending-init bucket for PendingInitDepth_, or
+  // NotInList when no OnInit is pending.
+  uint32_t PendingInitSlot_;
+  uint32_t PendingInitDepth_;
+
+  // First of the script tasks this node owns in the SceneTree's
+  // TaskScheduler (chained through the task records), or NotInList.
+  uint32_t TaskHead_;
+
+  //---------------------------------------------------------------------------
+  // Cold: name, allocation and out-of-line signal and group storage
+  //---------------------------------------------------------------------------
+
+  // Position in the owning SceneTree's name-index bucket for Name_.
+  uint32_t NameIndexSlot_;
+
+  // Slot of this node's memory in Pool_ (unused when Pool_ is nullptr).
+  uint32_t PoolSlot_;
+
+  // Pool that holds this node's memory (nodes made by SceneTree::CreateNode),
+  // or nullptr for a node allocated with new.
+  NodePool* Pool_;
+
+protected:
+  std::string Name_;
+  AxHashTableAPI* HashTableAPI_;
+
+private:
+  // A group this node belongs to, with the node's index in that group's
+  // member list so leaving is a swap-with-last.
+  struct GroupEntry
+  {
+    GroupId Group;
+    uint32_t Slot;
+  };
+
+  // Signal connections in both directions and group membership (sorted by
+  // ID). Allocated by GetColdData the first time a node connects a signal,
+  // is connected to, or joins a group; nullptr until then.
+  struct ColdData
+  {
+    std::vector<SignalSlot> Signals;
+    std::vector<OutgoingConnection> OutgoingConnections;
+    std::vector<GroupEntry> GroupEntries;
+    uint32_t NextConnectionID = 1;
+  };
+  ColdData* Cold_;
+
+  /** Cold data, allocated on first use. */
+  ColdData& GetColdData();
 
   /** Clean up all signal connections (called from destructor). */
   void CleanupSignals();
 
-  // Back-pointer to the owning SceneTree (set by SceneTree::CreateNode,
-  // cleared by SceneTree::DestroyNode). Enables Node to notify SceneTree
-  // of transform changes and script attach/detach without callers passing
-  // SceneTree explicitly.
-  SceneTree* OwningTree_;
+  /**
+   * Recompute ActiveInHierarchy_ from the parent's value and push changes
+   * down the subtree. Stops at nodes whose value does not change, since
+   * their descendants are already consistent.
+   */
+  void PropagateActiveInHierarchy(bool ParentActive);
 
-  // True if this node is currently in the SceneTree's TransformDirtyRoots_ list.
-  // Used for O(1) duplicate prevention.
-  bool InDirtyList_;
+  /**
+   * Set Depth_ and push the change down the subtree, stopping at nodes
+   * whose depth already matches. Called by AddChild/RemoveChild.
+   */
+  void PropagateDepth(uint32_t NewDepth);
 
   friend class SceneTree;
+  friend class TransformHierarchy;
+  friend class NodePool;
+  friend class TaskScheduler;
 };
 
 /**
@@ -0,0 +1,30 @@
+#pragma once
+
+/**
+ * AxNodeHandle.h - Generation-checked weak reference to a scene node
+ *
+ * A NodeHandle names a slot in a SceneTree's handle table plus the
+ * generation the slot had when the node was created. SceneTree::Resolve
+ * checks both in O(1) and returns nullptr once the node is destroyed, even
+ * if the slot has since been reused, so holding a handle across frames is
+ * safe where holding a Node* is not.
+ *
+ * Generations are issued from a per-tree counter that never repeats, and
+ * AxEngine carries handles across play-mode snapshot/restore, so handles
+ * taken in the editor still resolve after Stop.
+ */
+
+#include "Foundation/AxTypes.h"
+
+struct NodeHandle
+{
+  uint32_t Index{0};
+
+  /** 0 means "no node"; live nodes always have a nonzero generation. */
+  uint32_t Generation{0};
+
+  bool IsNull() const { return (Generation == 0); }
+  explicit operator bool() const { return (Generation != 0); }
+
+  bool operator==(const NodeHandle& Other) const = default;
+};
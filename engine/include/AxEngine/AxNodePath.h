@@ -0,0 +1,84 @@
+#pragma once
+
+/**
+ * AxNodePath.h - Precompiled relative node path
+ *
+ * NodePath splits a path such as "../Arm/Hand" into segments once, then
+ * caches the node it resolved to from a given starting node. The cache is
+ * keyed on the owning SceneTree's structure version, which changes whenever
+ * a node is created, destroyed, renamed or reparented, so a script holding a
+ * NodePath pays one integer compare per lookup until the tree changes.
+ *
+ * Paths use the same syntax as Node::GetNode(): "/" separates child names,
+ * ".." steps to the parent, an empty path resolves to the starting node.
+ * Resolving from a node outside any SceneTree works but is never cached.
+ *
+ * The cache is not synchronized; share a NodePath across threads only if
+ * every thread resolves it from the same node after a single warm-up.
+ *
+ * Usage:
+ *   NodePath HandPath("Arm/Hand");
+ *   Node* Hand = HandPath.Resolve(Owner);
+ */
+
+#include "Foundation/AxTypes.h"
+#include "AxEngine/AxNode.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+class SceneTree;
+
+class NodePath
+{
+public:
+  NodePath() = default;
+  explicit NodePath(std::string_view Path);
+
+  /** Replace the path and drop any cached resolution. */
+  void SetPath(std::string_view Path);
+
+  /** The path as given (trailing slash removed). */
+  const std::string& GetPath() const { return (Path_); }
+
+  /** True for the empty path, which resolves to the starting node. */
+  bool IsEmpty() const { return (Segments_.empty()); }
+
+  /** Number of parsed segments. */
+  uint32_t GetSegmentCount() const { return (static_cast<uint32_t>(Segments_.size())); }
+
+  /**
+   * Resolve the path relative to From.
+   * @return The target node, or nullptr if From is nullptr or any segment
+   *         fails to resolve.
+   */
+  Node* Resolve(Node* From) const;
+
+  /** Type-safe variant. Returns nullptr if the target is the wrong type. */
+  template<typename T>
+  T* Resolve(Node* From) const
+  {
+    Node* Found = Resolve(From);
+    if (Found) {
+      return (Found->As<T>());
+    }
+    return (nullptr);
+  }
+
+private:
+  struct Segment
+  {
+    std::string Name;
+    bool IsParent;
+  };
+
+  std::string Path_;
+  std::vector<Segment> Segments_;
+
+  // Last resolution; valid while CachedTree_'s structure version matches
+  mutable Node* CachedFrom_{nullptr};
+  mutable Node* CachedTarget_{nullptr};
+  mutable const SceneTree* CachedTree_{nullptr};
+  mutable uint64_t CachedVersion_{0};
+};
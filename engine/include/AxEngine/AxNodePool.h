@@ -0,0 +1,168 @@
+#pragma once
+
+/**
+ * AxNodePool.h - Per-type chunked storage for scene nodes
+ *
+ * A SceneTree allocates every node it creates from its NodePool instead of
+ * the global heap. Each NodeType has its own pool of fixed-size slots carved
+ * from chunks of SlotsPerChunk nodes, plus a free list, so despawning a node
+ * and spawning another of the same type reuses the slot without touching
+ * the heap.
+ *
+ * Chunks come from the SceneTree's AxAllocator when it has one (the parser
+ * passes a scene-lifetime linear arena) and from the heap otherwise. Each
+ * chunk remembers where it came from, so the allocator may be swapped while
+ * the tree is alive.
+ *
+ * DestroyAll() runs the destructor of every live node in chunk order with a
+ * direct (non-virtual) call for its type, then releases memory one chunk at
+ * a time. It does not unlink nodes or clean up scripts and signals; the
+ * owning SceneTree does that first (see ~SceneTree).
+ *
+ * Not thread-safe; used from the thread that owns the SceneTree.
+ */
+
+#include "Foundation/AxTypes.h"
+#include "AxEngine/AxNode.h"
+
+#include <bit>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+struct AxAllocator;
+
+class NodePool
+{
+public:
+  /** Nodes per chunk; one bit each in the chunk's live mask. */
+  static constexpr uint32_t SlotsPerChunk = 64;
+
+  /**
+   * Alignment of every slot: a cache line, so the first Node::HotBytes of
+   * each node occupy exactly two lines.
+   */
+  static constexpr size_t SlotAlignment = 64;
+
+  NodePool() = default;
+
+  /** Destroys any remaining nodes and releases every chunk. */
+  ~NodePool();
+
+  // Non-copyable
+  NodePool(const NodePool&) = delete;
+  NodePool& operator=(const NodePool&) = delete;
+
+  /**
+   * Construct a T in a free slot of Type's pool.
+   * @param Type Pool to draw from; types without a pool of their own share
+   *             the NodeType::Base pool.
+   * @param Backing Allocator for a new chunk if one is needed (nullptr uses
+   *                the heap). Falls back to the heap if Backing is exhausted.
+   * @return The node, or nullptr if no memory could be obtained.
+   */
+  template<typename T, typename... ArgTypes>
+  T* Create(NodeType Type, struct AxAllocator* Backing, ArgTypes&&... Args)
+  {
+    static_assert(alignof(T) <= SlotAlignment, "Node type is over-aligned for NodePool");
+
+    TypePool& Pool = Pools_[PoolIndex(Type)];
+    if (!Pool.Destruct) {
+      Pool.SlotSize = (sizeof(T) + SlotAlignment - 1) & ~(SlotAlignment - 1);
+      Pool.Destruct = &DestructAs<T>;
+    }
+
+    uint32_t Slot = 0;
+    void* Memory = AcquireSlot(Pool, Backing, Slot);
+    if (!Memory) {
+      return (nullptr);
+    }
+
+    T* Created = new (Memory) T(std::forward<ArgTypes>(Args)...);
+    Created->Pool_ = this;
+    Created->PoolSlot_ = Slot;
+    return (Created);
+  }
+
+  /** Run Target's destructor and return its slot to the free list. */
+  void Destroy(Node* Target);
+
+  /**
+   * Run the destructor of every live node, then release all chunks.
+   * O(live nodes) destructor calls plus O(chunks) frees.
+   */
+  void DestroyAll();
+
+  /** Call Fn(Node*) for every live node, in chunk order. */
+  template<typename FnType>
+  void ForEachLive(FnType&& Fn)
+  {
+    for (TypePool& Pool : Pools_) {
+      for (Chunk& C : Pool.Chunks) {
+        for (uint64_t Mask = C.LiveMask; Mask; Mask &= Mask - 1) {
+          Fn(SlotNode(Pool, C, static_cast<uint32_t>(std::countr_zero(Mask))));
+        }
+      }
+    }
+  }
+
+  /** Live nodes drawn from Type's pool. */
+  uint32_t GetLiveCount(NodeType Type) const { return (Pools_[PoolIndex(Type)].LiveCount); }
+
+  /** Free slots waiting for reuse in Type's pool. */
+  uint32_t GetFreeCount(NodeType Type) const
+  {
+    return (static_cast<uint32_t>(Pools_[PoolIndex(Type)].FreeSlots.size()));
+  }
+
+  /** Chunks held across all types. */
+  uint32_t GetChunkCount() const;
+
+  /** Bytes held in chunks across all types. */
+  size_t GetReservedBytes() const;
+
+private:
+  struct Chunk
+  {
+    uint8_t* Memory;
+    struct AxAllocator* Backing;   // nullptr: heap
+    uint64_t LiveMask;
+  };
+
+  struct TypePool
+  {
+    size_t SlotSize = 0;
+    void (*Destruct)(Node*) = nullptr;
+    std::vector<Chunk> Chunks;
+
+    // Encoded chunk * SlotsPerChunk + slot; popped from the back
+    std::vector<uint32_t> FreeSlots;
+    uint32_t LiveCount = 0;
+  };
+
+  // One pool per NodeType value (Base through Sprite)
+  static constexpr uint32_t PoolCount = static_cast<uint32_t>(NodeType::Sprite) + 1;
+
+  static uint32_t PoolIndex(NodeType Type)
+  {
+    uint32_t Index = static_cast<uint32_t>(Type);
+    return ((Index < PoolCount) ? Index : static_cast<uint32_t>(NodeType::Base));
+  }
+
+  // Direct call, so the compiler need not go through the vtable
+  template<typename T>
+  static void DestructAs(Node* Target) { static_cast<T*>(Target)->T::~T(); }
+
+  static Node* SlotNode(const TypePool& Pool, const Chunk& C, uint32_t Slot)
+  {
+    return (reinterpret_cast<Node*>(C.Memory + Pool.SlotSize * Slot));
+  }
+
+  /** Pop a free slot, adding a chunk if none is left. */
+  void* AcquireSlot(TypePool& Pool, struct AxAllocator* Backing, uint32_t& OutSlot);
+
+  static void ReleaseChunk(Chunk& C);
+
+  TypePool Pools_[PoolCount];
+};
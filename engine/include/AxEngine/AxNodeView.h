@@ -0,0 +1,177 @@
+#pragma once
+
+/**
+ * AxNodeView.h - Typed iteration over a SceneTree's per-type node arrays
+ *
+ * SceneTree keeps one dense array of node pointers per typed NodeType
+ * (MeshInstance through Sprite). NodeView<T> walks the array for
+ * T::StaticType and hands out T* without a cast or a tree walk:
+ *
+ *   for (RigidBodyNode* Body : Tree->View<RigidBodyNode>()) { ... }
+ *
+ * ChildJoinView<ParentT, ChildT> pairs every ChildT node with its parent
+ * when that parent is a ParentT, e.g. rigid bodies with their colliders:
+ *
+ *   for (auto [Body, Shape] : Tree->JoinChildren<RigidBodyNode, ColliderNode>()) { ... }
+ *
+ * It walks the ChildT array and checks one parent pointer per entry, so
+ * its cost is linear in the number of ChildT nodes.
+ *
+ * Destroying a node leaves a hole in its array that views skip; holes are
+ * closed (keeping creation order) by the next GetNodesByType or Update.
+ * Nodes created while a view is iterated are visited if they land after
+ * the current position. Views are cheap to construct and hold no state
+ * beyond pointers to the array and its hole count.
+ */
+
+#include "AxEngine/AxNode.h"
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//=============================================================================
+// NodeView
+//=============================================================================
+
+template<typename T>
+class NodeView
+{
+  static_assert(std::is_base_of_v<Node, T>, "NodeView needs a Node subclass");
+
+public:
+  class Iterator
+  {
+  public:
+    Iterator(const std::vector<Node*>* List, size_t Index)
+      : List_(List), Index_(Index)
+    {
+      SkipHoles();
+    }
+
+    T* operator*() const { return (static_cast<T*>((*List_)[Index_])); }
+
+    Iterator& operator++()
+    {
+      ++Index_;
+      SkipHoles();
+      return (*this);
+    }
+
+    // Re-reads the size so nodes created during iteration are reached
+    bool operator==(std::default_sentinel_t) const { return (Index_ >= List_->size()); }
+
+  private:
+    void SkipHoles()
+    {
+      while (Index_ < List_->size() && !(*List_)[Index_]) {
+        ++Index_;
+      }
+    }
+
+    const std::vector<Node*>* List_;
+    size_t Index_;
+  };
+
+  NodeView(const std::vector<Node*>& List, const uint32_t& Holes)
+    : List_(&List), Holes_(&Holes) {}
+
+  Iterator begin() const { return (Iterator(List_, 0)); }
+  std::default_sentinel_t end() const { return (std::default_sentinel); }
+
+  /** Live nodes of the type now; follows creates, destroys and compaction. */
+  uint32_t GetCount() const { return (static_cast<uint32_t>(List_->size()) - *Holes_); }
+  bool IsEmpty() const { return (GetCount() == 0); }
+
+  /** Call Fn(T*) for every node; the tightest loop when no iterator is needed. */
+  template<typename FnType>
+  void ForEach(FnType&& Fn) const
+  {
+    for (size_t i = 0; i < List_->size(); ++i) {
+      if (Node* Entry = (*List_)[i]) {
+        Fn(static_cast<T*>(Entry));
+      }
+    }
+  }
+
+private:
+  const std::vector<Node*>* List_;
+  const uint32_t* Holes_;     // the tree's hole count for the array
+};
+
+//=============================================================================
+// ChildJoinView
+//=============================================================================
+
+template<typename ParentT, typename ChildT>
+class ChildJoinView
+{
+  static_assert(std::is_base_of_v<Node, ParentT> && std::is_base_of_v<Node, ChildT>,
+                "ChildJoinView needs Node subclasses");
+
+public:
+  class Iterator
+  {
+  public:
+    Iterator(const std::vector<Node*>* Children, size_t Index)
+      : Children_(Children), Index_(Index)
+    {
+      SkipUnmatched();
+    }
+
+    std::pair<ParentT*, ChildT*> operator*() const
+    {
+      Node* Child = (*Children_)[Index_];
+      return (std::pair<ParentT*, ChildT*>(static_cast<ParentT*>(Child->GetParent()),
+                                           static_cast<ChildT*>(Child)));
+    }
+
+    Iterator& operator++()
+    {
+      ++Index_;
+      SkipUnmatched();
+      return (*this);
+    }
+
+    bool operator==(std::default_sentinel_t) const { return (Index_ >= Children_->size()); }
+
+  private:
+    void SkipUnmatched()
+    {
+      while (Index_ < Children_->size() && !Matches((*Children_)[Index_])) {
+        ++Index_;
+      }
+    }
+
+    const std::vector<Node*>* Children_;
+    size_t Index_;
+  };
+
+  explicit ChildJoinView(const std::vector<Node*>& Children)
+    : Children_(&Children) {}
+
+  Iterator begin() const { return (Iterator(Children_, 0)); }
+  std::default_sentinel_t end() const { return (std::default_sentinel); }
+
+  /** Call Fn(ParentT*, ChildT*) for every matching pair. */
+  template<typename FnType>
+  void ForEach(FnType&& Fn) const
+  {
+    for (size_t i = 0; i < Children_->size(); ++i) {
+      Node* Child = (*Children_)[i];
+      if (Matches(Child)) {
+        Fn(static_cast<ParentT*>(Child->GetParent()), static_cast<ChildT*>(Child));
+      }
+    }
+  }
+
+private:
+  static bool Matches(const Node* Child)
+  {
+    const Node* Parent = Child ? Child->GetParent() : nullptr;
+    return (Parent && Parent->GetType() == ParentT::StaticType);
+  }
+
+  const std::vector<Node*>* Children_;
+};
@@ -0,0 +1,164 @@
+#pragma once
+
+/**
+ * AxPrefabTemplate.h - Flat node records for bulk instantiation
+ *
+ * A PrefabTemplate describes a node subtree as an array of records in
+ * parent-before-child order. Each record holds the node type, a name ID
+ * into the template's string table, the index of its parent record, a
+ * local transform, the script class to attach (by ScriptRegistry name) and
+ * a run of reflected property values.
+ *
+ * Property values live in one byte blob. Fixed-size values (numbers,
+ * bools, enums, vectors) are stored as their raw bytes and strings as
+ * string-table IDs; instantiation writes each one through its typed
+ * Property<T> (ApplyValue), resolved by the PropertyRegistry. Only
+ * properties that were set are stored, so the rest keep the node type's
+ * defaults.
+ *
+ * A MeshInstance record may also carry a model (a primitive mesh built
+ * once for the template) that every instance shares; each instance takes
+ * its own reference, as a node loading the model itself would.
+ *
+ * Records hold indices and IDs only, never pointers, so a template is
+ * independent of any scene and can be shared between scenes (SceneParser
+ * caches one per prefab source, see SceneParser::CompilePrefab).
+ *
+ * SceneTree::InstantiateBatch turns a template into any number of live
+ * subtrees in one pass. Build a template with AddNode / SetProperty /
+ * SetScript, or flatten an existing subtree with Capture.
+ */
+
+#include "Foundation/AxTypes.h"
+#include "AxEngine/AxMathTypes.h"
+#include "AxEngine/AxNode.h"
+#include "AxEngine/AxPropertyReflection.h"
+#include "AxResource/AxResourceTypes.h"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/** Local translation, rotation and scale of a template record or instance. */
+struct PrefabTransform
+{
+  Vec3 Translation;
+  Quat Rotation;
+  Vec3 Scale = Vec3(1.0f, 1.0f, 1.0f);
+};
+
+class PrefabTemplate
+{
+public:
+  static constexpr uint32_t NoParent = 0xFFFFFFFFu;
+  static constexpr uint32_t NoScript = 0xFFFFFFFFu;
+
+  struct NodeRecord
+  {
+    NodeType Type;
+    uint32_t NameId;        // string table
+    uint32_t Parent;        // record index, NoParent for the root
+    uint32_t ScriptId;      // string table, NoScript for none
+    PrefabTransform Local;
+    uint32_t FirstValue;    // run of ValueCount entries in GetValues()
+    uint32_t ValueCount;
+    AxModelHandle Model;    // MeshInstance model shared by every instance, or invalid
+  };
+
+  struct PropertyValue
+  {
+    uint16_t Descriptor;    // index in the type's PropertyRegistry table
+    uint16_t Size;          // bytes in the blob
+    uint32_t BlobOffset;
+  };
+
+  PrefabTemplate() = default;
+
+  //=========================================================================
+  // Building
+  //=========================================================================
+
+  /**
+   * Append a node record. Record 0 is the template root and the only one
+   * without a parent; later records must name an earlier record as parent.
+   * @return The record index, or NoParent (with a warning) if Parent is
+   *         invalid, the name is empty or Type is NodeType::Root.
+   */
+  uint32_t AddNode(std::string_view NodeName, NodeType Type, uint32_t Parent = NoParent,
+                   const PrefabTransform& Local = PrefabTransform());
+
+  /**
+   * Store a value for a reflected property of a record. The value type must
+   * match the property; a string also sets an Enum property by entry name.
+   * Setting a property again replaces its value.
+   * @return false (with a warning) on an unknown property or mismatch.
+   */
+  bool SetProperty(uint32_t Record, std::string_view PropName, float Value);
+  bool SetProperty(uint32_t Record, std::string_view PropName, int32_t Value);
+  bool SetProperty(uint32_t Record, std::string_view PropName, uint32_t Value);
+  bool SetProperty(uint32_t Record, std::string_view PropName, bool Value);
+  bool SetProperty(uint32_t Record, std::string_view PropName, std::string_view Value);
+  bool SetProperty(uint32_t Record, std::string_view PropName, const char* Value);
+  bool SetProperty(uint32_t Record, std::string_view PropName, const Vec3& Value);
+  bool SetProperty(uint32_t Record, std::string_view PropName, const Vec4& Value);
+
+  /** Replace the local transform of Record. */
+  void SetTransform(uint32_t Record, const PrefabTransform& Local);
+
+  /** Attach a script, created through ScriptRegistry, to every instance of Record. */
+  void SetScript(uint32_t Record, std::string_view ScriptName);
+
+  /**
+   * Share Model with every instance of a MeshInstance record. The template
+   * does not take a reference; whoever built the model keeps it alive.
+   */
+  void SetModel(uint32_t Record, AxModelHandle Model);
+
+  /**
+   * Flatten a live subtree: names, types, local transforms and every
+   * reflected property. Scripts are not captured (a script does not know
+   * its registered name); add them with SetScript.
+   */
+  static PrefabTemplate Capture(const Node* Root);
+
+  /** Drop every record. */
+  void Clear();
+
+  //=========================================================================
+  // Reading
+  //=========================================================================
+
+  uint32_t GetNodeCount() const { return (static_cast<uint32_t>(Records_.size())); }
+  bool IsEmpty() const { return (Records_.empty()); }
+
+  const NodeRecord& GetRecord(uint32_t Index) const { return (Records_[Index]); }
+  const std::vector<NodeRecord>& GetRecords() const { return (Records_); }
+
+  const PropertyValue* GetValues() const { return (Values_.data()); }
+  const uint8_t* GetBlob() const { return (Blob_.data()); }
+
+  std::string_view GetString(uint32_t Id) const { return (Strings_[Id]); }
+
+  /** Bytes a value of Type takes in the blob (4 for a string ID). */
+  static uint32_t ValueSize(PropType Type);
+
+  /**
+   * Write a stored value into Target's property Prop through
+   * Property<T>::SetRaw, without marking Target dirty.
+   */
+  void ApplyValue(Node* Target, const PropDescriptor* Prop, const PropertyValue& Value) const;
+
+private:
+  uint32_t InternString(std::string_view Text);
+
+  /** Store a value of Type (raw Bytes, or Text for strings) for PropName. */
+  bool WriteValue(uint32_t Record, std::string_view PropName, PropType Type,
+                  const void* Bytes, std::string_view Text);
+
+  std::vector<NodeRecord> Records_;
+  std::vector<PropertyValue> Values_;
+  std::vector<uint8_t> Blob_;
+  std::vector<std::string> Strings_;
+  std::unordered_map<std::string, uint32_t> StringIds_;
+};
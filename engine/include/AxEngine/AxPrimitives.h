@@ -55,6 +55,14 @@ public:
     /** Generate geometry, upload via ResourceAPI, return model handle. */
     AxModelHandle CreateModel();
 
+    /**
+     * Take or drop one reference to a model shared between several
+     * MeshInstances (e.g. the instances of a prefab). No-ops on an invalid
+     * handle or before Init.
+     */
+    static AxModelHandle AcquireModel(AxModelHandle Model);
+    static void ReleaseModel(AxModelHandle Model);
+
     /** Dirty tracking for editor integration. */
     bool IsDirty() const { return (Dirty_); }
     void MarkDirty() { Dirty_ = true; }
@@ -7,6 +7,7 @@
  * node classes. It provides:
  *   - Implicit conversion for zero-overhead reads
  *   - operator= that auto-marks the owning node dirty on writes
+ *   - SetRaw for bulk writers that mark the node dirty once themselves
  *   - Compile-time type safety (assigning wrong type is a compile error)
  *   - Equality comparison for skip-if-default serialization
  *
@@ -14,13 +15,38 @@
  * so that member access (Color.X) works naturally. Whole-value assignment
  * (Color = Vec3(1,0,0)) marks the node dirty; component writes (Color.X = 1)
  * work but skip the dirty flag — same tradeoff as Unreal Engine's UPROPERTY.
+ *
+ * The owner is kept as the signed byte distance from the property back to
+ * its node rather than a pointer, so a Property<float> is 8 bytes instead
+ * of 16. A copy of a property is detached (it has no owner); assigning one
+ * property to another copies the value and marks the target's owner dirty.
  */
 
 #include "AxEngine/AxNode.h"
 #include "AxEngine/AxMathTypes.h"
 #include <concepts>
+#include <cstdint>
 #include <string>
 
+/** Byte distance from a property to its owner; 0 means no owner. */
+inline int32_t PropertyOwnerOffset(const void* Property, const Node* Owner)
+{
+  if (!Owner) {
+    return (0);
+  }
+  return (static_cast<int32_t>(reinterpret_cast<intptr_t>(Owner) -
+                               reinterpret_cast<intptr_t>(Property)));
+}
+
+/** Owner of a property from its offset, or nullptr. */
+inline Node* PropertyOwner(const void* Property, int32_t OwnerOffset)
+{
+  if (OwnerOffset == 0) {
+    return (nullptr);
+  }
+  return (reinterpret_cast<Node*>(reinterpret_cast<intptr_t>(Property) + OwnerOffset));
+}
+
 //=============================================================================
 // Primary template — scalars, strings, enums
 //=============================================================================
@@ -32,7 +58,11 @@ public:
   using ValueType = T;
 
   Property(Node* Owner, const T& Default)
-    : Value_(Default), Owner_(Owner) {}
+    : Value_(Default), OwnerOffset_(PropertyOwnerOffset(this, Owner)) {}
+
+  // A copy does not know its owner (the offset is relative to the original)
+  Property(const Property& Other)
+    : Value_(Other.Value_), OwnerOffset_(0) {}
 
   // Read -- implicit conversion, zero overhead (inlines to value read)
   operator const T&() const { return (Value_); }
@@ -47,17 +77,23 @@ public:
   Property& operator=(const T& V)
   {
     Value_ = V;
-    if (Owner_) { Owner_->MarkDirty(); }
+    if (Node* Owner = PropertyOwner(this, OwnerOffset_)) { Owner->MarkDirty(); }
     return (*this);
   }
 
+  Property& operator=(const Property& Other) { return (*this = Other.Value_); }
+
+  // Write without marking the owner dirty, for bulk writers that mark the
+  // node once themselves (SceneTree::InstantiateBatch)
+  void SetRaw(const T& V) { Value_ = V; }
+
   // Comparison (for skip-if-default serialization)
   bool operator==(const T& Other) const { return (Value_ == Other); }
   bool operator!=(const T& Other) const { return (Value_ != Other); }
 
 private:
   T Value_;
-  Node* Owner_;
+  int32_t OwnerOffset_;
 };
 
 //=============================================================================
@@ -72,22 +108,34 @@ public:                                                            \
   using ValueType = T;                                             \
                                                                    \
   Property(Node* Owner, const T& Default)                          \
-    : T(Default), Owner_(Owner) {}                                 \
+    : T(Default), OwnerOffset_(PropertyOwnerOffset(this, Owner)) {} \
+                                                                   \
+  Property(const Property& Other)                                  \
+    : T(Other.Get()), OwnerOffset_(0) {}                           \
                                                                    \
   const T& Get() const { return (*this); }                         \
                                                                    \
   Property& operator=(const T& V)                                  \
   {                                                                \
     static_cast<T&>(*this) = V;                                    \
-    if (Owner_) { Owner_->MarkDirty(); }                           \
+    if (Node* Owner = PropertyOwner(this, OwnerOffset_)) {         \
+      Owner->MarkDirty();                                          \
+    }                                                              \
     return (*this);                                                \
   }                                                                \
                                                                    \
+  Property& operator=(const Property& Other)                       \
+  {                                                                \
+    return (*this = Other.Get());                                  \
+  }                                                                \
+                                                                   \
+  void SetRaw(const T& V) { static_cast<T&>(*this) = V; }          \
+                                                                   \
   bool operator==(const T& Other) const { return (T::operator==(Other)); } \
   bool operator!=(const T& Other) const { return (!(*this == Other)); }    \
                                                                    \
 private:                                                           \
-  Node* Owner_;                                                    \
+  int32_t OwnerOffset_;                                            \
 };
 
 AX_COMPOUND_PROPERTY(Vec3)
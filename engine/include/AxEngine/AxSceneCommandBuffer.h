@@ -0,0 +1,197 @@
+#pragma once
+
+/**
+ * AxSceneCommandBuffer.h - Deferred structural changes to a SceneTree
+ *
+ * CreateNode, DestroyNode and Node::SetParent change the tree at once,
+ * which is unsafe while the tree is iterated or from another thread. A
+ * SceneCommandBuffer records the same changes (plus reflected property
+ * writes) from any thread, and SceneTree::ApplyCommands applies them at a
+ * sync point in one batched pass.
+ *
+ * The pass does not replay commands in the order they were recorded.
+ * Commands are kept in one list per kind and applied kind by kind:
+ *
+ *   1. Create     parents before children, list space reserved up front
+ *   2. Reparent   new parents may be nodes created in step 1
+ *   3. Property   written after every node exists and has its parent
+ *   4. Events     one flush: NODE_CREATED for step 1, then NODE_DESTROYED
+ *                 for every node step 5 removes, while they are all alive
+ *   5. Destroy    last, so no other command can target a freed node
+ *
+ * Within a kind, record order is kept. New nodes and moved subtrees mark
+ * their transform slots dirty directly, and all of them are recomputed
+ * together by the next FlushTransforms.
+ *
+ * Commands name their nodes through a NodeRef: a handle to an existing
+ * node, or the result of a Create recorded earlier in the same buffer, so
+ * a whole subtree can be built and configured before any of it exists.
+ * A handle whose node was destroyed meanwhile, or a pending ref taken
+ * before the buffer was last applied, makes its command a no-op.
+ *
+ * SceneTree owns one buffer (GetCommandBuffer) that it applies at the end
+ * of each parallel script phase and once per Update, before the transform
+ * flush and also in Edit mode. Other buffers are applied when passed to
+ * ApplyCommands.
+ */
+
+#include "Foundation/AxTypes.h"
+#include "AxEngine/AxMathTypes.h"
+#include "AxEngine/AxNode.h"
+#include "AxEngine/AxNodeHandle.h"
+#include "AxEngine/AxPropertyReflection.h"
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class SceneCommandBuffer
+{
+public:
+  /** A node by handle, or a Create recorded earlier in the same buffer. */
+  struct NodeRef
+  {
+    static constexpr uint32_t NotPending = 0xFFFFFFFFu;
+
+    NodeHandle Handle;
+    uint32_t Pending;   // index of the Create command
+    uint32_t Epoch;     // buffer epoch the index belongs to
+
+    // Constructors rather than member initializers, so NodeRef() can be a
+    // default argument inside SceneCommandBuffer
+    NodeRef() : Pending(NotPending), Epoch(0) {}
+    NodeRef(NodeHandle Target) : Handle(Target), Pending(NotPending), Epoch(0) {}
+    NodeRef(Node* Target)
+      : Handle(Target ? Target->GetHandle() : NodeHandle{}), Pending(NotPending), Epoch(0) {}
+
+    bool IsPending() const { return (Pending != NotPending); }
+    bool IsNull() const { return (!IsPending() && Handle.IsNull()); }
+  };
+
+  struct CreateCommand
+  {
+    std::string Name;
+    NodeType Type;
+    NodeRef Parent;                          // null: the scene root
+    std::function<void(Node*)> OnCreated;
+  };
+
+  struct ReparentCommand
+  {
+    NodeRef Child;
+    NodeRef NewParent;                       // null: the scene root
+  };
+
+  struct PropertyCommand
+  {
+    NodeRef Target;
+    std::string Name;
+    PropType Type;                           // String also sets Enum properties by name
+    union {
+      float Float;
+      int32_t Int;
+      uint32_t UInt;
+      bool Bool;
+    };
+    Vec4 Vector;                             // Vec3 uses X..Z
+    std::string Text;
+
+    // The value is set by the caller after construction
+    PropertyCommand(NodeRef InTarget, std::string_view PropName, PropType InType)
+      : Target(InTarget), Name(PropName), Type(InType), Float(0.0f), Vector(), Text() {}
+  };
+
+  struct DestroyCommand
+  {
+    NodeRef Target;
+  };
+
+  /** Everything recorded between two applies, one list per kind. */
+  struct CommandLists
+  {
+    std::vector<CreateCommand> Creates;
+    std::vector<ReparentCommand> Reparents;
+    std::vector<PropertyCommand> Properties;
+    std::vector<DestroyCommand> Destroys;
+    uint32_t Epoch = 0;
+
+    uint32_t GetCount() const
+    {
+      return (static_cast<uint32_t>(Creates.size() + Reparents.size() +
+                                    Properties.size() + Destroys.size()));
+    }
+
+    void Clear();
+  };
+
+  SceneCommandBuffer() = default;
+
+  // Non-copyable (owns a mutex and pending refs into itself)
+  SceneCommandBuffer(const SceneCommandBuffer&) = delete;
+  SceneCommandBuffer& operator=(const SceneCommandBuffer&) = delete;
+
+  //=========================================================================
+  // Recording (any thread)
+  //=========================================================================
+
+  /**
+   * Record a node creation.
+   * @param Parent Parent node; null for the scene root. If it is gone by
+   *        the time the buffer is applied, the node is not created.
+   * @param OnCreated Called with the new node on the applying thread,
+   *        after the event flush.
+   * @return A ref later commands in this buffer can target.
+   */
+  NodeRef Create(std::string_view NodeName, NodeType Type, NodeRef Parent = NodeRef(),
+                 std::function<void(Node*)> OnCreated = nullptr);
+
+  /** Record the destruction of a node and its subtree. */
+  void Destroy(NodeRef Target);
+
+  /**
+   * Record moving Child (with its subtree) under NewParent, or under the
+   * scene root if NewParent is null. Skipped if NewParent is inside
+   * Child's subtree when applied.
+   */
+  void Reparent(NodeRef Child, NodeRef NewParent);
+
+  /**
+   * Record a write to the reflected property PropName. The value type must
+   * match the property's type; a string also sets an Enum property by
+   * entry name. Mismatches are skipped with a warning when applied.
+   */
+  void SetProperty(NodeRef Target, std::string_view PropName, float Value);
+  void SetProperty(NodeRef Target, std::string_view PropName, int32_t Value);
+  void SetProperty(NodeRef Target, std::string_view PropName, uint32_t Value);
+  void SetProperty(NodeRef Target, std::string_view PropName, bool Value);
+  void SetProperty(NodeRef Target, std::string_view PropName, std::string_view Value);
+  void SetProperty(NodeRef Target, std::string_view PropName, const char* Value);
+  void SetProperty(NodeRef Target, std::string_view PropName, const Vec3& Value);
+  void SetProperty(NodeRef Target, std::string_view PropName, const Vec4& Value);
+
+  /** Commands recorded and not yet applied. */
+  uint32_t GetCommandCount() const;
+  bool IsEmpty() const { return (GetCommandCount() == 0); }
+
+  /** Drop every recorded command. Pending refs taken so far go stale. */
+  void Clear();
+
+  //=========================================================================
+  // Applying
+  //=========================================================================
+
+  /**
+   * Move every recorded command into Out (which is cleared first) and
+   * start a new epoch. Used by SceneTree::ApplyCommands; Out keeps its
+   * capacity, so swapping the same lists in each frame does not allocate.
+   */
+  void Take(CommandLists& Out);
+
+private:
+  void PushProperty(PropertyCommand&& Command);
+
+  mutable std::mutex Mutex_;
+  CommandLists Lists_;
+};
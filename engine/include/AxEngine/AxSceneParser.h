@@ -4,9 +4,12 @@
 #include "AxOpenGL/AxOpenGLTypes.h"
 
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 class SceneTree;
 class Node;
+class PrefabTemplate;
 struct Tokenizer;
 struct AxAPIRegistry;
 struct AxAllocator;
@@ -60,7 +63,7 @@ class SceneParser
 {
 public:
     SceneParser() = default;
-    ~SceneParser() = default;
+    ~SceneParser();
 
     // Non-copyable
     SceneParser(const SceneParser&) = delete;
@@ -91,7 +94,8 @@ public:
 
     /**
      * Load a scene from a .ats file with automatic memory management.
-     * Uses the default scene memory size for allocation.
+     * Uses the default scene memory size for allocation. The scene owns
+     * that arena (SceneTree::OwnsAllocator) and releases it on delete.
      * @param FilePath Path to the .ats scene file
      * @return Loaded scene, or nullptr on failure
      */
@@ -99,7 +103,8 @@ public:
 
     /**
      * Load a scene from a string containing .ats format data.
-     * Uses the default scene memory size for allocation.
+     * Uses the default scene memory size for allocation. The scene owns
+     * that arena (SceneTree::OwnsAllocator) and releases it on delete.
      * @param SceneData Scene file content as string
      * @return Loaded scene, or nullptr on failure
      */
@@ -130,12 +135,45 @@ public:
     /**
      * Parse a prefab (.axp) string into a node subtree attached to Scene.
      * Prefab format: a single top-level "node" block with no scene wrapper.
+     * Compiles the text through the prefab cache (CompilePrefab), so
+     * loading the same prefab again skips parsing. Event handlers are
+     * invoked for the new nodes, children first.
      */
     Node* ParsePrefab(const char* PrefabData, SceneTree* Scene);
 
+    /**
+     * Compile a prefab (.axp) string into a PrefabTemplate without creating
+     * any nodes. Templates are cached by a 64-bit hash of the text, so each
+     * distinct prefab is parsed once and shared by every scene; primitive
+     * meshes are built once per template.
+     * @return The cached template, owned by the parser and valid until
+     *         ClearPrefabCache or Term, or nullptr on a parse error (see
+     *         GetLastError).
+     */
+    const PrefabTemplate* CompilePrefab(const char* PrefabData);
+
+    /** Read a prefab (.axp) file and compile it (see CompilePrefab). */
+    const PrefabTemplate* CompilePrefabFile(const char* FilePath);
+
+    /** Drop every cached template and release its primitive models. */
+    void ClearPrefabCache();
+
+    /** Number of compiled templates in the cache. */
+    uint32_t GetPrefabCacheSize() const { return (static_cast<uint32_t>(PrefabCache_.size())); }
+
+    /**
+     * Instantiate a compiled template once under Parent (the scene root if
+     * null) with SceneTree::InstantiateBatch.
+     * @return The root of the new subtree, or nullptr on failure.
+     */
+    Node* InstantiatePrefab(SceneTree* Scene, const PrefabTemplate& Template, Node* Parent);
+
     /**
      * Deep-copy a prefab node subtree into Scene, creating new independent nodes.
-     * Creates new typed node instances via Scene->CreateNode and copies data fields.
+     * Captures the subtree as a PrefabTemplate and builds the copy with
+     * SceneTree::InstantiateBatch: names, types, local transforms and
+     * reflected property values are copied. To stamp out many copies,
+     * capture once and call InstantiateBatch directly.
      */
     Node* InstantiatePrefab(SceneTree* Scene, Node* PrefabRoot, Node* Parent);
 
@@ -173,8 +211,21 @@ private:
     // Configuration
     size_t DefaultSceneMemorySize_{1024 * 1024};
 
+    // Hashes std::string keys and std::string_view probes alike, so a
+    // cache lookup does not copy the source
+    struct SourceHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view Key) const { return (std::hash<std::string_view>{}(Key)); }
+    };
+
+    // Compiled prefabs by their full source text (owned). Keyed on the
+    // text itself, so two sources can never share a template.
+    std::unordered_map<std::string, PrefabTemplate*, SourceHash, std::equal_to<>> PrefabCache_;
+
     // Internal parsing (implementation in AxSceneParser.cpp)
     Node* ParseNodeImpl(Tokenizer* T, SceneTree* Scene, Node* Parent);
+    bool CompileNodeImpl(Tokenizer* T, PrefabTemplate* Template, uint32_t Parent);
     SceneTree* ParseSceneImpl(Tokenizer* T);
 
     // Internal serialization helpers
@@ -185,4 +236,5 @@ private:
     void InvokeOnLightParsed(const AxLight* Light);
     void InvokeOnSceneParsed(const SceneTree* Scene);
     void InvokeOnNodeParsed(Node* ParsedNode);
+    void InvokeOnSubtreeParsed(Node* SubtreeRoot);
 };
@@ -12,13 +12,63 @@
  * delegating to a system registry. The frame loop in AxEngine::Tick
  * calls these methods explicitly.
  *
- * Typed nodes (MeshInstance, CameraNode, LightNode) are tracked in flat
- * arrays for efficient system-level queries via GetNodesByType().
+ * Typed nodes (MeshInstance through Sprite) are tracked in one flat
+ * growable array per NodeType for system-level queries via GetNodesByType()
+ * and for typed iteration via View<T>() and JoinChildren<P, C>() (see
+ * AxNodeView.h). Destroying a node leaves a hole that is closed, keeping
+ * creation order, by the next GetNodesByType or Update. None of the
+ * tracking lists have a fixed capacity.
  *
  * Optimization: Transform propagation, script dispatch, and script init
  * use flat lists (dirty roots, script process list, pending init queue)
  * instead of full-tree traversal, reducing per-frame work from
- * O(total_nodes) to O(changed/active_nodes).
+ * O(total_nodes) to O(changed/active_nodes). World matrices live in a
+ * parent-ordered TransformHierarchy and are recomputed in one linear pass.
+ *
+ * Lookups by name, child name and NodeID go through indices kept current on
+ * create/rename/destroy, so FindNode and GetNode never walk the tree. A
+ * structure version counter lets NodePath cache resolved paths. Every node
+ * also gets a generation-checked NodeHandle from a slot table.
+ *
+ * Node memory belongs to the tree: CreateNode draws from per-type NodePool
+ * chunks (backed by the scene's AxAllocator when it has one) and
+ * DestroyNode returns the slot to that type's free list. Destroying the
+ * tree runs each node's destructor in chunk order and frees memory a chunk
+ * at a time.
+ *
+ * Nodes given bounds with SetNodeBounds are kept in a dynamic AABB tree
+ * (GetSpatialIndex) for region, frustum and ray queries. The transform
+ * flush refits only the indexed nodes whose world matrix it recomputed.
+ *
+ * OnUpdate of scripts declared OwnNode or ReadOnlyScene (see ScriptAccess)
+ * runs on the worker pool set with SetWorkerPool, one parallel phase per
+ * access kind in each tick group. CreateNode and DestroyNode called inside
+ * a phase are queued and applied when it ends.
+ *
+ * Structural changes can also be recorded into a SceneCommandBuffer from
+ * any thread and applied in one batched pass (ApplyCommands): creates,
+ * reparents and property writes first, then a single event flush, then
+ * destroys. The tree's own buffer, which the queued calls above feed, is
+ * applied after each parallel phase and once per Update.
+ *
+ * InstantiateBatch stamps out copies of a PrefabTemplate in one pass: list
+ * space is reserved for the whole batch, property values are copied as raw
+ * bytes, and one AX_EVENT_NODES_INSTANTIATED event replaces the per-node
+ * AX_EVENT_NODE_CREATED events.
+ *
+ * Scripts may also run coroutine tasks (ScriptTask). Update resumes them
+ * after OnUpdate dispatch from timer wheels, signal hooks and polled
+ * predicates (see TaskScheduler), so a sleeping task costs nothing per
+ * frame. A node's tasks end when its script detaches or it is destroyed.
+ *
+ * For plain delays and interpolation the tree also owns a TimerService
+ * (callbacks and delayed signals on a timer wheel) and a TweenSystem
+ * (reflected properties eased in one structure-of-arrays pass), both
+ * stepped by Update before tasks resume.
+ *
+ * Outside Shipping the tree times the parts of Update and counts the work
+ * of each frame phase into a FrameStats (GetFrameStats), which AxEngine
+ * resets and collects once per Tick.
  *
  * "Scene" as a concept is the serialized file (.ats) and the node subtree
  * it produces, not the runtime container class.
@@ -31,16 +81,33 @@
 #include "Foundation/AxHashTable.h"
 #include "Foundation/AxAllocator.h"
 #include "AxEngine/AxNode.h"
+#include "AxEngine/AxNodeHandle.h"
+#include "AxEngine/AxNodePool.h"
+#include "AxEngine/AxNodeView.h"
 #include "AxEngine/AxTypedNodes.h"
 #include "AxEngine/AxEventBus.h"
-
+#include "AxEngine/AxFrameStats.h"
+#include "AxEngine/AxTransformHierarchy.h"
+#include "AxEngine/AxScriptFrame.h"
+#include "AxEngine/AxTaskScheduler.h"
+#include "AxEngine/AxTimerService.h"
+#include "AxEngine/AxTweenSystem.h"
+#include "AxEngine/AxSpatialIndex.h"
+#include "AxEngine/AxSceneCommandBuffer.h"
+#include "AxEngine/AxPrefabTemplate.h"
+
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <vector>
+#include <typeindex>
 #include <unordered_map>
 
 // Forward declarations
 class ScriptBase;
+class WorkerPool;
 
 //=============================================================================
 // Constants
@@ -52,8 +119,31 @@ class ScriptBase;
 /** Maximum number of cameras in a scene tree. */
 #define AX_SCENE_TREE_MAX_CAMERAS 16
 
-/** Maximum number of nodes per typed-node tracking array. */
-#define AX_SCENE_TREE_MAX_TYPED_NODES 1024
+//=============================================================================
+// Tick Groups
+//=============================================================================
+
+/**
+ * Tick LOD for a tick group: stretches each script's OnUpdate interval by
+ * the node's distance from the main camera and whether it is on screen.
+ * Has no effect while the tree has no main camera.
+ */
+struct TickLODSettings
+{
+  /** Scripts up to this distance from the camera tick at their own interval. */
+  float NearDistance{0.0f};
+
+  /** At and beyond this distance the interval is multiplied by FarScale;
+   *  between the two the multiplier grows linearly. 0 disables distance LOD. */
+  float FarDistance{0.0f};
+  uint32_t FarScale{1};
+
+  /** Interval multiplier for nodes outside the camera's view (1 disables). */
+  uint32_t OffscreenScale{1};
+
+  /** Extra view extent, as a fraction of the half screen, still on screen. */
+  float OffscreenMargin{0.1f};
+};
 
 //=============================================================================
 // SceneTree Class
@@ -80,13 +170,18 @@ public:
    * Construct a SceneTree with a hash table API and optional allocator.
    * Creates the RootNode, EventBus, and initializes defaults.
    * @param TableAPI Required hash table API for node operations.
-   * @param SceneAllocator Optional allocator for scene-scoped memory.
+   * @param SceneAllocator Optional allocator for scene-scoped memory. Node
+   *        pool chunks come from it, so it must outlive the tree unless
+   *        OwnsAllocator is set.
    */
   SceneTree(AxHashTableAPI* TableAPI, struct AxAllocator* SceneAllocator = nullptr);
 
   /**
    * Destroy the scene tree and all owned resources.
-   * Tears down nodes and EventBus in correct order.
+   * Detaches every script while all nodes are still alive, drops signal
+   * connections, then destroys nodes pool by pool and releases their
+   * chunks. Nodes allocated with new and parented into the tree are
+   * deleted too.
    */
   ~SceneTree();
 
@@ -129,10 +224,14 @@ public:
 
   /**
    * Create a new node in the scene tree.
-   * Allocates the correct typed node subclass based on NodeType.
+   * Allocates the correct typed node subclass based on NodeType from the
+   * tree's node pool. The tree owns the node: release it with DestroyNode
+   * (or by destroying the tree), never with delete.
    * Registers the node in the corresponding typed-node tracking array.
    * Sets the node's OwningTree_ back-pointer.
    * Fires AX_EVENT_NODE_CREATED on the EventBus.
+   * During a parallel script phase the creation is queued instead (see
+   * QueueCreateNode) and nullptr is returned.
    * @param NodeName Node name.
    * @param Type Node type (determines which subclass to allocate).
    * @param Parent Parent node (nullptr for root children).
@@ -143,30 +242,205 @@ public:
   /**
    * Destroy a node and all its children, removing from typed-node lists
    * and all optimization lists (dirty roots, script nodes, pending inits).
-   * Fires AX_EVENT_NODE_DESTROYED on the EventBus.
+   * Fires AX_EVENT_NODE_DESTROYED on the EventBus. Pooled nodes go back
+   * to their type's free list for the next CreateNode.
+   * During a parallel script phase the destruction is queued instead.
    * @param Target Node to destroy.
    */
   void DestroyNode(Node* Target);
 
+  //=========================================================================
+  // Queued Structural Changes
+  //=========================================================================
+
+  /**
+   * Queue a CreateNode for the next sync point. Safe from any thread.
+   * Shorthand for GetCommandBuffer().Create.
+   * @param OnCreated Called with the new node on the thread applying the
+   *        queue. Not called if Parent was destroyed first or creation
+   *        failed.
+   */
+  void QueueCreateNode(std::string_view NodeName, NodeType Type, Node* Parent = nullptr,
+                       std::function<void(Node*)> OnCreated = nullptr);
+
+  /** Queue a DestroyNode for the next sync point. Safe from any thread. */
+  void QueueDestroyNode(Node* Target);
+
   /**
-   * Find a node by name (recursive search from root).
+   * The tree's own command buffer, applied at every sync point. Record
+   * reparents and property writes here from scripts or worker threads.
+   */
+  SceneCommandBuffer& GetCommandBuffer() { return (Commands_); }
+
+  /**
+   * Apply the tree's command buffer. Runs at the end of each parallel
+   * script phase and in Update; call it from the main thread to apply
+   * changes queued elsewhere sooner.
+   */
+  void FlushQueuedCommands();
+
+  /**
+   * Apply every command recorded in Buffer in one batched pass (see
+   * AxSceneCommandBuffer.h for the order), repeating until commands
+   * recorded by callbacks during the pass are applied too. Main thread
+   * only; warns and does nothing inside a parallel phase.
+   */
+  void ApplyCommands(SceneCommandBuffer& Buffer);
+
+  /** Changes waiting for the next sync point. */
+  uint32_t GetQueuedCommandCount() const;
+
+  /** True while a parallel script phase runs. */
+  bool IsInParallelPhase() const { return (ParallelPhase_); }
+
+  /**
+   * Find a node by name via the name index.
+   * When several nodes share the name, the earliest created one is returned.
    * @param Name Name to search for.
    * @return Pointer to the found Node, or nullptr.
    */
   Node* FindNode(std::string_view Name);
 
+  /**
+   * Collect every node with the given name, earliest created first.
+   * @param Name Name to search for.
+   * @param OutNodes Cleared, then filled with the matching nodes.
+   */
+  void FindNodesByName(std::string_view Name, std::vector<Node*>& OutNodes) const;
+
+  /**
+   * Find a direct child of Parent by name via the name index. Falls back
+   * to a sibling scan when the name is ambiguous under Parent, so the
+   * first matching child in sibling order wins. Called by Node::FindChild.
+   */
+  Node* FindChildByName(Node* Parent, std::string_view Name) const;
+
+  /**
+   * Look up a node by its NodeID.
+   * @return The node, or nullptr if the ID was never issued or its node
+   *         has been destroyed.
+   */
+  Node* GetNodeByID(uint32_t ID) const;
+
+  //=========================================================================
+  // Prefab Instantiation
+  //=========================================================================
+
+  /**
+   * Create Count copies of Template's subtree under Parent (the scene root
+   * if null). Each copy gets the template's names, types, local transforms,
+   * property values, scripts and shared models (one model reference per
+   * copy); Transforms[i], if Transforms is not null, replaces the local
+   * transform of copy i's root.
+   *
+   * All tracking lists are grown once for the batch, script factories are
+   * looked up once per record, and no per-node events fire. Instead one
+   * AX_EVENT_NODES_INSTANTIATED event (payload AxNodesInstantiatedEvent,
+   * sender Parent) is published after every copy exists.
+   *
+   * Main thread only; warns and creates nothing inside a parallel phase.
+   * @param OutRoots If not null, receives the root of each copy (Count
+   *        entries).
+   * @return The number of copies created.
+   */
+  uint32_t InstantiateBatch(const PrefabTemplate& Template, uint32_t Count,
+                            const PrefabTransform* Transforms = nullptr, Node* Parent = nullptr,
+                            Node** OutRoots = nullptr);
+
+  //=========================================================================
+  // Node Handles
+  //=========================================================================
+
+  /**
+   * Resolve a handle in O(1).
+   * @return The node, or nullptr if the handle is null, from another tree
+   *         lineage, or its node has been destroyed.
+   */
+  Node* Resolve(NodeHandle Handle) const
+  {
+    if (Handle.Index < HandleSlots_.size() && Handle.Generation != 0 &&
+        HandleSlots_[Handle.Index].Generation == Handle.Generation) {
+      return (HandleSlots_[Handle.Index].Target);
+    }
+    return (nullptr);
+  }
+
+  /** Type-safe variant. Returns nullptr if the node is the wrong type. */
+  template<typename T>
+  T* Resolve(NodeHandle Handle) const
+  {
+    Node* Found = Resolve(Handle);
+    if (Found) {
+      return (Found->As<T>());
+    }
+    return (nullptr);
+  }
+
+  /** Handle of the node FindNode would return, or a null handle. */
+  NodeHandle FindNodeHandle(std::string_view Name);
+
+  /** Number of live handles (equals GetNodeCount()). */
+  uint32_t GetHandleCount() const
+  {
+    return (static_cast<uint32_t>(HandleSlots_.size() - FreeHandleSlots_.size()));
+  }
+
+  /** Most recently issued handle generation. */
+  uint32_t GetHandleGeneration() const { return (HandleGeneration_); }
+
+  /**
+   * Append the handle of every node in pre-order (root first, children in
+   * sibling order), the order SceneParser serializes and re-creates nodes.
+   */
+  void CaptureHandles(std::vector<NodeHandle>& OutHandles) const;
+
+  /**
+   * Re-assign handles captured from an earlier tree with the same shape,
+   * e.g. one re-parsed from a snapshot, so old handles resolve again.
+   * Generations issued afterwards exceed MinGeneration, so handles to nodes
+   * that existed only in a later tree never match.
+   * @return false (leaving handles unchanged) if the node count differs or
+   *         the handles are malformed.
+   */
+  bool RestoreHandles(const std::vector<NodeHandle>& Handles, uint32_t MinGeneration);
+
   //=========================================================================
   // Typed Node Queries
   //=========================================================================
 
   /**
-   * Get all nodes of a given type across the entire scene.
+   * Get all nodes of a given type across the entire scene, in creation
+   * order. Only typed nodes (MeshInstance and later) are tracked.
    * @param Type Node type to query.
    * @param OutCount Receives the number of nodes returned.
    * @return Array of Node pointers, or nullptr if none.
    */
   Node** GetNodesByType(NodeType Type, uint32_t* OutCount);
 
+  /** Number of live nodes of a tracked type, without compacting. */
+  uint32_t GetTypedNodeCount(NodeType Type) const;
+
+  /**
+   * Iterate every node of type T (a typed node class with StaticType):
+   *   for (LightNode* Light : Tree->View<LightNode>()) { ... }
+   */
+  template<typename T>
+  NodeView<T> View() const
+  {
+    uint32_t Index = static_cast<uint32_t>(T::StaticType);
+    return (NodeView<T>(TypedNodes_[Index], TypedHoles_[Index]));
+  }
+
+  /**
+   * Iterate every ChildT node whose parent is a ParentT, as
+   * (ParentT*, ChildT*) pairs.
+   */
+  template<typename ParentT, typename ChildT>
+  ChildJoinView<ParentT, ChildT> JoinChildren() const
+  {
+    return (ChildJoinView<ParentT, ChildT>(TypedNodes_[static_cast<uint32_t>(ChildT::StaticType)]));
+  }
+
   //=========================================================================
   // Accessors
   //=========================================================================
@@ -176,31 +450,126 @@ public:
   EventBus* GetEventBus() const { return (Bus_); }
   AxHashTableAPI* GetHashTableAPI() const { return (HashTableAPI_); }
 
-  /** Store the main camera pointer for propagation to scripts. */
+  /**
+   * Counter that changes whenever a node is created, destroyed, renamed or
+   * reparented. Used by NodePath to invalidate cached resolutions.
+   */
+  uint64_t GetStructureVersion() const { return (StructureVersion_); }
+
+  /** Per-type storage holding every node this tree created. */
+  const NodePool& GetNodePool() const { return (NodePool_); }
+
+  /** Flat world transform storage backing Node::GetWorldTransform(). */
+  const TransformHierarchy& GetTransformHierarchy() const { return (Hierarchy_); }
+
+  /**
+   * Set the worker pool used to propagate large transform updates and to
+   * run OnUpdate of OwnNode and ReadOnlyScene scripts across threads. Not
+   * owned; nullptr (the default) keeps both serial.
+   */
+  void SetWorkerPool(WorkerPool* Pool) { WorkerPool_ = Pool; }
+  WorkerPool* GetWorkerPool() const { return (WorkerPool_); }
+
+  /** Set the main camera in the frame context scripts read. */
   void SetMainCamera(CameraNode* Camera);
 
-  /** Store the mouse delta for propagation to scripts this frame. */
+  /** Set this frame's mouse delta in the frame context scripts read. */
   void UpdateMouseDelta(AxVec2 Delta);
 
+  /** Per-frame state shared by every script in this tree. */
+  const ScriptFrameContext& GetFrameContext() const { return (Frame_); }
+
+  //=========================================================================
+  // Script Tasks
+  //=========================================================================
+
+  /**
+   * Start a coroutine task owned by Owner (see ScriptBase::StartTask). It
+   * runs to its first suspension before this returns. Ignored, destroying
+   * the task, if Owner is not in this tree or a parallel phase is running.
+   */
+  void StartTask(Node* Owner, ScriptTask Task);
+
+  /** Destroy every task owned by Owner. */
+  void StopTasks(Node* Owner);
+
+  /** Scheduler running this tree's tasks (task counts for tools and tests). */
+  const TaskScheduler& GetTaskScheduler() const { return (Tasks_); }
+
+  //=========================================================================
+  // Timers and Tweens
+  //=========================================================================
+
+  /** Callback and delayed-signal timers, fired by Update on frame time. */
+  TimerService& GetTimers() { return (Timers_); }
+  const TimerService& GetTimers() const { return (Timers_); }
+
+  /** Property tweens, stepped by Update with the frame's DeltaT. */
+  TweenSystem& GetTweens() { return (Tweens_); }
+  const TweenSystem& GetTweens() const { return (Tweens_); }
+
+  //=========================================================================
+  // Spatial Queries
+  //=========================================================================
+
+  /**
+   * Give a node bounds in its local space and index it for spatial
+   * queries; calling again replaces the bounds. The node's world box
+   * follows its transform: each transform flush refits the indexed nodes
+   * whose world matrix changed. Not for use during a parallel script phase.
+   */
+  void SetNodeBounds(Node* Target, const AxAABB& LocalBounds);
+
+  /** Remove a node from the spatial index. */
+  void ClearNodeBounds(Node* Target);
+
+  /** World box of an indexed node as of the last flush; false if not indexed. */
+  bool GetNodeBounds(const Node* Target, AxAABB* OutBounds) const;
+
+  /**
+   * Dynamic AABB tree of the nodes given bounds: QueryAABB, QuerySphere,
+   * QueryFrustum, Raycast and their batched forms (see AxSpatialIndex.h).
+   */
+  SpatialIndex& GetSpatialIndex() { return (Spatial_); }
+  const SpatialIndex& GetSpatialIndex() const { return (Spatial_); }
+
 
   //=========================================================================
   // Groups
   //=========================================================================
 
-  /** Get all nodes in a named group. Returns empty vector if group doesn't exist. */
+  /**
+   * ID of a named group, registering the name on first use. IDs are small
+   * and dense, issued in order from 0, and stay valid for the tree's
+   * lifetime. Returns InvalidGroupId for an empty name.
+   */
+  GroupId GetGroupId(std::string_view GroupName);
+
+  /** ID of a named group, or InvalidGroupId if the name was never used. */
+  GroupId FindGroupId(std::string_view GroupName) const;
+
+  /** Name a group ID was issued for; empty for an unknown ID. */
+  std::string_view GetGroupName(GroupId Group) const;
+
+  /** Get all nodes in a group, in no particular order. Empty if the group doesn't exist. */
   const std::vector<Node*>& GetNodesInGroup(std::string_view GroupName) const;
+  const std::vector<Node*>& GetNodesInGroup(GroupId Group) const;
 
-  /** Get the number of nodes in a named group. */
+  /** Get the number of nodes in a group. */
   uint32_t GetGroupSize(std::string_view GroupName) const;
+  uint32_t GetGroupSize(GroupId Group) const;
 
-  /** Add a node to a named group. No-op if already present. Called by Node::AddToGroup. */
+  /** Add a node to a group. No-op if already present. Called by Node::AddToGroup. */
   void AddNodeToGroup(Node* Target, std::string_view GroupName);
+  void AddNodeToGroup(Node* Target, GroupId Group);
 
-  /** Remove a node from a named group. Called by Node::RemoveFromGroup. */
+  /** Remove a node from a group in O(1). Called by Node::RemoveFromGroup. */
   void RemoveNodeFromGroup(Node* Target, std::string_view GroupName);
+  void RemoveNodeFromGroup(Node* Target, GroupId Group);
 
-  /** Check if a node is in a named group. Called by Node::IsInGroup. */
+  /** Check if a node is in a group. Called by Node::IsInGroup. */
   bool IsNodeInGroup(const Node* Target, std::string_view GroupName) const;
+  bool IsNodeInGroup(const Node* Target, GroupId Group) const;
 
   //=========================================================================
   // Script Execution Control
@@ -227,10 +596,29 @@ public:
   /**
    * Add a node to the transform dirty roots list if not already present.
    * Called by Node::SetPosition/SetRotation/SetScale via the OwningTree_
-   * back-pointer. Uses InDirtyList_ flag for O(1) duplicate prevention.
+   * back-pointer. Uses DirtyListSlot_ for O(1) duplicate prevention.
    */
   void MarkTransformDirty(Node* DirtyNode);
 
+  /**
+   * Sync a node's TransformHierarchy parent after its Parent_ changed.
+   * Called by Node::AddChild/RemoveChild via the OwningTree_ back-pointer.
+   */
+  void OnNodeReparented(Node* Child);
+
+  /**
+   * Note that a node allocated with new (not from the pool) was parented
+   * into this tree, so teardown must look for it in the hierarchy.
+   * Called by Node::AddChild via the parent's OwningTree_ back-pointer.
+   */
+  void OnHeapNodeAttached() { HasHeapNodes_ = true; }
+
+  /**
+   * Rename a node in this tree, updating the name index.
+   * Called by Node::SetName via the OwningTree_ back-pointer.
+   */
+  void RenameNode(Node* Target, std::string_view NewName);
+
   /**
    * Register a node for pending script initialization.
    * Called by Node::AttachScript via the OwningTree_ back-pointer.
@@ -238,18 +626,126 @@ public:
   void RegisterPendingInit(Node* PendingNode);
 
   /**
-   * Register a node in the script process list for per-frame dispatch.
-   * Called after OnInit completes during ProcessPendingInits.
+   * Move a pending node to the init bucket for its new depth.
+   * Called by Node when a reparent changes the depth of a pending node.
+   */
+  void OnPendingInitDepthChanged(Node* PendingNode);
+
+  /** Scripts attached in this tree that are still waiting for OnInit. */
+  uint32_t GetPendingInitCount() const { return (PendingInitCount_); }
+
+  /**
+   * Register a node for per-frame dispatch. It joins the dispatch list of
+   * each callback its script declares, in the group for the script's class.
+   * Called after OnInit completes during ProcessPendingInits, for nodes
+   * that are active in the hierarchy.
    */
   void RegisterScriptNode(Node* ScriptNode);
 
   /**
-   * Unregister a node from the script process list.
+   * Unregister a node from per-frame dispatch.
    * Called by Node::DetachScript via the OwningTree_ back-pointer.
-   * Uses swap-with-last removal for O(1) performance.
+   * Uses swap-with-last removal; during dispatch the entry is cleared
+   * instead and the list compacted after the pass, so no script is skipped.
    */
   void UnregisterScriptNode(Node* ScriptNode);
 
+  /**
+   * Move a registered node between dispatch lists after its script's
+   * declared callbacks, access or tick group changed. Called by
+   * ScriptBase::DeclareCallbacks, ScriptBase::DeclareAccess and
+   * ScriptBase::SetTickGroup.
+   */
+  void OnScriptDispatchChanged(Node* ScriptNode);
+
+  /**
+   * Re-file a registered node after its script's tick interval changed and
+   * count the new interval from the current frame. Called by
+   * ScriptBase::SetTickInterval and ScriptBase::SetTickIntervalSeconds.
+   */
+  void OnScriptTickChanged(Node* ScriptNode);
+
+  /**
+   * Move a scripted node into or out of the script process list after its
+   * IsActiveInHierarchy() changed. Scripts still awaiting OnInit are left
+   * to ProcessPendingInits. Called by Node via the OwningTree_ back-pointer.
+   */
+  void OnScriptNodeActiveChanged(Node* ScriptNode);
+
+  /** Scripts currently dispatched each frame (initialized, active in hierarchy). */
+  uint32_t GetActiveScriptCount() const { return (ActiveScriptCount_); }
+
+  /**
+   * Scripts in the dispatch list for one callback (Update, FixedUpdate or
+   * LateUpdate); other values return 0.
+   */
+  uint32_t GetDispatchCount(ScriptCallbacks Callback) const;
+
+  /**
+   * Class groups with at least one script in the list for Callback,
+   * counted per tick group.
+   */
+  uint32_t GetDispatchGroupCount(ScriptCallbacks Callback) const;
+
+  /** Scripts whose OnUpdate runs in a parallel phase. */
+  uint32_t GetParallelScriptCount() const;
+
+  //=========================================================================
+  // Tick Groups
+  //=========================================================================
+
+  /** The group every script starts in ("Default", order 0). */
+  static constexpr uint32_t DefaultTickGroup = 0;
+
+  /** Returned by FindTickGroup for an unknown name. */
+  static constexpr uint32_t InvalidTickGroup = 0xFFFFFFFFu;
+
+  /**
+   * Add a named tick group, or change the order of an existing one.
+   * Each callback runs group by group in ascending Order (ties in creation
+   * order), so e.g. an "Input" group at -10 updates before "Default".
+   * Order changes apply from the next dispatch pass.
+   * @return The group's ID, stable for the life of the tree.
+   */
+  uint32_t AddTickGroup(std::string_view GroupName, int32_t Order);
+
+  /** ID of a tick group by name, or InvalidTickGroup. */
+  uint32_t FindTickGroup(std::string_view GroupName) const;
+
+  /**
+   * Time-slice a group's OnUpdate pass: each frame scripts run round-robin
+   * from where the previous frame stopped until Microseconds have passed
+   * (at least one script runs). Scripts not reached keep accumulating
+   * DeltaT. 0 (the default) runs the whole group every frame.
+   */
+  void SetTickGroupBudget(uint32_t Group, uint32_t Microseconds);
+
+  /**
+   * Stretch the OnUpdate interval of the group's scripts by camera distance
+   * and visibility. The multiplier is taken each time a script ticks and
+   * applies to its next interval.
+   */
+  void SetTickGroupLOD(uint32_t Group, const TickLODSettings& Settings);
+
+  /** OnUpdate calls made for the group during the last Update(). */
+  uint32_t GetTickGroupUpdateCount(uint32_t Group) const;
+
+  //=========================================================================
+  // Frame Statistics
+  //=========================================================================
+
+  /**
+   * Timings of the TransformFlush, PendingInits and Scripts phases and the
+   * tree's work counters (dirty roots, nodes recomputed, scripts per
+   * callback), summed over every Update, FixedUpdate and LateUpdate since
+   * the last ResetFrameStats. The engine-level phases and counters are
+   * left at zero. All zero in Shipping.
+   */
+  const FrameStats& GetFrameStats() const { return (Stats_); }
+
+  /** Start a new accumulation (AxEngine calls this at the top of each Tick). */
+  void ResetFrameStats() { Stats_ = FrameStats(); }
+
   //=========================================================================
   // Public Members
   //=========================================================================
@@ -258,6 +754,10 @@ public:
   std::string Name;
   struct AxAllocator* Allocator;
 
+  // Destroy Allocator along with the tree (set by SceneParser for the
+  // scene arena it creates in LoadSceneFromFile/LoadSceneFromString)
+  bool OwnsAllocator;
+
   // Scene settings (public for direct access)
   AxVec3 AmbientLight;
   AxVec3 Gravity;
@@ -269,8 +769,14 @@ private:
   // Traversal Helpers
   //=========================================================================
 
-  void UpdateNodeTransforms(Node* Current, const Mat4& ParentWorldMatrix,
-                            bool ParentWasDirty);
+  /**
+   * Copy the local matrix of every node in TransformDirtyRoots_ into the
+   * TransformHierarchy, then recompute world matrices in one linear pass.
+   * Nested entries (a node and its ancestor both changed) need no sorting or
+   * pruning: the pass coalesces them to the highest dirty ancestor, see
+   * TransformHierarchy::GetLastStats().
+   */
+  void FlushTransforms();
 
   //=========================================================================
   // Optimization List Processing
@@ -279,9 +785,70 @@ private:
   /** Process all pending script initializations (bottom-up order). */
   void ProcessPendingInits();
 
+  /** Drop a node from its pending-init bucket in O(1). */
+  void RemovePendingInit(Node* PendingNode);
+
+  /** Drop the holes left in the dispatch lists by removals during dispatch. */
+  void CompactScriptNodes();
+
+  /** Class index of Script, assigning the next one on first sight. */
+  uint32_t ScriptClassIndex(const ScriptBase* Script);
+
+  /** Dispatch list index for a single callback flag, or ScriptListCount. */
+  static uint32_t DispatchListIndex(ScriptCallbacks Callback);
+
+  /**
+   * Call Fn(ScriptBase*) for every script in one dispatch list, tick group
+   * by tick group, class group by class group.
+   */
+  template<typename FnType>
+  void DispatchScripts(uint32_t ListIndex, FnType&& Fn);
+
+  /** Dispatch OnUpdate with tick intervals, LOD, budgets and parallel phases applied. */
+  void DispatchUpdate();
+
+  /**
+   * Run OnUpdate of every script in a parallel list on the worker pool,
+   * then apply what they queued.
+   * @return Scripts that ran.
+   */
+  uint32_t RunParallelPhase(uint32_t Group, uint32_t ListIndex);
+
+  struct ScriptTickState;
+
+  /**
+   * Call OnUpdate on a throttled script if it is due, then schedule its
+   * next call from its interval, scaled by the group's LOD at this point.
+   */
+  bool TickScript(Node* ScriptNode, ScriptTickState& State, uint32_t Group);
+
+  /** Set State's due frame and time from its last tick. */
+  static void ScheduleTick(ScriptTickState& State, const ScriptBase* Script, uint32_t Scale);
+
+  /** Tick state of a node in a throttled Update list. */
+  ScriptTickState& GetTickState(const Node* ScriptNode);
+
+  /** Interval multiplier for a node under a group's LOD settings. */
+  uint32_t TickLODScale(const Node* ScriptNode, const TickLODSettings& LOD) const;
+
+  /** Sort TickGroupOrder_ after groups were added or reordered. */
+  void SortTickGroups();
+
+  /** True if a script's OnUpdate goes through TickScript rather than the plain list. */
+  bool IsThrottled(uint32_t Group, const ScriptBase* Script) const;
+
+  /**
+   * Re-file every Update script of a group after its budget or LOD was
+   * switched on or off, so each lands in the list matching IsThrottled.
+   */
+  void RefileTickGroup(uint32_t Group);
+
+  /** Treat a script as having ticked this frame. */
+  void RestartScriptTick(Node* ScriptNode);
+
   /**
    * Remove a node from all optimization lists (TransformDirtyRoots_,
-   * ScriptNodes_, PendingInitScripts_). Called during DestroyNode.
+   * dispatch lists, pending-init buckets). Called during DestroyNode.
    */
   void UnregisterFromAllLists(Node* Target);
 
@@ -295,7 +862,18 @@ private:
   // Private Helpers
   //=========================================================================
 
-  static Node* FindNodeRecursive(Node* Current, std::string_view Name);
+  /** Add a node to the name index and ID table. */
+  void IndexNode(Node* Target);
+
+  /** Remove a node from the name index and ID table. */
+  void UnindexNode(Node* Target);
+
+  /** Give a node a handle slot with a fresh generation. */
+  void AllocateHandle(Node* Target);
+
+  /** Free a node's handle slot; the handle stops resolving. */
+  void ReleaseHandle(Node* Target);
+
   static uint32_t CountNodesInSubtree(Node* Root);
   void FireEvent(AxEventType Type, Node* Sender, void* Data, size_t DataSize);
 
@@ -305,18 +883,46 @@ private:
   /** Unregister a typed node from the corresponding tracking array. */
   void UnregisterTypedNode(Node* Target);
 
+  /** Close the holes left in one typed-node array, keeping order. */
+  void CompactTypedNodes(uint32_t Index);
+
   /** Unregister all typed nodes in a subtree. */
   void UnregisterSubtreeTypedNodes(Node* Target);
 
   /** Set OwningTree_ on a node and all its descendants recursively. */
   void SetOwningTreeRecursive(Node* Target, SceneTree* Tree);
 
-  /** Recursively delete a subtree bottom-up (children first, then the node). */
-  void DestroySubtreeBottomUp(Node* Target);
+  /**
+   * CreateNode without the dirty-list entry and NODE_CREATED event, for
+   * batched passes that flush both once. The new transform slot is dirty.
+   */
+  Node* InstantiateNode(std::string_view NodeName, NodeType Type, Node* Parent);
+
+  /** DestroyNode body; Notify fires NODE_DESTROYED for each node. */
+  void DestroySubtree(Node* Target, bool Notify);
+
+  /** One pass of ApplyCommands over commands taken from a buffer. */
+  void ApplyCommandLists(SceneCommandBuffer::CommandLists& Lists);
+
+  /** Resolve a ref; pending refs index Created, the nodes made this pass. */
+  Node* ResolveCommandRef(const SceneCommandBuffer::NodeRef& Ref,
+                          const std::vector<NodeHandle>& Created, uint32_t Epoch) const;
+
+  /** Write one recorded property; warns and skips on a mismatch. */
+  static void ApplyPropertyCommand(Node* Target, const SceneCommandBuffer::PropertyCommand& Command);
+
+  /** Destroy every node on tree teardown (see ~SceneTree). */
+  void DestroyAllNodes();
+
+  /** Free one node's memory: back to its pool, or delete if heap-allocated. */
+  static void ReleaseNode(Node* Target);
 
   /** Remove a node from all groups. Called during DestroyNode cleanup. */
   void RemoveNodeFromAllGroups(Node* Target);
 
+  /** Swap-remove Target from the member list of the group at Slot. */
+  void RemoveGroupMember(Node* Target, GroupId Group, uint32_t Slot);
+
   /** Recursively remove a node and its subtree from all groups. */
   void RemoveSubtreeFromAllGroups(Node* Target);
 
@@ -324,6 +930,14 @@ private:
   // Private Members
   //=========================================================================
 
+  // Memory for every node created by this tree, root included
+  NodePool NodePool_;
+
+  // Set once and never cleared; they let teardown skip passes that find
+  // nothing (see DestroyAllNodes)
+  bool HasHeapNodes_;
+  bool HasScripts_;
+
   // Node hierarchy
   RootNode* Root_;
   uint32_t NodeCount_;
@@ -332,44 +946,182 @@ private:
   // Hash table API
   AxHashTableAPI* HashTableAPI_;
 
-  // Typed-node tracking arrays for efficient system-level queries
-  Node* MeshInstances_[AX_SCENE_TREE_MAX_TYPED_NODES];
-  uint32_t MeshInstanceCount_;
-  Node* CameraNodes_[AX_SCENE_TREE_MAX_TYPED_NODES];
-  uint32_t CameraNodeCount_;
-  Node* LightNodes_[AX_SCENE_TREE_MAX_TYPED_NODES];
-  uint32_t LightNodeCount_;
+  // Hashes std::string keys and std::string_view probes alike, so lookups
+  // by string_view do not allocate
+  struct NameHash
+  {
+    using is_transparent = void;
+    size_t operator()(std::string_view Key) const { return (std::hash<std::string_view>{}(Key)); }
+  };
+
+  // Name index -- every node with a given name (names need not be unique).
+  // Each node stores its position in its bucket (Node::NameIndexSlot_) so
+  // removal is a swap-with-last.
+  std::unordered_map<std::string, std::vector<Node*>, NameHash, std::equal_to<>> NameIndex_;
+
+  // NodeID -> Node; IDs are never reused, destroyed nodes leave nullptr
+  std::vector<Node*> NodesByID_;
+
+  // Bumped on create/destroy/rename/reparent (see GetStructureVersion)
+  uint64_t StructureVersion_;
+
+  // Handle table; a free slot has a null Target and generation 0
+  struct HandleSlot
+  {
+    Node* Target;
+    uint32_t Generation;
+  };
+  std::vector<HandleSlot> HandleSlots_;
+  std::vector<uint32_t> FreeHandleSlots_;
+  uint32_t HandleGeneration_;
+
+  // Typed-node tracking arrays, one per NodeType (untyped entries stay
+  // empty), in creation order. Destroyed nodes leave nullptr holes, counted
+  // in TypedHoles_ until the array is compacted.
+  // Storage grows on demand; an empty SceneTree allocates nothing here.
+  std::vector<Node*> TypedNodes_[NodeTypeCount];
+  uint32_t TypedHoles_[NodeTypeCount];
 
   // Transform dirty roots -- nodes whose transforms changed since last flush.
   // Iterated during Update() instead of full-tree traversal.
-  Node* TransformDirtyRoots_[AX_SCENE_TREE_MAX_TYPED_NODES];
-  uint32_t TransformDirtyRootCount_;
-
-  // Script process list -- nodes with initialized scripts for per-frame dispatch.
-  // Iterated during Update/FixedUpdate/LateUpdate instead of full-tree traversal.
-  Node* ScriptNodes_[AX_SCENE_TREE_MAX_TYPED_NODES];
-  uint32_t ScriptNodeCount_;
-
-  // Pending init queue -- nodes with scripts that need OnInit called.
-  // Processed during Update() instead of full-tree bottom-up init scan.
-  Node* PendingInitScripts_[AX_SCENE_TREE_MAX_TYPED_NODES];
+  std::vector<Node*> TransformDirtyRoots_;
+
+  // World matrices for every node in the tree, parents before children
+  TransformHierarchy Hierarchy_;
+
+  // Optional threads for transform propagation (not owned)
+  WorkerPool* WorkerPool_;
+
+  // Dispatch lists -- nodes with initialized scripts that are active in the
+  // hierarchy, one list per per-frame callback in each tick group. A node is
+  // only in the lists for callbacks its script declares. Update scripts that
+  // are throttled (see IsThrottled) go to ThrottledUpdateList instead of
+  // UpdateList, so the plain list is dispatched without per-script checks;
+  // unthrottled OwnNode and ReadOnlyScene scripts go to the parallel lists. Each list is split
+  // into groups by script class (indexed by ScriptClassIndex) so consecutive
+  // calls go to the same function. Inactive subtrees are removed rather
+  // than skipped.
+  // When a throttled script last ran and when it is next due. Kept beside
+  // its list entry rather than on the node or script, so checking a script
+  // that is not due reads neither.
+  struct ScriptTickState
+  {
+    double LastTime;
+    double DueTime;
+    uint32_t LastFrame;   // low bits of FrameIndex; compared by difference
+    uint32_t DueFrame;
+  };
+
+  struct ScriptDispatchList
+  {
+    std::vector<std::vector<Node*>> Groups;
+
+    // ThrottledUpdateList only: the tick state of each entry in Groups
+    std::vector<std::vector<ScriptTickState>> TickStates;
+    uint32_t Count = 0;
+  };
+
+  enum ScriptListIndex : uint32_t
+  {
+    UpdateList = 0,
+    FixedUpdateList,
+    LateUpdateList,
+    ThrottledUpdateList,
+    OwnNodeUpdateList,
+    ReadOnlyUpdateList,
+    ScriptListCount
+  };
+
+  struct TickGroupData
+  {
+    std::string Name;
+    int32_t Order = 0;
+    uint32_t BudgetMicros = 0;
+    TickLODSettings LOD;
+    bool HasLOD = false;
+    ScriptDispatchList Lists[ScriptListCount];
+
+    // Where the next time-sliced pass resumes (class group, entry)
+    uint32_t CursorGroup = 0;
+    uint32_t CursorEntry = 0;
+    uint32_t LastUpdateCount = 0;
+  };
+
+  // Indexed by group ID; a deque so a group added from inside a callback
+  // does not move the one being dispatched
+  std::deque<TickGroupData> TickGroups_;
+  std::vector<uint32_t> TickGroupOrder_;
+  bool TickGroupOrderDirty_;
+
+  // Main camera data for tick LOD, captured once per Update
+  bool LODViewValid_;
+  Vec3 LODCameraPos_;
+  Mat4 LODViewProj_;
+
+  // Spreads scripts with the same frame interval across frames
+  uint32_t TickStagger_;
+
+  std::unordered_map<std::type_index, uint32_t> ScriptClasses_;
+  uint32_t ActiveScriptCount_;
+
+  // While a dispatch pass runs, removals leave nullptr holes (counted here)
+  // that CompactScriptNodes() drops afterwards
+  bool DispatchingScripts_;
+  uint32_t ScriptNodeHoles_;
+
+  // Parallel script phases: the entries of the list being run, and
+  // structural changes queued by scripts (or any thread) for the next sync
+  // point
+  static constexpr uint32_t ParallelScriptBatch = 64;
+
+  bool ParallelPhase_;
+  std::vector<Node*> ParallelNodes_;
+  SceneCommandBuffer Commands_;
+  std::mutex ParallelDirtyMutex_;   // TransformDirtyRoots_ during a phase
+
+  // Pending init queue -- nodes with scripts that need OnInit called,
+  // bucketed by node depth. Processed deepest bucket first during Update(),
+  // which yields bottom-up order without sorting or walking parent chains.
+  // While processing, removals leave nullptr entries instead of swapping.
+  std::vector<std::vector<Node*>> PendingInitsByDepth_;
   uint32_t PendingInitCount_;
+  bool ProcessingPendingInits_;
 
   // Scene-scoped EventBus
   EventBus* Bus_;
 
-  // Engine state propagated to scripts during traversal
-  CameraNode* MainCamera_{nullptr};
-  AxVec2 MouseDelta_;
+  // Engine state scripts read through ScriptBase::GetFrame()
+  ScriptFrameContext Frame_;
+
+  // Coroutine tasks of this tree's scripts, resumed at the end of Update
+  TaskScheduler Tasks_;
+
+  // Timers and tweens, stepped in Update just before tasks
+  TimerService Timers_;
+  TweenSystem Tweens_;
+
+  // Bounded nodes for region and ray queries, refitted by FlushTransforms
+  SpatialIndex Spatial_;
+
+  // Phase timings and work counters since the last ResetFrameStats
+  FrameStats Stats_;
 
   // Script execution control -- when false, Update() only propagates
   // transforms and skips script init/dispatch. Set by AxEngine based
   // on the current AxEngineMode (Edit disables, Play enables).
   bool ScriptsEnabled_{true};
 
-  // String-based groups -- runtime grouping for gameplay queries.
-  // Key: group name, Value: vector of nodes in the group.
-  std::unordered_map<std::string, std::vector<Node*>> Groups_;
+  // Groups -- runtime grouping for gameplay queries. Names map to dense
+  // IDs indexing Groups_; each node keeps its own sorted membership list
+  // (Node::ColdData::GroupEntries) with its index in every member list, so joining,
+  // leaving and destroying touch only the node's own groups.
+  struct GroupRecord
+  {
+    std::string Name;
+    std::vector<Node*> Members;
+  };
+  std::unordered_map<std::string, GroupId, NameHash, std::equal_to<>> GroupIds_;
+  std::vector<GroupRecord> Groups_;
 
   // Empty vector returned by GetNodesInGroup for nonexistent groups.
   static const std::vector<Node*> EmptyNodeVector_;
@@ -2,9 +2,14 @@
 
 #include "Foundation/AxTypes.h"
 #include "AxEngine/AxSceneTree.h"
+#include "AxEngine/AxNodePath.h"
 #include "AxEngine/AxDebugDraw.h"
 #include "AxEngine/AxScriptLog.h"
 
+#include <algorithm>
+#include <concepts>
+#include <type_traits>
+
 /**
  * AxScriptBase.h - Script Base Class for Node Behavioral Scripting
  *
@@ -23,6 +28,27 @@
  *   OnFixedUpdate(float DeltaT)
  *   OnLateUpdate(float DeltaT)
  *
+ * SceneTree only calls a per-frame callback on scripts that implement it.
+ * OnUpdate may also be throttled: a script can tick every N frames or every
+ * T seconds, and its tick group (SceneTree::AddTickGroup) may stretch that
+ * interval with distance from the main camera or spread the group over
+ * several frames under a time budget. A throttled script receives the time
+ * since its previous OnUpdate as DeltaT.
+ * A script class that only touches its own node, or only reads the scene,
+ * can say so (static constexpr ScriptAccess UpdateAccess) and have its
+ * OnUpdate run on worker threads; see ScriptAccess.
+ * Scripts created through ScriptRegistry have their overrides detected by
+ * AX_IMPLEMENT_SCRIPT; scripts constructed directly are dispatched every
+ * callback unless they call DeclareCallbacks() before attachment.
+ *
+ * Longer-running behavior can be written as coroutines: StartTask runs a
+ * ScriptTask that co_awaits WaitSeconds, WaitFrames, WaitForSignal or
+ * WaitUntil, and the SceneTree resumes it when the wait ends.
+ *
+ * Per-frame engine state (main camera, mouse delta, frame delta) is read
+ * through GetFrame(), which points at the owning SceneTree's shared
+ * ScriptFrameContext once the script is initialized.
+ *
  * Owner and IsInitialized are managed by Node and SceneTree respectively.
  */
 
@@ -80,6 +106,9 @@ public:
   //=========================================================================
 
   Node* GetOwner() const { return (Owner_); }
+
+  /** Generation-checked handle to the owner; null if the owner is not in a tree. */
+  NodeHandle GetOwnerHandle() const { return (Owner_ ? Owner_->GetHandle() : NodeHandle()); }
   bool IsInitialized() const { return (IsInitialized_); }
 
   //=========================================================================
@@ -98,17 +127,167 @@ public:
   /** Query whether OnFixedUpdate dispatch is enabled. */
   bool IsPhysicsProcessing() const { return (PhysicsProcessing_); }
 
+  //=========================================================================
+  // Tick Control (OnUpdate only)
+  //=========================================================================
+
+  /**
+   * Run OnUpdate every Frames frames (0 is treated as 1, at most 65535).
+   * Clears any interval set in seconds. Scripts with the same interval are
+   * staggered across frames when they are registered.
+   */
+  void SetTickInterval(uint32_t Frames)
+  {
+    TickInterval_ = static_cast<uint16_t>(std::clamp<uint32_t>(Frames, 1, 0xFFFF));
+    TickIntervalSeconds_ = 0.0f;
+    OnTickChanged();
+  }
+
+  /** Run OnUpdate at most once per Seconds (0 restores every frame). */
+  void SetTickIntervalSeconds(float Seconds)
+  {
+    TickInterval_ = 1;
+    TickIntervalSeconds_ = (Seconds > 0.0f) ? Seconds : 0.0f;
+    OnTickChanged();
+  }
+
+  uint32_t GetTickInterval() const { return (TickInterval_); }
+  float GetTickIntervalSeconds() const { return (TickIntervalSeconds_); }
+
+  /**
+   * Move this script to a tick group of its tree (an ID returned by
+   * SceneTree::AddTickGroup). Takes effect at once if already dispatched.
+   */
+  void SetTickGroup(uint32_t Group)
+  {
+    if (Group == TickGroup_ || Group > 0xFFFF) {
+      return;
+    }
+
+    TickGroup_ = static_cast<uint16_t>(Group);
+    SceneTree* Tree = Owner_ ? Owner_->GetOwningTree() : nullptr;
+    if (Tree) {
+      Tree->OnScriptDispatchChanged(Owner_);
+    }
+  }
+
+  uint32_t GetTickGroup() const { return (TickGroup_); }
+
+  //=========================================================================
+  // Callback Declaration
+  //=========================================================================
+
+  /**
+   * Declare which per-frame callbacks this script implements. Only those
+   * are dispatched. Default: ScriptCallbacks::All. Takes effect at once,
+   * also for a script that is already being dispatched.
+   */
+  void DeclareCallbacks(ScriptCallbacks Callbacks)
+  {
+    if (Callbacks == Callbacks_) {
+      return;
+    }
+
+    Callbacks_ = Callbacks;
+    SceneTree* Tree = Owner_ ? Owner_->GetOwningTree() : nullptr;
+    if (Tree) {
+      Tree->OnScriptDispatchChanged(Owner_);
+    }
+  }
+
+  /** Per-frame callbacks this script is dispatched for. */
+  ScriptCallbacks GetDeclaredCallbacks() const { return (Callbacks_); }
+
+  /**
+   * Declare what this script's OnUpdate touches (see ScriptAccess). OwnNode
+   * and ReadOnlyScene scripts may run on worker threads. Default:
+   * ScriptAccess::Exclusive. Takes effect at once, like DeclareCallbacks.
+   */
+  void DeclareAccess(ScriptAccess Access)
+  {
+    if (Access == Access_) {
+      return;
+    }
+
+    Access_ = Access;
+    SceneTree* Tree = Owner_ ? Owner_->GetOwningTree() : nullptr;
+    if (Tree) {
+      Tree->OnScriptDispatchChanged(Owner_);
+    }
+  }
+
+  /** Access this script's OnUpdate was declared with. */
+  ScriptAccess GetDeclaredAccess() const { return (Access_); }
+
+  /**
+   * Access declared by T as a static member, or Exclusive without one:
+   *   static constexpr ScriptAccess UpdateAccess = ScriptAccess::OwnNode;
+   */
+  template<typename T>
+  static constexpr ScriptAccess DetectAccess()
+  {
+    if constexpr (requires { { T::UpdateAccess } -> std::convertible_to<ScriptAccess>; }) {
+      return (T::UpdateAccess);
+    } else {
+      return (ScriptAccess::Exclusive);
+    }
+  }
+
+  /**
+   * Per-frame callbacks T overrides. A callback counts as overridden when
+   * &T::OnX no longer names the ScriptBase member, or when T made it
+   * inaccessible (only possible by redeclaring it).
+   */
+  template<typename T>
+  static constexpr ScriptCallbacks DetectCallbacks()
+  {
+    using CallbackFn = void (ScriptBase::*)(float);
+    ScriptCallbacks Found = ScriptCallbacks::None;
+
+    if constexpr (requires { &T::OnUpdate; }) {
+      if constexpr (!std::is_same_v<decltype(&T::OnUpdate), CallbackFn>) {
+        Found = Found | ScriptCallbacks::Update;
+      }
+    } else {
+      Found = Found | ScriptCallbacks::Update;
+    }
+
+    if constexpr (requires { &T::OnFixedUpdate; }) {
+      if constexpr (!std::is_same_v<decltype(&T::OnFixedUpdate), CallbackFn>) {
+        Found = Found | ScriptCallbacks::FixedUpdate;
+      }
+    } else {
+      Found = Found | ScriptCallbacks::FixedUpdate;
+    }
+
+    if constexpr (requires { &T::OnLateUpdate; }) {
+      if constexpr (!std::is_same_v<decltype(&T::OnLateUpdate), CallbackFn>) {
+        Found = Found | ScriptCallbacks::LateUpdate;
+      }
+    } else {
+      Found = Found | ScriptCallbacks::LateUpdate;
+    }
+
+    return (Found);
+  }
+
 protected:
   ScriptBase() = default;
 
-  /** Main camera — set by SceneTree before each traversal. */
-  CameraNode* MainCamera{nullptr};
+  /** The SceneTree this script's node belongs to — set by SceneTree before OnInit. */
+  SceneTree* Tree_{nullptr};
 
-  /** Mouse delta this frame — set by SceneTree before each traversal. */
-  AxVec2 MouseDelta{0.0f, 0.0f};
+  /** Per-frame engine state shared by every script in the tree. */
+  const ScriptFrameContext& GetFrame() const
+  {
+    return (Tree_ ? Tree_->GetFrameContext() : DefaultFrame_);
+  }
 
-  /** The SceneTree this script's node belongs to — set by SceneTree. */
-  SceneTree* Tree_{nullptr};
+  /** Main camera of the owning SceneTree. */
+  CameraNode* GetMainCamera() const { return (GetFrame().MainCamera); }
+
+  /** Mouse movement this frame. */
+  AxVec2 GetMouseDelta() const { return (GetFrame().MouseDelta); }
 
   /** Access the owning SceneTree (e.g., for runtime node creation). */
   SceneTree* GetSceneTree() const { return (Tree_); }
@@ -145,12 +324,55 @@ protected:
     return (nullptr);
   }
 
+  /** Resolve a precompiled path from this script's owner (cached per tree version). */
+  Node* GetNode(const NodePath& Path)
+  {
+    if (Owner_) { return (Owner_->GetNode(Path)); }
+    return (nullptr);
+  }
+
+  /** Type-safe variant of GetNode for a precompiled path. */
+  template<typename T>
+  T* GetNode(const NodePath& Path)
+  {
+    if (Owner_) { return (Owner_->GetNode<T>(Path)); }
+    return (nullptr);
+  }
+
+  /** Handle of the node at a relative path from the owner, or a null handle. */
+  NodeHandle GetNodeHandle(std::string_view Path)
+  {
+    Node* Found = GetNode(Path);
+    return (Found ? Found->GetHandle() : NodeHandle());
+  }
+
+  /** Resolve a handle held by this script; nullptr once the node is destroyed. */
+  Node* Resolve(NodeHandle Handle) const
+  {
+    SceneTree* Tree = Owner_ ? Owner_->GetOwningTree() : nullptr;
+    return (Tree ? Tree->Resolve(Handle) : nullptr);
+  }
+
+  /** Type-safe variant of Resolve. */
+  template<typename T>
+  T* Resolve(NodeHandle Handle) const
+  {
+    SceneTree* Tree = Owner_ ? Owner_->GetOwningTree() : nullptr;
+    return (Tree ? Tree->Resolve<T>(Handle) : nullptr);
+  }
+
   /** Add this script's owner to a named group. */
   void AddToGroup(std::string_view GroupName)
   {
     if (Owner_) { Owner_->AddToGroup(GroupName); }
   }
 
+  /** Add this script's owner to a group by ID (see SceneTree::GetGroupId). */
+  void AddToGroup(GroupId Group)
+  {
+    if (Owner_) { Owner_->AddToGroup(Group); }
+  }
+
   //=========================================================================
   // Signals — convenience wrappers that delegate to Owner_ node
   //=========================================================================
@@ -176,6 +398,41 @@ protected:
     return (0);
   }
 
+  /** Connect to a signal on a node held by handle. Returns 0 if it no longer exists. */
+  uint32_t Connect(NodeHandle Emitter, std::string_view SignalName, SignalCallback Callback)
+  {
+    return (Connect(Resolve(Emitter), SignalName, std::move(Callback)));
+  }
+
+  //=========================================================================
+  // Tasks — coroutines resumed by the SceneTree (see AxScriptTask.h)
+  //=========================================================================
+
+  /**
+   * Run a coroutine until its first co_await; the SceneTree resumes it
+   * when the wait ends. Tasks keep running while the node is inactive and
+   * end when the script detaches or the node is destroyed. Needs the owner
+   * to be in a SceneTree.
+   */
+  void StartTask(ScriptTask Task)
+  {
+    SceneTree* Tree = Owner_ ? Owner_->GetOwningTree() : nullptr;
+    if (Tree) {
+      Tree->StartTask(Owner_, std::move(Task));
+    } else {
+      Log::Warn("StartTask: script is not in a scene tree");
+    }
+  }
+
+  /** End every task this script started. */
+  void StopAllTasks()
+  {
+    SceneTree* Tree = Owner_ ? Owner_->GetOwningTree() : nullptr;
+    if (Tree) {
+      Tree->StopTasks(Owner_);
+    }
+  }
+
   //=========================================================================
   // Debug — draw and log utilities grouped under Debug member
   //
@@ -227,10 +484,30 @@ protected:
 
 private:
 
+  // Zeroed context used until SceneTree initializes the script
+  static inline const ScriptFrameContext DefaultFrame_{};
+
   Node* Owner_              = nullptr;
   bool  IsInitialized_      = false;
   bool  Processing_         = true;
   bool  PhysicsProcessing_  = true;
+  ScriptCallbacks Callbacks_ = ScriptCallbacks::All;
+  ScriptAccess Access_       = ScriptAccess::Exclusive;
+
+  // Tick control, packed into what would otherwise be padding. When the
+  // script last ticked is kept by SceneTree beside its dispatch entry.
+  uint16_t TickInterval_        = 1;
+  uint16_t TickGroup_           = 0;
+  float    TickIntervalSeconds_ = 0.0f;
+
+  // Interval changes count from now
+  void OnTickChanged()
+  {
+    SceneTree* Tree = Owner_ ? Owner_->GetOwningTree() : nullptr;
+    if (Tree) {
+      Tree->OnScriptTickChanged(Owner_);
+    }
+  }
 
   friend class Node;
   friend class SceneTree;
@@ -240,7 +517,8 @@ private:
 // AX_IMPLEMENT_SCRIPT — Place at the bottom of your game script .cpp file.
 // Auto-registers the script class with ScriptRegistry via a static initializer.
 // Works in both DLL mode (registration on DLL load) and monolithic shipping
-// (registration at program startup).
+// (registration at program startup). The factory declares the per-frame
+// callbacks ClassName overrides, so SceneTree skips the others.
 //
 // Example:
 //   class Game : public ScriptBase { ... };
@@ -249,7 +527,13 @@ private:
 #include "AxEngine/AxScriptRegistry.h"
 
 #define AX_IMPLEMENT_SCRIPT(ClassName) \
-  static ScriptBase* _CreateScript_##ClassName() { return (new ClassName()); } \
+  static ScriptBase* _CreateScript_##ClassName() \
+  { \
+    ScriptBase* Script = new ClassName(); \
+    Script->DeclareCallbacks(ScriptBase::DetectCallbacks<ClassName>()); \
+    Script->DeclareAccess(ScriptBase::DetectAccess<ClassName>()); \
+    return (Script); \
+  } \
   static struct _ScriptReg_##ClassName { \
     _ScriptReg_##ClassName() { ScriptRegistry::Get().Register(#ClassName, _CreateScript_##ClassName); } \
   } _s_scriptReg_##ClassName;
@@ -0,0 +1,104 @@
+#pragma once
+
+/**
+ * AxScriptFrame.h - Per-frame state shared by SceneTree and its scripts
+ *
+ * ScriptFrameContext holds the engine state scripts read every frame. The
+ * SceneTree owns one and updates it once per frame (SetMainCamera,
+ * UpdateMouseDelta, Update, FixedUpdate); scripts read it through their
+ * tree from OnInit on, so dispatch writes nothing into individual scripts.
+ *
+ * ScriptCallbacks names the per-frame callbacks a script implements. The
+ * SceneTree keeps one dispatch list per callback and enters a script only
+ * in the lists its flags select.
+ *
+ * ScriptAccess states what a script's OnUpdate touches, which decides
+ * whether SceneTree may run it on worker threads.
+ */
+
+#include "Foundation/AxTypes.h"
+
+class CameraNode;
+
+//=============================================================================
+// Frame Context
+//=============================================================================
+
+struct ScriptFrameContext
+{
+  /** Camera the scene renders from, or nullptr. */
+  CameraNode* MainCamera{nullptr};
+
+  /** Mouse movement since the previous frame. */
+  AxVec2 MouseDelta{0.0f, 0.0f};
+
+  /** Delta passed to the current (or last) Update. */
+  float DeltaT{0.0f};
+
+  /** Delta passed to the current (or last) FixedUpdate. */
+  float FixedDeltaT{0.0f};
+
+  /** Number of Update calls that dispatched scripts, including the current one. */
+  uint64_t FrameIndex{0};
+
+  /** Sum of those Update deltas, in seconds. */
+  double Time{0.0};
+};
+
+//=============================================================================
+// Script Callback Flags
+//=============================================================================
+
+/** Per-frame callbacks a script implements; selects its dispatch lists. */
+enum class ScriptCallbacks : uint8_t
+{
+  None        = 0,
+  Update      = 1 << 0,
+  FixedUpdate = 1 << 1,
+  LateUpdate  = 1 << 2,
+  All         = Update | FixedUpdate | LateUpdate,
+};
+
+inline constexpr ScriptCallbacks operator|(ScriptCallbacks A, ScriptCallbacks B)
+{
+  return (static_cast<ScriptCallbacks>(static_cast<uint8_t>(A) | static_cast<uint8_t>(B)));
+}
+
+inline constexpr ScriptCallbacks operator&(ScriptCallbacks A, ScriptCallbacks B)
+{
+  return (static_cast<ScriptCallbacks>(static_cast<uint8_t>(A) & static_cast<uint8_t>(B)));
+}
+
+inline constexpr bool HasFlag(ScriptCallbacks Flags, ScriptCallbacks Test)
+{
+  return (static_cast<uint8_t>(Flags & Test) != 0);
+}
+
+//=============================================================================
+// Script Access
+//=============================================================================
+
+/**
+ * What a script's OnUpdate reads and writes. SceneTree runs the OnUpdate of
+ * OwnNode and ReadOnlyScene scripts on its worker pool, each kind in a
+ * parallel phase of its own, and Exclusive scripts on the calling thread.
+ * The declaration is trusted, not checked.
+ *
+ * CreateNode and DestroyNode called during a parallel phase are queued and
+ * applied at the sync point that ends the phase.
+ */
+enum class ScriptAccess : uint8_t
+{
+  /** Anything; runs on the calling thread. The default. */
+  Exclusive = 0,
+
+  /**
+   * Reads and writes its own node's transform and properties and its own
+   * script only. Renaming, reparenting, activation, groups and signals
+   * touch shared tree state and need Exclusive.
+   */
+  OwnNode,
+
+  /** Reads any node; writes only its own script's members. */
+  ReadOnlyScene,
+};
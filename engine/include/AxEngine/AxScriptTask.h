@@ -0,0 +1,223 @@
+#pragma once
+
+/**
+ * AxScriptTask.h - Coroutine tasks for scripts
+ *
+ * A ScriptTask is a C++20 coroutine a script starts with StartTask. It runs
+ * up to its first co_await right away, then sleeps until what it awaits
+ * happens:
+ *
+ *   co_await WaitSeconds(0.5f);              // frame time, ms resolution
+ *   co_await WaitFrames(3);                  // three Update calls later
+ *   SignalArgs Hit = co_await WaitForSignal(Door, "opened");
+ *   co_await WaitUntil([this] { return (Health <= 0.0f); });
+ *
+ * The owning SceneTree resumes tasks once per Update, after OnUpdate
+ * dispatch. Timed waits sit in timer wheels and signal waits in the
+ * emitter's connection list, so a sleeping task costs nothing per frame;
+ * only WaitUntil predicates are polled. A task ends when its coroutine
+ * returns, when its script is detached, or when its node is destroyed
+ * (the frame is destroyed at its current suspension point, running the
+ * destructors of its locals).
+ *
+ * Typical use is a member function of the script, so the coroutine may
+ * use the script's members freely:
+ *
+ *   ScriptTask Blink()
+ *   {
+ *     for (;;) {
+ *       co_await WaitSeconds(0.25f);
+ *       GetOwner()->SetActive(!GetOwner()->IsActive());
+ *     }
+ *   }
+ *   void OnInit() override { StartTask(Blink()); }
+ *
+ * Captures of a coroutine lambda are not copied into its frame; prefer
+ * member functions or free functions taking arguments by value.
+ *
+ * Coroutine frames come from ScriptTaskFramePool, which keeps freed frames
+ * on per-size free lists, so starting a task after warm-up does not touch
+ * the heap. Tasks are started and resumed on the thread that owns the
+ * SceneTree, never from a parallel script phase.
+ */
+
+#include "Foundation/AxTypes.h"
+#include "AxEngine/AxNodeHandle.h"
+#include "AxEngine/AxSignal.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+class Node;
+class TaskScheduler;
+
+//=============================================================================
+// ScriptTaskFramePool
+//=============================================================================
+
+/**
+ * Process-wide storage for coroutine frames. Frames are rounded up to a
+ * multiple of FrameGranularity and carved from chunks of FramesPerChunk;
+ * larger frames go to the heap. Thread-safe.
+ */
+class ScriptTaskFramePool
+{
+public:
+  static constexpr size_t FrameGranularity = 64;
+  static constexpr size_t MaxPooledFrameSize = 1024;
+  static constexpr uint32_t FramesPerChunk = 64;
+
+  static void* Allocate(size_t Size);
+  static void Release(void* Frame, size_t Size);
+
+  /** Frames currently allocated (pooled and heap). */
+  static uint32_t GetLiveFrameCount();
+
+  /** Bytes held in pool chunks, in use or free. */
+  static size_t GetReservedBytes();
+};
+
+//=============================================================================
+// ScriptTask
+//=============================================================================
+
+/**
+ * Move-only owner of a coroutine that has not been started yet. StartTask
+ * takes it over; a ScriptTask destroyed without being started destroys its
+ * coroutine frame.
+ */
+class ScriptTask
+{
+public:
+  struct promise_type
+  {
+    // Set when the task is started
+    TaskScheduler* Scheduler = nullptr;
+    uint32_t Slot = 0;
+
+    ScriptTask get_return_object()
+    {
+      return (ScriptTask(std::coroutine_handle<promise_type>::from_promise(*this)));
+    }
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception();
+
+    static void* operator new(size_t Size) { return (ScriptTaskFramePool::Allocate(Size)); }
+    static void operator delete(void* Frame, size_t Size) { ScriptTaskFramePool::Release(Frame, Size); }
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  ScriptTask() = default;
+  ~ScriptTask()
+  {
+    if (Handle_) {
+      Handle_.destroy();
+    }
+  }
+
+  ScriptTask(ScriptTask&& Other) noexcept : Handle_(Other.Handle_) { Other.Handle_ = nullptr; }
+  ScriptTask& operator=(ScriptTask&& Other) noexcept
+  {
+    if (this != &Other) {
+      if (Handle_) {
+        Handle_.destroy();
+      }
+      Handle_ = Other.Handle_;
+      Other.Handle_ = nullptr;
+    }
+    return (*this);
+  }
+
+  ScriptTask(const ScriptTask&) = delete;
+  ScriptTask& operator=(const ScriptTask&) = delete;
+
+  bool IsValid() const { return (static_cast<bool>(Handle_)); }
+
+  /** Give up ownership of the coroutine (used by TaskScheduler::Start). */
+  Handle Release()
+  {
+    Handle Released = Handle_;
+    Handle_ = nullptr;
+    return (Released);
+  }
+
+private:
+  explicit ScriptTask(Handle H) : Handle_(H) {}
+
+  Handle Handle_;
+};
+
+//=============================================================================
+// Awaitables
+//=============================================================================
+
+/** Resume once Frames more SceneTree::Update calls have run. 0 does not suspend. */
+struct WaitFrames
+{
+  explicit WaitFrames(uint32_t FrameCount) : Frames(FrameCount) {}
+
+  bool await_ready() const noexcept { return (Frames == 0); }
+  bool await_suspend(ScriptTask::Handle Task);
+  void await_resume() const noexcept {}
+
+  uint32_t Frames;
+};
+
+/**
+ * Resume once the tree's frame time has advanced by Seconds, at the first
+ * Update that reaches it (millisecond resolution). <= 0 does not suspend.
+ */
+struct WaitSeconds
+{
+  explicit WaitSeconds(float Duration) : Seconds(Duration) {}
+
+  bool await_ready() const noexcept { return (Seconds <= 0.0f); }
+  bool await_suspend(ScriptTask::Handle Task);
+  void await_resume() const noexcept {}
+
+  float Seconds;
+};
+
+/**
+ * Resume after Emitter next emits SignalName, returning the signal's
+ * arguments. String arguments are not copied, so they must outlive the
+ * frame the signal was emitted in. Does not suspend (and returns no
+ * arguments) if the emitter is not in the task's SceneTree. A task waiting
+ * on an emitter that is destroyed sleeps until it is cancelled.
+ */
+struct WaitForSignal
+{
+  WaitForSignal(Node* Emitter, std::string_view Name) : EmitterNode(Emitter), SignalName(Name) {}
+  WaitForSignal(NodeHandle Emitter, std::string_view Name) : EmitterHandle(Emitter), SignalName(Name) {}
+
+  bool await_ready() const noexcept { return (false); }
+  bool await_suspend(ScriptTask::Handle Task);
+  SignalArgs await_resume() const noexcept { return (Args); }
+
+  Node* EmitterNode = nullptr;
+  NodeHandle EmitterHandle;
+  std::string_view SignalName;
+  SignalArgs Args;
+};
+
+/**
+ * Resume at the first task step (once per Update) where Predicate returns
+ * true. Checked once before suspending. Polled every frame while waiting,
+ * so prefer signals for conditions that have one.
+ */
+struct WaitUntil
+{
+  explicit WaitUntil(std::function<bool()> Condition) : Predicate(std::move(Condition)) {}
+
+  bool await_ready() const { return (!Predicate || Predicate()); }
+  bool await_suspend(ScriptTask::Handle Task);
+  void await_resume() const noexcept {}
+
+  std::function<bool()> Predicate;
+};
@@ -0,0 +1,496 @@
+#pragma once
+
+/**
+ * AxSpatialIndex.h - Dynamic AABB tree over the bounded nodes of a SceneTree
+ *
+ * Each indexed node is a proxy: its bounds in local space and the world box
+ * those bounds cover under its current world matrix. Proxies are the leaves
+ * of a binary bounding volume hierarchy whose leaf boxes are "fat" -- the
+ * world box grown by a margin and stretched along the last displacement --
+ * so a node that moves a little stays inside its leaf and the tree is not
+ * touched. A node that leaves its fat box is removed and reinserted: the
+ * insert descends by surface-area cost, and tree rotations on the way back
+ * up keep the height logarithmic.
+ *
+ * SceneTree owns one index (see SceneTree::SetNodeBounds) and refits the
+ * proxies of nodes whose world matrix changed during its transform flush,
+ * so queries always see the bounds of the last flush.
+ *
+ * Queries take a callback or fill an array:
+ *   - QueryAABB, QuerySphere, QueryFrustum: nodes whose world box overlaps
+ *   - Raycast: every node whose world box a ray segment enters, with the
+ *     entry distance; RaycastClosest only the nearest
+ *   - Batched forms answer many shapes or rays at once into one flat
+ *     result array plus per-query offsets, and closest-hit rays can be
+ *     split across a WorkerPool
+ * Callbacks receive Node* (rays also the distance) and may return false to
+ * stop the query. Results are in tree order, except ray arrays, which are
+ * sorted nearest first. Queries are const and may run concurrently with
+ * each other, but not with Insert, Remove or Update.
+ */
+
+#include "Foundation/AxTypes.h"
+#include "Foundation/AxBounds.h"
+#include "AxEngine/AxMathTypes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+class Node;
+class WorkerPool;
+
+/** Ray segment Origin + T * Direction for T in [0, MaxDistance]. */
+struct SpatialRay
+{
+  AxVec3 Origin;
+  AxVec3 Direction;     // distances are in units of its length
+  float MaxDistance;
+};
+
+struct SpatialRayHit
+{
+  Node* Target;         // nullptr when nothing was hit
+  float Distance;       // where the ray enters Target's world box
+};
+
+class SpatialIndex
+{
+public:
+  using ProxyId = uint32_t;
+  static constexpr ProxyId InvalidProxy = 0xFFFFFFFFu;
+
+  /** Default growth of a fat box on every side, in world units. */
+  static constexpr float DefaultMargin = 0.1f;
+
+  /** Fat boxes also stretch this many times the last displacement. */
+  static constexpr float DisplacementFactor = 4.0f;
+
+  SpatialIndex();
+
+  // Non-copyable
+  SpatialIndex(const SpatialIndex&) = delete;
+  SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+  //=========================================================================
+  // Proxies
+  //=========================================================================
+
+  /** Index Owner with LocalBounds placed by World. */
+  ProxyId Insert(Node* Owner, const AxAABB& LocalBounds, const Mat4& World);
+
+  /** Remove a proxy from the tree. */
+  void Remove(ProxyId Proxy);
+
+  /** Replace a proxy's local bounds and refit it under World. */
+  void SetLocalBounds(ProxyId Proxy, const AxAABB& LocalBounds, const Mat4& World);
+
+  /**
+   * Refit a proxy to a new world matrix.
+   * @return True if the node left its fat box and was reinserted.
+   */
+  bool Update(ProxyId Proxy, const Mat4& World);
+
+  /** Drop every proxy. */
+  void Clear();
+
+  /** World box of a proxy as of its last update. */
+  const AxAABB& GetBounds(ProxyId Proxy) const { return (Proxies_[Proxy].Bounds); }
+  const AxAABB& GetLocalBounds(ProxyId Proxy) const { return (Proxies_[Proxy].Local); }
+  Node* GetOwner(ProxyId Proxy) const { return (Proxies_[Proxy].Owner); }
+
+  /** Number of indexed nodes. */
+  uint32_t GetProxyCount() const { return (ProxyCount_); }
+
+  /** Height of the tree (0 for a single leaf or an empty tree). */
+  uint32_t GetHeight() const;
+
+  /** Reinsertions caused by Update since construction. */
+  uint64_t GetReinsertCount() const { return (ReinsertCount_); }
+
+  /** Fat-box margin for proxies inserted or reinserted from now on. */
+  void SetMargin(float Margin) { Margin_ = (Margin > 0.0f) ? Margin : 0.0f; }
+  float GetMargin() const { return (Margin_); }
+
+  /** Check links, heights and box containment of the whole tree (for tests). */
+  bool Validate() const;
+
+  //=========================================================================
+  // Queries
+  //=========================================================================
+
+  /** Visit(Node*) for every node whose world box overlaps Box. */
+  template<typename FnType>
+  void QueryAABB(const AxAABB& Box, FnType&& Visit) const
+  {
+    Traverse([&Box](const AxAABB& Other) { return (BoxesOverlap(Box, Other)); }, Visit);
+  }
+
+  /** Visit(Node*) for every node whose world box overlaps Sphere. */
+  template<typename FnType>
+  void QuerySphere(const AxSphere& Sphere, FnType&& Visit) const
+  {
+    float RadiusSq = Sphere.Radius * Sphere.Radius;
+    Traverse([&Sphere, RadiusSq](const AxAABB& Other) {
+      return (SphereBoxDistanceSq(Sphere.Center, Other) <= RadiusSq);
+    }, Visit);
+  }
+
+  /**
+   * Visit(Node*) for every node whose world box is at least partly inside
+   * Frustum. Subtrees found inside a plane skip that plane from then on,
+   * and subtrees inside all six are visited without further tests.
+   */
+  template<typename FnType>
+  void QueryFrustum(const AxFrustum& Frustum, FnType&& Visit) const;
+
+  /**
+   * Visit(Node*, float Distance) for every node whose world box Ray enters,
+   * in tree order.
+   */
+  template<typename FnType>
+  void Raycast(const SpatialRay& Ray, FnType&& Visit) const;
+
+  /** The nearest box Ray enters. Returns false (and a null hit) on a miss. */
+  bool RaycastClosest(const SpatialRay& Ray, SpatialRayHit* OutHit) const;
+
+  /** Array forms: OutNodes is replaced; the count is returned. */
+  uint32_t QueryAABB(const AxAABB& Box, std::vector<Node*>& OutNodes) const;
+  uint32_t QuerySphere(const AxSphere& Sphere, std::vector<Node*>& OutNodes) const;
+  uint32_t QueryFrustum(const AxFrustum& Frustum, std::vector<Node*>& OutNodes) const;
+
+  /** Every hit of Ray, nearest first. OutHits is replaced. */
+  uint32_t Raycast(const SpatialRay& Ray, std::vector<SpatialRayHit>& OutHits) const;
+
+  /**
+   * Batched queries. Results of query i are
+   * OutNodes[OutOffsets[i] .. OutOffsets[i + 1]); OutOffsets gets Count + 1
+   * entries. Both vectors are replaced.
+   */
+  void QueryAABBs(const AxAABB* Boxes, uint32_t Count, std::vector<Node*>& OutNodes,
+                  std::vector<uint32_t>& OutOffsets) const;
+  void QuerySpheres(const AxSphere* Spheres, uint32_t Count, std::vector<Node*>& OutNodes,
+                    std::vector<uint32_t>& OutOffsets) const;
+  void QueryFrustums(const AxFrustum* Frustums, uint32_t Count, std::vector<Node*>& OutNodes,
+                     std::vector<uint32_t>& OutOffsets) const;
+
+  /**
+   * Closest hit of each ray into OutHits[i] (Count entries). With a pool,
+   * rays are split across its threads.
+   */
+  void RaycastClosest(const SpatialRay* Rays, uint32_t Count, SpatialRayHit* OutHits,
+                      WorkerPool* Pool = nullptr) const;
+
+private:
+  static constexpr uint32_t NullNode = 0xFFFFFFFFu;
+
+  // Tree node; a leaf has Child1 == NullNode and its proxy in Child2
+  struct TreeNode
+  {
+    AxAABB Box;           // fat box of a leaf, union of the children otherwise
+    uint32_t Parent;      // next free node while on the free list
+    uint32_t Child1;
+    uint32_t Child2;
+    int32_t Height;       // 0 for leaves, -1 while free
+  };
+
+  struct Proxy
+  {
+    AxAABB Bounds;        // world box
+    AxAABB Local;
+    Node* Owner;          // nullptr while free
+    uint32_t Leaf;        // tree node; next free proxy while free
+  };
+
+  // Depth-first traversal stack: inline storage, spilling to the heap only
+  // for trees deeper than a balanced tree ever gets
+  template<typename T>
+  class QueryStack
+  {
+  public:
+    QueryStack() : Data_(Inline_), Capacity_(InlineCapacity), Size_(0) {}
+    QueryStack(const QueryStack&) = delete;
+    QueryStack& operator=(const QueryStack&) = delete;
+
+    void Push(T Value)
+    {
+      if (Size_ == Capacity_) {
+        Grow();
+      }
+      Data_[Size_++] = Value;
+    }
+    T Pop() { return (Data_[--Size_]); }
+    bool IsEmpty() const { return (Size_ == 0); }
+
+  private:
+    static constexpr uint32_t InlineCapacity = 64;
+
+    void Grow()
+    {
+      if (Data_ == Inline_) {
+        Spill_.assign(Inline_, Inline_ + Size_);
+      }
+      Capacity_ *= 2;
+      Spill_.resize(Capacity_);
+      Data_ = Spill_.data();
+    }
+
+    T Inline_[InlineCapacity];
+    std::vector<T> Spill_;
+    T* Data_;
+    uint32_t Capacity_;
+    uint32_t Size_;
+  };
+
+  // Calls Visit(Args...), treating a void return as "keep going"
+  template<typename FnType, typename... ArgTypes>
+  static bool Continue(FnType& Visit, ArgTypes... Args)
+  {
+    if constexpr (std::is_same_v<std::invoke_result_t<FnType&, ArgTypes...>, bool>) {
+      return (Visit(Args...));
+    } else {
+      Visit(Args...);
+      return (true);
+    }
+  }
+
+  static bool BoxesOverlap(const AxAABB& A, const AxAABB& B)
+  {
+    return (A.Min.X <= B.Max.X && A.Max.X >= B.Min.X &&
+            A.Min.Y <= B.Max.Y && A.Max.Y >= B.Min.Y &&
+            A.Min.Z <= B.Max.Z && A.Max.Z >= B.Min.Z);
+  }
+
+  static float SphereBoxDistanceSq(const AxVec3& Center, const AxAABB& Box)
+  {
+    float DistanceSq = 0.0f;
+    for (int i = 0; i < 3; ++i) {
+      float C = Center.XYZ[i];
+      float D = (C < Box.Min.XYZ[i]) ? Box.Min.XYZ[i] - C : (C > Box.Max.XYZ[i]) ? C - Box.Max.XYZ[i] : 0.0f;
+      DistanceSq += D * D;
+    }
+    return (DistanceSq);
+  }
+
+  // Slab test of Origin + T * Dir (InvDir = 1 / Dir) against Box within
+  // [0, MaxT]; OutT receives the entry distance
+  static bool RayEntersBox(const AxVec3& Origin, const AxVec3& InvDir, float MaxT,
+                           const AxAABB& Box, float* OutT)
+  {
+    float Enter = 0.0f;
+    float Exit = MaxT;
+    for (int i = 0; i < 3; ++i) {
+      float T1 = (Box.Min.XYZ[i] - Origin.XYZ[i]) * InvDir.XYZ[i];
+      float T2 = (Box.Max.XYZ[i] - Origin.XYZ[i]) * InvDir.XYZ[i];
+      // NaN (a ray on a slab plane with zero direction) fails neither test
+      Enter = std::max(Enter, std::min(T1, T2));
+      Exit = std::min(Exit, std::max(T1, T2));
+    }
+    *OutT = Enter;
+    return (Enter <= Exit);
+  }
+
+  static AxVec3 InverseDirection(const AxVec3& Direction)
+  {
+    AxVec3 Inv;
+    for (int i = 0; i < 3; ++i) {
+      Inv.XYZ[i] = (Direction.XYZ[i] != 0.0f) ? 1.0f / Direction.XYZ[i] : INFINITY;
+    }
+    return (Inv);
+  }
+
+  // Classify Box against the planes in Mask: false if outside one of them;
+  // planes Box lies fully inside are cleared from Mask
+  static bool FrustumClassify(const AxFrustum& Frustum, const AxAABB& Box, uint32_t& Mask)
+  {
+    float CX = (Box.Min.X + Box.Max.X) * 0.5f;
+    float CY = (Box.Min.Y + Box.Max.Y) * 0.5f;
+    float CZ = (Box.Min.Z + Box.Max.Z) * 0.5f;
+    float EX = (Box.Max.X - Box.Min.X) * 0.5f;
+    float EY = (Box.Max.Y - Box.Min.Y) * 0.5f;
+    float EZ = (Box.Max.Z - Box.Min.Z) * 0.5f;
+
+    for (uint32_t p = 0; p < AX_FRUSTUM_PLANE_COUNT; ++p) {
+      if (!(Mask & (1u << p))) {
+        continue;
+      }
+      const AxPlane& Plane = Frustum.Planes[p];
+      float Distance = Plane.Normal.X * CX + Plane.Normal.Y * CY + Plane.Normal.Z * CZ + Plane.D;
+      float Radius = std::fabs(Plane.Normal.X) * EX + std::fabs(Plane.Normal.Y) * EY +
+                     std::fabs(Plane.Normal.Z) * EZ;
+      if (Distance < -Radius) {
+        return (false);
+      }
+      if (Distance >= Radius) {
+        Mask &= ~(1u << p);
+      }
+    }
+    return (true);
+  }
+
+  // Depth-first walk: subtrees whose box fails Overlaps are skipped, and
+  // leaves are tested again on their exact world box
+  template<typename OverlapFn, typename VisitFn>
+  bool Traverse(OverlapFn&& Overlaps, VisitFn& Visit) const
+  {
+    if (Root_ == NullNode) {
+      return (true);
+    }
+
+    QueryStack<uint32_t> Stack;
+    Stack.Push(Root_);
+    while (!Stack.IsEmpty()) {
+      const TreeNode& Current = Nodes_[Stack.Pop()];
+      if (!Overlaps(Current.Box)) {
+        continue;
+      }
+      if (Current.Child1 == NullNode) {
+        const Proxy& Leaf = Proxies_[Current.Child2];
+        if (Overlaps(Leaf.Bounds) && !Continue(Visit, Leaf.Owner)) {
+          return (false);
+        }
+      } else {
+        Stack.Push(Current.Child1);
+        Stack.Push(Current.Child2);
+      }
+    }
+    return (true);
+  }
+
+  // Visit every leaf under Index without testing
+  template<typename VisitFn>
+  bool VisitSubtree(uint32_t Index, VisitFn& Visit) const
+  {
+    QueryStack<uint32_t> Stack;
+    Stack.Push(Index);
+    while (!Stack.IsEmpty()) {
+      const TreeNode& Current = Nodes_[Stack.Pop()];
+      if (Current.Child1 == NullNode) {
+        if (!Continue(Visit, Proxies_[Current.Child2].Owner)) {
+          return (false);
+        }
+      } else {
+        Stack.Push(Current.Child1);
+        Stack.Push(Current.Child2);
+      }
+    }
+    return (true);
+  }
+
+  // Runs Query(Shapes[i], Out) for each shape and records offsets
+  template<typename ShapeType>
+  void QueryBatch(const ShapeType* Shapes, uint32_t Count, std::vector<Node*>& OutNodes,
+                  std::vector<uint32_t>& OutOffsets) const
+  {
+    OutNodes.clear();
+    OutOffsets.resize(static_cast<size_t>(Count) + 1);
+    auto Append = [&OutNodes](Node* Found) { OutNodes.push_back(Found); };
+    for (uint32_t i = 0; i < Count; ++i) {
+      OutOffsets[i] = static_cast<uint32_t>(OutNodes.size());
+      if constexpr (std::is_same_v<ShapeType, AxAABB>) {
+        QueryAABB(Shapes[i], Append);
+      } else if constexpr (std::is_same_v<ShapeType, AxSphere>) {
+        QuerySphere(Shapes[i], Append);
+      } else {
+        QueryFrustum(Shapes[i], Append);
+      }
+    }
+    OutOffsets[Count] = static_cast<uint32_t>(OutNodes.size());
+  }
+
+  uint32_t AllocateNode();
+  void FreeNode(uint32_t Index);
+  void InsertLeaf(uint32_t Leaf);
+  void RemoveLeaf(uint32_t Leaf);
+
+  /** Balance and refit from Index to the root, stopping once nothing changes. */
+  void RefitAncestors(uint32_t Index);
+
+  /** Rotate Index's taller grandchild up if its children differ in height by more than one. */
+  uint32_t Balance(uint32_t Index);
+
+  /** Box grown by the margin and stretched along Displacement. */
+  AxAABB FattenBox(const AxAABB& Box, const AxVec3& Displacement) const;
+
+  std::vector<TreeNode> Nodes_;
+  std::vector<Proxy> Proxies_;
+  uint32_t Root_;
+  uint32_t FreeNode_;
+  uint32_t FreeProxy_;
+  uint32_t ProxyCount_;
+  float Margin_;
+  uint64_t ReinsertCount_;
+};
+
+//=============================================================================
+// Template Queries
+//=============================================================================
+
+template<typename FnType>
+void SpatialIndex::QueryFrustum(const AxFrustum& Frustum, FnType&& Visit) const
+{
+  if (Root_ == NullNode) {
+    return;
+  }
+
+  constexpr uint32_t AllPlanes = (1u << AX_FRUSTUM_PLANE_COUNT) - 1;
+
+  // Entries carry the planes still to be tested in their high bits
+  QueryStack<uint64_t> Stack;
+  Stack.Push((static_cast<uint64_t>(AllPlanes) << 32) | Root_);
+  while (!Stack.IsEmpty()) {
+    uint64_t Entry = Stack.Pop();
+    uint32_t Index = static_cast<uint32_t>(Entry);
+    uint32_t Mask = static_cast<uint32_t>(Entry >> 32);
+    const TreeNode& Current = Nodes_[Index];
+
+    if (!FrustumClassify(Frustum, Current.Box, Mask)) {
+      continue;
+    }
+    if (Mask == 0) {
+      if (!VisitSubtree(Index, Visit)) {
+        return;
+      }
+      continue;
+    }
+    if (Current.Child1 == NullNode) {
+      const Proxy& Leaf = Proxies_[Current.Child2];
+      if (FrustumClassify(Frustum, Leaf.Bounds, Mask) && !Continue(Visit, Leaf.Owner)) {
+        return;
+      }
+    } else {
+      Stack.Push((static_cast<uint64_t>(Mask) << 32) | Current.Child1);
+      Stack.Push((static_cast<uint64_t>(Mask) << 32) | Current.Child2);
+    }
+  }
+}
+
+template<typename FnType>
+void SpatialIndex::Raycast(const SpatialRay& Ray, FnType&& Visit) const
+{
+  if (Root_ == NullNode) {
+    return;
+  }
+
+  AxVec3 InvDir = InverseDirection(Ray.Direction);
+  QueryStack<uint32_t> Stack;
+  Stack.Push(Root_);
+  while (!Stack.IsEmpty()) {
+    const TreeNode& Current = Nodes_[Stack.Pop()];
+    float T;
+    if (!RayEntersBox(Ray.Origin, InvDir, Ray.MaxDistance, Current.Box, &T)) {
+      continue;
+    }
+    if (Current.Child1 == NullNode) {
+      const Proxy& Leaf = Proxies_[Current.Child2];
+      if (RayEntersBox(Ray.Origin, InvDir, Ray.MaxDistance, Leaf.Bounds, &T) &&
+          !Continue(Visit, Leaf.Owner, T)) {
+        return;
+      }
+    } else {
+      Stack.Push(Current.Child1);
+      Stack.Push(Current.Child2);
+    }
+  }
+}
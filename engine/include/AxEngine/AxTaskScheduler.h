@@ -0,0 +1,164 @@
+#pragma once
+
+/**
+ * AxTaskScheduler.h - Runs the ScriptTasks of one SceneTree
+ *
+ * Each started task gets a record in a slot table. Records of one node are
+ * chained through Node::TaskHead_, so cancelling a node's tasks when its
+ * script detaches or the node is destroyed visits only those tasks, and a
+ * node without tasks costs one compare.
+ *
+ * What a suspended task waits on decides where it is filed:
+ *   - WaitFrames: a TimerWheel ticking in frames (FrameIndex)
+ *   - WaitSeconds: a TimerWheel ticking in milliseconds of frame time
+ *   - WaitForSignal: a connection on the emitter with the task's node as
+ *     receiver; emission moves the task to the ready list
+ *   - WaitUntil: a dense list of predicates polled once per Step
+ * Step (called by SceneTree::Update) advances both wheels, polls the
+ * predicates, and resumes every ready task in the order its wait ended.
+ *
+ * A task cancelled while it is running (it stopped its own node's tasks, or
+ * destroyed its node) is destroyed when it next suspends.
+ *
+ * Not thread-safe; used from the thread that owns the SceneTree.
+ */
+
+#include "Foundation/AxTypes.h"
+#include "AxEngine/AxScriptTask.h"
+#include "AxEngine/AxTimerWheel.h"
+
+#include <functional>
+#include <string_view>
+#include <vector>
+
+class Node;
+class SceneTree;
+
+class TaskScheduler
+{
+public:
+  explicit TaskScheduler(SceneTree& Tree);
+
+  /** Destroys every task still alive. */
+  ~TaskScheduler();
+
+  // Non-copyable
+  TaskScheduler(const TaskScheduler&) = delete;
+  TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+  /**
+   * Take over Task, owned by Owner, and run it to its first suspension.
+   * An invalid task is ignored.
+   */
+  void Start(Node* Owner, ScriptTask Task);
+
+  /** Destroy every task owned by Owner. */
+  void CancelOwner(Node* Owner);
+
+  /** Destroy every task. */
+  void CancelAll();
+
+  /**
+   * Advance the wheels to FrameIndex and Time, then resume every task
+   * whose wait ended, including tasks readied by signals since the last
+   * Step and by waits that end during this one.
+   */
+  void Step(uint64_t FrameIndex, double Time);
+
+  /** Tasks alive, running or suspended. */
+  uint32_t GetTaskCount() const { return (TaskCount_); }
+
+  /** Tasks waiting on a WaitUntil predicate. */
+  uint32_t GetPolledCount() const { return (static_cast<uint32_t>(Polled_.size())); }
+
+  /** Tasks resumed by the last Step. */
+  uint32_t GetLastResumeCount() const { return (LastResumeCount_); }
+
+  // Called by the awaitables in AxScriptTask.h; return false to continue
+  // without suspending
+  bool WaitFrames(uint32_t Slot, uint32_t Frames);
+  bool WaitSeconds(uint32_t Slot, float Seconds);
+  bool WaitForSignal(uint32_t Slot, ::WaitForSignal& Awaiter);
+  bool WaitUntil(uint32_t Slot, const std::function<bool()>& Predicate);
+
+private:
+  static constexpr uint32_t NoTask = 0xFFFFFFFFu;
+
+  enum class WaitKind : uint8_t
+  {
+    None,      // running, or just started
+    Timer,     // frame or time wheel
+    Signal,
+    Until,
+    Ready      // wait ended; resumed by the next Step
+  };
+
+  struct TaskRecord
+  {
+    ScriptTask::Handle Handle;
+    Node* Owner;
+    uint32_t Generation;   // odd while the slot holds a task
+    uint32_t NextOfOwner;
+    uint32_t PrevOfOwner;
+    WaitKind Wait;
+    bool Running;
+    bool Cancelled;
+
+    // Timer: the wheel and timer ID
+    TimerWheel* Wheel;
+    TimerWheel::TimerId Timer;
+
+    // Signal: where the connection lives and where the arguments go; the
+    // name points into the awaiter, which lives in the suspended frame
+    NodeHandle Emitter;
+    std::string_view SignalName;
+    uint32_t Connection;
+    SignalArgs* ArgsOut;
+
+    // Until: the awaiter's predicate and this task's index in Polled_
+    const std::function<bool()>* Predicate;
+    uint32_t PollSlot;
+  };
+
+  static uint64_t TaskKey(uint32_t Slot, uint32_t Generation)
+  {
+    return ((static_cast<uint64_t>(Generation) << 32) | Slot);
+  }
+
+  /** Move a task to the ready list if Key still names it and it waits on Kind. */
+  void MakeReady(uint64_t Key, WaitKind Kind);
+
+  /** Signal hook: keep the arguments and ready the task. */
+  void OnSignal(uint64_t Key, const SignalArgs& Args);
+
+  /** Resume one task; destroys it if it finished or was cancelled meanwhile. */
+  void Resume(uint32_t Slot);
+
+  /** Stop a task, now or (if it is running) when it next suspends. */
+  void Cancel(uint32_t Slot);
+
+  /** Undo whatever the task's current wait registered. */
+  void ClearWait(TaskRecord& Record);
+
+  /** Unlink from the owner's chain, destroy the frame and free the slot. */
+  void Destroy(uint32_t Slot);
+
+  /** Take the task off its owner's chain. */
+  void UnlinkOwner(TaskRecord& Record);
+
+  SceneTree& Tree_;
+  std::vector<TaskRecord> Records_;
+  std::vector<uint32_t> FreeRecords_;
+  uint32_t TaskCount_;
+
+  TimerWheel FrameWheel_;
+  TimerWheel TimeWheel_;
+  std::vector<uint32_t> Polled_;
+  std::vector<uint64_t> PollScratch_;
+
+  // Keys of tasks whose wait ended, in order; swapped with ReadyScratch_
+  // while resuming so waits ending meanwhile queue behind
+  std::vector<uint64_t> Ready_;
+  std::vector<uint64_t> ReadyScratch_;
+  uint32_t LastResumeCount_;
+};
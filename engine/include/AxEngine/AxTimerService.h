@@ -0,0 +1,111 @@
+#pragma once
+
+/**
+ * AxTimerService.h - Callback and signal timers of one SceneTree
+ *
+ * Replaces the accumulate-DeltaT-in-OnUpdate pattern: a timer costs nothing
+ * per frame until it comes due. Timers are filed in a TimerWheel ticking in
+ * milliseconds of frame time (ScriptFrameContext::Time), so they follow the
+ * same clock as WaitSeconds tasks and stop while scripts are disabled.
+ *
+ * A timer either calls a function or emits a signal on a node. A timer
+ * bound to a node is dropped without firing once that node is destroyed;
+ * the node is checked through its handle when the timer comes due, so
+ * destroying a node costs the service nothing. Repeating timers are
+ * re-armed from their previous due time, not from when they fired, and
+ * fire at most once per Step however far the clock jumps.
+ *
+ * Not thread-safe; used from the thread that owns the SceneTree.
+ */
+
+#include "Foundation/AxTypes.h"
+#include "AxEngine/AxNodeHandle.h"
+#include "AxEngine/AxSignal.h"
+#include "AxEngine/AxTimerWheel.h"
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Node;
+class SceneTree;
+
+class TimerService
+{
+public:
+  /** Generation in the high 32 bits, slot in the low; 0 is never issued. */
+  using TimerHandle = uint64_t;
+
+  explicit TimerService(SceneTree& Tree);
+
+  // Non-copyable
+  TimerService(const TimerService&) = delete;
+  TimerService& operator=(const TimerService&) = delete;
+
+  /**
+   * Call Fn once, Seconds from now. With an Owner the timer is dropped if
+   * the node is destroyed first. Returns 0 (and warns) if Owner is not in
+   * this tree.
+   */
+  TimerHandle After(float Seconds, std::function<void()> Fn, Node* Owner = nullptr);
+
+  /** Call Fn every Interval seconds (at least one millisecond) until cancelled. */
+  TimerHandle Every(float Interval, std::function<void()> Fn, Node* Owner = nullptr);
+
+  /**
+   * Emit SignalName on Emitter with Args, Seconds from now, unless the
+   * emitter is destroyed first. String arguments must outlive the timer.
+   */
+  TimerHandle EmitAfter(float Seconds, Node* Emitter, std::string_view SignalName,
+                        const SignalArgs& Args = {});
+
+  /** Remove a pending timer. Returns false if it already fired or was cancelled. */
+  bool Cancel(TimerHandle Handle);
+
+  /** Whether Handle names a timer that is still pending. */
+  bool IsPending(TimerHandle Handle) const;
+
+  /** Drop every timer without firing it. */
+  void Clear();
+
+  /**
+   * Advance to Time (seconds of frame time) and fire every timer due by
+   * then, in due order. Callbacks may start and cancel timers.
+   */
+  void Step(double Time);
+
+  /** Timers pending. */
+  uint32_t GetTimerCount() const { return (TimerCount_); }
+
+  /** Timers fired by the last Step. */
+  uint32_t GetLastFireCount() const { return (LastFireCount_); }
+
+private:
+  struct TimerRecord
+  {
+    std::function<void()> Callback;
+    std::string SignalName;      // non-empty: emit on Target instead of calling
+    SignalArgs Args;
+    NodeHandle Target;           // owner, or the emitter; null for neither
+    uint64_t Due;                // wheel tick
+    uint32_t Interval;           // ticks between repeats; 0 for one-shot
+    uint32_t Generation;         // odd while the slot holds a timer
+    TimerWheel::TimerId Timer;
+  };
+
+  /** Take a free record, fill in the common fields and schedule it. */
+  TimerHandle Add(float Seconds, uint32_t Interval, Node* Target, const char* Caller,
+                  TimerRecord** OutRecord);
+
+  /** Free a record whose wheel timer is already gone. */
+  void Release(uint32_t Slot);
+
+  SceneTree& Tree_;
+  TimerWheel Wheel_;
+  std::vector<TimerRecord> Records_;
+  std::vector<uint32_t> FreeRecords_;
+  std::vector<uint64_t> Fired_;
+  uint32_t TimerCount_;
+  uint32_t LastFireCount_;
+};
@@ -0,0 +1,163 @@
+#pragma once
+
+/**
+ * AxTimerWheel.h - Hierarchical timer wheel over an integer tick
+ *
+ * Timers are kept in LevelCount wheels of SlotsPerLevel slots. Level L
+ * covers ticks that share every bit above the lowest 6 * (L + 1) with the
+ * current tick, so a timer lands in one slot on insertion and moves down at
+ * most LevelCount - 1 times before it fires: Schedule and Cancel are O(1)
+ * and Advance is O(1) amortized per timer. Advance jumps from one occupied
+ * slot to the next using one occupancy mask per level, so ticks with
+ * nothing due cost nothing.
+ *
+ * The tick unit is up to the owner (SceneTree runs one wheel on frames and
+ * one on milliseconds). Each timer carries a 64-bit payload that Advance
+ * hands back when it fires; timers due on the same tick fire in the order
+ * they were scheduled. Timers further out than the wheels cover wait in an
+ * overflow list that is re-filed at each turn of the top level.
+ *
+ * Timer IDs carry a generation, so cancelling a timer that already fired
+ * (or whose entry was reused) is a harmless no-op.
+ *
+ * Not thread-safe; used from the thread that owns it.
+ */
+
+#include "Foundation/AxTypes.h"
+
+#include <bit>
+#include <cmath>
+#include <vector>
+
+class TimerWheel
+{
+public:
+  /** Generation in the high 32 bits, entry index in the low; 0 is never issued. */
+  using TimerId = uint64_t;
+
+  static constexpr uint32_t LevelBits = 6;
+  static constexpr uint32_t SlotsPerLevel = 1u << LevelBits;
+  static constexpr uint32_t LevelCount = 6;
+
+  /**
+   * Millisecond tick for a time in seconds, rounded to nearest; 0 for
+   * times at or before zero. The unit of every wheel SceneTree runs on
+   * frame time, so tasks and timers round a deadline the same way.
+   */
+  static uint64_t SecondsToTick(double Seconds)
+  {
+    return ((Seconds > 0.0) ? static_cast<uint64_t>(std::llround(Seconds * 1000.0)) : 0);
+  }
+
+  /** Start at StartTick; timers due at or before it fire on the next Advance. */
+  explicit TimerWheel(uint64_t StartTick = 0);
+
+  /**
+   * Schedule a timer that fires on the first Advance reaching DueTick.
+   * A DueTick at or before the current tick fires on the next Advance.
+   */
+  TimerId Schedule(uint64_t DueTick, uint64_t Payload);
+
+  /** Remove a pending timer. Returns false if it already fired or was cancelled. */
+  bool Cancel(TimerId ID);
+
+  /** Drop every pending timer without firing it. */
+  void Clear();
+
+  /**
+   * Move the current tick forward to Now, calling Fn(Payload) for every
+   * timer that comes due on the way, in tick order. Fn may schedule and
+   * cancel timers. Does nothing if Now is not past the current tick.
+   */
+  template<typename FnType>
+  void Advance(uint64_t Now, FnType&& Fn)
+  {
+    while (Current_ < Now) {
+      if (PendingCount_ == 0) {
+        Current_ = Now;
+        break;
+      }
+
+      uint64_t Next = NextEventTick();
+      if (Next > Now) {
+        Current_ = Now;
+        break;
+      }
+
+      Current_ = Next;
+      Cascade(Next);
+
+      // Everything in this level-0 slot is due now. Pop from the head each
+      // time: Fn may cancel the timers behind it.
+      uint32_t Slot = static_cast<uint32_t>(Next & (SlotsPerLevel - 1));
+      uint32_t Index;
+      while ((Index = Heads_[0][Slot]) != NoEntry) {
+        Unlink(Index);
+        uint64_t Payload = Entries_[Index].Payload;
+        Release(Index);
+        Fn(Payload);
+      }
+    }
+  }
+
+  uint64_t GetCurrentTick() const { return (Current_); }
+  uint32_t GetPendingCount() const { return (PendingCount_); }
+
+private:
+  static constexpr uint32_t NoEntry = 0xFFFFFFFFu;
+
+  struct Entry
+  {
+    uint64_t Due;
+    uint64_t Payload;
+    uint32_t Next;
+    uint32_t Prev;
+    uint32_t Generation;   // odd while pending
+    uint8_t Level;
+    uint8_t Slot;
+  };
+
+  // Heads_/Tails_ row (slot 0) of timers beyond the top level
+  static constexpr uint32_t OverflowLevel = LevelCount;
+
+  /**
+   * The next tick at which a slot fires or cascades. Every occupied slot
+   * of a level lies after the current tick's slot there, and lower levels
+   * come due before higher ones, so it is the first occupied slot of the
+   * lowest occupied level.
+   */
+  uint64_t NextEventTick() const
+  {
+    for (uint32_t Level = 0; Level < LevelCount; ++Level) {
+      if (Occupied_[Level]) {
+        uint32_t Shift = Level * LevelBits;
+        uint64_t Turn = (Current_ >> (Shift + LevelBits)) << (Shift + LevelBits);
+        return (Turn | (static_cast<uint64_t>(std::countr_zero(Occupied_[Level])) << Shift));
+      }
+    }
+    return (((Current_ >> (LevelBits * LevelCount)) + 1) << (LevelBits * LevelCount));
+  }
+
+  /** Re-file the timers of every slot (and the overflow list) that starts at Tick. */
+  void Cascade(uint64_t Tick);
+
+  /** Re-file every timer in one slot against the current tick. */
+  void Refile(uint32_t Level, uint32_t Slot);
+
+  /** File an unlinked entry into the slot its due tick maps to. */
+  void Place(uint32_t Index);
+
+  /** Take an entry out of its slot list. */
+  void Unlink(uint32_t Index);
+
+  /** Return an unlinked entry to the free list, invalidating its ID. */
+  void Release(uint32_t Index);
+
+  std::vector<Entry> Entries_;
+  std::vector<uint32_t> FreeEntries_;
+  uint32_t Heads_[LevelCount + 1][SlotsPerLevel];
+  uint32_t Tails_[LevelCount + 1][SlotsPerLevel];
+  uint64_t Occupied_[LevelCount + 1];
+  uint64_t Current_;
+  uint32_t PendingCount_;
+};
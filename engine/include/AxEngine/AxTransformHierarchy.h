@@ -0,0 +1,183 @@
+#pragma once
+
+/**
+ * AxTransformHierarchy.h - Flat, parent-ordered world transform storage
+ *
+ * Holds the transform hierarchy of a SceneTree as parallel arrays (SoA):
+ * owning node, parent slot, local matrix, world matrix and a dirty byte.
+ * Slots are kept ordered so every parent precedes its children, which lets
+ * Update() compute world matrices in one forward pass with no recursion or
+ * pointer chasing: a slot is recomputed if it or its parent is dirty.
+ *
+ * Nodes keep their authoring TRS in Transform; SceneTree copies the local
+ * matrix of each changed node into its slot before Update(). Node looks up
+ * its world matrix here through Node::HierarchyIndex_.
+ *
+ * New slots are appended (a parent is always inserted before its children).
+ * Removed slots become holes. Reparenting under a later slot, or letting
+ * holes pile up, schedules a relayout: slots are re-sorted by depth (stable,
+ * so parents still come first), holes dropped and node indices rewritten.
+ *
+ * Given a WorkerPool, Update() instead walks the hierarchy one depth level
+ * at a time and splits each level across threads. A slot only reads its
+ * parent, which lives in an earlier level, so levels need no locking and
+ * every slot is computed exactly as in the serial pass: results are
+ * bit-identical regardless of thread count.
+ *
+ * Dirty bytes hold a count rather than a flag: a slot's count is its own
+ * change (0 or 1) plus its parent's count, i.e. how many changed slots lie
+ * on its ancestor path. That coalesces every change to its highest dirty
+ * ancestor -- each slot is recomputed once -- and tells Update() how many
+ * multiplies a per-change subtree walk would have spent.
+ *
+ * Slots can be marked watched. After each Update(), GetMovedWatched() lists
+ * the watched slots whose world matrix was recomputed, found with one byte
+ * scan from the first dirty slot; SceneTree uses it to refit the bounds of
+ * nodes in its SpatialIndex.
+ */
+
+#include "Foundation/AxTypes.h"
+#include "AxEngine/AxMathTypes.h"
+
+#include <vector>
+
+class Node;
+class WorkerPool;
+
+/** Counters from the most recent TransformHierarchy::Update(). */
+struct TransformUpdateStats
+{
+  /** Slots whose own local matrix or parent changed. */
+  uint32_t ChangedSlots = 0;
+
+  /** Changed slots with no changed ancestor (the coalesced dirty roots). */
+  uint32_t DirtyRoots = 0;
+
+  /** World matrices recomputed (each dirty slot and descendant, once). */
+  uint32_t Recomputed = 0;
+
+  /** Multiplies avoided versus walking every changed slot's subtree
+   *  separately, which recomputes shared descendants once per change. */
+  uint64_t MultipliesSaved = 0;
+};
+
+class TransformHierarchy
+{
+public:
+  /** Slot value meaning "no slot" (used for root parents and unplaced nodes). */
+  static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+  TransformHierarchy();
+
+  /**
+   * Append a slot for Owner. The slot starts dirty with an identity local.
+   * @param Owner Node that owns the slot (required); its HierarchyIndex_ is set.
+   * @param ParentIndex Slot of the parent, or InvalidIndex for a root.
+   * @return The new slot index, or InvalidIndex if Owner is nullptr.
+   */
+  uint32_t Insert(Node* Owner, uint32_t ParentIndex);
+
+  /** Make room for Count more slots so that many Inserts do not reallocate. */
+  void Reserve(uint32_t Count);
+
+  /** Free a slot. Its owner's HierarchyIndex_ is reset to InvalidIndex. */
+  void Remove(uint32_t Index);
+
+  /** Change a slot's parent and mark it dirty. Schedules a relayout if the
+   *  new parent comes after the slot. */
+  void SetParent(uint32_t Index, uint32_t ParentIndex);
+
+  /** Replace a slot's local matrix and mark it dirty. */
+  void SetLocal(uint32_t Index, const Mat4& Local);
+
+  /** World matrix of a slot as of the last Update(). */
+  const Mat4& GetWorld(uint32_t Index) const { return (Worlds_[Index]); }
+
+  /** Parent slot of a slot, or InvalidIndex. */
+  uint32_t GetParent(uint32_t Index) const { return (Parents_[Index]); }
+
+  /** Node that owns a slot, or nullptr for a hole. */
+  Node* GetNode(uint32_t Index) const { return (Nodes_[Index]); }
+
+  /** Mark a slot watched or not; removing a slot unwatches it. */
+  void SetWatched(uint32_t Index, bool Watched);
+
+  /**
+   * Watched slots whose world matrix the last Update() recomputed, in slot
+   * order. Valid until the next Update().
+   */
+  const std::vector<uint32_t>& GetMovedWatched() const { return (MovedWatched_); }
+
+  /**
+   * Recompute world matrices for every dirty slot and its descendants, then
+   * clear all dirty flags. Runs a pending relayout first.
+   * @param Pool Optional worker pool. Large updates are split by depth level
+   *             across its threads; nullptr runs a single forward pass.
+   * @return Number of world matrices recomputed.
+   */
+  uint32_t Update(WorkerPool* Pool = nullptr);
+
+  /** Counters from the most recent Update() (zeroed when nothing was dirty). */
+  const TransformUpdateStats& GetLastStats() const { return (LastStats_); }
+
+  /** Number of depth levels (deepest depth + 1). */
+  uint32_t GetLevelCount() const { return (static_cast<uint32_t>(Levels_.size())); }
+
+  /** Minimum slots from the first dirty slot onward before Update() uses the pool. */
+  static constexpr uint32_t ParallelMinSlots = 8192;
+
+  /** Minimum slots per batch handed to a worker. */
+  static constexpr uint32_t ParallelBatchSlots = 1024;
+
+  /** Number of slots including holes. */
+  uint32_t GetSlotCount() const { return (static_cast<uint32_t>(Nodes_.size())); }
+
+  /** Number of occupied slots. */
+  uint32_t GetLiveCount() const { return (GetSlotCount() - HoleCount_); }
+
+private:
+  /** Re-sort slots by depth, drop holes and rewrite owner indices. */
+  void Relayout();
+
+  /**
+   * Compute the depth of every live slot into OutDepths, tolerating parents
+   * that currently come after their children.
+   * @return Deepest depth found.
+   */
+  uint32_t ComputeDepths(std::vector<uint32_t>& OutDepths) const;
+
+  /** Rebuild Depths_ and Levels_ after a reparent changed subtree depths. */
+  void RebuildLevels();
+
+  /** Recompute slots [Begin, End) of Slots (or of all slots if nullptr). */
+  TransformUpdateStats UpdateSlots(const uint32_t* Slots, uint32_t Begin, uint32_t End);
+
+  /** Level-by-level update across Pool's threads. */
+  TransformUpdateStats UpdateParallel(WorkerPool* Pool);
+
+  void MarkSlotDirty(uint32_t Index);
+
+  // Parallel per-slot arrays; Nodes_[i] == nullptr marks a hole
+  std::vector<Node*> Nodes_;
+  std::vector<uint32_t> Parents_;
+  std::vector<Mat4> Locals_;
+  std::vector<Mat4> Worlds_;
+  std::vector<uint8_t> Dirty_;
+  std::vector<uint32_t> Depths_;
+  std::vector<uint8_t> Watched_;
+
+  // Slot indices per depth (holes included; they are never dirty)
+  std::vector<std::vector<uint32_t>> Levels_;
+
+  // Output of the last Update() for watched slots
+  std::vector<uint32_t> MovedWatched_;
+
+  // Lowest dirty slot; Update() starts scanning here
+  uint32_t FirstDirty_;
+  uint32_t HoleCount_;
+  uint32_t WatchedCount_;
+  bool NeedsRelayout_;
+  bool LevelsDirty_;
+
+  TransformUpdateStats LastStats_;
+};
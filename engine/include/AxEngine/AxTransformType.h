@@ -49,7 +49,10 @@ public:
 
   // Matrix access (cached, lazy-evaluated)
   const Mat4& GetForwardMatrix() const;
-  const Mat4& GetInverseMatrix() const;
+
+  // Inverse matrix (computed on demand, not cached -- rarely needed, and a
+  // second cached Mat4 would add 64 bytes to every Node)
+  Mat4 GetInverseMatrix() const;
 
   // View matrix (computed on demand, not cached -- only cameras need this)
   Mat4 GetViewMatrix() const;
@@ -71,9 +74,7 @@ public:
 private:
   // Cache (lazy-evaluated from TRS)
   mutable Mat4 CachedForwardMatrix_;
-  mutable Mat4 CachedInverseMatrix_;
   mutable bool ForwardMatrixDirty_;
-  mutable bool InverseMatrixDirty_;
   bool IsIdentity_;
 
   // Back-pointer for SceneTree dirty notification (set by Node)
@@ -0,0 +1,142 @@
+#pragma once
+
+/**
+ * AxTweenSystem.h - Property tweens of one SceneTree
+ *
+ * A tween moves a reflected node property (Float, Vec3 or Vec4, found
+ * through its PropDescriptor) from its current value to a target value over
+ * a duration, shaped by an easing curve. The property is written through
+ * Property<T>::operator=, so the node is marked dirty as if a script had set
+ * it.
+ *
+ * Active tweens live in dense structure-of-arrays lanes, one set per
+ * EaseType, so Step runs each curve as straight loops over floats: advance
+ * progress, ease, interpolate four component lanes, then write each result
+ * through its node and byte offset. Finished tweens are swap-removed and
+ * their completion callbacks run after the pass. Tweens whose node was
+ * destroyed are dropped silently when they are next stepped.
+ *
+ * Tweens on the same property do not replace each other; cancel the old
+ * one first. Not thread-safe; used from the thread that owns the SceneTree.
+ */
+
+#include "Foundation/AxTypes.h"
+#include "AxEngine/AxMathTypes.h"
+#include "AxEngine/AxNodeHandle.h"
+#include "AxEngine/AxPropertyReflection.h"
+
+#include <functional>
+#include <string_view>
+#include <vector>
+
+class Node;
+class SceneTree;
+
+/** Easing curves, applied to progress T in [0, 1]. */
+enum class EaseType : uint8_t
+{
+  Linear,
+  InQuad,
+  OutQuad,
+  InOutQuad,
+  InCubic,
+  OutCubic,
+  InOutCubic,
+  SmoothStep,
+  Count
+};
+
+class TweenSystem
+{
+public:
+  /** Generation in the high 32 bits, slot in the low; 0 is never issued. */
+  using TweenHandle = uint64_t;
+
+  explicit TweenSystem(SceneTree& Tree);
+
+  // Non-copyable
+  TweenSystem(const TweenSystem&) = delete;
+  TweenSystem& operator=(const TweenSystem&) = delete;
+
+  /**
+   * Tween the property Prop of Target to To over Duration seconds. Float
+   * properties use To.X and Vec3 properties To.X..Z. OnComplete runs once
+   * the end value has been written. Returns 0 (and warns) if Target is
+   * not in this tree or the property cannot be tweened.
+   */
+  TweenHandle Start(Node* Target, const PropDescriptor* Prop, const Vec4& To, float Duration,
+                    EaseType Ease = EaseType::Linear, std::function<void()> OnComplete = nullptr);
+
+  /** Tween a property looked up by name; its type must match To. */
+  TweenHandle Start(Node* Target, std::string_view PropName, float To, float Duration,
+                    EaseType Ease = EaseType::Linear, std::function<void()> OnComplete = nullptr);
+  TweenHandle Start(Node* Target, std::string_view PropName, const Vec3& To, float Duration,
+                    EaseType Ease = EaseType::Linear, std::function<void()> OnComplete = nullptr);
+  TweenHandle Start(Node* Target, std::string_view PropName, const Vec4& To, float Duration,
+                    EaseType Ease = EaseType::Linear, std::function<void()> OnComplete = nullptr);
+
+  /** Stop a tween where it is, without its completion callback. */
+  bool Cancel(TweenHandle Handle);
+
+  /** Stop every tween on Target. Walks all active tweens. */
+  void CancelTarget(Node* Target);
+
+  /** Whether Handle names a tween that is still running. */
+  bool IsActive(TweenHandle Handle) const;
+
+  /** Drop every tween without completing it. */
+  void Clear();
+
+  /** Advance every tween by DeltaT seconds and write the new values. */
+  void Step(float DeltaT);
+
+  /** Tweens running. */
+  uint32_t GetActiveCount() const { return (ActiveCount_); }
+
+  /** Evaluate an easing curve at T (0 to 1). */
+  static float Evaluate(EaseType Ease, float T);
+
+private:
+  static constexpr uint32_t LaneCount = 4;
+
+  // Hot data of the tweens sharing one curve, one array per field
+  struct TweenLanes
+  {
+    std::vector<float> Elapsed;
+    std::vector<float> InvDuration;
+    std::vector<float> From[LaneCount];
+    std::vector<float> Delta[LaneCount];   // To - From
+    std::vector<NodeHandle> Target;
+    std::vector<uint16_t> Offset;          // PropDescriptor::Offset
+    std::vector<PropType> Type;
+    std::vector<uint32_t> Slot;            // back-index into Slots_
+  };
+
+  // Cold data and position of each tween, addressed by handle
+  struct TweenSlot
+  {
+    uint32_t Generation;   // odd while the slot holds a tween
+    uint8_t Ease;
+    uint32_t Index;        // in Lanes_[Ease]
+    std::function<void()> OnComplete;
+  };
+
+  /** Look up PropName on Target and check it holds Type. */
+  const PropDescriptor* FindTweenable(Node* Target, std::string_view PropName, PropType Type) const;
+
+  /** Swap-remove a tween from its lanes and free its slot. */
+  void Remove(uint32_t Slot);
+
+  SceneTree& Tree_;
+  TweenLanes Lanes_[static_cast<uint32_t>(EaseType::Count)];
+  std::vector<TweenSlot> Slots_;
+  std::vector<uint32_t> FreeSlots_;
+  uint32_t ActiveCount_;
+
+  // Step scratch: eased progress and interpolated values of one lane set,
+  // lane indices that finished, and callbacks to run after the pass
+  std::vector<float> Progress_;
+  std::vector<float> Values_[LaneCount];
+  std::vector<uint32_t> Finished_;
+  std::vector<std::function<void()>> Completed_;
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+/**
+ * AxWorkerPool.h - Persistent worker threads for data-parallel loops
+ *
+ * A small fork/join pool: ParallelFor splits [0, Count) into fixed-size
+ * batches, wakes the workers, runs batches on the calling thread too, and
+ * returns once every batch has finished. Batch boundaries depend only on
+ * Count, MinBatch and the worker count, so any loop whose iterations are
+ * independent produces the same result no matter which thread ran which
+ * batch.
+ *
+ * Threads are created once and sleep between jobs, so a ParallelFor costs a
+ * wake-up rather than thread creation. A pool with zero workers runs every
+ * loop inline.
+ *
+ * Usage:
+ *   WorkerPool Pool(WorkerPool::DefaultWorkerCount());
+ *   Pool.ParallelFor(Count, 1024, [&](uint32_t Begin, uint32_t End) { ... });
+ */
+
+#include "Foundation/AxTypes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool
+{
+public:
+  /** Loop body: processes indices [Begin, End). */
+  using RangeFunction = std::function<void(uint32_t Begin, uint32_t End)>;
+
+  /**
+   * Start WorkerCount background threads. The calling thread also works
+   * during ParallelFor, so total parallelism is WorkerCount + 1.
+   */
+  explicit WorkerPool(uint32_t WorkerCount);
+  ~WorkerPool();
+
+  // Non-copyable
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /** Number of background threads (excluding the caller). */
+  uint32_t GetWorkerCount() const { return (static_cast<uint32_t>(Threads_.size())); }
+
+  /**
+   * Run Body over [0, Count) split into batches of at least MinBatch
+   * indices, blocking until all batches complete. Runs inline when there
+   * are no workers or the range is too small to split. Not reentrant.
+   */
+  void ParallelFor(uint32_t Count, uint32_t MinBatch, const RangeFunction& Body);
+
+  /** Hardware threads minus one (for the caller), or 0 on single-core. */
+  static uint32_t DefaultWorkerCount();
+
+private:
+  void WorkerMain();
+
+  // Claims and runs batches of the current job until none remain
+  void RunBatches();
+
+  std::vector<std::thread> Threads_;
+
+  std::mutex Mutex_;
+  std::condition_variable WakeCV_;
+  std::condition_variable DoneCV_;
+
+  // Current job; written under Mutex_ while no worker is active
+  const RangeFunction* Body_;
+  uint32_t Count_;
+  uint32_t BatchSize_;
+  uint32_t BatchCount_;
+  uint64_t Generation_;
+  uint32_t ActiveWorkers_;
+  bool Stopping_;
+
+  std::atomic<uint32_t> NextBatch_;
+  std::atomic<uint32_t> FinishedBatches_;
+};
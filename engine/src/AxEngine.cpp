@@ -20,6 +20,7 @@
 #include "AxEngine/AxNode.h"
 #include "AxEngine/AxTypedNodes.h"
 #include "AxEngine/AxPrimitives.h"
+#include "AxEngine/AxWorkerPool.h"
 
 #include "AxResource/AxResource.h"
 #include "Foundation/AxAPIRegistry.h"
@@ -307,6 +308,9 @@ bool AxEngine::Initialize(const AxEngineConfig* config, AxAPIRegistry* Registry)
     // Initialize scene parser for all modes (editor will call LoadScene/NewScene/SaveScene)
     SceneParser_.Init(APIRegistry_);
 
+    // Worker threads for scene transform propagation
+    WorkerPool_ = new WorkerPool(WorkerPool::DefaultWorkerCount());
+
     // Scene loading: skip in editor-hosted mode (editor calls LoadScene/NewScene explicitly)
     if (!IsEditorHosted()) {
         if (!InitScene())
@@ -336,35 +340,52 @@ bool AxEngine::Tick()
     float DeltaT = PlatformAPI_->TimeAPI->ElapsedWallTime(LastFrameTime_, CurrentTime);
     LastFrameTime_ = CurrentTime;
 
-    // Poll window events -- only when AxWindow is available (standalone mode)
-    if (WindowAPI_ && Window_) {
-        WindowAPI_->PollEvents(Window_);
-        if (WindowAPI_->HasRequestedClose(Window_)) {
-            isRunning_ = false;
-            return (false);
-        }
+    // Phase timings for this frame; the scene tree counts its own work.
+    // In Shipping the timers are empty and Stats is never read.
+    FrameStats Stats;
+#if AX_FRAME_STATS
+    Stats.FrameIndex = FrameIndex_++;
+    Stats.DeltaT = DeltaT;
+    if (SceneTree_) {
+        SceneTree_->ResetFrameStats();
     }
+#endif
+
+    {
+        FramePhaseTimer Timer(Stats, FramePhase::Input);
+
+        // Poll window events -- only when AxWindow is available (standalone mode)
+        if (WindowAPI_ && Window_) {
+            WindowAPI_->PollEvents(Window_);
+            if (WindowAPI_->HasRequestedClose(Window_)) {
+                isRunning_ = false;
+                return (false);
+            }
+        }
 
-    // Update input
-    AxInput::Get().Update();
+        // Update input
+        AxInput::Get().Update();
 
 #if !defined(AX_SHIPPING)
-    // Check for ESC to exit (dev-only, standalone only)
-    if (!IsEditorHosted() && AxInput::Get().IsKeyPressed(AX_KEY_ESCAPE)) {
-        isRunning_ = false;
-        return (false);
-    }
+        // Check for ESC to exit (dev-only, standalone only)
+        if (!IsEditorHosted() && AxInput::Get().IsKeyPressed(AX_KEY_ESCAPE)) {
+            isRunning_ = false;
+            return (false);
+        }
 #endif
 
-    // Propagate mouse delta to SceneTree for script access
-    if (SceneTree_) {
-        SceneTree_->UpdateMouseDelta(AxInput::Get().GetMouseDelta());
+        // Propagate mouse delta to SceneTree for script access
+        if (SceneTree_) {
+            SceneTree_->UpdateMouseDelta(AxInput::Get().GetMouseDelta());
+        }
     }
 
     // In Edit mode, skip fixed-update and late-update entirely.
     // SceneTree::Update() internally skips script dispatch when
     // scripts are disabled, but still propagates transforms.
     if (Mode_ == AxEngineMode::Play) {
+        FramePhaseTimer Timer(Stats, FramePhase::FixedUpdate);
+
         // Fixed-timestep update (Play mode only)
         FixedAccumulator_ += DeltaT;
         while (FixedAccumulator_ >= FixedTimestep_) {
@@ -373,23 +394,29 @@ bool AxEngine::Tick()
                 SceneTree_->FixedUpdate(FixedTimestep_);
             }
             FixedAccumulator_ -= FixedTimestep_;
+#if AX_FRAME_STATS
+            Stats.FixedSteps++;
+#endif
         }
     }
 
     // Variable-rate update (always runs -- transform propagation needed for rendering)
     if (SceneTree_) {
+        FramePhaseTimer Timer(Stats, FramePhase::Update);
         SceneTree_->Update(DeltaT);
     }
 
     if (Mode_ == AxEngineMode::Play) {
         // Late update (Play mode only)
         if (SceneTree_) {
+            FramePhaseTimer Timer(Stats, FramePhase::LateUpdate);
             SceneTree_->LateUpdate(DeltaT);
         }
     }
 
     // Render
     if (Renderer_) {
+        FramePhaseTimer Timer(Stats, FramePhase::Render);
         Renderer_->BeginFrame();
         Renderer_->RenderScene(SceneTree_);
         Renderer_->FlushDebugDraw();
@@ -398,9 +425,27 @@ bool AxEngine::Tick()
 
     // Process pending resource releases
     if (ResourceAPI_ && ResourceAPI_->IsInitialized()) {
+        FramePhaseTimer Timer(Stats, FramePhase::Releases);
+#if AX_FRAME_STATS
+        uint32_t Pending = ResourceAPI_->GetPendingReleaseCount();
+#endif
         ResourceAPI_->ProcessPendingReleases();
+#if AX_FRAME_STATS
+        uint32_t Remaining = ResourceAPI_->GetPendingReleaseCount();
+        Stats.ResourcesReleased = (Pending > Remaining) ? Pending - Remaining : 0;
+#endif
     }
 
+#if AX_FRAME_STATS
+    if (SceneTree_) {
+        Stats.Accumulate(SceneTree_->GetFrameStats());
+    }
+    Stats.FrameMicros = PlatformAPI_->TimeAPI->ElapsedWallTime(CurrentTime,
+                                                               PlatformAPI_->TimeAPI->WallTime()) * 1.0e6f;
+    FrameStats_ = Stats;
+    FrameHistory_.Push(Stats);
+#endif
+
     return (true);
 }
 
@@ -454,6 +499,9 @@ void AxEngine::Shutdown()
     // the DLL is still loaded.
     UnloadScene();
 
+    delete WorkerPool_;
+    WorkerPool_ = nullptr;
+
     // Clear the script registry
     ScriptRegistry::Get().Clear();
 
@@ -467,6 +515,7 @@ void AxEngine::Shutdown()
 
     // Discard any scene snapshot
     SceneSnapshot_.clear();
+    SnapshotHandles_.clear();
 
     // Shutdown renderer
     if (Renderer_) {
@@ -516,6 +565,7 @@ SceneTree* AxEngine::LoadScene(const char* FilePath)
 
     SceneTree* Scene = SceneParser_.LoadSceneFromFile(FilePath);
     if (Scene) {
+        Scene->SetWorkerPool(WorkerPool_);
         LoadSceneModels(Scene);
     }
     return (Scene);
@@ -652,6 +702,7 @@ void AxEngine::NewScene()
     // Create a fresh scene tree with just a root node
     SceneTree_ = new SceneTree(HashTableAPI, nullptr);
     SceneTree_->Name = "NewScene";
+    SceneTree_->SetWorkerPool(WorkerPool_);
 
     // Propagate current mode and debug draw to the new scene tree
     SceneTree_->SetScriptsEnabled(Mode_ == AxEngineMode::Play);
@@ -692,10 +743,13 @@ void AxEngine::SnapshotScene()
     if (!SceneTree_) {
         AX_LOG(ERROR, "SnapshotScene: No scene loaded");
         SceneSnapshot_.clear();
+        SnapshotHandles_.clear();
         return;
     }
 
     SceneSnapshot_ = SceneParser_.SaveSceneToString(SceneTree_);
+    SnapshotHandles_.clear();
+    SceneTree_->CaptureHandles(SnapshotHandles_);
     if (SceneSnapshot_.empty()) {
         AX_LOG(ERROR, "SnapshotScene: Failed to serialize scene");
     } else {
@@ -715,6 +769,10 @@ void AxEngine::RestoreSnapshot()
         Renderer_->SetMainCamera(nullptr);
     }
 
+    // Generations issued by the restored tree must exceed any handed out
+    // during play, or a stale play-time handle could match a new node
+    uint32_t PlayGeneration = SceneTree_ ? SceneTree_->GetHandleGeneration() : 0;
+
     // Unload the current scene (releases model handles, destroys tree)
     UnloadScene();
 
@@ -724,6 +782,13 @@ void AxEngine::RestoreSnapshot()
         AX_LOG(ERROR, "RestoreSnapshot: Failed to parse snapshot");
         return;
     }
+    SceneTree_->SetWorkerPool(WorkerPool_);
+
+    // Re-parsing creates nodes in serialization order, so the captured
+    // handles line up one-to-one
+    if (!SceneTree_->RestoreHandles(SnapshotHandles_, PlayGeneration)) {
+        AX_LOG(WARNING, "RestoreSnapshot: Node handles could not be restored");
+    }
 
     // Reload models for the restored scene (handles were released during unload)
     LoadSceneModels(SceneTree_);
@@ -790,6 +855,7 @@ void AxEngine::ExitPlayMode()
 
     // Discard the snapshot
     SceneSnapshot_.clear();
+    SnapshotHandles_.clear();
 
     // Switch renderer back to editor camera
     if (Renderer_) {
@@ -11,35 +11,77 @@
  */
 
 #include "AxEngine/AxNode.h"
+#include "AxEngine/AxNodePath.h"
 #include "AxEngine/AxScriptBase.h"
 #include "AxEngine/AxScriptLog.h"
 #include "AxEngine/AxSceneTree.h"
+#include "AxEngine/AxTransformHierarchy.h"
 #include "Foundation/AxAllocator.h"
 #include "Foundation/AxHashTable.h"
 #include "Foundation/AxMath.h"
 
+#include <cstddef>
+
 //=============================================================================
 // Node Construction / Destruction
 //=============================================================================
 
 Node::Node(std::string_view Name, NodeType Type, AxHashTableAPI* TableAPI)
-  : Name_(Name)
-  , Type_(Type)
-  , NodeID_(0)
-  , Parent_(nullptr)
+  : Parent_(nullptr)
   , FirstChild_(nullptr)
+  , LastChild_(nullptr)
   , NextSibling_(nullptr)
-  , HashTableAPI_(TableAPI)
+  , PrevSibling_(nullptr)
+  , OwningTree_(nullptr)
   , Script_(nullptr)
+  , Type_(Type)
+  , ChildCount_(0)
+  , NodeID_(0)
+  , Depth_(0)
+  , HierarchyIndex_(TransformHierarchy::InvalidIndex)
+  , DirtyListSlot_(NotInList)
+  , TypedSlot_(NotInList)
+  , SpatialProxy_(NotInList)
+  , GroupMask_(0)
   , IsInitialized_(false)
   , IsActive_(true)
   , PropertiesDirty_(false)
-  , OwningTree_(nullptr)
-  , InDirtyList_(false)
+  , ActiveInHierarchy_(true)
+  , InScriptList_(false)
+  , ScriptLists_(0)
+  , ScriptTickGroup_(0)
+  , ScriptClass_(0)
+  , ScriptListSlots_{NotInList, NotInList, NotInList, NotInList, NotInList, NotInList}
+  , PendingInitSlot_(NotInList)
+  , PendingInitDepth_(0)
+  , TaskHead_(NotInList)
+  , NameIndexSlot_(0)
+  , PoolSlot_(0)
+  , Pool_(nullptr)
+  , Name_(Name)
+  , HashTableAPI_(TableAPI)
+  , Cold_(nullptr)
 {
+  // Node is not standard-layout (it has a vtable), but GCC, Clang and MSVC
+  // all place members in declaration order, which is all these checks need
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#endif
+  static_assert(offsetof(Node, Script_) + sizeof(Script_) <= 64,
+                "Hierarchy links, owner and script must share the first cache line");
+  static_assert(offsetof(Node, InScriptList_) + sizeof(InScriptList_) <= HotBytes,
+                "Hot node data must fit in HotBytes");
+  static_assert(offsetof(Node, Transform_) >= offsetof(Node, InScriptList_),
+                "The transform must follow the hot data");
+  static_assert(offsetof(Node, Name_) > offsetof(Node, TaskHead_),
+                "The name is cold and must follow the script bookkeeping");
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
   // Transform default constructor handles identity initialization
   Transform_.OwningNode_ = this;
-  WorldMatrix_ = Mat4::Identity();
 }
 
 Node::~Node()
@@ -61,6 +103,8 @@ Node::~Node()
   if (Parent_) {
     Parent_->RemoveChild(this);
   }
+
+  delete Cold_;
 }
 
 //=============================================================================
@@ -80,16 +124,25 @@ void Node::AddChild(Node* Child)
 
   Child->Parent_ = this;
   Child->NextSibling_ = nullptr;
+  Child->PrevSibling_ = LastChild_;
 
   // Append to end of child list to preserve insertion order
-  if (!FirstChild_) {
-    FirstChild_ = Child;
+  if (LastChild_) {
+    LastChild_->NextSibling_ = Child;
   } else {
-    Node* Last = FirstChild_;
-    while (Last->NextSibling_) {
-      Last = Last->NextSibling_;
-    }
-    Last->NextSibling_ = Child;
+    FirstChild_ = Child;
+  }
+  LastChild_ = Child;
+  ChildCount_++;
+
+  Child->PropagateDepth(Depth_ + 1);
+  Child->PropagateActiveInHierarchy(ActiveInHierarchy_);
+
+  if (Child->OwningTree_) {
+    Child->OwningTree_->OnNodeReparented(Child);
+  } else if (OwningTree_ && !Child->Pool_) {
+    // A node from new joined the tree, which deletes it on teardown
+    OwningTree_->OnHeapNodeAttached();
   }
 }
 
@@ -99,21 +152,30 @@ void Node::RemoveChild(Node* Child)
     return;
   }
 
-  // Find and unlink the child from the sibling list
-  if (FirstChild_ == Child) {
+  // Unlink the child from the sibling list
+  if (Child->PrevSibling_) {
+    Child->PrevSibling_->NextSibling_ = Child->NextSibling_;
+  } else {
     FirstChild_ = Child->NextSibling_;
+  }
+
+  if (Child->NextSibling_) {
+    Child->NextSibling_->PrevSibling_ = Child->PrevSibling_;
   } else {
-    Node* Prev = FirstChild_;
-    while (Prev && Prev->NextSibling_ != Child) {
-      Prev = Prev->NextSibling_;
-    }
-    if (Prev) {
-      Prev->NextSibling_ = Child->NextSibling_;
-    }
+    LastChild_ = Child->PrevSibling_;
   }
+  ChildCount_--;
 
   Child->Parent_ = nullptr;
   Child->NextSibling_ = nullptr;
+  Child->PrevSibling_ = nullptr;
+
+  Child->PropagateDepth(0);
+  Child->PropagateActiveInHierarchy(true);
+
+  if (Child->OwningTree_) {
+    Child->OwningTree_->OnNodeReparented(Child);
+  }
 }
 
 void Node::SetParent(Node* NewParent)
@@ -134,6 +196,7 @@ void Node::SetParent(Node* NewParent)
     // Detaching from hierarchy entirely
     Parent_ = nullptr;
     NextSibling_ = nullptr;
+    PrevSibling_ = nullptr;
   }
 }
 
@@ -143,6 +206,10 @@ Node* Node::FindChild(std::string_view ChildName)
     return (nullptr);
   }
 
+  if (OwningTree_) {
+    return (OwningTree_->FindChildByName(this, ChildName));
+  }
+
   Node* Current = FirstChild_;
   while (Current) {
     if (Current->Name_ == ChildName) {
@@ -154,18 +221,6 @@ Node* Node::FindChild(std::string_view ChildName)
   return (nullptr);
 }
 
-uint32_t Node::GetChildCount() const
-{
-  uint32_t Count = 0;
-  Node* Current = FirstChild_;
-  while (Current) {
-    Count++;
-    Current = Current->NextSibling_;
-  }
-
-  return (Count);
-}
-
 //=============================================================================
 // Scene Queries
 //=============================================================================
@@ -223,6 +278,11 @@ Node* Node::GetNode(std::string_view Path)
   return (Current);
 }
 
+Node* Node::GetNode(const NodePath& Path)
+{
+  return (Path.Resolve(this));
+}
+
 //=============================================================================
 // Groups
 //=============================================================================
@@ -249,6 +309,38 @@ bool Node::IsInGroup(std::string_view GroupName) const
   return (false);
 }
 
+void Node::AddToGroup(GroupId Group)
+{
+  if (OwningTree_) {
+    OwningTree_->AddNodeToGroup(this, Group);
+  }
+}
+
+void Node::RemoveFromGroup(GroupId Group)
+{
+  if (OwningTree_) {
+    OwningTree_->RemoveNodeFromGroup(this, Group);
+  }
+}
+
+bool Node::IsInGroup(GroupId Group) const
+{
+  if (Group < 64) {
+    return ((GroupMask_ >> Group) & 1);
+  }
+
+  // Beyond the mask: the entries are sorted and usually few
+  if (!Cold_) {
+    return (false);
+  }
+  for (const GroupEntry& Entry : Cold_->GroupEntries) {
+    if (Entry.Group >= Group) {
+      return (Entry.Group == Group);
+    }
+  }
+  return (false);
+}
+
 //=============================================================================
 // Lifecycle
 //=============================================================================
@@ -329,6 +421,11 @@ ScriptBase* Node::DetachScript()
   // Always fire OnDetach
   Detached->OnDetach();
 
+  // Tasks the script started end with it
+  if (OwningTree_ && TaskHead_ != NotInList) {
+    OwningTree_->StopTasks(this);
+  }
+
   // Clear the owner reference
   Detached->Owner_ = nullptr;
 
@@ -388,6 +485,35 @@ Node& Node::SetScale(const Vec3& S)
   return (*this);
 }
 
+const Mat4& Node::GetWorldTransform() const
+{
+  if (OwningTree_ && HierarchyIndex_ != TransformHierarchy::InvalidIndex) {
+    return (OwningTree_->GetTransformHierarchy().GetWorld(HierarchyIndex_));
+  }
+
+  static const Mat4 IdentityMatrix = Mat4::Identity();
+  return (IdentityMatrix);
+}
+
+//=============================================================================
+// Naming
+//=============================================================================
+
+void Node::SetName(std::string_view Name)
+{
+  if (Name.empty() || Name == Name_) {
+    return;
+  }
+
+  // The tree's name index keys on Name_, so it must see the change
+  if (OwningTree_) {
+    OwningTree_->RenameNode(this, Name);
+    return;
+  }
+
+  Name_ = Name;
+}
+
 //=============================================================================
 // Active State
 //=============================================================================
@@ -399,6 +525,7 @@ void Node::SetActive(bool Active)
   }
 
   IsActive_ = Active;
+  PropagateActiveInHierarchy(Parent_ ? Parent_->ActiveInHierarchy_ : true);
 
   // Fire script callbacks on active state transitions, if script is initialized
   if (Script_ && Script_->IsInitialized_) {
@@ -410,6 +537,39 @@ void Node::SetActive(bool Active)
   }
 }
 
+void Node::PropagateActiveInHierarchy(bool ParentActive)
+{
+  bool Active = ParentActive && IsActive_;
+  if (Active == ActiveInHierarchy_) {
+    return;
+  }
+
+  ActiveInHierarchy_ = Active;
+  if (OwningTree_ && Script_) {
+    OwningTree_->OnScriptNodeActiveChanged(this);
+  }
+
+  for (Node* Child = FirstChild_; Child; Child = Child->NextSibling_) {
+    Child->PropagateActiveInHierarchy(Active);
+  }
+}
+
+void Node::PropagateDepth(uint32_t NewDepth)
+{
+  if (NewDepth == Depth_) {
+    return;
+  }
+
+  Depth_ = NewDepth;
+  if (OwningTree_ && PendingInitSlot_ != NotInList) {
+    OwningTree_->OnPendingInitDepthChanged(this);
+  }
+
+  for (Node* Child = FirstChild_; Child; Child = Child->NextSibling_) {
+    Child->PropagateDepth(NewDepth + 1);
+  }
+}
+
 //=============================================================================
 // Signals
 //=============================================================================
@@ -442,7 +602,11 @@ void Node::EmitSignal(std::string_view Name, float Arg0, float Arg1)
 
 void Node::EmitSignalArgs(std::string_view Name, const SignalArgs& Args)
 {
-  for (auto& Slot : Signals_) {
+  if (!Cold_) {
+    return;
+  }
+
+  for (auto& Slot : Cold_->Signals) {
     if (Slot.Name == Name) {
       // Snapshot IDs — callbacks may disconnect during emission
       std::vector<uint32_t> IDs;
@@ -470,35 +634,50 @@ uint32_t Node::Connect(std::string_view SignalName, SignalCallback Callback, Nod
   }
 
   // Find or create signal slot
+  ColdData& Cold = GetColdData();
   SignalSlot* Slot = nullptr;
-  for (auto& S : Signals_) {
+  for (auto& S : Cold.Signals) {
     if (S.Name == SignalName) { Slot = &S; break; }
   }
   if (!Slot) {
-    Signals_.push_back({std::string(SignalName), {}});
-    Slot = &Signals_.back();
+    Cold.Signals.push_back({std::string(SignalName), {}});
+    Slot = &Cold.Signals.back();
   }
 
-  uint32_t ID = NextConnectionID_++;
+  uint32_t ID = Cold.NextConnectionID++;
   Slot->Connections.push_back({ID, std::move(Callback), Receiver});
 
   // Track outgoing connection on receiver for cleanup
   if (Receiver) {
-    Receiver->OutgoingConnections_.push_back({this, std::string(SignalName), ID});
+    Receiver->GetColdData().OutgoingConnections.push_back({this, std::string(SignalName), ID});
   }
 
   return (ID);
 }
 
+uint32_t Node::Connect(std::string_view SignalName, SignalCallback Callback, NodeHandle Receiver)
+{
+  Node* ReceiverNode = OwningTree_ ? OwningTree_->Resolve(Receiver) : nullptr;
+  if (!ReceiverNode) {
+    return (0);
+  }
+
+  return (Connect(SignalName, std::move(Callback), ReceiverNode));
+}
+
 void Node::Disconnect(std::string_view SignalName, uint32_t ConnectionID)
 {
-  for (auto& Slot : Signals_) {
+  if (!Cold_) {
+    return;
+  }
+
+  for (auto& Slot : Cold_->Signals) {
     if (Slot.Name == SignalName) {
       for (auto It = Slot.Connections.begin(); It != Slot.Connections.end(); ++It) {
         if (It->ID == ConnectionID) {
           // Remove corresponding outgoing connection from receiver
           if (It->Receiver) {
-            auto& Out = It->Receiver->OutgoingConnections_;
+            auto& Out = It->Receiver->Cold_->OutgoingConnections;
             for (auto OIt = Out.begin(); OIt != Out.end(); ++OIt) {
               if (OIt->Emitter == this && OIt->ConnectionID == ConnectionID) {
                 Out.erase(OIt);
@@ -515,14 +694,26 @@ void Node::Disconnect(std::string_view SignalName, uint32_t ConnectionID)
   }
 }
 
+Node::ColdData& Node::GetColdData()
+{
+  if (!Cold_) {
+    Cold_ = new ColdData();
+  }
+  return (*Cold_);
+}
+
 void Node::CleanupSignals()
 {
+  if (!Cold_) {
+    return;
+  }
+
   // 1. Clean up incoming connections: for each subscriber with a Receiver,
   //    remove the corresponding OutgoingConnection from the receiver
-  for (auto& Slot : Signals_) {
+  for (auto& Slot : Cold_->Signals) {
     for (auto& Conn : Slot.Connections) {
       if (Conn.Receiver) {
-        auto& Out = Conn.Receiver->OutgoingConnections_;
+        auto& Out = Conn.Receiver->Cold_->OutgoingConnections;
         for (auto It = Out.begin(); It != Out.end(); ++It) {
           if (It->Emitter == this && It->ConnectionID == Conn.ID) {
             Out.erase(It);
@@ -532,15 +723,15 @@ void Node::CleanupSignals()
       }
     }
   }
-  Signals_.clear();
+  Cold_->Signals.clear();
 
   // 2. Clean up outgoing connections: disconnect this node's subscriptions
   //    from the emitters
-  for (auto& OC : OutgoingConnections_) {
+  for (auto& OC : Cold_->OutgoingConnections) {
     if (OC.Emitter) {
       // Remove the connection directly without calling Disconnect
-      // (which would try to modify our OutgoingConnections_ while we iterate)
-      for (auto& Slot : OC.Emitter->Signals_) {
+      // (which would try to modify our outgoing list while we iterate)
+      for (auto& Slot : OC.Emitter->Cold_->Signals) {
         if (Slot.Name == OC.SignalName) {
           for (auto It = Slot.Connections.begin(); It != Slot.Connections.end(); ++It) {
             if (It->ID == OC.ConnectionID) {
@@ -553,5 +744,5 @@ void Node::CleanupSignals()
       }
     }
   }
-  OutgoingConnections_.clear();
+  Cold_->OutgoingConnections.clear();
 }
@@ -0,0 +1,93 @@
+/**
+ * AxNodePath.cpp - Precompiled relative node path
+ *
+ * Segments are parsed once by SetPath. Resolve walks them with
+ * Node::FindChild (backed by the SceneTree name index) and remembers the
+ * result until the owning tree's structure version changes.
+ */
+
+#include "AxEngine/AxNodePath.h"
+#include "AxEngine/AxSceneTree.h"
+#include "AxEngine/AxScriptLog.h"
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+NodePath::NodePath(std::string_view Path)
+{
+  SetPath(Path);
+}
+
+void NodePath::SetPath(std::string_view Path)
+{
+  // Strip trailing slash, matching Node::GetNode
+  if (!Path.empty() && Path.back() == '/') {
+    Path = Path.substr(0, Path.size() - 1);
+  }
+
+  Path_ = Path;
+  Segments_.clear();
+  CachedFrom_ = nullptr;
+  CachedTarget_ = nullptr;
+  CachedTree_ = nullptr;
+
+  while (!Path.empty()) {
+    size_t SlashPos = Path.find('/');
+    std::string_view Name = (SlashPos != std::string_view::npos)
+      ? Path.substr(0, SlashPos)
+      : Path;
+
+    Segments_.push_back({std::string(Name), Name == ".."});
+
+    if (SlashPos == std::string_view::npos) {
+      break;
+    }
+    Path = Path.substr(SlashPos + 1);
+  }
+}
+
+//=============================================================================
+// Resolution
+//=============================================================================
+
+Node* NodePath::Resolve(Node* From) const
+{
+  if (!From) {
+    return (nullptr);
+  }
+
+  const SceneTree* Tree = From->GetOwningTree();
+  if (Tree && From == CachedFrom_ && Tree == CachedTree_ &&
+      Tree->GetStructureVersion() == CachedVersion_) {
+    return (CachedTarget_);
+  }
+
+  Node* Current = From;
+  for (const Segment& Seg : Segments_) {
+    Current = Seg.IsParent ? Current->GetParent() : Current->FindChild(Seg.Name);
+    if (!Current) {
+      break;
+    }
+  }
+
+  // Only results the tree tracks are cached: a standalone node could be
+  // deleted without the structure version noticing
+  if (Tree && (!Current || Current->GetOwningTree() == Tree)) {
+    CachedFrom_ = From;
+    CachedTarget_ = Current;
+    CachedTree_ = Tree;
+    CachedVersion_ = Tree->GetStructureVersion();
+  }
+
+  if (!Current) {
+    std::string Msg = "NodePath: path not found '";
+    Msg += Path_;
+    Msg += "' from node '";
+    Msg += From->GetName();
+    Msg += "'";
+    Log::Warn(Msg);
+  }
+
+  return (Current);
+}
@@ -0,0 +1,128 @@
+/**
+ * AxNodePool.cpp - Per-type chunked storage for scene nodes
+ *
+ * Slots are addressed as chunk * SlotsPerChunk + slot. A chunk's live mask
+ * tells DestroyAll() and ForEachLive() which slots hold a node, so neither
+ * needs the hierarchy. New chunks push their slots onto the free list
+ * highest first, so nodes fill a chunk front to back.
+ */
+
+#include "AxEngine/AxNodePool.h"
+#include "Foundation/AxAllocator.h"
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+NodePool::~NodePool()
+{
+  DestroyAll();
+}
+
+//=============================================================================
+// Allocation
+//=============================================================================
+
+void* NodePool::AcquireSlot(TypePool& Pool, struct AxAllocator* Backing, uint32_t& OutSlot)
+{
+  if (Pool.FreeSlots.empty()) {
+    size_t ChunkBytes = Pool.SlotSize * SlotsPerChunk;
+
+    Chunk NewChunk{nullptr, Backing, 0};
+    if (Backing) {
+      NewChunk.Memory = static_cast<uint8_t*>(AxAllocAligned(Backing, ChunkBytes, SlotAlignment));
+    }
+
+    // No allocator, or it is full: take the chunk from the heap
+    if (!NewChunk.Memory) {
+      NewChunk.Backing = nullptr;
+      NewChunk.Memory = static_cast<uint8_t*>(
+        ::operator new(ChunkBytes, std::align_val_t(SlotAlignment), std::nothrow));
+      if (!NewChunk.Memory) {
+        return (nullptr);
+      }
+    }
+
+    uint32_t Base = static_cast<uint32_t>(Pool.Chunks.size()) * SlotsPerChunk;
+    Pool.Chunks.push_back(NewChunk);
+    for (uint32_t i = SlotsPerChunk; i-- > 0;) {
+      Pool.FreeSlots.push_back(Base + i);
+    }
+  }
+
+  uint32_t Slot = Pool.FreeSlots.back();
+  Pool.FreeSlots.pop_back();
+
+  Chunk& C = Pool.Chunks[Slot / SlotsPerChunk];
+  C.LiveMask |= (1ull << (Slot % SlotsPerChunk));
+  Pool.LiveCount++;
+
+  OutSlot = Slot;
+  return (C.Memory + Pool.SlotSize * (Slot % SlotsPerChunk));
+}
+
+void NodePool::Destroy(Node* Target)
+{
+  if (!Target || Target->Pool_ != this) {
+    return;
+  }
+
+  TypePool& Pool = Pools_[PoolIndex(Target->Type_)];
+  uint32_t Slot = Target->PoolSlot_;
+
+  Pool.Destruct(Target);
+
+  Pool.Chunks[Slot / SlotsPerChunk].LiveMask &= ~(1ull << (Slot % SlotsPerChunk));
+  Pool.FreeSlots.push_back(Slot);
+  Pool.LiveCount--;
+}
+
+void NodePool::DestroyAll()
+{
+  for (TypePool& Pool : Pools_) {
+    for (Chunk& C : Pool.Chunks) {
+      for (uint64_t Mask = C.LiveMask; Mask; Mask &= Mask - 1) {
+        Pool.Destruct(SlotNode(Pool, C, static_cast<uint32_t>(std::countr_zero(Mask))));
+      }
+      ReleaseChunk(C);
+    }
+
+    Pool.Chunks.clear();
+    Pool.FreeSlots.clear();
+    Pool.LiveCount = 0;
+  }
+}
+
+void NodePool::ReleaseChunk(Chunk& C)
+{
+  // Linear allocators ignore Free; their memory goes when the arena does
+  if (C.Backing) {
+    C.Backing->Free(C.Backing, C.Memory);
+  } else {
+    ::operator delete(C.Memory, std::align_val_t(SlotAlignment));
+  }
+  C.Memory = nullptr;
+  C.LiveMask = 0;
+}
+
+//=============================================================================
+// Statistics
+//=============================================================================
+
+uint32_t NodePool::GetChunkCount() const
+{
+  uint32_t Count = 0;
+  for (const TypePool& Pool : Pools_) {
+    Count += static_cast<uint32_t>(Pool.Chunks.size());
+  }
+  return (Count);
+}
+
+size_t NodePool::GetReservedBytes() const
+{
+  size_t Bytes = 0;
+  for (const TypePool& Pool : Pools_) {
+    Bytes += Pool.Chunks.size() * Pool.SlotSize * SlotsPerChunk;
+  }
+  return (Bytes);
+}
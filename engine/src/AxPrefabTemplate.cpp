@@ -0,0 +1,310 @@
+/**
+ * AxPrefabTemplate.cpp - Flat node records for bulk instantiation
+ *
+ * Building a template validates every property against the
+ * PropertyRegistry once, so SceneTree::InstantiateBatch can copy the
+ * stored bytes without looking anything up per instance.
+ */
+
+#include "AxEngine/AxPrefabTemplate.h"
+#include "AxEngine/AxProperty.h"
+#include "AxEngine/AxScriptLog.h"
+
+#include <cstring>
+
+//=============================================================================
+// Value Layout
+//=============================================================================
+
+/** Copy a value of type T out of the blob (values are not aligned there). */
+template<typename T>
+static T ReadBlob(const uint8_t* Source)
+{
+  T Value;
+  std::memcpy(&Value, Source, sizeof(T));
+  return (Value);
+}
+
+uint32_t PrefabTemplate::ValueSize(PropType Type)
+{
+  switch (Type) {
+    case PropType::Bool:   return (sizeof(bool));
+    case PropType::Vec3:   return (sizeof(Vec3));
+    case PropType::Vec4:   return (sizeof(Vec4));
+    case PropType::Quat:   return (sizeof(Quat));
+    case PropType::Float:
+    case PropType::Int32:
+    case PropType::UInt32:
+    case PropType::String:
+    case PropType::Enum:
+    default:               return (4);
+  }
+}
+
+void PrefabTemplate::ApplyValue(Node* Target, const PropDescriptor* Prop,
+                                const PropertyValue& Value) const
+{
+  const uint8_t* Source = Blob_.data() + Value.BlobOffset;
+  switch (Prop->Type) {
+    case PropType::Float:
+      GetPropertyPtr_Float(Target, Prop)->SetRaw(ReadBlob<float>(Source));
+      break;
+    case PropType::Int32:
+    case PropType::Enum:
+      GetPropertyPtr_Int32(Target, Prop)->SetRaw(ReadBlob<int32_t>(Source));
+      break;
+    case PropType::UInt32:
+      GetPropertyPtr_UInt32(Target, Prop)->SetRaw(ReadBlob<uint32_t>(Source));
+      break;
+    case PropType::Bool:
+      GetPropertyPtr_Bool(Target, Prop)->SetRaw(ReadBlob<bool>(Source));
+      break;
+    case PropType::String:
+      GetPropertyPtr_String(Target, Prop)->SetRaw(Strings_[ReadBlob<uint32_t>(Source)]);
+      break;
+    case PropType::Vec3:
+      GetPropertyPtr_Vec3(Target, Prop)->SetRaw(ReadBlob<Vec3>(Source));
+      break;
+    case PropType::Vec4:
+      GetPropertyPtr_Vec4(Target, Prop)->SetRaw(ReadBlob<Vec4>(Source));
+      break;
+    default:
+      break;
+  }
+}
+
+//=============================================================================
+// Building
+//=============================================================================
+
+uint32_t PrefabTemplate::AddNode(std::string_view NodeName, NodeType Type, uint32_t Parent,
+                                 const PrefabTransform& Local)
+{
+  const char* Problem = nullptr;
+  if (NodeName.empty()) {
+    Problem = "empty node name";
+  } else if (Type == NodeType::Root) {
+    Problem = "a scene root cannot be part of a template";
+  } else if (Records_.empty() ? (Parent != NoParent) : (Parent >= Records_.size())) {
+    Problem = "record 0 is the only root, and a parent must be an earlier record";
+  }
+  if (Problem) {
+    std::string Msg = "PrefabTemplate::AddNode: ";
+    Msg += Problem;
+    Log::Warn(Msg);
+    return (NoParent);
+  }
+
+  NodeRecord Record;
+  Record.Type = Type;
+  Record.NameId = InternString(NodeName);
+  Record.Parent = Parent;
+  Record.ScriptId = NoScript;
+  Record.Local = Local;
+  Record.FirstValue = static_cast<uint32_t>(Values_.size());
+  Record.ValueCount = 0;
+  Record.Model = AxModelHandle{0, 0};
+  Records_.push_back(Record);
+  return (static_cast<uint32_t>(Records_.size() - 1));
+}
+
+bool PrefabTemplate::SetProperty(uint32_t Record, std::string_view PropName, float Value)
+{
+  return (WriteValue(Record, PropName, PropType::Float, &Value, {}));
+}
+
+bool PrefabTemplate::SetProperty(uint32_t Record, std::string_view PropName, int32_t Value)
+{
+  return (WriteValue(Record, PropName, PropType::Int32, &Value, {}));
+}
+
+bool PrefabTemplate::SetProperty(uint32_t Record, std::string_view PropName, uint32_t Value)
+{
+  return (WriteValue(Record, PropName, PropType::UInt32, &Value, {}));
+}
+
+bool PrefabTemplate::SetProperty(uint32_t Record, std::string_view PropName, bool Value)
+{
+  return (WriteValue(Record, PropName, PropType::Bool, &Value, {}));
+}
+
+bool PrefabTemplate::SetProperty(uint32_t Record, std::string_view PropName, std::string_view Value)
+{
+  return (WriteValue(Record, PropName, PropType::String, nullptr, Value));
+}
+
+bool PrefabTemplate::SetProperty(uint32_t Record, std::string_view PropName, const char* Value)
+{
+  return (SetProperty(Record, PropName, std::string_view(Value ? Value : "")));
+}
+
+bool PrefabTemplate::SetProperty(uint32_t Record, std::string_view PropName, const Vec3& Value)
+{
+  return (WriteValue(Record, PropName, PropType::Vec3, &Value, {}));
+}
+
+bool PrefabTemplate::SetProperty(uint32_t Record, std::string_view PropName, const Vec4& Value)
+{
+  return (WriteValue(Record, PropName, PropType::Vec4, &Value, {}));
+}
+
+void PrefabTemplate::SetTransform(uint32_t Record, const PrefabTransform& Local)
+{
+  if (Record < Records_.size()) {
+    Records_[Record].Local = Local;
+  }
+}
+
+void PrefabTemplate::SetScript(uint32_t Record, std::string_view ScriptName)
+{
+  if (Record >= Records_.size()) {
+    return;
+  }
+  Records_[Record].ScriptId = ScriptName.empty() ? NoScript : InternString(ScriptName);
+}
+
+void PrefabTemplate::SetModel(uint32_t Record, AxModelHandle Model)
+{
+  if (Record >= Records_.size() || Records_[Record].Type != NodeType::MeshInstance) {
+    return;
+  }
+  Records_[Record].Model = Model;
+}
+
+void PrefabTemplate::Clear()
+{
+  Records_.clear();
+  Values_.clear();
+  Blob_.clear();
+  Strings_.clear();
+  StringIds_.clear();
+}
+
+uint32_t PrefabTemplate::InternString(std::string_view Text)
+{
+  auto It = StringIds_.find(std::string(Text));
+  if (It != StringIds_.end()) {
+    return (It->second);
+  }
+
+  uint32_t Id = static_cast<uint32_t>(Strings_.size());
+  Strings_.emplace_back(Text);
+  StringIds_.emplace(Strings_.back(), Id);
+  return (Id);
+}
+
+bool PrefabTemplate::WriteValue(uint32_t Record, std::string_view PropName, PropType Type,
+                                const void* Bytes, std::string_view Text)
+{
+  if (Record >= Records_.size()) {
+    return (false);
+  }
+  NodeRecord& Target = Records_[Record];
+
+  uint32_t PropCount = 0;
+  const PropDescriptor* Props = PropertyRegistry::Get().GetProperties(Target.Type, &PropCount);
+  const PropDescriptor* Prop = PropertyRegistry::Get().FindProperty(Target.Type, PropName);
+
+  // Enums are set by entry name or by value
+  int32_t EnumValue = 0;
+  bool Matches = Prop && Prop->Type == Type;
+  if (Prop && Prop->Type == PropType::Enum && Type == PropType::String) {
+    Matches = StringToEnum(Prop->EnumEntries, Prop->EnumCount, Text, &EnumValue);
+    Bytes = &EnumValue;
+  } else if (Prop && Prop->Type == PropType::Enum && Type == PropType::Int32) {
+    Matches = true;
+  }
+
+  if (!Matches) {
+    std::string Msg = "PrefabTemplate::SetProperty: node '";
+    Msg += Strings_[Target.NameId];
+    Msg += "' has no property '";
+    Msg += PropName;
+    Msg += "' of the given type";
+    Log::Warn(Msg);
+    return (false);
+  }
+
+  uint32_t StringId = 0;
+  if (Prop->Type == PropType::String) {
+    StringId = InternString(Text);
+    Bytes = &StringId;
+  }
+
+  auto Descriptor = static_cast<uint16_t>(Prop - Props);
+  auto Size = static_cast<uint16_t>(ValueSize(Prop->Type));
+
+  // Setting a property again replaces its bytes in place
+  for (uint32_t i = 0; i < Target.ValueCount; ++i) {
+    const PropertyValue& Existing = Values_[Target.FirstValue + i];
+    if (Existing.Descriptor == Descriptor) {
+      std::memcpy(Blob_.data() + Existing.BlobOffset, Bytes, Size);
+      return (true);
+    }
+  }
+
+  // Values are kept grouped by record. Templates are normally built one
+  // record at a time, so this inserts at the end; setting an earlier
+  // record shifts the runs of the records after it.
+  PropertyValue Value{Descriptor, Size, static_cast<uint32_t>(Blob_.size())};
+  Blob_.resize(Blob_.size() + Size);
+  std::memcpy(Blob_.data() + Value.BlobOffset, Bytes, Size);
+
+  uint32_t InsertAt = Target.FirstValue + Target.ValueCount;
+  Values_.insert(Values_.begin() + InsertAt, Value);
+  Target.ValueCount++;
+  for (uint32_t i = Record + 1; i < Records_.size(); ++i) {
+    Records_[i].FirstValue++;
+  }
+  return (true);
+}
+
+//=============================================================================
+// Capture
+//=============================================================================
+
+static void CaptureSubtree(PrefabTemplate& Out, const Node* Source, uint32_t Parent)
+{
+  const Transform& Local = Source->GetTransform();
+  PrefabTransform Record;
+  Record.Translation = Local.Translation;
+  Record.Rotation = Local.Rotation;
+  Record.Scale = Local.Scale;
+
+  uint32_t Index = Out.AddNode(Source->GetName(), Source->GetType(), Parent, Record);
+  if (Index == PrefabTemplate::NoParent) {
+    return;
+  }
+
+  uint32_t PropCount = 0;
+  const PropDescriptor* Props = PropertyRegistry::Get().GetProperties(Source->GetType(), &PropCount);
+  for (uint32_t i = 0; i < PropCount; ++i) {
+    const PropDescriptor* Prop = &Props[i];
+    switch (Prop->Type) {
+      case PropType::Float:  Out.SetProperty(Index, Prop->Name, GetPropertyFloat(Source, Prop)); break;
+      case PropType::Int32:
+      case PropType::Enum:   Out.SetProperty(Index, Prop->Name, GetPropertyInt32(Source, Prop)); break;
+      case PropType::UInt32: Out.SetProperty(Index, Prop->Name, GetPropertyUInt32(Source, Prop)); break;
+      case PropType::Bool:   Out.SetProperty(Index, Prop->Name, GetPropertyBool(Source, Prop)); break;
+      case PropType::String:
+        Out.SetProperty(Index, Prop->Name, std::string_view(GetPropertyString(Source, Prop)));
+        break;
+      case PropType::Vec3:   Out.SetProperty(Index, Prop->Name, GetPropertyVec3(Source, Prop)); break;
+      case PropType::Vec4:   Out.SetProperty(Index, Prop->Name, GetPropertyVec4(Source, Prop)); break;
+      default: break;
+    }
+  }
+
+  for (const Node* Child = Source->GetFirstChild(); Child; Child = Child->GetNextSibling()) {
+    CaptureSubtree(Out, Child, Index);
+  }
+}
+
+PrefabTemplate PrefabTemplate::Capture(const Node* Root)
+{
+  PrefabTemplate Result;
+  if (Root) {
+    CaptureSubtree(Result, Root, NoParent);
+  }
+  return (Result);
+}
@@ -72,6 +72,31 @@ AxModelHandle PrimitiveMesh::CreateModel()
     return (ModelHandle);
 }
 
+AxModelHandle PrimitiveMesh::AcquireModel(AxModelHandle Model)
+{
+    if (!Registry_ || !AX_HANDLE_IS_VALID(Model)) {
+        return (Model);
+    }
+
+    AxResourceAPI* ResAPI = static_cast<AxResourceAPI*>(Registry_->Get(AXON_RESOURCE_API_NAME));
+    if (!ResAPI || !ResAPI->IsInitialized()) {
+        return (Model);
+    }
+    return (ResAPI->AcquireModel(Model));
+}
+
+void PrimitiveMesh::ReleaseModel(AxModelHandle Model)
+{
+    if (!Registry_ || !AX_HANDLE_IS_VALID(Model)) {
+        return;
+    }
+
+    AxResourceAPI* ResAPI = static_cast<AxResourceAPI*>(Registry_->Get(AXON_RESOURCE_API_NAME));
+    if (ResAPI && ResAPI->IsInitialized()) {
+        ResAPI->ReleaseModel(Model);
+    }
+}
+
 //=============================================================================
 // BoxMesh
 //=============================================================================
@@ -215,9 +215,9 @@ void AxRenderer::RenderScene(SceneTree* Scene)
 
     if (LightNodes && LightNodeCount > 0) {
         // Build a temporary AxLight array for the OpenGL API
-        AxLight TempLights[AX_SCENE_TREE_MAX_TYPED_NODES];
-        uint32_t Count = (LightNodeCount < AX_SCENE_TREE_MAX_TYPED_NODES)
-                       ? LightNodeCount : AX_SCENE_TREE_MAX_TYPED_NODES;
+        AxLight TempLights[AX_SCENE_TREE_MAX_LIGHTS];
+        uint32_t Count = (LightNodeCount < AX_SCENE_TREE_MAX_LIGHTS)
+                       ? LightNodeCount : AX_SCENE_TREE_MAX_LIGHTS;
 
         for (uint32_t i = 0; i < Count; ++i) {
             LightNode* LN = static_cast<LightNode*>(LightNodes[i]);
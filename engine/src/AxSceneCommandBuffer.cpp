@@ -0,0 +1,152 @@
+/**
+ * AxSceneCommandBuffer.cpp - Deferred structural changes to a SceneTree
+ *
+ * Recording only appends to the list of the command's kind under one
+ * lock; everything that touches the tree happens in
+ * SceneTree::ApplyCommands.
+ */
+
+#include "AxEngine/AxSceneCommandBuffer.h"
+
+#include <utility>
+
+//=============================================================================
+// Command Lists
+//=============================================================================
+
+void SceneCommandBuffer::CommandLists::Clear()
+{
+  Creates.clear();
+  Reparents.clear();
+  Properties.clear();
+  Destroys.clear();
+}
+
+//=============================================================================
+// Recording
+//=============================================================================
+
+SceneCommandBuffer::NodeRef SceneCommandBuffer::Create(std::string_view NodeName, NodeType Type,
+                                                       NodeRef Parent,
+                                                       std::function<void(Node*)> OnCreated)
+{
+  CreateCommand Command{std::string(NodeName), Type, Parent, std::move(OnCreated)};
+
+  NodeRef Result;
+  std::lock_guard<std::mutex> Lock(Mutex_);
+  Result.Pending = static_cast<uint32_t>(Lists_.Creates.size());
+  Result.Epoch = Lists_.Epoch;
+  Lists_.Creates.push_back(std::move(Command));
+  return (Result);
+}
+
+void SceneCommandBuffer::Destroy(NodeRef Target)
+{
+  if (Target.IsNull()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> Lock(Mutex_);
+  Lists_.Destroys.push_back({Target});
+}
+
+void SceneCommandBuffer::Reparent(NodeRef Child, NodeRef NewParent)
+{
+  if (Child.IsNull()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> Lock(Mutex_);
+  Lists_.Reparents.push_back({Child, NewParent});
+}
+
+void SceneCommandBuffer::SetProperty(NodeRef Target, std::string_view PropName, float Value)
+{
+  PropertyCommand Command(Target, PropName, PropType::Float);
+  Command.Float = Value;
+  PushProperty(std::move(Command));
+}
+
+void SceneCommandBuffer::SetProperty(NodeRef Target, std::string_view PropName, int32_t Value)
+{
+  PropertyCommand Command(Target, PropName, PropType::Int32);
+  Command.Int = Value;
+  PushProperty(std::move(Command));
+}
+
+void SceneCommandBuffer::SetProperty(NodeRef Target, std::string_view PropName, uint32_t Value)
+{
+  PropertyCommand Command(Target, PropName, PropType::UInt32);
+  Command.UInt = Value;
+  PushProperty(std::move(Command));
+}
+
+void SceneCommandBuffer::SetProperty(NodeRef Target, std::string_view PropName, bool Value)
+{
+  PropertyCommand Command(Target, PropName, PropType::Bool);
+  Command.Bool = Value;
+  PushProperty(std::move(Command));
+}
+
+void SceneCommandBuffer::SetProperty(NodeRef Target, std::string_view PropName,
+                                     std::string_view Value)
+{
+  PropertyCommand Command(Target, PropName, PropType::String);
+  Command.Text = std::string(Value);
+  PushProperty(std::move(Command));
+}
+
+void SceneCommandBuffer::SetProperty(NodeRef Target, std::string_view PropName, const char* Value)
+{
+  SetProperty(Target, PropName, std::string_view(Value ? Value : ""));
+}
+
+void SceneCommandBuffer::SetProperty(NodeRef Target, std::string_view PropName, const Vec3& Value)
+{
+  PropertyCommand Command(Target, PropName, PropType::Vec3);
+  Command.Vector = Vec4(Value, 0.0f);
+  PushProperty(std::move(Command));
+}
+
+void SceneCommandBuffer::SetProperty(NodeRef Target, std::string_view PropName, const Vec4& Value)
+{
+  PropertyCommand Command(Target, PropName, PropType::Vec4);
+  Command.Vector = Value;
+  PushProperty(std::move(Command));
+}
+
+void SceneCommandBuffer::PushProperty(PropertyCommand&& Command)
+{
+  if (Command.Target.IsNull()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> Lock(Mutex_);
+  Lists_.Properties.push_back(std::move(Command));
+}
+
+uint32_t SceneCommandBuffer::GetCommandCount() const
+{
+  std::lock_guard<std::mutex> Lock(Mutex_);
+  return (Lists_.GetCount());
+}
+
+void SceneCommandBuffer::Clear()
+{
+  std::lock_guard<std::mutex> Lock(Mutex_);
+  Lists_.Clear();
+  Lists_.Epoch++;
+}
+
+//=============================================================================
+// Applying
+//=============================================================================
+
+void SceneCommandBuffer::Take(CommandLists& Out)
+{
+  Out.Clear();
+
+  std::lock_guard<std::mutex> Lock(Mutex_);
+  std::swap(Out, Lists_);
+  Lists_.Epoch = Out.Epoch + 1;
+}
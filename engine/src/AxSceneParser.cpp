@@ -10,6 +10,7 @@
 #include "AxEngine/AxTypedNodes.h"
 #include "AxEngine/AxPrimitives.h"
 #include "AxEngine/AxPropertyReflection.h"
+#include "AxEngine/AxPrefabTemplate.h"
 
 #include <cstring>
 #include <cstdio>
@@ -451,37 +452,36 @@ static NodeType MapTypeNameToNodeType(const char* TypeName)
 ///////////////////////////////////////////////////////////////
 
 /**
- * Parse a property value from the tokenizer and set it on the node.
+ * A property value read from the token stream, before it is applied to a
+ * node or stored in a prefab template. Has is false when the value token
+ * did not match the property type (the property is then left as is).
+ */
+struct ParsedPropertyValue {
+    bool Has = false;
+    float Number = 0.0f;
+    bool Flag = false;
+    std::string Text;
+    Vec3 Vector;
+};
+
+/**
+ * Parse a property value from the tokenizer.
  * Each PropType owns its own token consumption, so multi-token types
  * (Vec3, Vec4, Quat) are handled uniformly alongside single-token types.
- * Returns false on parse error, true on success (including unknown properties).
+ * Returns false on parse error, true on success (including values of the
+ * wrong token type, which leave Value->Has false).
  */
-static bool ParseAndSetProperty(Node* NodePtr, const PropDescriptor* Desc,
-                                Tokenizer* T, SceneParser* Parser)
+static bool ParsePropertyValue(const PropDescriptor* Desc, Tokenizer* T, SceneParser* Parser,
+                               ParsedPropertyValue* Value)
 {
     switch (Desc->Type) {
-        case PropType::Float: {
-            if (T->CurrentToken.Type != AX_TOKEN_NUMBER) { return (true); }
-            float V;
-            ParseFloatToken(&T->CurrentToken, &V);
-            T->CurrentToken = NextToken(T);
-            SetPropertyFloat(NodePtr, Desc, V);
-            return (true);
-        }
-        case PropType::Int32: {
-            if (T->CurrentToken.Type != AX_TOKEN_NUMBER) { return (true); }
-            float V;
-            ParseFloatToken(&T->CurrentToken, &V);
-            T->CurrentToken = NextToken(T);
-            SetPropertyInt32(NodePtr, Desc, static_cast<int32_t>(V));
-            return (true);
-        }
+        case PropType::Float:
+        case PropType::Int32:
         case PropType::UInt32: {
             if (T->CurrentToken.Type != AX_TOKEN_NUMBER) { return (true); }
-            float V;
-            ParseFloatToken(&T->CurrentToken, &V);
+            ParseFloatToken(&T->CurrentToken, &Value->Number);
             T->CurrentToken = NextToken(T);
-            SetPropertyUInt32(NodePtr, Desc, static_cast<uint32_t>(V));
+            Value->Has = true;
             return (true);
         }
         case PropType::Bool: {
@@ -489,7 +489,8 @@ static bool ParseAndSetProperty(Node* NodePtr, const PropDescriptor* Desc,
             char Buf[16];
             CopyTokenString(&T->CurrentToken, Buf, sizeof(Buf));
             T->CurrentToken = NextToken(T);
-            SetPropertyBool(NodePtr, Desc, strcmp(Buf, "true") == 0);
+            Value->Flag = (strcmp(Buf, "true") == 0);
+            Value->Has = true;
             return (true);
         }
         case PropType::String: {
@@ -497,7 +498,8 @@ static bool ParseAndSetProperty(Node* NodePtr, const PropDescriptor* Desc,
             char Buf[256];
             CopyTokenString(&T->CurrentToken, Buf, sizeof(Buf));
             T->CurrentToken = NextToken(T);
-            SetPropertyString(NodePtr, Desc, std::string(Buf));
+            Value->Text = Buf;
+            Value->Has = true;
             return (true);
         }
         case PropType::Enum: {
@@ -505,13 +507,15 @@ static bool ParseAndSetProperty(Node* NodePtr, const PropDescriptor* Desc,
             char Buf[64];
             CopyTokenString(&T->CurrentToken, Buf, sizeof(Buf));
             T->CurrentToken = NextToken(T);
-            SetPropertyEnum(NodePtr, Desc, Buf);
+            Value->Text = Buf;
+            Value->Has = true;
             return (true);
         }
         case PropType::Vec3: {
             AxVec3 V;
             if (!ParseVector3(T, &V, Parser)) { return (false); }
-            SetPropertyVec3(NodePtr, Desc, Vec3(V));
+            Value->Vector = Vec3(V);
+            Value->Has = true;
             return (true);
         }
         case PropType::Vec4:
@@ -521,6 +525,68 @@ static bool ParseAndSetProperty(Node* NodePtr, const PropDescriptor* Desc,
     return (true);
 }
 
+/** Parse a property value and set it on the node. */
+static bool ParseAndSetProperty(Node* NodePtr, const PropDescriptor* Desc,
+                                Tokenizer* T, SceneParser* Parser)
+{
+    ParsedPropertyValue Value;
+    if (!ParsePropertyValue(Desc, T, Parser, &Value)) {
+        return (false);
+    }
+    if (!Value.Has) {
+        return (true);
+    }
+
+    switch (Desc->Type) {
+        case PropType::Float:  SetPropertyFloat(NodePtr, Desc, Value.Number); break;
+        case PropType::Int32:  SetPropertyInt32(NodePtr, Desc, static_cast<int32_t>(Value.Number)); break;
+        case PropType::UInt32: SetPropertyUInt32(NodePtr, Desc, static_cast<uint32_t>(Value.Number)); break;
+        case PropType::Bool:   SetPropertyBool(NodePtr, Desc, Value.Flag); break;
+        case PropType::String: SetPropertyString(NodePtr, Desc, Value.Text); break;
+        case PropType::Enum:   SetPropertyEnum(NodePtr, Desc, Value.Text.c_str()); break;
+        case PropType::Vec3:   SetPropertyVec3(NodePtr, Desc, Value.Vector); break;
+        default: break;
+    }
+    return (true);
+}
+
+/** Parse a property value and store it in a prefab template record. */
+static bool ParseAndStoreProperty(PrefabTemplate* Template, uint32_t Record,
+                                  const PropDescriptor* Desc, Tokenizer* T, SceneParser* Parser)
+{
+    ParsedPropertyValue Value;
+    if (!ParsePropertyValue(Desc, T, Parser, &Value)) {
+        return (false);
+    }
+    if (!Value.Has) {
+        return (true);
+    }
+
+    switch (Desc->Type) {
+        case PropType::Float:
+            Template->SetProperty(Record, Desc->Name, Value.Number);
+            break;
+        case PropType::Int32:
+            Template->SetProperty(Record, Desc->Name, static_cast<int32_t>(Value.Number));
+            break;
+        case PropType::UInt32:
+            Template->SetProperty(Record, Desc->Name, static_cast<uint32_t>(Value.Number));
+            break;
+        case PropType::Bool:
+            Template->SetProperty(Record, Desc->Name, Value.Flag);
+            break;
+        case PropType::String:
+        case PropType::Enum:
+            Template->SetProperty(Record, Desc->Name, std::string_view(Value.Text));
+            break;
+        case PropType::Vec3:
+            Template->SetProperty(Record, Desc->Name, Value.Vector);
+            break;
+        default: break;
+    }
+    return (true);
+}
+
 ///////////////////////////////////////////////////////////////
 // Primitive Mesh Parsing Helper
 ///////////////////////////////////////////////////////////////
@@ -532,11 +598,10 @@ static bool ParseAndSetProperty(Node* NodePtr, const PropDescriptor* Desc,
  * Expected syntax: <shape> { key: value ... }
  * or: <shape> { }
  *
- * Reads the shape name, optional parameter block, calls the
- * appropriate primitive creation function, and assigns the result
- * to the MeshInstance's ModelHandle.
+ * Reads the shape name, optional parameter block, and calls the
+ * appropriate primitive creation function, returning its model.
  */
-static bool ParsePrimitiveMesh(Tokenizer* T, MeshInstance* MI, SceneParser* SP)
+static bool ParsePrimitiveModel(Tokenizer* T, AxModelHandle* OutModel, SceneParser* SP)
 {
     // Read shape name identifier
     if (!ExpectToken(T, AX_TOKEN_IDENTIFIER)) {
@@ -548,9 +613,6 @@ static bool ParsePrimitiveMesh(Tokenizer* T, MeshInstance* MI, SceneParser* SP)
     CopyTokenString(&T->CurrentToken, ShapeName, sizeof(ShapeName));
     T->CurrentToken = NextToken(T);
 
-    // Clear MeshPath to indicate this is a primitive, not file-based
-    MI->MeshPath = "";
-
     // Initialize default primitive mesh instances for each shape
     BoxMesh BoxP;
     SphereMesh SphereP;
@@ -671,67 +733,49 @@ static bool ParsePrimitiveMesh(Tokenizer* T, MeshInstance* MI, SceneParser* SP)
             Handle = CapP.CreateModel();
         }
 
-        MI->ModelHandle = Handle;
+        *OutModel = Handle;
     }
 
     return (true);
 }
 
-///////////////////////////////////////////////////////////////
-// Deep Copy Helper (file-local)
-///////////////////////////////////////////////////////////////
-
-static Node* DeepCopyNode(SceneTree* Scene, Node* Src, Node* NewParent)
+/** Parse a primitive mesh declaration and assign it to the MeshInstance. */
+static bool ParsePrimitiveMesh(Tokenizer* T, MeshInstance* MI, SceneParser* SP)
 {
-    if (!Src || !Scene) {
-        return (nullptr);
-    }
-
-    Node* Copy = Scene->CreateNode(Src->GetName(), Src->GetType(), NewParent);
-    if (!Copy) {
-        return (nullptr);
-    }
-
-    Copy->GetTransform() = Src->GetTransform();
-
-    for (Node* Child = Src->GetFirstChild(); Child; Child = Child->GetNextSibling()) {
-        DeepCopyNode(Scene, Child, Copy);
+    AxModelHandle Model = AX_INVALID_HANDLE;
+    if (!ParsePrimitiveModel(T, &Model, SP)) {
+        return (false);
     }
 
-    return (Copy);
+    // Clear MeshPath to indicate this is a primitive, not file-based
+    MI->MeshPath = "";
+    MI->ModelHandle = Model;
+    return (true);
 }
 
 ///////////////////////////////////////////////////////////////
-// SceneParser Private Method Implementations
+// Node Block Helpers
 ///////////////////////////////////////////////////////////////
 
-void SceneParser::SetParserError(Tokenizer* T, const char* Format, ...)
-{
-    va_list Args;
-    va_start(Args, Format);
-    vsnprintf(T->ErrorMessage, sizeof(T->ErrorMessage), Format, Args);
-    va_end(Args);
-
-    strncpy(ParserLastErrorMessage_, T->ErrorMessage, sizeof(ParserLastErrorMessage_) - 1);
-    ParserLastErrorMessage_[sizeof(ParserLastErrorMessage_) - 1] = '\0';
-}
-
-Node* SceneParser::ParseNodeImpl(Tokenizer* T, SceneTree* Scene, Node* Parent)
+/**
+ * Parse the start of a node block: node "Name" [Type] {
+ * Called with T->CurrentToken == "node"; leaves the token after '{'.
+ */
+static bool ParseNodeHeader(Tokenizer* T, char* NodeName, size_t NameSize, NodeType* OutType,
+                            SceneParser* SP)
 {
-    // Called with T->CurrentToken == "node" identifier.
     T->CurrentToken = NextToken(T); // advance past "node"
 
     if (!ExpectToken(T, AX_TOKEN_STRING)) {
-        SetParserError(T, "Expected node name string at line %d", T->CurrentToken.Line);
-        return (nullptr);
+        SP->SetParserError(T, "Expected node name string at line %d", T->CurrentToken.Line);
+        return (false);
     }
 
-    char NodeName[64];
-    CopyTokenString(&T->CurrentToken, NodeName, sizeof(NodeName));
+    CopyTokenString(&T->CurrentToken, NodeName, NameSize);
     T->CurrentToken = NextToken(T);
 
     // Check for optional type name identifier before '{'
-    NodeType Type = NodeType::Node3D; // default if no type specified
+    *OutType = NodeType::Node3D; // default if no type specified
     while (T->CurrentToken.Type == AX_TOKEN_COMMENT ||
            T->CurrentToken.Type == AX_TOKEN_NEWLINE) {
         T->CurrentToken = NextToken(T);
@@ -743,20 +787,69 @@ Node* SceneParser::ParseNodeImpl(Tokenizer* T, SceneTree* Scene, Node* Parent)
 
         NodeType MappedType = MapTypeNameToNodeType(TypeName);
         if (MappedType != NodeType::Base) {
-            Type = MappedType;
+            *OutType = MappedType;
             T->CurrentToken = NextToken(T);
         } else {
-            SetParserError(T, "Unknown node type '%s' at line %d",
-                           TypeName, T->CurrentToken.Line);
-            return (nullptr);
+            SP->SetParserError(T, "Unknown node type '%s' at line %d",
+                               TypeName, T->CurrentToken.Line);
+            return (false);
         }
     }
 
     if (!ExpectToken(T, AX_TOKEN_LBRACE)) {
-        SetParserError(T, "Expected '{' to start node block at line %d", T->CurrentToken.Line);
-        return (nullptr);
+        SP->SetParserError(T, "Expected '{' to start node block at line %d", T->CurrentToken.Line);
+        return (false);
     }
     T->CurrentToken = NextToken(T);
+    return (true);
+}
+
+/**
+ * Parse "name:" of an inline property, leaving the token at its value.
+ * Called with T->CurrentToken == the property name identifier.
+ */
+static bool ParsePropertyName(Tokenizer* T, char* PropName, size_t NameSize, SceneParser* SP)
+{
+    CopyTokenString(&T->CurrentToken, PropName, NameSize);
+    T->CurrentToken = NextToken(T);
+
+    if (!ExpectToken(T, AX_TOKEN_COLON)) {
+        SP->SetParserError(T, "Expected ':' after property name '%s' at line %d",
+                           PropName, T->CurrentToken.Line);
+        return (false);
+    }
+    T->CurrentToken = NextToken(T);
+
+    // Skip whitespace tokens before the value
+    while (T->CurrentToken.Type == AX_TOKEN_COMMENT ||
+           T->CurrentToken.Type == AX_TOKEN_NEWLINE) {
+        T->CurrentToken = NextToken(T);
+    }
+    return (true);
+}
+
+///////////////////////////////////////////////////////////////
+// SceneParser Private Method Implementations
+///////////////////////////////////////////////////////////////
+
+void SceneParser::SetParserError(Tokenizer* T, const char* Format, ...)
+{
+    va_list Args;
+    va_start(Args, Format);
+    vsnprintf(T->ErrorMessage, sizeof(T->ErrorMessage), Format, Args);
+    va_end(Args);
+
+    strncpy(ParserLastErrorMessage_, T->ErrorMessage, sizeof(ParserLastErrorMessage_) - 1);
+    ParserLastErrorMessage_[sizeof(ParserLastErrorMessage_) - 1] = '\0';
+}
+
+Node* SceneParser::ParseNodeImpl(Tokenizer* T, SceneTree* Scene, Node* Parent)
+{
+    char NodeName[64];
+    NodeType Type;
+    if (!ParseNodeHeader(T, NodeName, sizeof(NodeName), &Type, this)) {
+        return (nullptr);
+    }
 
     Node* NewNode = Scene->CreateNode(NodeName, Type, Parent);
     if (!NewNode) {
@@ -791,21 +884,9 @@ Node* SceneParser::ParseNodeImpl(Tokenizer* T, SceneTree* Scene, Node* Parent)
         } else {
             // Inline property: key: value
             char PropName[64];
-            CopyTokenString(&T->CurrentToken, PropName, sizeof(PropName));
-            T->CurrentToken = NextToken(T);
-
-            if (!ExpectToken(T, AX_TOKEN_COLON)) {
-                SetParserError(T, "Expected ':' after property name '%s' at line %d",
-                               PropName, T->CurrentToken.Line);
+            if (!ParsePropertyName(T, PropName, sizeof(PropName), this)) {
                 return (nullptr);
             }
-            T->CurrentToken = NextToken(T);
-
-            // Skip whitespace tokens before the value
-            while (T->CurrentToken.Type == AX_TOKEN_COMMENT ||
-                   T->CurrentToken.Type == AX_TOKEN_NEWLINE) {
-                T->CurrentToken = NextToken(T);
-            }
 
             // Check for primitive mesh syntax: mesh: primitive <shape> { params }
             if (Type == NodeType::MeshInstance &&
@@ -848,6 +929,88 @@ Node* SceneParser::ParseNodeImpl(Tokenizer* T, SceneTree* Scene, Node* Parent)
     return (NewNode);
 }
 
+bool SceneParser::CompileNodeImpl(Tokenizer* T, PrefabTemplate* Template, uint32_t Parent)
+{
+    char NodeName[64];
+    NodeType Type;
+    if (!ParseNodeHeader(T, NodeName, sizeof(NodeName), &Type, this)) {
+        return (false);
+    }
+
+    uint32_t Record = Template->AddNode(NodeName, Type, Parent);
+    if (Record == PrefabTemplate::NoParent) {
+        SetParserError(T, "Failed to add node '%s' to prefab", NodeName);
+        return (false);
+    }
+
+    while (T->CurrentToken.Type != AX_TOKEN_RBRACE &&
+           T->CurrentToken.Type != AX_TOKEN_EOF) {
+        if (T->CurrentToken.Type == AX_TOKEN_COMMENT ||
+            T->CurrentToken.Type == AX_TOKEN_NEWLINE) {
+            T->CurrentToken = NextToken(T);
+            continue;
+        }
+
+        if (!ExpectToken(T, AX_TOKEN_IDENTIFIER)) {
+            SetParserError(T, "Expected keyword in node block at line %d", T->CurrentToken.Line);
+            return (false);
+        }
+
+        if (TokenEquals(&T->CurrentToken, "transform")) {
+            T->CurrentToken = NextToken(T); // advance past "transform"
+            AxTransform Transform;
+            if (!ParseTransform(T, &Transform, this)) {
+                return (false);
+            }
+            PrefabTransform Local;
+            Local.Translation = Vec3(Transform.Translation);
+            Local.Rotation = Quat(Transform.Rotation);
+            Local.Scale = Vec3(Transform.Scale);
+            Template->SetTransform(Record, Local);
+        } else if (TokenEquals(&T->CurrentToken, "node")) {
+            if (!CompileNodeImpl(T, Template, Record)) {
+                return (false);
+            }
+        } else {
+            // Inline property: key: value
+            char PropName[64];
+            if (!ParsePropertyName(T, PropName, sizeof(PropName), this)) {
+                return (false);
+            }
+
+            // Primitive meshes are built now and shared by every instance
+            if (Type == NodeType::MeshInstance &&
+                strcmp(PropName, "mesh") == 0 &&
+                T->CurrentToken.Type == AX_TOKEN_IDENTIFIER &&
+                TokenEquals(&T->CurrentToken, "primitive")) {
+                T->CurrentToken = NextToken(T); // consume "primitive"
+
+                AxModelHandle Model = AX_INVALID_HANDLE;
+                if (!ParsePrimitiveModel(T, &Model, this)) {
+                    return (false);
+                }
+                PrimitiveMesh::ReleaseModel(Template->GetRecord(Record).Model);
+                Template->SetModel(Record, Model);
+                continue;
+            }
+
+            const PropDescriptor* Desc = PropertyRegistry::Get().FindProperty(Type, PropName);
+            if (Desc) {
+                if (!ParseAndStoreProperty(Template, Record, Desc, T, this)) {
+                    return (false);
+                }
+            }
+        }
+    }
+
+    if (!ExpectToken(T, AX_TOKEN_RBRACE)) {
+        SetParserError(T, "Expected '}' to close node block at line %d", T->CurrentToken.Line);
+        return (false);
+    }
+    T->CurrentToken = NextToken(T);
+    return (true);
+}
+
 SceneTree* SceneParser::ParseSceneImpl(Tokenizer* T)
 {
     if (!ExpectToken(T, AX_TOKEN_IDENTIFIER) ||
@@ -931,8 +1094,14 @@ void SceneParser::Init(AxAPIRegistry* Registry)
     HashTableAPI_ = static_cast<AxHashTableAPI*>(Registry->Get(AXON_HASH_TABLE_API_NAME));
 }
 
+SceneParser::~SceneParser()
+{
+    ClearPrefabCache();
+}
+
 void SceneParser::Term()
 {
+    ClearPrefabCache();
     Registry_      = nullptr;
     AllocatorAPI_  = nullptr;
     PlatformAPI_   = nullptr;
@@ -1029,6 +1198,8 @@ SceneTree* SceneParser::LoadSceneFromFile(const char* FilePath)
         return (nullptr);
     }
 
+    // The arena holds the scene's node pools; it goes away with the tree
+    Scene->OwnsAllocator = true;
     return (Scene);
 }
 
@@ -1053,6 +1224,8 @@ SceneTree* SceneParser::LoadSceneFromString(const char* SceneData)
         return (nullptr);
     }
 
+    // The arena holds the scene's node pools; it goes away with the tree
+    Scene->OwnsAllocator = true;
     return (Scene);
 }
 
@@ -1062,16 +1235,33 @@ Node* SceneParser::ParsePrefab(const char* PrefabData, SceneTree* Scene)
         return (nullptr);
     }
 
-    AxAllocator* Allocator = Scene->Allocator;
-    if (!Allocator && AllocatorAPI_) {
-        Allocator = AllocatorAPI_->CreateHeap("PrefabAlloc", 64 * 1024, 256 * 1024);
+    const PrefabTemplate* Template = CompilePrefab(PrefabData);
+    if (!Template) {
+        return (nullptr);
+    }
+
+    Node* PrefabRoot = InstantiatePrefab(Scene, *Template, nullptr);
+    if (PrefabRoot) {
+        InvokeOnSubtreeParsed(PrefabRoot);
     }
-    if (!Allocator) {
+    return (PrefabRoot);
+}
+
+const PrefabTemplate* SceneParser::CompilePrefab(const char* PrefabData)
+{
+    if (!PrefabData) {
         return (nullptr);
     }
 
+    std::string_view Source(PrefabData);
+    auto It = PrefabCache_.find(Source);
+    if (It != PrefabCache_.end()) {
+        return (It->second);
+    }
+
+    // The tokenizer allocates nothing for prefabs; no allocator needed
     Tokenizer T;
-    InitTokenizer(&T, PrefabData, Allocator);
+    InitTokenizer(&T, PrefabData, nullptr);
 
     while (T.CurrentToken.Type == AX_TOKEN_COMMENT ||
            T.CurrentToken.Type == AX_TOKEN_NEWLINE) {
@@ -1080,10 +1270,73 @@ Node* SceneParser::ParsePrefab(const char* PrefabData, SceneTree* Scene)
 
     if (!ExpectToken(&T, AX_TOKEN_IDENTIFIER) ||
         !TokenEquals(&T.CurrentToken, "node")) {
+        SetParserError(&T, "Expected top-level 'node' block in prefab at line %d",
+                       T.CurrentToken.Line);
+        SetError("Failed to compile prefab: %s", ParserLastErrorMessage_);
+        return (nullptr);
+    }
+
+    PrefabTemplate* Template = new PrefabTemplate();
+    if (!CompileNodeImpl(&T, Template, PrefabTemplate::NoParent)) {
+        for (const PrefabTemplate::NodeRecord& Record : Template->GetRecords()) {
+            PrimitiveMesh::ReleaseModel(Record.Model);
+        }
+        delete Template;
+        SetError("Failed to compile prefab: %s", ParserLastErrorMessage_);
+        return (nullptr);
+    }
+
+    PrefabCache_.emplace(std::string(Source), Template);
+    return (Template);
+}
+
+const PrefabTemplate* SceneParser::CompilePrefabFile(const char* FilePath)
+{
+    if (!FilePath || !PlatformAPI_) {
+        SetError("Invalid prefab file path: NULL");
         return (nullptr);
     }
 
-    return (ParseNodeImpl(&T, Scene, nullptr));
+    const AxPlatformFileAPI* FileAPI = PlatformAPI_->FileAPI;
+    AxFile File = FileAPI->OpenForRead(FilePath);
+    if (!FileAPI->IsValid(File)) {
+        SetError("Failed to open file: %s", FilePath);
+        return (nullptr);
+    }
+
+    uint64_t FileSize = FileAPI->Size(File);
+    std::string FileContent(FileSize, '\0');
+    uint64_t BytesRead = FileSize ? FileAPI->Read(File, FileContent.data(), FileSize) : 0;
+    FileAPI->Close(File);
+
+    if (FileSize == 0 || BytesRead != FileSize) {
+        SetError("Failed to read prefab file: %s", FilePath);
+        return (nullptr);
+    }
+
+    return (CompilePrefab(FileContent.c_str()));
+}
+
+void SceneParser::ClearPrefabCache()
+{
+    for (auto& [Source, Template] : PrefabCache_) {
+        for (const PrefabTemplate::NodeRecord& Record : Template->GetRecords()) {
+            PrimitiveMesh::ReleaseModel(Record.Model);
+        }
+        delete Template;
+    }
+    PrefabCache_.clear();
+}
+
+Node* SceneParser::InstantiatePrefab(SceneTree* Scene, const PrefabTemplate& Template, Node* Parent)
+{
+    if (!Scene) {
+        return (nullptr);
+    }
+
+    Node* Root = nullptr;
+    Scene->InstantiateBatch(Template, 1, nullptr, Parent, &Root);
+    return (Root);
 }
 
 Node* SceneParser::InstantiatePrefab(SceneTree* Scene, Node* PrefabRoot, Node* Parent)
@@ -1092,7 +1345,10 @@ Node* SceneParser::InstantiatePrefab(SceneTree* Scene, Node* PrefabRoot, Node* P
         return (nullptr);
     }
 
-    return (DeepCopyNode(Scene, PrefabRoot, Parent));
+    // Flatten the source once, then build the copy in one batched pass;
+    // typed property values are copied along with names and transforms
+    PrefabTemplate Template = PrefabTemplate::Capture(PrefabRoot);
+    return (InstantiatePrefab(Scene, Template, Parent));
 }
 
 void SceneParser::SetDefaultSceneMemorySize(size_t MemorySize)
@@ -1199,6 +1455,20 @@ void SceneParser::InvokeOnNodeParsed(Node* ParsedNode)
     }
 }
 
+void SceneParser::InvokeOnSubtreeParsed(Node* SubtreeRoot)
+{
+    // Children first, in the order ParseNodeImpl reports them
+    for (Node* Child = SubtreeRoot->GetFirstChild(); Child; Child = Child->GetNextSibling()) {
+        InvokeOnSubtreeParsed(Child);
+    }
+
+    if (SubtreeRoot->GetType() == NodeType::Light) {
+        AxLight TempLight = static_cast<LightNode*>(SubtreeRoot)->BuildLight();
+        InvokeOnLightParsed(&TempLight);
+    }
+    InvokeOnNodeParsed(SubtreeRoot);
+}
+
 ///////////////////////////////////////////////////////////////
 // Scene Serialization (Save)
 ///////////////////////////////////////////////////////////////
@@ -6,64 +6,95 @@
  * methods for script dispatch and transform propagation.
  *
  * Optimization: Uses three flat lists to avoid O(N) full-tree traversals:
- *   - TransformDirtyRoots_: nodes whose transforms changed since last flush
- *   - ScriptNodes_: nodes with initialized scripts for per-frame dispatch
- *   - PendingInitScripts_: nodes with scripts awaiting OnInit
+ *   - TransformDirtyRoots_: nodes whose transforms changed since last flush;
+ *     their local matrices feed TransformHierarchy's linear world update
+ *   - Tick group dispatch lists: nodes with initialized scripts for
+ *     per-frame dispatch, one list per callback the script declares in its
+ *     tick group, grouped by script class.
+ *     Limited to nodes active in the hierarchy (Node keeps that flag cached
+ *     and reports changes, so dispatch never walks parent chains)
+ *   - PendingInitsByDepth_: nodes with scripts awaiting OnInit, bucketed
+ *     by the depth Node keeps cached, so bottom-up order needs no sort
+ *
+ * Every node records its index in each of these lists, so membership
+ * checks and removal are O(1) (swap-with-last, renumbering the moved node).
  *
  * Typed nodes (MeshInstance, CameraNode, LightNode) are tracked in flat
- * arrays populated during CreateNode() for efficient system-level queries.
+ * lists populated during CreateNode() for efficient system-level queries.
+ * All lists are growable std::vectors, so large scenes never drop entries.
+ *
+ * Name and NodeID lookups use NameIndex_ and NodesByID_, maintained by
+ * IndexNode/UnindexNode as nodes are created, renamed and destroyed.
+ *
+ * Nodes live in NodePool_. Teardown never walks the hierarchy bottom-up:
+ * it detaches scripts and signals across all live nodes first, then lets
+ * the pool destroy them in memory order and free whole chunks.
  */
 
 #include "AxEngine/AxSceneTree.h"
 #include "AxEngine/AxScriptBase.h"
 #include "AxEngine/AxScriptLog.h"
+#include "AxEngine/AxScriptRegistry.h"
 #include "AxEngine/AxEventBus.h"
+#include "AxEngine/AxWorkerPool.h"
 #include "Foundation/AxMath.h"
 
 #include <cstdlib>
 #include <cstring>
 #include <cstdio>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <typeinfo>
 
 //=============================================================================
 // File-local Helpers
 //=============================================================================
 
 /**
- * Compute the depth of a node in the tree hierarchy.
- * Root is depth 0, its children are depth 1, etc.
+ * Next node after Current in pre-order within the subtree rooted at Top,
+ * or nullptr when the walk is done.
  */
-static uint32_t NodeDepth(Node* N)
+static Node* NextPreOrder(Node* Current, Node* Top)
 {
-  if (!N) {
-    return (0);
+  if (Current->GetFirstChild()) {
+    return (Current->GetFirstChild());
   }
 
-  uint32_t Depth = 0;
-  Node* Current = N->GetParent();
-  while (Current) {
-    Depth++;
+  while (Current && Current != Top) {
+    if (Current->GetNextSibling()) {
+      return (Current->GetNextSibling());
+    }
     Current = Current->GetParent();
   }
-  return (Depth);
+  return (nullptr);
+}
+
+// Grow a list ahead of a batch. Never less than doubling, so a run of
+// small batches still grows geometrically.
+template<typename T>
+static void ReserveExtra(std::vector<T>& List, size_t Extra)
+{
+  size_t Size = List.size() + Extra;
+  if (Size > List.capacity()) {
+    List.reserve(std::max(Size, List.capacity() * 2));
+  }
 }
 
+// Largest name bucket FindChildByName searches before it falls back to
+// scanning the parent's children (names shared by many nodes, e.g. "Bone")
+static constexpr uint32_t MaxIndexedChildCandidates = 16;
+
 /**
- * Check whether a node is effectively active by walking up the parent chain.
- * Returns false if the node or any ancestor is inactive.
- * This preserves the old TraverseTopDown behavior where an inactive parent
- * caused its entire subtree to be skipped.
+ * Starting structure version for a new tree. Each tree counts within its
+ * own 2^32 range so a NodePath cached against a destroyed tree never
+ * matches a new tree allocated at the same address.
  */
-static bool IsNodeEffectivelyActive(Node* N)
+static uint64_t NextStructureVersionBase()
 {
-  Node* Current = N;
-  while (Current) {
-    if (!Current->IsActive()) {
-      return (false);
-    }
-    Current = Current->GetParent();
-  }
-  return (true);
+  static std::atomic<uint64_t> NextBase{0};
+  return (NextBase.fetch_add(1ull << 32, std::memory_order_relaxed));
 }
 
 //=============================================================================
@@ -72,28 +103,31 @@ static bool IsNodeEffectivelyActive(Node* N)
 
 SceneTree::SceneTree(AxHashTableAPI* TableAPI, struct AxAllocator* SceneAllocator)
   : Allocator(SceneAllocator)
+  , OwnsAllocator(false)
+  , HasHeapNodes_(false)
+  , HasScripts_(false)
   , Root_(nullptr)
   , NodeCount_(0)
   , NextNodeID_(1)
   , HashTableAPI_(TableAPI)
-  , MeshInstanceCount_(0)
-  , CameraNodeCount_(0)
-  , LightNodeCount_(0)
-  , TransformDirtyRootCount_(0)
-  , ScriptNodeCount_(0)
+  , StructureVersion_(NextStructureVersionBase())
+  , HandleGeneration_(0)
+  , TypedHoles_{}
+  , WorkerPool_(nullptr)
+  , TickGroupOrderDirty_(false)
+  , LODViewValid_(false)
+  , TickStagger_(0)
+  , ActiveScriptCount_(0)
+  , DispatchingScripts_(false)
+  , ScriptNodeHoles_(0)
+  , ParallelPhase_(false)
   , PendingInitCount_(0)
+  , ProcessingPendingInits_(false)
   , Bus_(nullptr)
+  , Tasks_(*this)
+  , Timers_(*this)
+  , Tweens_(*this)
 {
-  // Zero-initialize typed-node tracking arrays
-  memset(MeshInstances_, 0, sizeof(MeshInstances_));
-  memset(CameraNodes_, 0, sizeof(CameraNodes_));
-  memset(LightNodes_, 0, sizeof(LightNodes_));
-
-  // Zero-initialize optimization arrays
-  memset(TransformDirtyRoots_, 0, sizeof(TransformDirtyRoots_));
-  memset(ScriptNodes_, 0, sizeof(ScriptNodes_));
-  memset(PendingInitScripts_, 0, sizeof(PendingInitScripts_));
-
   // Initialize scene settings to defaults
   AmbientLight = {0.1f, 0.1f, 0.1f};
   Gravity = {0.0f, -9.81f, 0.0f};
@@ -103,10 +137,16 @@ SceneTree::SceneTree(AxHashTableAPI* TableAPI, struct AxAllocator* SceneAllocato
   // Create the EventBus
   Bus_ = new EventBus();
 
+  // Every script starts in the default tick group
+  AddTickGroup("Default", 0);
+
   // Create the root node
-  Root_ = new RootNode(HashTableAPI_);
+  Root_ = NodePool_.Create<RootNode>(NodeType::Root, Allocator, HashTableAPI_);
   Root_->SetNodeID(NextNodeID_++);
   Root_->OwningTree_ = this;
+  IndexNode(Root_);
+  AllocateHandle(Root_);
+  Hierarchy_.Insert(Root_, TransformHierarchy::InvalidIndex);
   NodeCount_++;
 }
 
@@ -118,14 +158,16 @@ SceneTree::~SceneTree()
     Bus_ = nullptr;
   }
 
-  // Recursively destroy all children of Root before deleting Root itself.
-  // This ensures scripts, signal connections, and std::function captures
-  // are properly cleaned up while all nodes are still alive.
   if (Root_) {
-    SetOwningTreeRecursive(static_cast<Node*>(Root_), nullptr);
-    DestroySubtreeBottomUp(static_cast<Node*>(Root_));
+    DestroyAllNodes();
     Root_ = nullptr;
   }
+
+  // Chunks are already back; a scene arena goes in one release
+  if (OwnsAllocator && Allocator) {
+    Allocator->Destroy(Allocator);
+    Allocator = nullptr;
+  }
 }
 
 //=============================================================================
@@ -134,42 +176,43 @@ SceneTree::~SceneTree()
 
 void SceneTree::SetMainCamera(CameraNode* Camera)
 {
-  MainCamera_ = Camera;
+  Frame_.MainCamera = Camera;
 }
 
 void SceneTree::UpdateMouseDelta(AxVec2 Delta)
 {
-  MouseDelta_ = Delta;
+  Frame_.MouseDelta = Delta;
 }
 
 //=============================================================================
 // Transform Propagation
 //=============================================================================
 
-void SceneTree::UpdateNodeTransforms(Node* Current,
-                                     const Mat4& ParentWorldMatrix,
-                                     bool ParentWasDirty)
+void SceneTree::FlushTransforms()
 {
-  if (!Current) {
-    return;
-  }
-
-  Transform& T = Current->Transform_;
-  bool ThisNodeDirty = T.IsDirty() || ParentWasDirty;
-
-  if (ThisNodeDirty) {
-    // Get the local TRS matrix (lazy-evaluated by Transform)
-    const Mat4& LocalMatrix = T.GetForwardMatrix();
+  // Copy changed local matrices into the hierarchy. The root's local stays
+  // identity so the root's world matrix is always identity.
+  for (size_t i = 0; i < TransformDirtyRoots_.size(); ++i) {
+    Node* DirtyNode = TransformDirtyRoots_[i];
+    DirtyNode->DirtyListSlot_ = Node::NotInList;
+
+    if (DirtyNode == static_cast<Node*>(Root_) ||
+        DirtyNode->HierarchyIndex_ == TransformHierarchy::InvalidIndex) {
+      continue;
+    }
 
-    // WorldMatrix = Parent.WorldMatrix * Local.TRS
-    Current->WorldMatrix_ = ParentWorldMatrix * LocalMatrix;
+    Hierarchy_.SetLocal(DirtyNode->HierarchyIndex_, DirtyNode->Transform_.GetForwardMatrix());
   }
+  TransformDirtyRoots_.clear();
 
-  // Recurse to children, passing this node's world matrix
-  Node* Child = Current->GetFirstChild();
-  while (Child) {
-    UpdateNodeTransforms(Child, Current->WorldMatrix_, ThisNodeDirty);
-    Child = Child->GetNextSibling();
+  // Each dirty node and its descendants, parents first; large updates are
+  // split by depth level across the worker pool when one is set
+  Hierarchy_.Update(WorkerPool_);
+
+  // Refit the bounds of indexed nodes whose world matrix changed. Only
+  // their slots are watched, so this visits nothing else.
+  for (uint32_t Slot : Hierarchy_.GetMovedWatched()) {
+    Spatial_.Update(Hierarchy_.GetNode(Slot)->SpatialProxy_, Hierarchy_.GetWorld(Slot));
   }
 }
 
@@ -184,461 +227,1280 @@ void SceneTree::MarkTransformDirty(Node* DirtyNode)
   }
 
   // O(1) duplicate prevention
-  if (DirtyNode->InDirtyList_) {
+  if (DirtyNode->DirtyListSlot_ != Node::NotInList) {
     return;
   }
 
-  // Add to dirty roots if there is space
-  if (TransformDirtyRootCount_ < AX_SCENE_TREE_MAX_TYPED_NODES) {
-    TransformDirtyRoots_[TransformDirtyRootCount_++] = DirtyNode;
-    DirtyNode->InDirtyList_ = true;
+  // OwnNode scripts of a parallel phase each dirty their own node; only
+  // the shared list needs a lock
+  std::unique_lock<std::mutex> Lock(ParallelDirtyMutex_, std::defer_lock);
+  if (ParallelPhase_) {
+    Lock.lock();
   }
+
+  DirtyNode->DirtyListSlot_ = static_cast<uint32_t>(TransformDirtyRoots_.size());
+  TransformDirtyRoots_.push_back(DirtyNode);
 }
 
-void SceneTree::RegisterPendingInit(Node* PendingNode)
+void SceneTree::OnNodeReparented(Node* Child)
 {
-  if (!PendingNode) {
+  StructureVersion_++;
+
+  if (!Child || Child->HierarchyIndex_ == TransformHierarchy::InvalidIndex) {
     return;
   }
 
-  // Avoid duplicates: check if already in the queue
-  for (uint32_t i = 0; i < PendingInitCount_; ++i) {
-    if (PendingInitScripts_[i] == PendingNode) {
-      return;
-    }
-  }
+  // Parents outside this tree leave the node as a hierarchy root
+  Node* NewParent = Child->GetParent();
+  uint32_t ParentIndex = (NewParent && NewParent->OwningTree_ == this)
+    ? NewParent->HierarchyIndex_
+    : TransformHierarchy::InvalidIndex;
 
-  if (PendingInitCount_ < AX_SCENE_TREE_MAX_TYPED_NODES) {
-    PendingInitScripts_[PendingInitCount_++] = PendingNode;
-  }
+  Hierarchy_.SetParent(Child->HierarchyIndex_, ParentIndex);
 }
 
-void SceneTree::RegisterScriptNode(Node* ScriptNode)
+void SceneTree::RenameNode(Node* Target, std::string_view NewName)
 {
-  if (!ScriptNode) {
+  if (!Target || NewName.empty()) {
     return;
   }
 
-  // Avoid duplicates
-  for (uint32_t i = 0; i < ScriptNodeCount_; ++i) {
-    if (ScriptNodes_[i] == ScriptNode) {
-      return;
-    }
+  // Leave the old name's bucket before the name changes
+  UnindexNode(Target);
+  Target->Name_ = NewName;
+  IndexNode(Target);
+}
+
+void SceneTree::RegisterPendingInit(Node* PendingNode)
+{
+  // O(1) duplicate prevention
+  if (!PendingNode || PendingNode->PendingInitSlot_ != Node::NotInList) {
+    return;
   }
 
-  if (ScriptNodeCount_ < AX_SCENE_TREE_MAX_TYPED_NODES) {
-    ScriptNodes_[ScriptNodeCount_++] = ScriptNode;
+  uint32_t Depth = PendingNode->Depth_;
+  if (PendingInitsByDepth_.size() <= Depth) {
+    PendingInitsByDepth_.resize(Depth + 1);
   }
+
+  std::vector<Node*>& Bucket = PendingInitsByDepth_[Depth];
+  PendingNode->PendingInitSlot_ = static_cast<uint32_t>(Bucket.size());
+  PendingNode->PendingInitDepth_ = Depth;
+  Bucket.push_back(PendingNode);
+  PendingInitCount_++;
+  HasScripts_ = true;
 }
 
-void SceneTree::UnregisterScriptNode(Node* ScriptNode)
+void SceneTree::RemovePendingInit(Node* PendingNode)
 {
-  if (!ScriptNode) {
+  uint32_t Slot = PendingNode->PendingInitSlot_;
+  if (Slot == Node::NotInList) {
     return;
   }
 
-  // Swap-with-last removal for O(1) performance
-  for (uint32_t i = 0; i < ScriptNodeCount_; ++i) {
-    if (ScriptNodes_[i] == ScriptNode) {
-      ScriptNodes_[i] = ScriptNodes_[ScriptNodeCount_ - 1];
-      ScriptNodes_[ScriptNodeCount_ - 1] = nullptr;
-      ScriptNodeCount_--;
-      return;
-    }
+  std::vector<Node*>& Bucket = PendingInitsByDepth_[PendingNode->PendingInitDepth_];
+  if (ProcessingPendingInits_) {
+    // The bucket may be mid-iteration; it is cleared when processed
+    Bucket[Slot] = nullptr;
+  } else {
+    Node* Moved = Bucket.back();
+    Bucket[Slot] = Moved;
+    Moved->PendingInitSlot_ = Slot;
+    Bucket.pop_back();
   }
+
+  PendingNode->PendingInitSlot_ = Node::NotInList;
+  PendingInitCount_--;
 }
 
-//=============================================================================
-// Pending Init Processing
-//=============================================================================
+void SceneTree::OnPendingInitDepthChanged(Node* PendingNode)
+{
+  RemovePendingInit(PendingNode);
+  RegisterPendingInit(PendingNode);
+}
 
-void SceneTree::ProcessPendingInits()
+void SceneTree::RegisterScriptNode(Node* ScriptNode)
 {
-  if (PendingInitCount_ == 0) {
+  // O(1) duplicate prevention
+  if (!ScriptNode || ScriptNode->InScriptList_) {
     return;
   }
 
-  // Sort pending inits by depth (deepest first) for bottom-up initialization.
-  // Children must be initialized before parents.
-  std::sort(PendingInitScripts_, PendingInitScripts_ + PendingInitCount_,
-    [](Node* A, Node* B) {
-      return (NodeDepth(A) > NodeDepth(B));
-    });
+  ScriptBase* Script = ScriptNode->GetScript();
+  if (!Script) {
+    return;
+  }
 
-  // Process each pending init
-  for (uint32_t i = 0; i < PendingInitCount_; ++i) {
-    Node* PendingNode = PendingInitScripts_[i];
-    if (!PendingNode) {
-      continue;
+  uint32_t Group = Script->TickGroup_;
+  if (Group >= TickGroups_.size()) {
+    Log::Warn("SceneTree: unknown tick group for script on node '" +
+              std::string(ScriptNode->GetName()) + "', using Default");
+    Group = DefaultTickGroup;
+  }
+
+  // List L holds the scripts whose callback flags have bit L set, except
+  // that throttled Update scripts get a list of their own
+  uint32_t Class = ScriptClassIndex(Script);
+  uint8_t Lists = static_cast<uint8_t>(Script->Callbacks_);
+  if (Lists & (1u << UpdateList)) {
+    uint32_t Target = UpdateList;
+    if (IsThrottled(Group, Script)) {
+      Target = ThrottledUpdateList;
+    } else if (Script->Access_ == ScriptAccess::OwnNode) {
+      Target = OwnNodeUpdateList;
+    } else if (Script->Access_ == ScriptAccess::ReadOnlyScene) {
+      Target = ReadOnlyUpdateList;
     }
-
-    ScriptBase* Script = PendingNode->GetScript();
-    if (!Script || Script->IsInitialized_) {
+    Lists = static_cast<uint8_t>((Lists & ~(1u << UpdateList)) | (1u << Target));
+  }
+  for (uint32_t L = 0; L < ScriptListCount; ++L) {
+    if (!(Lists & (1u << L))) {
       continue;
     }
 
-    // Set SceneTree reference, main camera, and debug draw on the script
-    Script->MainCamera = MainCamera_;
-
-    Script->Tree_ = this;
-    Script->IsInitialized_ = true;
-    Script->OnInit();
-
-    // OnEnable fires immediately after OnInit only if the node is active
-    if (PendingNode->IsActive()) {
-      Script->OnEnable();
+    ScriptDispatchList& List = TickGroups_[Group].Lists[L];
+    if (List.Groups.size() <= Class) {
+      List.Groups.resize(Class + 1);
+    }
+    ScriptNode->ScriptListSlots_[L] = static_cast<uint32_t>(List.Groups[Class].size());
+    List.Groups[Class].push_back(ScriptNode);
+    List.Count++;
+
+    // The first OnUpdate gets the time since registration. Scripts with a
+    // frame interval start at different points of it.
+    if (L == ThrottledUpdateList) {
+      if (List.TickStates.size() <= Class) {
+        List.TickStates.resize(Class + 1);
+      }
+      ScriptTickState State;
+      State.LastTime = Frame_.Time - Frame_.DeltaT;
+      State.LastFrame = static_cast<uint32_t>(Frame_.FrameIndex) - 1 -
+                        (TickStagger_++ % Script->TickInterval_);
+      ScheduleTick(State, Script, 1);
+      List.TickStates[Class].push_back(State);
     }
-
-    // Move to the script process list for per-frame dispatch
-    RegisterScriptNode(PendingNode);
   }
 
-  // Clear the pending init queue
-  memset(PendingInitScripts_, 0, PendingInitCount_ * sizeof(Node*));
-  PendingInitCount_ = 0;
+  ScriptNode->InScriptList_ = true;
+  ScriptNode->ScriptLists_ = Lists;
+  ScriptNode->ScriptTickGroup_ = Group;
+  ScriptNode->ScriptClass_ = Class;
+  ActiveScriptCount_++;
 }
 
-//=============================================================================
-// Frame Loop Methods
-//=============================================================================
-
-void SceneTree::Update(float DeltaT)
+void SceneTree::UnregisterScriptNode(Node* ScriptNode)
 {
-  if (!Root_) {
+  if (!ScriptNode || !ScriptNode->InScriptList_) {
     return;
   }
 
-  // Step 1: Flush dirty transform roots (ALWAYS runs, even in Edit mode)
-  // Process only nodes whose transforms changed since last frame.
-  // On initial load, all nodes are dirty and the dirty list contains all
-  // of them, gracefully degrading to equivalent of full traversal.
-  // Ensure root's world matrix is identity
-  RootNode* RootPtr = Root_;
-  static const Mat4 IdentityMatrix = Mat4::Identity();
-  RootPtr->WorldMatrix_ = IdentityMatrix;
+  for (uint32_t L = 0; L < ScriptListCount; ++L) {
+    if (!(ScriptNode->ScriptLists_ & (1u << L))) {
+      continue;
+    }
 
-  if (TransformDirtyRootCount_ > 0) {
-    for (uint32_t i = 0; i < TransformDirtyRootCount_; ++i) {
-      Node* DirtyRoot = TransformDirtyRoots_[i];
-      if (!DirtyRoot) {
-        continue;
+    ScriptDispatchList& List = TickGroups_[ScriptNode->ScriptTickGroup_].Lists[L];
+    std::vector<Node*>& Group = List.Groups[ScriptNode->ScriptClass_];
+    uint32_t Slot = ScriptNode->ScriptListSlots_[L];
+
+    if (DispatchingScripts_) {
+      // Swapping would move an undispatched entry behind the loop index
+      Group[Slot] = nullptr;
+      ScriptNodeHoles_++;
+    } else {
+      Node* Moved = Group.back();
+      Group[Slot] = Moved;
+      Moved->ScriptListSlots_[L] = Slot;
+      Group.pop_back();
+
+      if (L == ThrottledUpdateList) {
+        std::vector<ScriptTickState>& States = List.TickStates[ScriptNode->ScriptClass_];
+        States[Slot] = States.back();
+        States.pop_back();
       }
-
-      // Determine parent world matrix for this dirty root
-      const Mat4& ParentMatrix = DirtyRoot->GetParent()
-        ? DirtyRoot->GetParent()->GetWorldTransform()
-        : IdentityMatrix;
-
-      UpdateNodeTransforms(DirtyRoot, ParentMatrix, false);
-
-      // Clear the InDirtyList_ flag
-      DirtyRoot->InDirtyList_ = false;
     }
-
-    // Clear the dirty roots array
-    memset(TransformDirtyRoots_, 0, TransformDirtyRootCount_ * sizeof(Node*));
-    TransformDirtyRootCount_ = 0;
+    ScriptNode->ScriptListSlots_[L] = Node::NotInList;
+    List.Count--;
   }
 
-  // Steps 2-3: Script processing -- skipped when scripts are disabled (Edit mode)
-  if (!ScriptsEnabled_) {
+  ScriptNode->InScriptList_ = false;
+  ScriptNode->ScriptLists_ = 0;
+  ActiveScriptCount_--;
+}
+
+void SceneTree::OnScriptDispatchChanged(Node* ScriptNode)
+{
+  if (!ScriptNode || !ScriptNode->InScriptList_) {
     return;
   }
 
-  // Step 2: Process pending script initializations (bottom-up order)
-  ProcessPendingInits();
-
-  // Step 3: Dispatch OnUpdate to all scripted nodes
-  // Check IsNodeEffectivelyActive to preserve subtree-skip behavior:
-  // if a parent is inactive, its children are also skipped.
-  for (uint32_t i = 0; i < ScriptNodeCount_; ++i) {
-    Node* ScriptNode = ScriptNodes_[i];
-    if (!ScriptNode || !IsNodeEffectivelyActive(ScriptNode)) {
-      continue;
-    }
-
-    ScriptBase* Script = ScriptNode->GetScript();
-    if (Script && Script->IsInitialized_ && Script->IsProcessing()) {
-      Script->MainCamera = MainCamera_;
-      Script->MouseDelta = MouseDelta_;
-  
-      Script->Tree_ = this;
-      Script->OnUpdate(DeltaT);
-    }
-  }
+  UnregisterScriptNode(ScriptNode);
+  RegisterScriptNode(ScriptNode);
 }
 
-void SceneTree::FixedUpdate(float DeltaT)
+void SceneTree::OnScriptTickChanged(Node* ScriptNode)
 {
-  if (!Root_ || !ScriptsEnabled_) {
+  if (!ScriptNode || !ScriptNode->InScriptList_) {
     return;
   }
 
-  // Dispatch OnFixedUpdate to all scripted nodes
-  for (uint32_t i = 0; i < ScriptNodeCount_; ++i) {
-    Node* ScriptNode = ScriptNodes_[i];
-    if (!ScriptNode || !IsNodeEffectivelyActive(ScriptNode)) {
-      continue;
-    }
-
-    ScriptBase* Script = ScriptNode->GetScript();
-    if (Script && Script->IsInitialized_ && Script->IsPhysicsProcessing()) {
-      Script->MainCamera = MainCamera_;
-      Script->MouseDelta = MouseDelta_;
-  
-      Script->Tree_ = this;
-      Script->OnFixedUpdate(DeltaT);
-    }
-  }
+  OnScriptDispatchChanged(ScriptNode);
+  RestartScriptTick(ScriptNode);
 }
 
-void SceneTree::LateUpdate(float DeltaT)
+void SceneTree::OnScriptNodeActiveChanged(Node* ScriptNode)
 {
-  if (!Root_ || !ScriptsEnabled_) {
+  ScriptBase* Script = ScriptNode->GetScript();
+  if (!Script || !Script->IsInitialized_) {
     return;
   }
 
-  // Dispatch OnLateUpdate to all scripted nodes
-  for (uint32_t i = 0; i < ScriptNodeCount_; ++i) {
-    Node* ScriptNode = ScriptNodes_[i];
-    if (!ScriptNode || !IsNodeEffectivelyActive(ScriptNode)) {
-      continue;
-    }
-
-    ScriptBase* Script = ScriptNode->GetScript();
-    if (Script && Script->IsInitialized_) {
-      Script->MainCamera = MainCamera_;
-      Script->MouseDelta = MouseDelta_;
-  
-      Script->Tree_ = this;
-      Script->OnLateUpdate(DeltaT);
-    }
+  if (ScriptNode->ActiveInHierarchy_) {
+    RegisterScriptNode(ScriptNode);
+  } else {
+    UnregisterScriptNode(ScriptNode);
   }
 }
 
-//=============================================================================
-// Private Helpers
-//=============================================================================
-
-void SceneTree::FireEvent(AxEventType Type, Node* Sender,
-                          void* Data, size_t DataSize)
+void SceneTree::CompactScriptNodes()
 {
-  if (!Bus_) {
+  if (ScriptNodeHoles_ == 0) {
     return;
   }
 
-  AxEvent Event;
-  Event.Type = Type;
-  Event.Sender = Sender;
-  Event.Data = Data;
-  Event.DataSize = DataSize;
+  // Close the holes in place, renumbering the slots of nodes that move
+  for (TickGroupData& Tick : TickGroups_) {
+    for (uint32_t L = 0; L < ScriptListCount; ++L) {
+      ScriptDispatchList& List = Tick.Lists[L];
+      for (size_t g = 0; g < List.Groups.size(); ++g) {
+        std::vector<Node*>& Group = List.Groups[g];
+        std::vector<ScriptTickState>* States =
+          (L == ThrottledUpdateList) ? &List.TickStates[g] : nullptr;
+
+        uint32_t Kept = 0;
+        for (size_t i = 0; i < Group.size(); ++i) {
+          if (Group[i]) {
+            Group[i]->ScriptListSlots_[L] = Kept;
+            if (States) {
+              (*States)[Kept] = (*States)[i];
+            }
+            Group[Kept++] = Group[i];
+          }
+        }
+        Group.resize(Kept);
+        if (States) {
+          States->resize(Kept);
+        }
+      }
+    }
+  }
+  ScriptNodeHoles_ = 0;
+}
 
-  Bus_->Publish(Event);
+uint32_t SceneTree::ScriptClassIndex(const ScriptBase* Script)
+{
+  auto Result = ScriptClasses_.try_emplace(std::type_index(typeid(*Script)),
+                                           static_cast<uint32_t>(ScriptClasses_.size()));
+  return (Result.first->second);
 }
 
-Node* SceneTree::FindNodeRecursive(Node* Current, std::string_view NodeName)
+uint32_t SceneTree::DispatchListIndex(ScriptCallbacks Callback)
 {
-  if (!Current || NodeName.empty()) {
-    return (nullptr);
+  switch (Callback) {
+    case ScriptCallbacks::Update:      return (UpdateList);
+    case ScriptCallbacks::FixedUpdate: return (FixedUpdateList);
+    case ScriptCallbacks::LateUpdate:  return (LateUpdateList);
+    default:                           return (ScriptListCount);
   }
+}
 
-  if (Current->GetName() == NodeName) {
-    return (Current);
+uint32_t SceneTree::GetDispatchCount(ScriptCallbacks Callback) const
+{
+  uint32_t Index = DispatchListIndex(Callback);
+  if (Index >= ScriptListCount) {
+    return (0);
   }
 
-  // Search children
-  Node* Child = Current->GetFirstChild();
-  while (Child) {
-    Node* Found = FindNodeRecursive(Child, NodeName);
-    if (Found) {
-      return (Found);
+  uint32_t Count = 0;
+  for (const TickGroupData& Tick : TickGroups_) {
+    Count += Tick.Lists[Index].Count;
+    if (Index == UpdateList) {
+      Count += Tick.Lists[ThrottledUpdateList].Count + Tick.Lists[OwnNodeUpdateList].Count +
+               Tick.Lists[ReadOnlyUpdateList].Count;
     }
-    Child = Child->GetNextSibling();
   }
-
-  return (nullptr);
+  return (Count);
 }
 
-uint32_t SceneTree::CountNodesInSubtree(Node* SubtreeRoot)
+uint32_t SceneTree::GetDispatchGroupCount(ScriptCallbacks Callback) const
 {
-  if (!SubtreeRoot) {
+  uint32_t Index = DispatchListIndex(Callback);
+  if (Index >= ScriptListCount) {
     return (0);
   }
 
-  uint32_t Count = 1;
-  Node* Child = SubtreeRoot->GetFirstChild();
-  while (Child) {
-    Count += CountNodesInSubtree(Child);
-    Child = Child->GetNextSibling();
+  uint32_t Count = 0;
+  for (const TickGroupData& Tick : TickGroups_) {
+    for (const std::vector<Node*>& Group : Tick.Lists[Index].Groups) {
+      Count += Group.empty() ? 0 : 1;
+    }
+    if (Index == UpdateList) {
+      for (uint32_t L : {ThrottledUpdateList, OwnNodeUpdateList, ReadOnlyUpdateList}) {
+        for (const std::vector<Node*>& Group : Tick.Lists[L].Groups) {
+          Count += Group.empty() ? 0 : 1;
+        }
+      }
+    }
   }
+  return (Count);
+}
 
+uint32_t SceneTree::GetParallelScriptCount() const
+{
+  uint32_t Count = 0;
+  for (const TickGroupData& Tick : TickGroups_) {
+    Count += Tick.Lists[OwnNodeUpdateList].Count + Tick.Lists[ReadOnlyUpdateList].Count;
+  }
   return (Count);
 }
 
-void SceneTree::SetOwningTreeRecursive(Node* Target, SceneTree* Tree)
+template<typename FnType>
+void SceneTree::DispatchScripts(uint32_t ListIndex, FnType&& Fn)
 {
-  if (!Target) {
-    return;
+  SortTickGroups();
+
+  // Indexed loops: a callback may register scripts, appending to a group or
+  // adding a new class group, and unregistering leaves a nullptr hole
+  DispatchingScripts_ = true;
+  for (size_t t = 0; t < TickGroupOrder_.size(); ++t) {
+    ScriptDispatchList& List = TickGroups_[TickGroupOrder_[t]].Lists[ListIndex];
+    for (size_t g = 0; g < List.Groups.size(); ++g) {
+      for (size_t i = 0; i < List.Groups[g].size(); ++i) {
+        Node* ScriptNode = List.Groups[g][i];
+        if (ScriptNode) {
+          Fn(ScriptNode->GetScript());
+        }
+      }
+    }
   }
+  DispatchingScripts_ = false;
+  CompactScriptNodes();
+}
 
-  Target->OwningTree_ = Tree;
+//=============================================================================
+// Tick Groups
+//=============================================================================
 
-  Node* Child = Target->GetFirstChild();
-  while (Child) {
-    SetOwningTreeRecursive(Child, Tree);
-    Child = Child->GetNextSibling();
-  }
+uint32_t SceneTree::AddTickGroup(std::string_view GroupName, int32_t Order)
+{
+  uint32_t Existing = FindTickGroup(GroupName);
+  if (Existing != InvalidTickGroup) {
+    TickGroups_[Existing].Order = Order;
+    TickGroupOrderDirty_ = true;
+    return (Existing);
+  }
+
+  uint32_t ID = static_cast<uint32_t>(TickGroups_.size());
+  TickGroups_.emplace_back();
+  TickGroups_.back().Name = GroupName;
+  TickGroups_.back().Order = Order;
+  TickGroupOrderDirty_ = true;
+  return (ID);
 }
 
-void SceneTree::DestroySubtreeBottomUp(Node* Target)
+uint32_t SceneTree::FindTickGroup(std::string_view GroupName) const
 {
-  if (!Target) {
-    return;
+  for (size_t i = 0; i < TickGroups_.size(); ++i) {
+    if (TickGroups_[i].Name == GroupName) {
+      return (static_cast<uint32_t>(i));
+    }
   }
+  return (InvalidTickGroup);
+}
 
-  // Destroy children first (bottom-up)
-  while (Target->GetFirstChild()) {
-    DestroySubtreeBottomUp(Target->GetFirstChild());
+void SceneTree::SetTickGroupBudget(uint32_t Group, uint32_t Microseconds)
+{
+  if (Group >= TickGroups_.size()) {
+    return;
   }
 
-  // Detach from parent before deleting
-  if (Target->GetParent()) {
-    Target->GetParent()->RemoveChild(Target);
+  TickGroupData& Tick = TickGroups_[Group];
+  bool HadBudget = Tick.BudgetMicros > 0;
+  Tick.BudgetMicros = Microseconds;
+  if (HadBudget != (Microseconds > 0)) {
+    RefileTickGroup(Group);
   }
-
-  delete Target;
 }
 
-//=============================================================================
-// Typed Node Tracking
-//=============================================================================
-
-void SceneTree::RegisterTypedNode(Node* NewNode)
+void SceneTree::SetTickGroupLOD(uint32_t Group, const TickLODSettings& Settings)
 {
-  if (!NewNode) {
+  if (Group >= TickGroups_.size()) {
     return;
   }
 
-  switch (NewNode->GetType()) {
-    case NodeType::MeshInstance:
-      if (MeshInstanceCount_ < AX_SCENE_TREE_MAX_TYPED_NODES) {
-        MeshInstances_[MeshInstanceCount_++] = NewNode;
-      }
-      break;
-    case NodeType::Camera:
-      if (CameraNodeCount_ < AX_SCENE_TREE_MAX_TYPED_NODES) {
-        CameraNodes_[CameraNodeCount_++] = NewNode;
-      }
-      break;
-    case NodeType::Light:
-      if (LightNodeCount_ < AX_SCENE_TREE_MAX_TYPED_NODES) {
-        LightNodes_[LightNodeCount_++] = NewNode;
-      }
-      break;
-    default:
-      break;
+  TickGroupData& Tick = TickGroups_[Group];
+  bool HadLOD = Tick.HasLOD;
+  Tick.LOD = Settings;
+  Tick.HasLOD = (Settings.FarScale > 1 && Settings.FarDistance > Settings.NearDistance) ||
+                Settings.OffscreenScale > 1;
+  if (Tick.HasLOD != HadLOD) {
+    RefileTickGroup(Group);
   }
 }
 
-void SceneTree::UnregisterTypedNode(Node* Target)
+bool SceneTree::IsThrottled(uint32_t Group, const ScriptBase* Script) const
 {
-  if (!Target) {
-    return;
-  }
+  const TickGroupData& Tick = TickGroups_[Group];
+  return (Tick.HasLOD || Tick.BudgetMicros > 0 ||
+          Script->TickInterval_ > 1 || Script->TickIntervalSeconds_ > 0.0f);
+}
 
-  auto RemoveFromArray = [](Node** Array, uint32_t& Count, Node* Target) {
-    for (uint32_t i = 0; i < Count; ++i) {
-      if (Array[i] == Target) {
-        // Shift remaining elements
-        for (uint32_t j = i; j < Count - 1; ++j) {
-          Array[j] = Array[j + 1];
+void SceneTree::RefileTickGroup(uint32_t Group)
+{
+  // Collected first: re-registering edits the lists being walked
+  std::vector<Node*> Refile;
+  for (uint32_t L : {UpdateList, ThrottledUpdateList, OwnNodeUpdateList, ReadOnlyUpdateList}) {
+    for (const std::vector<Node*>& Entry : TickGroups_[Group].Lists[L].Groups) {
+      for (Node* ScriptNode : Entry) {
+        if (ScriptNode) {
+          Refile.push_back(ScriptNode);
         }
-        Count--;
-        return;
       }
     }
-  };
+  }
 
-  switch (Target->GetType()) {
-    case NodeType::MeshInstance:
-      RemoveFromArray(MeshInstances_, MeshInstanceCount_, Target);
-      break;
-    case NodeType::Camera:
-      RemoveFromArray(CameraNodes_, CameraNodeCount_, Target);
-      break;
-    case NodeType::Light:
-      RemoveFromArray(LightNodes_, LightNodeCount_, Target);
-      break;
-    default:
-      break;
+  for (Node* ScriptNode : Refile) {
+    OnScriptDispatchChanged(ScriptNode);
+    RestartScriptTick(ScriptNode);
   }
+  TickGroups_[Group].CursorGroup = 0;
+  TickGroups_[Group].CursorEntry = 0;
 }
 
-void SceneTree::UnregisterSubtreeTypedNodes(Node* Target)
+void SceneTree::RestartScriptTick(Node* ScriptNode)
 {
-  if (!Target) {
+  if (!(ScriptNode->ScriptLists_ & (1u << ThrottledUpdateList))) {
     return;
   }
 
-  // Unregister this node
-  UnregisterTypedNode(Target);
+  ScriptTickState& State = GetTickState(ScriptNode);
+  State.LastTime = Frame_.Time;
+  State.LastFrame = static_cast<uint32_t>(Frame_.FrameIndex);
+  ScheduleTick(State, ScriptNode->GetScript(), 1);
+}
 
-  // Recurse to children
-  Node* Child = Target->GetFirstChild();
-  while (Child) {
-    Node* Next = Child->GetNextSibling();
-    UnregisterSubtreeTypedNodes(Child);
-    Child = Next;
+SceneTree::ScriptTickState& SceneTree::GetTickState(const Node* ScriptNode)
+{
+  ScriptDispatchList& List = TickGroups_[ScriptNode->ScriptTickGroup_].Lists[ThrottledUpdateList];
+  return (List.TickStates[ScriptNode->ScriptClass_][ScriptNode->ScriptListSlots_[ThrottledUpdateList]]);
+}
+
+void SceneTree::ScheduleTick(ScriptTickState& State, const ScriptBase* Script, uint32_t Scale)
+{
+  if (Script->TickIntervalSeconds_ > 0.0f) {
+    State.DueFrame = State.LastFrame + 1;
+    State.DueTime = State.LastTime + static_cast<double>(Script->TickIntervalSeconds_) * Scale;
+  } else {
+    uint64_t Frames = static_cast<uint64_t>(Script->TickInterval_) * Scale;
+    State.DueFrame = State.LastFrame + static_cast<uint32_t>(std::min<uint64_t>(Frames, 0x7FFFFFFFu));
+    State.DueTime = State.LastTime;
   }
 }
 
-//=============================================================================
-// Optimization List Cleanup
-//=============================================================================
+uint32_t SceneTree::GetTickGroupUpdateCount(uint32_t Group) const
+{
+  return ((Group < TickGroups_.size()) ? TickGroups_[Group].LastUpdateCount : 0);
+}
 
-void SceneTree::UnregisterFromAllLists(Node* Target)
+void SceneTree::SortTickGroups()
 {
-  if (!Target) {
+  if (!TickGroupOrderDirty_ || DispatchingScripts_) {
     return;
   }
 
-  // Remove from TransformDirtyRoots_ (swap-with-last)
-  if (Target->InDirtyList_) {
-    for (uint32_t i = 0; i < TransformDirtyRootCount_; ++i) {
-      if (TransformDirtyRoots_[i] == Target) {
-        TransformDirtyRoots_[i] = TransformDirtyRoots_[TransformDirtyRootCount_ - 1];
-        TransformDirtyRoots_[TransformDirtyRootCount_ - 1] = nullptr;
-        TransformDirtyRootCount_--;
-        break;
-      }
-    }
-    Target->InDirtyList_ = false;
+  TickGroupOrder_.resize(TickGroups_.size());
+  for (uint32_t i = 0; i < TickGroupOrder_.size(); ++i) {
+    TickGroupOrder_[i] = i;
+  }
+  std::stable_sort(TickGroupOrder_.begin(), TickGroupOrder_.end(),
+    [this](uint32_t A, uint32_t B) {
+      return (TickGroups_[A].Order < TickGroups_[B].Order);
+    });
+  TickGroupOrderDirty_ = false;
+}
+
+uint32_t SceneTree::TickLODScale(const Node* ScriptNode, const TickLODSettings& LOD) const
+{
+  if (!LODViewValid_) {
+    return (1);
   }
 
-  // Remove from ScriptNodes_ (swap-with-last)
-  UnregisterScriptNode(Target);
+  const Mat4& World = ScriptNode->GetWorldTransform();
+  Vec3 Position(World.E[3][0], World.E[3][1], World.E[3][2]);
+  uint32_t Scale = 1;
 
-  // Remove from PendingInitScripts_ (swap-with-last)
-  for (uint32_t i = 0; i < PendingInitCount_; ++i) {
-    if (PendingInitScripts_[i] == Target) {
-      PendingInitScripts_[i] = PendingInitScripts_[PendingInitCount_ - 1];
-      PendingInitScripts_[PendingInitCount_ - 1] = nullptr;
-      PendingInitCount_--;
-      break;
+  if (LOD.FarScale > 1 && LOD.FarDistance > LOD.NearDistance) {
+    float Distance = (Position - LODCameraPos_).Length();
+    if (Distance >= LOD.FarDistance) {
+      Scale = LOD.FarScale;
+    } else if (Distance > LOD.NearDistance) {
+      float T = (Distance - LOD.NearDistance) / (LOD.FarDistance - LOD.NearDistance);
+      Scale = 1 + static_cast<uint32_t>(T * static_cast<float>(LOD.FarScale - 1));
+    }
+  }
+
+  if (LOD.OffscreenScale > Scale) {
+    Vec4 Clip = LODViewProj_ * Vec4(Position, 1.0f);
+    float Extent = Clip.W * (1.0f + LOD.OffscreenMargin);
+    bool OnScreen = (Clip.W > 0.0f) && (std::fabs(Clip.X) <= Extent) &&
+                    (std::fabs(Clip.Y) <= Extent);
+    if (!OnScreen) {
+      Scale = LOD.OffscreenScale;
     }
   }
+
+  return (Scale);
 }
 
-void SceneTree::UnregisterSubtreeFromAllLists(Node* Target)
+bool SceneTree::TickScript(Node* ScriptNode, ScriptTickState& State, uint32_t Group)
 {
-  if (!Target) {
-    return;
+  // Tolerance for deltas that sum to a seconds interval in float steps
+  uint32_t FrameIndex = static_cast<uint32_t>(Frame_.FrameIndex);
+  if (static_cast<int32_t>(FrameIndex - State.DueFrame) < 0 ||
+      Frame_.Time + 1.0e-6 < State.DueTime) {
+    return (false);
   }
 
-  // Unregister this node from all optimization lists
-  UnregisterFromAllLists(Target);
+  // Exact delta for the every-frame case, accumulated time otherwise
+  float DeltaT = (FrameIndex - State.LastFrame == 1)
+    ? Frame_.DeltaT
+    : static_cast<float>(Frame_.Time - State.LastTime);
 
-  // Recurse to children
+  State.LastTime = Frame_.Time;
+  State.LastFrame = FrameIndex;
+
+  const TickGroupData& Tick = TickGroups_[Group];
+  ScriptBase* Script = ScriptNode->GetScript();
+  ScheduleTick(State, Script, Tick.HasLOD ? TickLODScale(ScriptNode, Tick.LOD) : 1);
+
+  // A paused script does not build up time to catch up on. State is not
+  // touched after OnUpdate, which may register scripts and grow its list.
+  if (!Script->IsProcessing()) {
+    return (false);
+  }
+  Script->OnUpdate(DeltaT);
+  return (true);
+}
+
+void SceneTree::DispatchUpdate()
+{
+  SortTickGroups();
+
+  // Camera data for LOD, shared by every group that uses it
+  LODViewValid_ = false;
+  CameraNode* Camera = Frame_.MainCamera;
+  if (Camera) {
+    for (const TickGroupData& Tick : TickGroups_) {
+      if (Tick.HasLOD && Tick.Lists[ThrottledUpdateList].Count > 0) {
+        const Mat4& CameraWorld = Camera->GetWorldTransform();
+        LODCameraPos_ = Vec3(CameraWorld.E[3][0], CameraWorld.E[3][1], CameraWorld.E[3][2]);
+        LODViewProj_ = Camera->GetProjectionMatrix() * Camera->GetViewMatrix();
+        LODViewValid_ = true;
+        break;
+      }
+    }
+  }
+
+  using BudgetClock = std::chrono::steady_clock;
+  const float DeltaT = Frame_.DeltaT;
+
+  DispatchingScripts_ = true;
+  for (size_t t = 0; t < TickGroupOrder_.size(); ++t) {
+    uint32_t Group = TickGroupOrder_[t];
+    uint32_t Ticked = 0;
+
+    // Readers of the scene, then writers of their own node, each in a
+    // phase of their own so no script sees another's half-written node
+    Ticked += RunParallelPhase(Group, ReadOnlyUpdateList);
+    Ticked += RunParallelPhase(Group, OwnNodeUpdateList);
+    TickGroupData& Tick = TickGroups_[Group];
+
+    // Every-frame scripts on this thread: no interval or LOD checks.
+    // Indexed loops: see DispatchScripts.
+    ScriptDispatchList& Plain = Tick.Lists[UpdateList];
+    for (size_t g = 0; g < Plain.Groups.size(); ++g) {
+      for (size_t i = 0; i < Plain.Groups[g].size(); ++i) {
+        Node* ScriptNode = Plain.Groups[g][i];
+        if (!ScriptNode) {
+          continue;
+        }
+
+        ScriptBase* Script = ScriptNode->GetScript();
+        if (Script->IsProcessing()) {
+          Script->OnUpdate(DeltaT);
+          Ticked++;
+        }
+      }
+    }
+
+    ScriptDispatchList& List = Tick.Lists[ThrottledUpdateList];
+    if (Tick.BudgetMicros == 0) {
+      for (size_t g = 0; g < List.Groups.size(); ++g) {
+        for (size_t i = 0; i < List.Groups[g].size(); ++i) {
+          Node* ScriptNode = List.Groups[g][i];
+          if (ScriptNode && TickScript(ScriptNode, List.TickStates[g][i], Group)) {
+            Ticked++;
+          }
+        }
+      }
+      Tick.LastUpdateCount = Ticked;
+      continue;
+    }
+
+    // Time-sliced: resume at the cursor and visit each entry at most once
+    size_t Entries = 0;
+    for (const std::vector<Node*>& Entry : List.Groups) {
+      Entries += Entry.size();
+    }
+
+    BudgetClock::time_point Deadline =
+      BudgetClock::now() + std::chrono::microseconds(Tick.BudgetMicros);
+    size_t g = Tick.CursorGroup;
+    size_t i = Tick.CursorEntry;
+
+    for (size_t Visited = 0; Visited < Entries; ++Visited) {
+      // Step past exhausted class groups, wrapping to the first
+      while (g >= List.Groups.size() || i >= List.Groups[g].size()) {
+        g = (g >= List.Groups.size()) ? 0 : g + 1;
+        i = 0;
+      }
+
+      Node* ScriptNode = List.Groups[g][i];
+      ScriptTickState& State = List.TickStates[g][i++];
+      if (ScriptNode && TickScript(ScriptNode, State, Group)) {
+        Ticked++;
+        if (BudgetClock::now() >= Deadline) {
+          break;
+        }
+      }
+    }
+
+    Tick.CursorGroup = static_cast<uint32_t>(g);
+    Tick.CursorEntry = static_cast<uint32_t>(i);
+    Tick.LastUpdateCount = Ticked;
+  }
+  DispatchingScripts_ = false;
+  CompactScriptNodes();
+}
+
+uint32_t SceneTree::RunParallelPhase(uint32_t Group, uint32_t ListIndex)
+{
+  ScriptDispatchList& List = TickGroups_[Group].Lists[ListIndex];
+  if (List.Count == 0) {
+    return (0);
+  }
+
+  // A snapshot, so the entries stay put while workers read them
+  ParallelNodes_.clear();
+  for (const std::vector<Node*>& Entry : List.Groups) {
+    for (Node* ScriptNode : Entry) {
+      if (ScriptNode) {
+        ParallelNodes_.push_back(ScriptNode);
+      }
+    }
+  }
+
+  const float DeltaT = Frame_.DeltaT;
+  std::atomic<uint32_t> Ticked{0};
+  auto RunRange = [this, DeltaT, &Ticked](uint32_t Begin, uint32_t End) {
+    uint32_t Local = 0;
+    for (uint32_t i = Begin; i < End; ++i) {
+      ScriptBase* Script = ParallelNodes_[i]->GetScript();
+      if (Script->IsProcessing()) {
+        Script->OnUpdate(DeltaT);
+        Local++;
+      }
+    }
+    Ticked.fetch_add(Local, std::memory_order_relaxed);
+  };
+
+  ParallelPhase_ = true;
+  uint32_t Count = static_cast<uint32_t>(ParallelNodes_.size());
+  if (WorkerPool_) {
+    WorkerPool_->ParallelFor(Count, ParallelScriptBatch, RunRange);
+  } else {
+    RunRange(0, Count);
+  }
+  ParallelPhase_ = false;
+
+  // Sync point
+  FlushQueuedCommands();
+  return (Ticked.load(std::memory_order_relaxed));
+}
+
+//=============================================================================
+// Pending Init Processing
+//=============================================================================
+
+void SceneTree::ProcessPendingInits()
+{
+  if (PendingInitCount_ == 0) {
+    return;
+  }
+
+  // Deepest bucket first: children are initialized before parents. OnInit
+  // may attach scripts to new nodes; those at the current depth or above
+  // are reached in this sweep, deeper ones in the next.
+  ProcessingPendingInits_ = true;
+  while (PendingInitCount_ > 0) {
+    for (size_t Depth = PendingInitsByDepth_.size(); Depth-- > 0;) {
+      // Indexed loop and re-fetched bucket: OnInit may append to it
+      for (size_t i = 0; i < PendingInitsByDepth_[Depth].size(); ++i) {
+        Node* PendingNode = PendingInitsByDepth_[Depth][i];
+        if (!PendingNode) {
+          continue;
+        }
+
+        PendingNode->PendingInitSlot_ = Node::NotInList;
+        PendingInitCount_--;
+
+        ScriptBase* Script = PendingNode->GetScript();
+        if (!Script || Script->IsInitialized_) {
+          continue;
+        }
+
+        // Scripts read the shared frame context through Tree_; dispatch
+        // writes nothing into scripts after this
+        Script->Tree_ = this;
+        Script->IsInitialized_ = true;
+        Script->OnInit();
+#if AX_FRAME_STATS
+        Stats_.InitScripts++;
+#endif
+
+        // OnEnable fires immediately after OnInit only if the node is active
+        if (PendingNode->IsActive()) {
+          Script->OnEnable();
+        }
+
+        // Move to the dispatch lists for per-frame dispatch; inactive
+        // subtrees join them when they are re-activated
+        if (PendingNode->ActiveInHierarchy_) {
+          RegisterScriptNode(PendingNode);
+        }
+      }
+
+      // Keeps capacity for the next spawn burst
+      PendingInitsByDepth_[Depth].clear();
+    }
+  }
+  ProcessingPendingInits_ = false;
+}
+
+//=============================================================================
+// Frame Loop Methods
+//=============================================================================
+
+void SceneTree::Update(float DeltaT)
+{
+  if (!Root_) {
+    return;
+  }
+
+  // Changes queued since the last sync point (in Edit mode too), applied
+  // first so new and moved nodes are placed by this frame's flush
+  FlushQueuedCommands();
+
+  // Close the holes destroyed nodes left in the typed-node arrays, so
+  // systems reading them this frame see dense arrays
+  for (uint32_t Index = 0; Index < NodeTypeCount; ++Index) {
+    CompactTypedNodes(Index);
+  }
+
+  // Step 1: Flush dirty transforms (ALWAYS runs, even in Edit mode)
+  // Only nodes whose transforms changed since last frame, and their
+  // descendants, are recomputed. On initial load every node is dirty and
+  // the pass degrades gracefully to a full linear sweep.
+  {
+    FramePhaseTimer Timer(Stats_, FramePhase::TransformFlush);
+    FlushTransforms();
+  }
+#if AX_FRAME_STATS
+  Stats_.DirtyRoots += Hierarchy_.GetLastStats().DirtyRoots;
+  Stats_.NodesRecomputed += Hierarchy_.GetLastStats().Recomputed;
+#endif
+
+  // Steps 2-3: Script processing -- skipped when scripts are disabled (Edit mode)
+  if (!ScriptsEnabled_) {
+    return;
+  }
+
+  // Publish this frame's state once; scripts read it through GetFrame()
+  Frame_.DeltaT = DeltaT;
+  Frame_.FrameIndex++;
+  Frame_.Time += DeltaT;
+
+  // Step 2: Process pending script initializations (bottom-up order)
+  {
+    FramePhaseTimer Timer(Stats_, FramePhase::PendingInits);
+    ProcessPendingInits();
+  }
+
+  FramePhaseTimer ScriptsTimer(Stats_, FramePhase::Scripts);
+
+  // Step 3: Dispatch OnUpdate to scripts that implement it and are due.
+  // Nodes in inactive subtrees are not in the list at all.
+  DispatchUpdate();
+#if AX_FRAME_STATS
+  for (const TickGroupData& Tick : TickGroups_) {
+    Stats_.UpdateScripts += Tick.LastUpdateCount;
+  }
+#endif
+
+  // Step 4: Fire due timers, then advance tweens. Neither visits anything
+  // that is not due or running.
+  Timers_.Step(Frame_.Time);
+  Tweens_.Step(DeltaT);
+
+  // Step 5: Resume script tasks whose wait ended. Sleeping tasks sit in
+  // timer wheels and signal connections and are not visited.
+  Tasks_.Step(Frame_.FrameIndex, Frame_.Time);
+}
+
+void SceneTree::FixedUpdate(float DeltaT)
+{
+  if (!Root_ || !ScriptsEnabled_) {
+    return;
+  }
+
+  Frame_.FixedDeltaT = DeltaT;
+
+  // Dispatch OnFixedUpdate to scripts that implement it
+#if AX_FRAME_STATS
+  uint32_t& Count = Stats_.FixedUpdateScripts;
+#endif
+  DispatchScripts(FixedUpdateList, [&](ScriptBase* Script) {
+    if (Script->IsPhysicsProcessing()) {
+      Script->OnFixedUpdate(DeltaT);
+#if AX_FRAME_STATS
+      Count++;
+#endif
+    }
+  });
+}
+
+void SceneTree::LateUpdate(float DeltaT)
+{
+  if (!Root_ || !ScriptsEnabled_) {
+    return;
+  }
+
+  // Dispatch OnLateUpdate to scripts that implement it
+#if AX_FRAME_STATS
+  uint32_t& Count = Stats_.LateUpdateScripts;
+#endif
+  DispatchScripts(LateUpdateList, [&](ScriptBase* Script) {
+    Script->OnLateUpdate(DeltaT);
+#if AX_FRAME_STATS
+    Count++;
+#endif
+  });
+}
+
+//=============================================================================
+// Private Helpers
+//=============================================================================
+
+void SceneTree::FireEvent(AxEventType Type, Node* Sender,
+                          void* Data, size_t DataSize)
+{
+  if (!Bus_) {
+    return;
+  }
+
+  AxEvent Event;
+  Event.Type = Type;
+  Event.Sender = Sender;
+  Event.Data = Data;
+  Event.DataSize = DataSize;
+
+  Bus_->Publish(Event);
+}
+
+uint32_t SceneTree::CountNodesInSubtree(Node* SubtreeRoot)
+{
+  if (!SubtreeRoot) {
+    return (0);
+  }
+
+  uint32_t Count = 1;
+  Node* Child = SubtreeRoot->GetFirstChild();
+  while (Child) {
+    Count += CountNodesInSubtree(Child);
+    Child = Child->GetNextSibling();
+  }
+
+  return (Count);
+}
+
+//=============================================================================
+// Lookup Indices
+//=============================================================================
+
+void SceneTree::IndexNode(Node* Target)
+{
+  uint32_t ID = Target->NodeID_;
+  if (ID >= NodesByID_.size()) {
+    NodesByID_.resize(ID + 1, nullptr);
+  }
+  NodesByID_[ID] = Target;
+
+  auto It = NameIndex_.find(Target->Name_);
+  if (It == NameIndex_.end()) {
+    It = NameIndex_.emplace(Target->Name_, std::vector<Node*>()).first;
+  }
+  Target->NameIndexSlot_ = static_cast<uint32_t>(It->second.size());
+  It->second.push_back(Target);
+
+  StructureVersion_++;
+}
+
+void SceneTree::UnindexNode(Node* Target)
+{
+  // Subtrees may be unregistered more than once during DestroyNode, and may
+  // contain standalone children that were never indexed
+  uint32_t ID = Target->NodeID_;
+  if (ID >= NodesByID_.size() || NodesByID_[ID] != Target) {
+    return;
+  }
+  NodesByID_[ID] = nullptr;
+
+  // Swap-with-last removal from the name bucket
+  auto It = NameIndex_.find(Target->Name_);
+  if (It != NameIndex_.end()) {
+    std::vector<Node*>& Bucket = It->second;
+    Node* Moved = Bucket.back();
+    Bucket[Target->NameIndexSlot_] = Moved;
+    Moved->NameIndexSlot_ = Target->NameIndexSlot_;
+    Bucket.pop_back();
+
+    if (Bucket.empty()) {
+      NameIndex_.erase(It);
+    }
+  }
+
+  StructureVersion_++;
+}
+
+//=============================================================================
+// Node Handles
+//=============================================================================
+
+void SceneTree::AllocateHandle(Node* Target)
+{
+  uint32_t Index = 0;
+  if (!FreeHandleSlots_.empty()) {
+    Index = FreeHandleSlots_.back();
+    FreeHandleSlots_.pop_back();
+  } else {
+    Index = static_cast<uint32_t>(HandleSlots_.size());
+    HandleSlots_.push_back({nullptr, 0});
+  }
+
+  // A tree-wide counter rather than a per-slot one, so a generation is
+  // never issued twice (see RestoreHandles)
+  uint32_t Generation = ++HandleGeneration_;
+  HandleSlots_[Index] = {Target, Generation};
+  Target->Handle_ = {Index, Generation};
+}
+
+void SceneTree::ReleaseHandle(Node* Target)
+{
+  // Called again for subtrees already unregistered during DestroyNode
+  NodeHandle Handle = Target->Handle_;
+  if (Resolve(Handle) != Target) {
+    return;
+  }
+
+  HandleSlots_[Handle.Index] = {nullptr, 0};
+  FreeHandleSlots_.push_back(Handle.Index);
+  Target->Handle_ = NodeHandle();
+}
+
+NodeHandle SceneTree::FindNodeHandle(std::string_view NodeName)
+{
+  Node* Found = FindNode(NodeName);
+  return (Found ? Found->Handle_ : NodeHandle());
+}
+
+void SceneTree::CaptureHandles(std::vector<NodeHandle>& OutHandles) const
+{
+  Node* Top = static_cast<Node*>(Root_);
+  for (Node* Current = Top; Current; Current = NextPreOrder(Current, Top)) {
+    OutHandles.push_back(Current->Handle_);
+  }
+}
+
+bool SceneTree::RestoreHandles(const std::vector<NodeHandle>& Handles, uint32_t MinGeneration)
+{
+  std::vector<Node*> Nodes;
+  Nodes.reserve(Handles.size());
+  Node* Top = static_cast<Node*>(Root_);
+  for (Node* Current = Top; Current; Current = NextPreOrder(Current, Top)) {
+    Nodes.push_back(Current);
+  }
+
+  if (Nodes.size() != Handles.size()) {
+    return (false);
+  }
+
+  // Validate before touching anything: nonzero generations, unique slots
+  uint32_t SlotCount = 0;
+  uint32_t MaxGeneration = MinGeneration;
+  for (const NodeHandle& Handle : Handles) {
+    if (Handle.IsNull()) {
+      return (false);
+    }
+    SlotCount = std::max(SlotCount, Handle.Index + 1);
+    MaxGeneration = std::max(MaxGeneration, Handle.Generation);
+  }
+
+  std::vector<HandleSlot> Slots(SlotCount, HandleSlot{nullptr, 0});
+  for (size_t i = 0; i < Handles.size(); ++i) {
+    if (Slots[Handles[i].Index].Target) {
+      return (false);
+    }
+    Slots[Handles[i].Index] = {Nodes[i], Handles[i].Generation};
+  }
+
+  for (size_t i = 0; i < Handles.size(); ++i) {
+    Nodes[i]->Handle_ = Handles[i];
+  }
+  HandleSlots_ = std::move(Slots);
+
+  // Pushed from the highest index down, so the lowest free slot is reused first
+  FreeHandleSlots_.clear();
+  for (uint32_t i = SlotCount; i-- > 0;) {
+    if (!HandleSlots_[i].Target) {
+      FreeHandleSlots_.push_back(i);
+    }
+  }
+
+  HandleGeneration_ = std::max(HandleGeneration_, MaxGeneration);
+  return (true);
+}
+
+void SceneTree::SetOwningTreeRecursive(Node* Target, SceneTree* Tree)
+{
+  if (!Target) {
+    return;
+  }
+
+  Target->OwningTree_ = Tree;
+
+  Node* Child = Target->GetFirstChild();
+  while (Child) {
+    SetOwningTreeRecursive(Child, Tree);
+    Child = Child->GetNextSibling();
+  }
+}
+
+void SceneTree::DestroyAllNodes()
+{
+  // Nodes allocated with new and parented into the tree are deleted with
+  // it. Pooled nodes are found through the pool, so the hierarchy is only
+  // walked if such a node was ever attached.
+  std::vector<Node*> HeapNodes;
+  if (HasHeapNodes_) {
+    Node* Top = static_cast<Node*>(Root_);
+    for (Node* Current = Top; Current; Current = NextPreOrder(Current, Top)) {
+      if (!Current->Pool_) {
+        HeapNodes.push_back(Current);
+      }
+    }
+  }
+
+  auto ForEachNode = [this, &HeapNodes](auto&& Fn) {
+    NodePool_.ForEachLive(Fn);
+    for (Node* HeapNode : HeapNodes) {
+      Fn(HeapNode);
+    }
+  };
+
+  // Tasks, timers and tweens first: their frames and callbacks may refer
+  // to scripts and nodes
+  Tasks_.CancelAll();
+  Timers_.Clear();
+  Tweens_.Clear();
+  Spatial_.Clear();
+
+  // Scripts next, while every node they might reach is still alive and
+  // linked. With OwningTree_ cleared, detaching skips the per-node list
+  // bookkeeping.
+  if (HasScripts_) {
+    ForEachNode([](Node* Target) {
+      Target->OwningTree_ = nullptr;
+      if (Target->Script_) {
+        delete Target->DetachScript();
+      }
+    });
+  }
+
+  // Then connections (which point across nodes) and hierarchy links, so no
+  // destructor below reaches another node
+  ForEachNode([](Node* Target) {
+    Target->OwningTree_ = nullptr;
+    Target->CleanupSignals();
+    Target->Parent_ = nullptr;
+    Target->FirstChild_ = nullptr;
+    Target->LastChild_ = nullptr;
+    Target->NextSibling_ = nullptr;
+    Target->PrevSibling_ = nullptr;
+    Target->ChildCount_ = 0;
+  });
+
+  for (Node* HeapNode : HeapNodes) {
+    delete HeapNode;
+  }
+  NodePool_.DestroyAll();
+}
+
+void SceneTree::ReleaseNode(Node* Target)
+{
+  if (Target->Pool_) {
+    Target->Pool_->Destroy(Target);
+  } else {
+    delete Target;
+  }
+}
+
+//=============================================================================
+// Typed Node Tracking
+//=============================================================================
+
+// Only the typed node classes are tracked; base, 2D/3D and root nodes are
+// too numerous and have no system that walks them by type
+static bool IsTrackedType(NodeType Type)
+{
+  return (Type >= NodeType::MeshInstance && static_cast<uint32_t>(Type) < NodeTypeCount);
+}
+
+void SceneTree::RegisterTypedNode(Node* NewNode)
+{
+  if (!NewNode || !IsTrackedType(NewNode->GetType())) {
+    return;
+  }
+
+  std::vector<Node*>& List = TypedNodes_[static_cast<uint32_t>(NewNode->GetType())];
+  NewNode->TypedSlot_ = static_cast<uint32_t>(List.size());
+  List.push_back(NewNode);
+}
+
+void SceneTree::UnregisterTypedNode(Node* Target)
+{
+  if (!Target || Target->TypedSlot_ == Node::NotInList) {
+    return;
+  }
+
+  // Leave a hole rather than erase: GetNodesByType callers rely on creation
+  // order (e.g. the first camera is the default main camera), and closing
+  // holes in one pass later keeps destroying a subtree linear
+  uint32_t Index = static_cast<uint32_t>(Target->GetType());
+  TypedNodes_[Index][Target->TypedSlot_] = nullptr;
+  TypedHoles_[Index]++;
+  Target->TypedSlot_ = Node::NotInList;
+}
+
+void SceneTree::CompactTypedNodes(uint32_t Index)
+{
+  if (TypedHoles_[Index] == 0) {
+    return;
+  }
+
+  std::vector<Node*>& List = TypedNodes_[Index];
+  uint32_t Write = 0;
+  for (Node* Entry : List) {
+    if (Entry) {
+      Entry->TypedSlot_ = Write;
+      List[Write++] = Entry;
+    }
+  }
+  List.resize(Write);
+  TypedHoles_[Index] = 0;
+}
+
+void SceneTree::UnregisterSubtreeTypedNodes(Node* Target)
+{
+  if (!Target) {
+    return;
+  }
+
+  // Unregister this node
+  UnregisterTypedNode(Target);
+
+  // Recurse to children
+  Node* Child = Target->GetFirstChild();
+  while (Child) {
+    Node* Next = Child->GetNextSibling();
+    UnregisterSubtreeTypedNodes(Child);
+    Child = Next;
+  }
+}
+
+//=============================================================================
+// Optimization List Cleanup
+//=============================================================================
+
+void SceneTree::UnregisterFromAllLists(Node* Target)
+{
+  if (!Target) {
+    return;
+  }
+
+  // End its script's tasks while emitters they wait on still resolve
+  if (Target->TaskHead_ != Node::NotInList) {
+    Tasks_.CancelOwner(Target);
+  }
+
+  // Remove from TransformDirtyRoots_ (swap-with-last)
+  uint32_t DirtySlot = Target->DirtyListSlot_;
+  if (DirtySlot != Node::NotInList) {
+    Node* Moved = TransformDirtyRoots_.back();
+    TransformDirtyRoots_[DirtySlot] = Moved;
+    Moved->DirtyListSlot_ = DirtySlot;
+    TransformDirtyRoots_.pop_back();
+    Target->DirtyListSlot_ = Node::NotInList;
+  }
+
+  // Remove from the dispatch lists (swap-with-last)
+  UnregisterScriptNode(Target);
+
+  // Remove from its pending-init bucket (swap-with-last)
+  RemovePendingInit(Target);
+
+  // Leave the spatial index, then free the transform slot (which stops
+  // watching it)
+  if (Target->SpatialProxy_ != Node::NotInList) {
+    Spatial_.Remove(Target->SpatialProxy_);
+    Target->SpatialProxy_ = Node::NotInList;
+  }
+  Hierarchy_.Remove(Target->HierarchyIndex_);
+
+  // Drop from the name index and ID table, and invalidate its handle
+  UnindexNode(Target);
+  ReleaseHandle(Target);
+}
+
+void SceneTree::UnregisterSubtreeFromAllLists(Node* Target)
+{
+  if (!Target) {
+    return;
+  }
+
+  // Unregister this node from all optimization lists
+  UnregisterFromAllLists(Target);
+
+  // Recurse to children
   Node* Child = Target->GetFirstChild();
   while (Child) {
     Node* Next = Child->GetNextSibling();
@@ -648,149 +1510,686 @@ void SceneTree::UnregisterSubtreeFromAllLists(Node* Target)
 }
 
 //=============================================================================
-// Node Management
+// Node Management
+//=============================================================================
+
+Node* SceneTree::CreateNode(std::string_view NodeName, NodeType Type, Node* Parent)
+{
+  if (ParallelPhase_) {
+    QueueCreateNode(NodeName, Type, Parent);
+    return (nullptr);
+  }
+
+  Node* NewNode = InstantiateNode(NodeName, Type, Parent);
+  if (!NewNode || NewNode == static_cast<Node*>(Root_)) {
+    return (NewNode);
+  }
+
+  // Mark the new node's transform as dirty so it gets processed
+  // on the next Update() call
+  MarkTransformDirty(NewNode);
+
+  // Fire AX_EVENT_NODE_CREATED on the scene's EventBus
+  FireEvent(AX_EVENT_NODE_CREATED, NewNode, nullptr, 0);
+
+  return (NewNode);
+}
+
+Node* SceneTree::InstantiateNode(std::string_view NodeName, NodeType Type, Node* Parent)
+{
+  if (NodeName.empty()) {
+    Log::Warn("CreateNode called with empty name");
+    return (nullptr);
+  }
+
+  Node* NewNode = nullptr;
+
+  switch (Type) {
+    case NodeType::Node2D:
+      NewNode = NodePool_.Create<Node2D>(Type, Allocator, NodeName, HashTableAPI_);
+      break;
+    case NodeType::Node3D:
+      NewNode = NodePool_.Create<Node3D>(Type, Allocator, NodeName, HashTableAPI_);
+      break;
+    case NodeType::Root:
+      // Only one root per scene; return existing root
+      return (static_cast<Node*>(Root_));
+    case NodeType::MeshInstance:
+      NewNode = NodePool_.Create<MeshInstance>(Type, Allocator, NodeName, HashTableAPI_);
+      break;
+    case NodeType::Camera:
+      NewNode = NodePool_.Create<CameraNode>(Type, Allocator, NodeName, HashTableAPI_);
+      break;
+    case NodeType::Light:
+      NewNode = NodePool_.Create<LightNode>(Type, Allocator, NodeName, HashTableAPI_);
+      break;
+    case NodeType::RigidBody:
+      NewNode = NodePool_.Create<RigidBodyNode>(Type, Allocator, NodeName, HashTableAPI_);
+      break;
+    case NodeType::Collider:
+      NewNode = NodePool_.Create<ColliderNode>(Type, Allocator, NodeName, HashTableAPI_);
+      break;
+    case NodeType::AudioSource:
+      NewNode = NodePool_.Create<AudioSourceNode>(Type, Allocator, NodeName, HashTableAPI_);
+      break;
+    case NodeType::AudioListener:
+      NewNode = NodePool_.Create<AudioListenerNode>(Type, Allocator, NodeName, HashTableAPI_);
+      break;
+    case NodeType::Animator:
+      NewNode = NodePool_.Create<AnimatorNode>(Type, Allocator, NodeName, HashTableAPI_);
+      break;
+    case NodeType::ParticleEmitter:
+      NewNode = NodePool_.Create<ParticleEmitterNode>(Type, Allocator, NodeName, HashTableAPI_);
+      break;
+    case NodeType::Sprite:
+      NewNode = NodePool_.Create<SpriteNode>(Type, Allocator, NodeName, HashTableAPI_);
+      break;
+    default:
+      NewNode = NodePool_.Create<Node>(NodeType::Base, Allocator, NodeName, Type, HashTableAPI_);
+      break;
+  }
+
+  if (!NewNode) {
+    return (nullptr);
+  }
+
+  // Assign node ID
+  NewNode->SetNodeID(NextNodeID_++);
+
+  // Set the OwningTree_ back-pointer and make the node findable
+  NewNode->OwningTree_ = this;
+  IndexNode(NewNode);
+  AllocateHandle(NewNode);
+
+  // Attach to parent (default to root if no parent specified)
+  if (Parent) {
+    Parent->AddChild(NewNode);
+  } else {
+    Root_->AddChild(NewNode);
+  }
+
+  // Append the transform slot; the parent is already placed, so
+  // parent-before-child order holds
+  Node* ParentNode = NewNode->GetParent();
+  Hierarchy_.Insert(NewNode, (ParentNode->OwningTree_ == this)
+    ? ParentNode->HierarchyIndex_
+    : TransformHierarchy::InvalidIndex);
+
+  NodeCount_++;
+
+  // Register in typed-node tracking array
+  RegisterTypedNode(NewNode);
+
+  return (NewNode);
+}
+
+void SceneTree::DestroyNode(Node* Target)
+{
+  if (!Target) {
+    return;
+  }
+
+  if (ParallelPhase_) {
+    QueueDestroyNode(Target);
+    return;
+  }
+
+  // Don't allow destroying the root
+  if (Target == static_cast<Node*>(Root_)) {
+    return;
+  }
+
+  DestroySubtree(Target, true);
+}
+
+void SceneTree::DestroySubtree(Node* Target, bool Notify)
+{
+  // Unregister all typed nodes in this subtree from tracking arrays
+  UnregisterSubtreeTypedNodes(Target);
+
+  // Unregister from all optimization lists (dirty roots, script nodes, pending inits)
+  UnregisterSubtreeFromAllLists(Target);
+
+  // Remove from all groups
+  RemoveSubtreeFromAllGroups(Target);
+
+  // Fire AX_EVENT_NODE_DESTROYED before detaching from parent
+  if (Notify) {
+    FireEvent(AX_EVENT_NODE_DESTROYED, Target, nullptr, 0);
+  }
+
+  // Clear OwningTree_ on the entire subtree to prevent Node destructors
+  // from trying to unregister from lists (we already did it above). Done
+  // before detaching, which would otherwise re-register the subtree's
+  // scripts as it becomes active outside an inactive parent.
+  SetOwningTreeRecursive(Target, nullptr);
+
+  // Detach from parent
+  Node* ParentNode = Target->GetParent();
+  if (ParentNode) {
+    ParentNode->RemoveChild(Target);
+  }
+
+  // Recursively destroy children first
+  while (Target->GetFirstChild()) {
+    DestroySubtree(Target->GetFirstChild(), Notify);
+  }
+
+  // Now safe to free the leaf node (back to its pool's free list)
+  ReleaseNode(Target);
+
+  // Update count
+  if (NodeCount_ > 0) {
+    NodeCount_--;
+  }
+}
+
+//=============================================================================
+// Queued Structural Changes
+//=============================================================================
+
+void SceneTree::QueueCreateNode(std::string_view NodeName, NodeType Type, Node* Parent,
+                                std::function<void(Node*)> OnCreated)
+{
+  Commands_.Create(NodeName, Type, Parent, std::move(OnCreated));
+}
+
+void SceneTree::QueueDestroyNode(Node* Target)
+{
+  Commands_.Destroy(Target);
+}
+
+void SceneTree::FlushQueuedCommands()
+{
+  ApplyCommands(Commands_);
+}
+
+uint32_t SceneTree::GetQueuedCommandCount() const
+{
+  return (Commands_.GetCommandCount());
+}
+
+void SceneTree::ApplyCommands(SceneCommandBuffer& Buffer)
+{
+  if (ParallelPhase_) {
+    Log::Warn("ApplyCommands called during a parallel script phase; commands stay queued");
+    return;
+  }
+
+  // Taken out first: OnCreated and the events fired during a pass may
+  // record more, which the next pass picks up
+  SceneCommandBuffer::CommandLists Lists;
+  for (;;) {
+    Buffer.Take(Lists);
+    if (Lists.GetCount() == 0) {
+      break;
+    }
+    ApplyCommandLists(Lists);
+  }
+}
+
+Node* SceneTree::ResolveCommandRef(const SceneCommandBuffer::NodeRef& Ref,
+                                   const std::vector<NodeHandle>& Created, uint32_t Epoch) const
+{
+  if (!Ref.IsPending()) {
+    return (Resolve(Ref.Handle));
+  }
+
+  // A pending ref taken before its buffer was last applied names nothing
+  if (Ref.Epoch != Epoch || Ref.Pending >= Created.size()) {
+    return (nullptr);
+  }
+  return (Resolve(Created[Ref.Pending]));
+}
+
+void SceneTree::ApplyCommandLists(SceneCommandBuffer::CommandLists& Lists)
+{
+  const uint32_t Epoch = Lists.Epoch;
+  Node* RootNode = static_cast<Node*>(Root_);
+
+  // 1. Creates, with every list they append to grown once for the batch.
+  // A parent always comes before its pending children, so one pass places
+  // them all. No per-node dirty entry: each new slot starts dirty.
+  std::vector<NodeHandle> Created;
+  Created.reserve(Lists.Creates.size());
+  if (!Lists.Creates.empty()) {
+    uint32_t TypeCounts[NodeTypeCount] = {};
+    for (const SceneCommandBuffer::CreateCommand& Command : Lists.Creates) {
+      if (IsTrackedType(Command.Type)) {
+        TypeCounts[static_cast<uint32_t>(Command.Type)]++;
+      }
+    }
+    for (uint32_t i = 0; i < NodeTypeCount; ++i) {
+      if (TypeCounts[i]) {
+        ReserveExtra(TypedNodes_[i], TypeCounts[i]);
+      }
+    }
+
+    size_t Count = Lists.Creates.size();
+    Hierarchy_.Reserve(static_cast<uint32_t>(Count));
+    ReserveExtra(HandleSlots_, Count);
+    if (NodesByID_.size() < NextNodeID_ + Count) {
+      ReserveExtra(NodesByID_, NextNodeID_ + Count - NodesByID_.size());
+    }
+  }
+
+  for (const SceneCommandBuffer::CreateCommand& Command : Lists.Creates) {
+    Node* Parent = nullptr;
+    if (!Command.Parent.IsNull()) {
+      Parent = ResolveCommandRef(Command.Parent, Created, Epoch);
+      if (!Parent) {
+        Created.push_back(NodeHandle{});
+        continue;
+      }
+    }
+
+    Node* NewNode = InstantiateNode(Command.Name, Command.Type, Parent);
+    Created.push_back(NewNode ? NewNode->GetHandle() : NodeHandle{});
+  }
+
+  // 2. Reparents. Moving a node marks its slot dirty, which brings its
+  // subtree along on the next transform flush.
+  for (const SceneCommandBuffer::ReparentCommand& Command : Lists.Reparents) {
+    Node* Child = ResolveCommandRef(Command.Child, Created, Epoch);
+    if (!Child || Child == RootNode) {
+      continue;
+    }
+
+    Node* NewParent = Command.NewParent.IsNull()
+      ? RootNode
+      : ResolveCommandRef(Command.NewParent, Created, Epoch);
+    if (!NewParent) {
+      continue;
+    }
+
+    bool IntoOwnSubtree = false;
+    for (Node* Ancestor = NewParent; Ancestor; Ancestor = Ancestor->GetParent()) {
+      if (Ancestor == Child) {
+        IntoOwnSubtree = true;
+        break;
+      }
+    }
+    if (IntoOwnSubtree) {
+      std::string Msg = "ApplyCommands: cannot move node '";
+      Msg += Child->GetName();
+      Msg += "' under its own subtree";
+      Log::Warn(Msg);
+      continue;
+    }
+
+    Child->SetParent(NewParent);
+  }
+
+  // 3. Property writes
+  for (const SceneCommandBuffer::PropertyCommand& Command : Lists.Properties) {
+    if (Node* Target = ResolveCommandRef(Command.Target, Created, Epoch)) {
+      ApplyPropertyCommand(Target, Command);
+    }
+  }
+
+  // 4. One event flush while every node involved is still alive: created
+  // nodes, then each destroyed node parents first, as DestroyNode reports
+  // them. Senders are re-resolved since subscribers may destroy nodes.
+  if (Bus_ && Bus_->GetSubscriberCount(AX_EVENT_NODE_CREATED) > 0) {
+    for (NodeHandle Handle : Created) {
+      Node* NewNode = Resolve(Handle);
+      if (NewNode && NewNode != RootNode) {
+        FireEvent(AX_EVENT_NODE_CREATED, NewNode, nullptr, 0);
+      }
+    }
+  }
+
+  if (Bus_ && Bus_->GetSubscriberCount(AX_EVENT_NODE_DESTROYED) > 0 && !Lists.Destroys.empty()) {
+    // Targets are marked by transform slot: 1 = recorded, 2 = reported.
+    // A target inside another target's subtree is reported with that one,
+    // and a target recorded twice once.
+    std::vector<uint8_t> Marks(Hierarchy_.GetSlotCount(), 0);
+    std::vector<Node*> Targets;
+    Targets.reserve(Lists.Destroys.size());
+    for (const SceneCommandBuffer::DestroyCommand& Command : Lists.Destroys) {
+      Node* Target = ResolveCommandRef(Command.Target, Created, Epoch);
+      if (Target && Target != RootNode && Target->HierarchyIndex_ < Marks.size()) {
+        Marks[Target->HierarchyIndex_] = 1;
+        Targets.push_back(Target);
+      }
+    }
+
+    std::vector<NodeHandle> Doomed;
+    for (Node* Target : Targets) {
+      bool Covered = (Marks[Target->HierarchyIndex_] == 2);
+      for (Node* Up = Target->GetParent(); Up && !Covered; Up = Up->GetParent()) {
+        Covered = (Up->HierarchyIndex_ < Marks.size() && Marks[Up->HierarchyIndex_] != 0);
+      }
+      if (Covered) {
+        continue;
+      }
+      Marks[Target->HierarchyIndex_] = 2;
+
+      for (Node* Current = Target; Current; Current = NextPreOrder(Current, Target)) {
+        Doomed.push_back(Current->GetHandle());
+      }
+    }
+
+    for (NodeHandle Handle : Doomed) {
+      if (Node* Target = Resolve(Handle)) {
+        FireEvent(AX_EVENT_NODE_DESTROYED, Target, nullptr, 0);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < Lists.Creates.size(); ++i) {
+    if (!Lists.Creates[i].OnCreated) {
+      continue;
+    }
+    if (Node* NewNode = Resolve(Created[i])) {
+      Lists.Creates[i].OnCreated(NewNode);
+    }
+  }
+
+  // 5. Destroys, already reported above
+  for (const SceneCommandBuffer::DestroyCommand& Command : Lists.Destroys) {
+    Node* Target = ResolveCommandRef(Command.Target, Created, Epoch);
+    if (Target && Target != RootNode) {
+      DestroySubtree(Target, false);
+    }
+  }
+}
+
+void SceneTree::ApplyPropertyCommand(Node* Target, const SceneCommandBuffer::PropertyCommand& Command)
+{
+  const PropDescriptor* Prop = PropertyRegistry::Get().FindProperty(Target->GetType(), Command.Name);
+  bool Matches = Prop && (Prop->Type == Command.Type ||
+                          (Prop->Type == PropType::Enum && Command.Type == PropType::String));
+  if (!Matches) {
+    std::string Msg = "ApplyCommands: node '";
+    Msg += Target->GetName();
+    Msg += "' has no property '";
+    Msg += Command.Name;
+    Msg += "' of the recorded type";
+    Log::Warn(Msg);
+    return;
+  }
+
+  switch (Prop->Type) {
+    case PropType::Float:  SetPropertyFloat(Target, Prop, Command.Float); break;
+    case PropType::Int32:  SetPropertyInt32(Target, Prop, Command.Int); break;
+    case PropType::UInt32: SetPropertyUInt32(Target, Prop, Command.UInt); break;
+    case PropType::Bool:   SetPropertyBool(Target, Prop, Command.Bool); break;
+    case PropType::String: SetPropertyString(Target, Prop, Command.Text); break;
+    case PropType::Vec3:
+      SetPropertyVec3(Target, Prop, Vec3(Command.Vector.X, Command.Vector.Y, Command.Vector.Z));
+      break;
+    case PropType::Vec4:   SetPropertyVec4(Target, Prop, Command.Vector); break;
+    case PropType::Enum:   SetPropertyEnum(Target, Prop, Command.Text.c_str()); break;
+    default: break;
+  }
+}
+
+//=============================================================================
+// Prefab Instantiation
 //=============================================================================
 
-Node* SceneTree::CreateNode(std::string_view NodeName, NodeType Type, Node* Parent)
+static bool IsIdentityLocal(const PrefabTransform& Local)
 {
-  if (NodeName.empty()) {
-    Log::Warn("CreateNode called with empty name");
-    return (nullptr);
+  const Vec3& T = Local.Translation;
+  const Quat& R = Local.Rotation;
+  const Vec3& S = Local.Scale;
+  return (T.X == 0.0f && T.Y == 0.0f && T.Z == 0.0f &&
+          R.X == 0.0f && R.Y == 0.0f && R.Z == 0.0f && R.W == 1.0f &&
+          S.X == 1.0f && S.Y == 1.0f && S.Z == 1.0f);
+}
+
+uint32_t SceneTree::InstantiateBatch(const PrefabTemplate& Template, uint32_t Count,
+                                     const PrefabTransform* Transforms, Node* Parent,
+                                     Node** OutRoots)
+{
+  if (ParallelPhase_) {
+    Log::Warn("InstantiateBatch called inside a parallel script phase; nothing created");
+    return (0);
+  }
+  if (Template.IsEmpty() || Count == 0) {
+    return (0);
   }
 
-  Node* NewNode = nullptr;
+  const std::vector<PrefabTemplate::NodeRecord>& Records = Template.GetRecords();
+  const uint32_t RecordCount = Template.GetNodeCount();
+  const size_t Total = static_cast<size_t>(RecordCount) * Count;
 
-  switch (Type) {
-    case NodeType::Node2D:
-      NewNode = new Node2D(NodeName, HashTableAPI_);
-      break;
-    case NodeType::Node3D:
-      NewNode = new Node3D(NodeName, HashTableAPI_);
-      break;
-    case NodeType::Root:
-      // Only one root per scene; return existing root
-      return (static_cast<Node*>(Root_));
-    case NodeType::MeshInstance:
-      NewNode = new MeshInstance(NodeName, HashTableAPI_);
-      break;
-    case NodeType::Camera:
-      NewNode = new CameraNode(NodeName, HashTableAPI_);
-      break;
-    case NodeType::Light:
-      NewNode = new LightNode(NodeName, HashTableAPI_);
-      break;
-    case NodeType::RigidBody:
-      NewNode = new RigidBodyNode(NodeName, HashTableAPI_);
-      break;
-    case NodeType::Collider:
-      NewNode = new ColliderNode(NodeName, HashTableAPI_);
-      break;
-    case NodeType::AudioSource:
-      NewNode = new AudioSourceNode(NodeName, HashTableAPI_);
-      break;
-    case NodeType::AudioListener:
-      NewNode = new AudioListenerNode(NodeName, HashTableAPI_);
-      break;
-    case NodeType::Animator:
-      NewNode = new AnimatorNode(NodeName, HashTableAPI_);
-      break;
-    case NodeType::ParticleEmitter:
-      NewNode = new ParticleEmitterNode(NodeName, HashTableAPI_);
-      break;
-    case NodeType::Sprite:
-      NewNode = new SpriteNode(NodeName, HashTableAPI_);
-      break;
-    default:
-      NewNode = new Node(NodeName, Type, HashTableAPI_);
-      break;
+  // Grow every list the batch appends to once
+  uint32_t TypeCounts[NodeTypeCount] = {};
+  for (const PrefabTemplate::NodeRecord& Record : Records) {
+    if (IsTrackedType(Record.Type)) {
+      TypeCounts[static_cast<uint32_t>(Record.Type)] += Count;
+    }
+  }
+  for (uint32_t i = 0; i < NodeTypeCount; ++i) {
+    if (TypeCounts[i]) {
+      ReserveExtra(TypedNodes_[i], TypeCounts[i]);
+    }
   }
+  Hierarchy_.Reserve(static_cast<uint32_t>(Total));
+  ReserveExtra(HandleSlots_, Total);
+  if (NodesByID_.size() < NextNodeID_ + Total) {
+    ReserveExtra(NodesByID_, NextNodeID_ + Total - NodesByID_.size());
+  }
+
+  // Resolve everything that is the same for every copy: each record's
+  // local matrix and script factory, and each value's property descriptor
+  std::vector<Transform> Locals(RecordCount);
+  std::vector<ScriptRegistry::FactoryFn> Factories(RecordCount, nullptr);
+  const auto& Scripts = ScriptRegistry::Get().GetAll();
+  for (uint32_t r = 0; r < RecordCount; ++r) {
+    const PrefabTemplate::NodeRecord& Record = Records[r];
+    if (!IsIdentityLocal(Record.Local)) {
+      Transform& Local = Locals[r];
+      Local.Translation = Record.Local.Translation;
+      Local.Rotation = Record.Local.Rotation;
+      Local.Scale = Record.Local.Scale;
+      Local.MarkDirty();
+      Local.GetForwardMatrix();
+    }
 
-  if (!NewNode) {
-    return (nullptr);
+    if (Record.ScriptId != PrefabTemplate::NoScript) {
+      auto It = Scripts.find(std::string(Template.GetString(Record.ScriptId)));
+      if (It != Scripts.end()) {
+        Factories[r] = It->second;
+      } else {
+        std::string Msg = "InstantiateBatch: script '";
+        Msg += Template.GetString(Record.ScriptId);
+        Msg += "' is not registered";
+        Log::Warn(Msg);
+      }
+    }
   }
 
-  // Assign node ID
-  NewNode->SetNodeID(NextNodeID_++);
+  const PrefabTemplate::PropertyValue* Values = Template.GetValues();
+  const uint32_t ValueTotal = RecordCount ? Records.back().FirstValue + Records.back().ValueCount : 0;
+  std::vector<const PropDescriptor*> ValueProps(ValueTotal, nullptr);
+  for (const PrefabTemplate::NodeRecord& Record : Records) {
+    uint32_t PropCount = 0;
+    const PropDescriptor* Props = PropertyRegistry::Get().GetProperties(Record.Type, &PropCount);
+    for (uint32_t v = Record.FirstValue; v < Record.FirstValue + Record.ValueCount; ++v) {
+      if (Values[v].Descriptor < PropCount) {
+        ValueProps[v] = &Props[Values[v].Descriptor];
+      }
+    }
+  }
 
-  // Set the OwningTree_ back-pointer
-  NewNode->OwningTree_ = this;
+  Node* Under = Parent ? Parent : static_cast<Node*>(Root_);
+  std::vector<Node*> Made(RecordCount, nullptr);
+  std::vector<Node*> Roots;
+  Roots.reserve(Count);
+
+  for (uint32_t i = 0; i < Count; ++i) {
+    for (uint32_t r = 0; r < RecordCount; ++r) {
+      const PrefabTemplate::NodeRecord& Record = Records[r];
+      Node* RecordParent = (r == 0) ? Under : Made[Record.Parent];
+      Node* NewNode = RecordParent
+        ? InstantiateNode(Template.GetString(Record.NameId), Record.Type, RecordParent)
+        : nullptr;
+      Made[r] = NewNode;
+      if (!NewNode) {
+        continue;
+      }
 
-  // Attach to parent (default to root if no parent specified)
-  if (Parent) {
-    Parent->AddChild(NewNode);
-  } else {
-    Root_->AddChild(NewNode);
-  }
+      // Local transform: the instance's own for its root, otherwise the
+      // record's with the matrix computed above. A new slot starts dirty,
+      // so the next flush places the whole copy.
+      Transform& Local = NewNode->Transform_;
+      if (r == 0 && Transforms) {
+        Local.Translation = Transforms[i].Translation;
+        Local.Rotation = Transforms[i].Rotation;
+        Local.Scale = Transforms[i].Scale;
+        Local.ForwardMatrixDirty_ = true;
+        Local.IsIdentity_ = false;
+        Hierarchy_.SetLocal(NewNode->HierarchyIndex_, Local.GetForwardMatrix());
+      } else if (!Locals[r].IsIdentity_) {
+        const Transform& Source = Locals[r];
+        Local.Translation = Source.Translation;
+        Local.Rotation = Source.Rotation;
+        Local.Scale = Source.Scale;
+        Local.CachedForwardMatrix_ = Source.CachedForwardMatrix_;
+        Local.ForwardMatrixDirty_ = false;
+        Local.IsIdentity_ = false;
+        Hierarchy_.SetLocal(NewNode->HierarchyIndex_, Source.CachedForwardMatrix_);
+      }
 
-  NodeCount_++;
+      // Property values: written raw, then the node is marked dirty once
+      for (uint32_t v = Record.FirstValue; v < Record.FirstValue + Record.ValueCount; ++v) {
+        if (const PropDescriptor* Prop = ValueProps[v]) {
+          Template.ApplyValue(NewNode, Prop, Values[v]);
+        }
+      }
+      if (Record.ValueCount > 0) {
+        NewNode->MarkDirty();
+      }
+      if (AX_HANDLE_IS_VALID(Record.Model) && Record.Type == NodeType::MeshInstance) {
+        static_cast<MeshInstance*>(NewNode)->ModelHandle = PrimitiveMesh::AcquireModel(Record.Model);
+      }
 
-  // Register in typed-node tracking array
-  RegisterTypedNode(NewNode);
+      if (Factories[r]) {
+        NewNode->AttachScript(Factories[r]());
+      }
+    }
 
-  // Mark the new node's transform as dirty so it gets processed
-  // on the next Update() call
-  MarkTransformDirty(NewNode);
+    if (Made[0]) {
+      Roots.push_back(Made[0]);
+    }
+  }
 
-  // Fire AX_EVENT_NODE_CREATED on the scene's EventBus
-  FireEvent(AX_EVENT_NODE_CREATED, NewNode, nullptr, 0);
+  if (!Roots.empty() && Bus_ && Bus_->GetSubscriberCount(AX_EVENT_NODES_INSTANTIATED) > 0) {
+    AxNodesInstantiatedEvent Payload{Roots.data(), static_cast<uint32_t>(Roots.size()), RecordCount};
+    FireEvent(AX_EVENT_NODES_INSTANTIATED, Under, &Payload, sizeof(Payload));
+  }
 
-  return (NewNode);
+  if (OutRoots) {
+    std::copy(Roots.begin(), Roots.end(), OutRoots);
+  }
+  return (static_cast<uint32_t>(Roots.size()));
 }
 
-void SceneTree::DestroyNode(Node* Target)
+//=============================================================================
+// Script Tasks
+//=============================================================================
+
+void SceneTree::StartTask(Node* Owner, ScriptTask Task)
 {
-  if (!Target) {
+  if (!Owner || Owner->OwningTree_ != this) {
+    Log::Warn("StartTask: owner node is not in this scene tree");
     return;
   }
 
-  // Don't allow destroying the root
-  if (Target == static_cast<Node*>(Root_)) {
+  // Tasks are resumed on this thread only
+  if (ParallelPhase_) {
+    Log::Warn("StartTask: tasks cannot be started from a parallel script phase");
     return;
   }
 
-  // Unregister all typed nodes in this subtree from tracking arrays
-  UnregisterSubtreeTypedNodes(Target);
-
-  // Unregister from all optimization lists (dirty roots, script nodes, pending inits)
-  UnregisterSubtreeFromAllLists(Target);
-
-  // Remove from all groups
-  RemoveSubtreeFromAllGroups(Target);
-
-  // Fire AX_EVENT_NODE_DESTROYED before detaching from parent
-  FireEvent(AX_EVENT_NODE_DESTROYED, Target, nullptr, 0);
+  Tasks_.Start(Owner, std::move(Task));
+}
 
-  // Detach from parent
-  Node* ParentNode = Target->GetParent();
-  if (ParentNode) {
-    ParentNode->RemoveChild(Target);
+void SceneTree::StopTasks(Node* Owner)
+{
+  if (Owner && Owner->TaskHead_ != Node::NotInList) {
+    Tasks_.CancelOwner(Owner);
   }
+}
 
-  // Clear OwningTree_ on the entire subtree to prevent Node destructors
-  // from trying to unregister from lists (we already did it above)
-  SetOwningTreeRecursive(Target, nullptr);
+Node* SceneTree::FindNode(std::string_view NodeName)
+{
+  auto It = NameIndex_.find(NodeName);
+  if (It == NameIndex_.end()) {
+    return (nullptr);
+  }
 
-  // Recursively destroy children first
-  while (Target->GetFirstChild()) {
-    DestroyNode(Target->GetFirstChild());
+  // Lowest NodeID among duplicates, so the result never depends on
+  // bucket order
+  Node* Found = nullptr;
+  for (Node* Candidate : It->second) {
+    if (!Found || Candidate->NodeID_ < Found->NodeID_) {
+      Found = Candidate;
+    }
   }
 
-  // Now safe to delete the leaf node
-  delete Target;
+  return (Found);
+}
 
-  // Update count
-  if (NodeCount_ > 0) {
-    NodeCount_--;
+void SceneTree::FindNodesByName(std::string_view NodeName, std::vector<Node*>& OutNodes) const
+{
+  OutNodes.clear();
+
+  auto It = NameIndex_.find(NodeName);
+  if (It == NameIndex_.end()) {
+    return;
   }
+
+  OutNodes = It->second;
+  std::sort(OutNodes.begin(), OutNodes.end(),
+    [](Node* A, Node* B) { return (A->NodeID_ < B->NodeID_); });
 }
 
-Node* SceneTree::FindNode(std::string_view NodeName)
+Node* SceneTree::FindChildByName(Node* Parent, std::string_view ChildName) const
 {
-  if (NodeName.empty() || !Root_) {
+  if (!Parent || ChildName.empty()) {
     return (nullptr);
   }
 
-  return (FindNodeRecursive(static_cast<Node*>(Root_), NodeName));
+  // A rare name is resolved from its bucket: a single child of Parent
+  // with this name is the answer
+  auto It = NameIndex_.find(ChildName);
+  if (It != NameIndex_.end() && It->second.size() <= MaxIndexedChildCandidates) {
+    Node* Found = nullptr;
+    bool Unique = true;
+    for (Node* Candidate : It->second) {
+      if (Candidate->Parent_ != Parent) {
+        continue;
+      }
+      if (Found) {
+        Unique = false;
+        break;
+      }
+      Found = Candidate;
+    }
+
+    if (Found && Unique) {
+      return (Found);
+    }
+  }
+
+  // Duplicate siblings, a very common name, or a standalone child that was
+  // never indexed: fall back to sibling order
+  for (Node* Child = Parent->FirstChild_; Child; Child = Child->NextSibling_) {
+    if (Child->Name_ == ChildName) {
+      return (Child);
+    }
+  }
+
+  return (nullptr);
+}
+
+Node* SceneTree::GetNodeByID(uint32_t ID) const
+{
+  return ((ID < NodesByID_.size()) ? NodesByID_[ID] : nullptr);
 }
 
 //=============================================================================
@@ -803,20 +2202,75 @@ Node** SceneTree::GetNodesByType(NodeType Type, uint32_t* OutCount)
     return (nullptr);
   }
 
-  switch (Type) {
-    case NodeType::MeshInstance:
-      *OutCount = MeshInstanceCount_;
-      return (MeshInstanceCount_ > 0 ? MeshInstances_ : nullptr);
-    case NodeType::Camera:
-      *OutCount = CameraNodeCount_;
-      return (CameraNodeCount_ > 0 ? CameraNodes_ : nullptr);
-    case NodeType::Light:
-      *OutCount = LightNodeCount_;
-      return (LightNodeCount_ > 0 ? LightNodes_ : nullptr);
-    default:
-      *OutCount = 0;
-      return (nullptr);
+  if (!IsTrackedType(Type)) {
+    *OutCount = 0;
+    return (nullptr);
+  }
+
+  // Callers index the array directly, so it must be free of holes
+  uint32_t Index = static_cast<uint32_t>(Type);
+  CompactTypedNodes(Index);
+
+  std::vector<Node*>& List = TypedNodes_[Index];
+  *OutCount = static_cast<uint32_t>(List.size());
+  return (List.empty() ? nullptr : List.data());
+}
+
+uint32_t SceneTree::GetTypedNodeCount(NodeType Type) const
+{
+  if (!IsTrackedType(Type)) {
+    return (0);
+  }
+
+  uint32_t Index = static_cast<uint32_t>(Type);
+  return (static_cast<uint32_t>(TypedNodes_[Index].size()) - TypedHoles_[Index]);
+}
+
+//=============================================================================
+// Spatial Queries
+//=============================================================================
+
+void SceneTree::SetNodeBounds(Node* Target, const AxAABB& LocalBounds)
+{
+  if (!Target || Target->OwningTree_ != this ||
+      Target->HierarchyIndex_ == TransformHierarchy::InvalidIndex) {
+    Log::Warn("SceneTree::SetNodeBounds: node is not in this scene tree");
+    return;
+  }
+
+  // The world matrix may be a flush behind; the slot is then dirty, so the
+  // next flush refits the box
+  const Mat4& World = Hierarchy_.GetWorld(Target->HierarchyIndex_);
+  if (Target->SpatialProxy_ != Node::NotInList) {
+    Spatial_.SetLocalBounds(Target->SpatialProxy_, LocalBounds, World);
+    return;
+  }
+
+  Target->SpatialProxy_ = Spatial_.Insert(Target, LocalBounds, World);
+  Hierarchy_.SetWatched(Target->HierarchyIndex_, true);
+}
+
+void SceneTree::ClearNodeBounds(Node* Target)
+{
+  if (!Target || Target->OwningTree_ != this || Target->SpatialProxy_ == Node::NotInList) {
+    return;
+  }
+
+  Spatial_.Remove(Target->SpatialProxy_);
+  Target->SpatialProxy_ = Node::NotInList;
+  Hierarchy_.SetWatched(Target->HierarchyIndex_, false);
+}
+
+bool SceneTree::GetNodeBounds(const Node* Target, AxAABB* OutBounds) const
+{
+  if (!Target || Target->OwningTree_ != this || Target->SpatialProxy_ == Node::NotInList) {
+    return (false);
+  }
+
+  if (OutBounds) {
+    *OutBounds = Spatial_.GetBounds(Target->SpatialProxy_);
   }
+  return (true);
 }
 
 //=============================================================================
@@ -825,60 +2279,114 @@ Node** SceneTree::GetNodesByType(NodeType Type, uint32_t* OutCount)
 
 const std::vector<Node*> SceneTree::EmptyNodeVector_;
 
-const std::vector<Node*>& SceneTree::GetNodesInGroup(std::string_view GroupName) const
+// Position of Group in a node's sorted membership list, or where it would go
+template<typename EntryListType>
+static auto FindGroupEntry(EntryListType& Entries, GroupId Group)
+{
+  return (std::lower_bound(Entries.begin(), Entries.end(), Group,
+    [](const auto& Entry, GroupId Id) { return (Entry.Group < Id); }));
+}
+
+GroupId SceneTree::GetGroupId(std::string_view GroupName)
 {
-  auto It = Groups_.find(std::string(GroupName));
-  if (It != Groups_.end()) {
+  if (GroupName.empty()) {
+    return (InvalidGroupId);
+  }
+
+  auto It = GroupIds_.find(GroupName);
+  if (It != GroupIds_.end()) {
     return (It->second);
   }
-  return (EmptyNodeVector_);
+
+  GroupId Group = static_cast<GroupId>(Groups_.size());
+  Groups_.push_back({std::string(GroupName), {}});
+  GroupIds_.emplace(std::string(GroupName), Group);
+  return (Group);
+}
+
+GroupId SceneTree::FindGroupId(std::string_view GroupName) const
+{
+  auto It = GroupIds_.find(GroupName);
+  return ((It != GroupIds_.end()) ? It->second : InvalidGroupId);
+}
+
+std::string_view SceneTree::GetGroupName(GroupId Group) const
+{
+  return ((Group < Groups_.size()) ? std::string_view(Groups_[Group].Name) : std::string_view());
+}
+
+const std::vector<Node*>& SceneTree::GetNodesInGroup(std::string_view GroupName) const
+{
+  return (GetNodesInGroup(FindGroupId(GroupName)));
+}
+
+const std::vector<Node*>& SceneTree::GetNodesInGroup(GroupId Group) const
+{
+  return ((Group < Groups_.size()) ? Groups_[Group].Members : EmptyNodeVector_);
 }
 
 uint32_t SceneTree::GetGroupSize(std::string_view GroupName) const
 {
-  auto It = Groups_.find(std::string(GroupName));
-  if (It != Groups_.end()) {
-    return (static_cast<uint32_t>(It->second.size()));
-  }
-  return (0);
+  return (GetGroupSize(FindGroupId(GroupName)));
+}
+
+uint32_t SceneTree::GetGroupSize(GroupId Group) const
+{
+  return ((Group < Groups_.size()) ? static_cast<uint32_t>(Groups_[Group].Members.size()) : 0);
 }
 
 void SceneTree::AddNodeToGroup(Node* Target, std::string_view GroupName)
 {
-  if (!Target || GroupName.empty()) {
-    return;
+  if (Target && !GroupName.empty()) {
+    AddNodeToGroup(Target, GetGroupId(GroupName));
   }
+}
 
-  auto& Vec = Groups_[std::string(GroupName)];
+void SceneTree::AddNodeToGroup(Node* Target, GroupId Group)
+{
+  if (!Target || Group >= Groups_.size()) {
+    return;
+  }
 
-  // Check for duplicate
-  for (Node* N : Vec) {
-    if (N == Target) {
-      return;
-    }
+  std::vector<Node::GroupEntry>& Entries = Target->GetColdData().GroupEntries;
+  auto It = FindGroupEntry(Entries, Group);
+  if (It != Entries.end() && It->Group == Group) {
+    return;
   }
 
-  Vec.push_back(Target);
+  std::vector<Node*>& Members = Groups_[Group].Members;
+  Entries.insert(It, {Group, static_cast<uint32_t>(Members.size())});
+  if (Group < 64) {
+    Target->GroupMask_ |= (1ull << Group);
+  }
+  Members.push_back(Target);
 }
 
 void SceneTree::RemoveNodeFromGroup(Node* Target, std::string_view GroupName)
 {
-  if (!Target || GroupName.empty()) {
+  if (Target && !GroupName.empty()) {
+    RemoveNodeFromGroup(Target, FindGroupId(GroupName));
+  }
+}
+
+void SceneTree::RemoveNodeFromGroup(Node* Target, GroupId Group)
+{
+  if (!Target || Group >= Groups_.size() || !Target->Cold_) {
     return;
   }
 
-  auto It = Groups_.find(std::string(GroupName));
-  if (It == Groups_.end()) {
+  std::vector<Node::GroupEntry>& Entries = Target->Cold_->GroupEntries;
+  auto It = FindGroupEntry(Entries, Group);
+  if (It == Entries.end() || It->Group != Group) {
     return;
   }
 
-  auto& Vec = It->second;
-  for (auto VIt = Vec.begin(); VIt != Vec.end(); ++VIt) {
-    if (*VIt == Target) {
-      Vec.erase(VIt);
-      return;
-    }
+  uint32_t Slot = It->Slot;
+  Entries.erase(It);
+  if (Group < 64) {
+    Target->GroupMask_ &= ~(1ull << Group);
   }
+  RemoveGroupMember(Target, Group, Slot);
 }
 
 bool SceneTree::IsNodeInGroup(const Node* Target, std::string_view GroupName) const
@@ -886,34 +2394,38 @@ bool SceneTree::IsNodeInGroup(const Node* Target, std::string_view GroupName) co
   if (!Target || GroupName.empty()) {
     return (false);
   }
+  return (IsNodeInGroup(Target, FindGroupId(GroupName)));
+}
 
-  auto It = Groups_.find(std::string(GroupName));
-  if (It == Groups_.end()) {
-    return (false);
-  }
+bool SceneTree::IsNodeInGroup(const Node* Target, GroupId Group) const
+{
+  return (Target && Group < Groups_.size() && Target->IsInGroup(Group));
+}
 
-  for (const Node* N : It->second) {
-    if (N == Target) {
-      return (true);
-    }
+void SceneTree::RemoveGroupMember(Node* Target, GroupId Group, uint32_t Slot)
+{
+  std::vector<Node*>& Members = Groups_[Group].Members;
+  Node* Moved = Members.back();
+  Members[Slot] = Moved;
+  Members.pop_back();
+
+  if (Moved != Target) {
+    FindGroupEntry(Moved->Cold_->GroupEntries, Group)->Slot = Slot;
   }
-  return (false);
 }
 
 void SceneTree::RemoveNodeFromAllGroups(Node* Target)
 {
-  if (!Target) {
+  if (!Target || !Target->Cold_) {
     return;
   }
 
-  for (auto& [Name, Vec] : Groups_) {
-    for (auto It = Vec.begin(); It != Vec.end(); ++It) {
-      if (*It == Target) {
-        Vec.erase(It);
-        break;
-      }
-    }
+  // Only the node's own groups; other groups are never visited
+  for (const Node::GroupEntry& Entry : Target->Cold_->GroupEntries) {
+    RemoveGroupMember(Target, Entry.Group, Entry.Slot);
   }
+  Target->Cold_->GroupEntries.clear();
+  Target->GroupMask_ = 0;
 }
 
 void SceneTree::RemoveSubtreeFromAllGroups(Node* Target)
@@ -0,0 +1,171 @@
+/**
+ * AxScriptTask.cpp - Coroutine frame pool and awaitables for ScriptTask
+ *
+ * Free frames of each size class are chained through their first bytes, so
+ * the pool needs no bookkeeping beyond one list head per class. Chunks are
+ * kept until the process exits; a game that once ran N tasks of a size is
+ * likely to run N again.
+ *
+ * The awaitables only forward to the TaskScheduler that started the task.
+ */
+
+#include "AxEngine/AxScriptTask.h"
+#include "AxEngine/AxTaskScheduler.h"
+#include "AxEngine/AxScriptLog.h"
+
+#include <mutex>
+#include <new>
+#include <vector>
+
+//=============================================================================
+// File-local Helpers
+//=============================================================================
+
+namespace {
+
+constexpr uint32_t FrameClassCount =
+  static_cast<uint32_t>(ScriptTaskFramePool::MaxPooledFrameSize / ScriptTaskFramePool::FrameGranularity);
+
+struct FreeFrame
+{
+  FreeFrame* Next;
+};
+
+struct FramePoolState
+{
+  std::mutex Mutex;
+  FreeFrame* FreeLists[FrameClassCount] = {};
+  std::vector<void*> Chunks;
+  size_t ReservedBytes = 0;
+  uint32_t LiveFrames = 0;
+
+  ~FramePoolState()
+  {
+    for (void* Chunk : Chunks) {
+      ::operator delete(Chunk);
+    }
+  }
+};
+
+FramePoolState& PoolState()
+{
+  static FramePoolState State;
+  return (State);
+}
+
+// Size class of a frame; FrameClassCount for frames the pool does not hold
+uint32_t FrameClass(size_t Size)
+{
+  size_t Class = (Size + ScriptTaskFramePool::FrameGranularity - 1) / ScriptTaskFramePool::FrameGranularity;
+  return ((Class == 0 || Class > FrameClassCount) ? FrameClassCount : static_cast<uint32_t>(Class - 1));
+}
+
+} // namespace
+
+//=============================================================================
+// ScriptTaskFramePool
+//=============================================================================
+
+void* ScriptTaskFramePool::Allocate(size_t Size)
+{
+  FramePoolState& State = PoolState();
+  uint32_t Class = FrameClass(Size);
+
+  if (Class == FrameClassCount) {
+    void* Frame = ::operator new(Size);
+    std::lock_guard<std::mutex> Lock(State.Mutex);
+    State.LiveFrames++;
+    return (Frame);
+  }
+
+  std::lock_guard<std::mutex> Lock(State.Mutex);
+  if (!State.FreeLists[Class]) {
+    size_t FrameSize = (Class + 1) * FrameGranularity;
+    uint8_t* Chunk = static_cast<uint8_t*>(::operator new(FrameSize * FramesPerChunk));
+    State.Chunks.push_back(Chunk);
+    State.ReservedBytes += FrameSize * FramesPerChunk;
+
+    // Highest first, so frames are handed out front to back
+    for (uint32_t i = FramesPerChunk; i-- > 0;) {
+      FreeFrame* Free = reinterpret_cast<FreeFrame*>(Chunk + FrameSize * i);
+      Free->Next = State.FreeLists[Class];
+      State.FreeLists[Class] = Free;
+    }
+  }
+
+  FreeFrame* Frame = State.FreeLists[Class];
+  State.FreeLists[Class] = Frame->Next;
+  State.LiveFrames++;
+  return (Frame);
+}
+
+void ScriptTaskFramePool::Release(void* Frame, size_t Size)
+{
+  FramePoolState& State = PoolState();
+  uint32_t Class = FrameClass(Size);
+
+  if (Class == FrameClassCount) {
+    ::operator delete(Frame);
+    std::lock_guard<std::mutex> Lock(State.Mutex);
+    State.LiveFrames--;
+    return;
+  }
+
+  std::lock_guard<std::mutex> Lock(State.Mutex);
+  FreeFrame* Free = static_cast<FreeFrame*>(Frame);
+  Free->Next = State.FreeLists[Class];
+  State.FreeLists[Class] = Free;
+  State.LiveFrames--;
+}
+
+uint32_t ScriptTaskFramePool::GetLiveFrameCount()
+{
+  FramePoolState& State = PoolState();
+  std::lock_guard<std::mutex> Lock(State.Mutex);
+  return (State.LiveFrames);
+}
+
+size_t ScriptTaskFramePool::GetReservedBytes()
+{
+  FramePoolState& State = PoolState();
+  std::lock_guard<std::mutex> Lock(State.Mutex);
+  return (State.ReservedBytes);
+}
+
+//=============================================================================
+// ScriptTask
+//=============================================================================
+
+void ScriptTask::promise_type::unhandled_exception()
+{
+  // The coroutine is finished at this point; the scheduler destroys it
+  Log::Error("ScriptTask: unhandled exception, task ended");
+}
+
+//=============================================================================
+// Awaitables
+//=============================================================================
+
+bool WaitFrames::await_suspend(ScriptTask::Handle Task)
+{
+  ScriptTask::promise_type& Promise = Task.promise();
+  return (Promise.Scheduler->WaitFrames(Promise.Slot, Frames));
+}
+
+bool WaitSeconds::await_suspend(ScriptTask::Handle Task)
+{
+  ScriptTask::promise_type& Promise = Task.promise();
+  return (Promise.Scheduler->WaitSeconds(Promise.Slot, Seconds));
+}
+
+bool WaitForSignal::await_suspend(ScriptTask::Handle Task)
+{
+  ScriptTask::promise_type& Promise = Task.promise();
+  return (Promise.Scheduler->WaitForSignal(Promise.Slot, *this));
+}
+
+bool WaitUntil::await_suspend(ScriptTask::Handle Task)
+{
+  ScriptTask::promise_type& Promise = Task.promise();
+  return (Promise.Scheduler->WaitUntil(Promise.Slot, Predicate));
+}
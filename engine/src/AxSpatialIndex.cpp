@@ -0,0 +1,615 @@
+/**
+ * AxSpatialIndex.cpp - Dynamic AABB tree maintenance and array queries
+ *
+ * Insertion picks a sibling by walking down from the root and comparing
+ * the surface area the new leaf would add below each child against the
+ * cost of pairing it with the current node. After an insert or removal the
+ * path to the root is refitted and rebalanced with single rotations that
+ * promote the taller grandchild.
+ */
+
+#include "AxEngine/AxSpatialIndex.h"
+#include "AxEngine/AxWorkerPool.h"
+
+// Rays handed to one worker at a time by the batched closest-hit query
+#define AX_SPATIAL_RAY_BATCH 64
+
+//=============================================================================
+// File-local Helpers
+//=============================================================================
+
+static inline AxAABB UnionBoxes(const AxAABB& A, const AxAABB& B)
+{
+  AxAABB Result;
+  for (int i = 0; i < 3; ++i) {
+    Result.Min.XYZ[i] = std::min(A.Min.XYZ[i], B.Min.XYZ[i]);
+    Result.Max.XYZ[i] = std::max(A.Max.XYZ[i], B.Max.XYZ[i]);
+  }
+  return (Result);
+}
+
+static inline float SurfaceArea(const AxAABB& Box)
+{
+  float DX = Box.Max.X - Box.Min.X;
+  float DY = Box.Max.Y - Box.Min.Y;
+  float DZ = Box.Max.Z - Box.Min.Z;
+  return (2.0f * (DX * DY + DY * DZ + DZ * DX));
+}
+
+static inline bool BoxContains(const AxAABB& Outer, const AxAABB& Inner)
+{
+  return (Outer.Min.X <= Inner.Min.X && Outer.Min.Y <= Inner.Min.Y && Outer.Min.Z <= Inner.Min.Z &&
+          Inner.Max.X <= Outer.Max.X && Inner.Max.Y <= Outer.Max.Y && Inner.Max.Z <= Outer.Max.Z);
+}
+
+static inline bool BoxesEqual(const AxAABB& A, const AxAABB& B)
+{
+  return (A.Min.X == B.Min.X && A.Min.Y == B.Min.Y && A.Min.Z == B.Min.Z &&
+          A.Max.X == B.Max.X && A.Max.Y == B.Max.Y && A.Max.Z == B.Max.Z);
+}
+
+static inline AxVec3 BoxCenter(const AxAABB& Box)
+{
+  AxVec3 Center;
+  for (int i = 0; i < 3; ++i) {
+    Center.XYZ[i] = (Box.Min.XYZ[i] + Box.Max.XYZ[i]) * 0.5f;
+  }
+  return (Center);
+}
+
+static inline AxAABB WorldBox(const AxAABB& Local, const Mat4& World)
+{
+  return (AABBTransform(Local, static_cast<AxMat4x4>(World)));
+}
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+SpatialIndex::SpatialIndex()
+  : Root_(NullNode)
+  , FreeNode_(NullNode)
+  , FreeProxy_(InvalidProxy)
+  , ProxyCount_(0)
+  , Margin_(DefaultMargin)
+  , ReinsertCount_(0)
+{
+}
+
+//=============================================================================
+// Proxies
+//=============================================================================
+
+SpatialIndex::ProxyId SpatialIndex::Insert(Node* Owner, const AxAABB& LocalBounds, const Mat4& World)
+{
+  if (!Owner) {
+    return (InvalidProxy);
+  }
+
+  ProxyId Id;
+  if (FreeProxy_ != InvalidProxy) {
+    Id = FreeProxy_;
+    FreeProxy_ = Proxies_[Id].Leaf;
+  } else {
+    Id = static_cast<ProxyId>(Proxies_.size());
+    Proxies_.push_back({});
+  }
+
+  uint32_t Leaf = AllocateNode();
+  Proxy& Entry = Proxies_[Id];
+  Entry.Local = LocalBounds;
+  Entry.Bounds = WorldBox(LocalBounds, World);
+  Entry.Owner = Owner;
+  Entry.Leaf = Leaf;
+
+  TreeNode& LeafNode = Nodes_[Leaf];
+  LeafNode.Box = FattenBox(Entry.Bounds, AxVec3{0.0f, 0.0f, 0.0f});
+  LeafNode.Child1 = NullNode;
+  LeafNode.Child2 = Id;
+  LeafNode.Height = 0;
+  InsertLeaf(Leaf);
+
+  ProxyCount_++;
+  return (Id);
+}
+
+void SpatialIndex::Remove(ProxyId Id)
+{
+  if (Id >= Proxies_.size() || !Proxies_[Id].Owner) {
+    return;
+  }
+
+  Proxy& Entry = Proxies_[Id];
+  RemoveLeaf(Entry.Leaf);
+  FreeNode(Entry.Leaf);
+
+  Entry.Owner = nullptr;
+  Entry.Leaf = FreeProxy_;
+  FreeProxy_ = Id;
+  ProxyCount_--;
+}
+
+void SpatialIndex::SetLocalBounds(ProxyId Id, const AxAABB& LocalBounds, const Mat4& World)
+{
+  if (Id >= Proxies_.size() || !Proxies_[Id].Owner) {
+    return;
+  }
+
+  // New bounds can shrink, so always reinsert with a fresh fat box
+  Proxy& Entry = Proxies_[Id];
+  Entry.Local = LocalBounds;
+  Entry.Bounds = WorldBox(LocalBounds, World);
+  RemoveLeaf(Entry.Leaf);
+  Nodes_[Entry.Leaf].Box = FattenBox(Entry.Bounds, AxVec3{0.0f, 0.0f, 0.0f});
+  InsertLeaf(Entry.Leaf);
+}
+
+bool SpatialIndex::Update(ProxyId Id, const Mat4& World)
+{
+  if (Id >= Proxies_.size() || !Proxies_[Id].Owner) {
+    return (false);
+  }
+
+  Proxy& Entry = Proxies_[Id];
+  AxAABB Box = WorldBox(Entry.Local, World);
+  AxVec3 OldCenter = BoxCenter(Entry.Bounds);
+  AxVec3 NewCenter = BoxCenter(Box);
+  Entry.Bounds = Box;
+
+  // Still inside the fat box, and the fat box is not far larger than it
+  // would be if rebuilt now (a node that stopped after moving fast)
+  const AxAABB& Fat = Nodes_[Entry.Leaf].Box;
+  if (BoxContains(Fat, Box)) {
+    AxAABB Huge = Box;
+    float Slack = 4.0f * Margin_;
+    for (int i = 0; i < 3; ++i) {
+      float Reach = DisplacementFactor * std::fabs(NewCenter.XYZ[i] - OldCenter.XYZ[i]) + Slack;
+      Huge.Min.XYZ[i] -= Reach;
+      Huge.Max.XYZ[i] += Reach;
+    }
+    if (BoxContains(Huge, Fat)) {
+      return (false);
+    }
+  }
+
+  AxVec3 Displacement;
+  for (int i = 0; i < 3; ++i) {
+    Displacement.XYZ[i] = NewCenter.XYZ[i] - OldCenter.XYZ[i];
+  }
+
+  RemoveLeaf(Entry.Leaf);
+  Nodes_[Entry.Leaf].Box = FattenBox(Box, Displacement);
+  InsertLeaf(Entry.Leaf);
+  ReinsertCount_++;
+  return (true);
+}
+
+void SpatialIndex::Clear()
+{
+  Nodes_.clear();
+  Proxies_.clear();
+  Root_ = NullNode;
+  FreeNode_ = NullNode;
+  FreeProxy_ = InvalidProxy;
+  ProxyCount_ = 0;
+}
+
+uint32_t SpatialIndex::GetHeight() const
+{
+  return ((Root_ == NullNode) ? 0 : static_cast<uint32_t>(Nodes_[Root_].Height));
+}
+
+AxAABB SpatialIndex::FattenBox(const AxAABB& Box, const AxVec3& Displacement) const
+{
+  AxAABB Fat = Box;
+  for (int i = 0; i < 3; ++i) {
+    Fat.Min.XYZ[i] -= Margin_;
+    Fat.Max.XYZ[i] += Margin_;
+
+    // Stretch ahead of the motion so the next few steps stay inside
+    float Ahead = DisplacementFactor * Displacement.XYZ[i];
+    if (Ahead < 0.0f) {
+      Fat.Min.XYZ[i] += Ahead;
+    } else {
+      Fat.Max.XYZ[i] += Ahead;
+    }
+  }
+  return (Fat);
+}
+
+//=============================================================================
+// Tree Nodes
+//=============================================================================
+
+uint32_t SpatialIndex::AllocateNode()
+{
+  uint32_t Index;
+  if (FreeNode_ != NullNode) {
+    Index = FreeNode_;
+    FreeNode_ = Nodes_[Index].Parent;
+  } else {
+    Index = static_cast<uint32_t>(Nodes_.size());
+    Nodes_.push_back({});
+  }
+
+  TreeNode& Fresh = Nodes_[Index];
+  Fresh.Parent = NullNode;
+  Fresh.Child1 = NullNode;
+  Fresh.Child2 = NullNode;
+  Fresh.Height = 0;
+  return (Index);
+}
+
+void SpatialIndex::FreeNode(uint32_t Index)
+{
+  Nodes_[Index].Parent = FreeNode_;
+  Nodes_[Index].Height = -1;
+  FreeNode_ = Index;
+}
+
+void SpatialIndex::InsertLeaf(uint32_t Leaf)
+{
+  if (Root_ == NullNode) {
+    Root_ = Leaf;
+    Nodes_[Leaf].Parent = NullNode;
+    return;
+  }
+
+  // Find the best sibling: stop where pairing with the current node is
+  // cheaper than descending into either child
+  AxAABB LeafBox = Nodes_[Leaf].Box;
+  uint32_t Index = Root_;
+  while (Nodes_[Index].Child1 != NullNode) {
+    const TreeNode& Current = Nodes_[Index];
+    float Area = SurfaceArea(Current.Box);
+    float CombinedArea = SurfaceArea(UnionBoxes(Current.Box, LeafBox));
+
+    // Cost of a new parent for this node and the leaf, and the increase
+    // every ancestor below it would inherit from going deeper
+    float Cost = 2.0f * CombinedArea;
+    float Inherited = 2.0f * (CombinedArea - Area);
+
+    auto DescentCost = [this, &LeafBox, Inherited](uint32_t Child) {
+      const TreeNode& ChildNode = Nodes_[Child];
+      float Grown = SurfaceArea(UnionBoxes(LeafBox, ChildNode.Box));
+      return ((ChildNode.Child1 == NullNode) ? Grown + Inherited
+                                             : Grown - SurfaceArea(ChildNode.Box) + Inherited);
+    };
+    float Cost1 = DescentCost(Current.Child1);
+    float Cost2 = DescentCost(Current.Child2);
+
+    if (Cost < Cost1 && Cost < Cost2) {
+      break;
+    }
+    Index = (Cost1 < Cost2) ? Current.Child1 : Current.Child2;
+  }
+
+  // Pair the leaf with the sibling under a new parent
+  uint32_t Sibling = Index;
+  uint32_t OldParent = Nodes_[Sibling].Parent;
+  uint32_t NewParent = AllocateNode();
+  Nodes_[NewParent].Parent = OldParent;
+  Nodes_[NewParent].Box = UnionBoxes(LeafBox, Nodes_[Sibling].Box);
+  Nodes_[NewParent].Height = Nodes_[Sibling].Height + 1;
+  Nodes_[NewParent].Child1 = Sibling;
+  Nodes_[NewParent].Child2 = Leaf;
+  Nodes_[Sibling].Parent = NewParent;
+  Nodes_[Leaf].Parent = NewParent;
+
+  if (OldParent == NullNode) {
+    Root_ = NewParent;
+  } else if (Nodes_[OldParent].Child1 == Sibling) {
+    Nodes_[OldParent].Child1 = NewParent;
+  } else {
+    Nodes_[OldParent].Child2 = NewParent;
+  }
+
+  RefitAncestors(NewParent);
+}
+
+void SpatialIndex::RemoveLeaf(uint32_t Leaf)
+{
+  if (Leaf == Root_) {
+    Root_ = NullNode;
+    return;
+  }
+
+  uint32_t Parent = Nodes_[Leaf].Parent;
+  uint32_t GrandParent = Nodes_[Parent].Parent;
+  uint32_t Sibling = (Nodes_[Parent].Child1 == Leaf) ? Nodes_[Parent].Child2 : Nodes_[Parent].Child1;
+
+  // The sibling takes the parent's place
+  FreeNode(Parent);
+  Nodes_[Sibling].Parent = GrandParent;
+  if (GrandParent == NullNode) {
+    Root_ = Sibling;
+    return;
+  }
+
+  if (Nodes_[GrandParent].Child1 == Parent) {
+    Nodes_[GrandParent].Child1 = Sibling;
+  } else {
+    Nodes_[GrandParent].Child2 = Sibling;
+  }
+
+  RefitAncestors(GrandParent);
+}
+
+void SpatialIndex::RefitAncestors(uint32_t Index)
+{
+  bool First = true;
+  while (Index != NullNode) {
+    uint32_t Top = Balance(Index);
+    TreeNode& Current = Nodes_[Top];
+    const TreeNode& A = Nodes_[Current.Child1];
+    const TreeNode& B = Nodes_[Current.Child2];
+    int32_t Height = 1 + std::max(A.Height, B.Height);
+    AxAABB Box = UnionBoxes(A.Box, B.Box);
+
+    // A node left as it was leaves everything above it as it was too. The
+    // first node was just relinked, so its stored values prove nothing.
+    if (!First && Top == Index && Height == Current.Height && BoxesEqual(Box, Current.Box)) {
+      break;
+    }
+    First = false;
+
+    Current.Height = Height;
+    Current.Box = Box;
+    Index = Current.Parent;
+  }
+}
+
+uint32_t SpatialIndex::Balance(uint32_t IA)
+{
+  TreeNode& A = Nodes_[IA];
+  if (A.Child1 == NullNode || A.Height < 2) {
+    return (IA);
+  }
+
+  uint32_t IB = A.Child1;
+  uint32_t IC = A.Child2;
+  TreeNode& B = Nodes_[IB];
+  TreeNode& C = Nodes_[IC];
+  int32_t Difference = C.Height - B.Height;
+
+  // Re-point A's parent (or the root) at the node replacing A
+  auto Replace = [this, IA](uint32_t Parent, uint32_t With) {
+    if (Parent == NullNode) {
+      Root_ = With;
+    } else if (Nodes_[Parent].Child1 == IA) {
+      Nodes_[Parent].Child1 = With;
+    } else {
+      Nodes_[Parent].Child2 = With;
+    }
+  };
+
+  // C is too tall: promote it, and give A the shorter of C's children
+  if (Difference > 1) {
+    uint32_t IF = C.Child1;
+    uint32_t IG = C.Child2;
+    TreeNode& F = Nodes_[IF];
+    TreeNode& G = Nodes_[IG];
+
+    C.Child1 = IA;
+    C.Parent = A.Parent;
+    A.Parent = IC;
+    Replace(C.Parent, IC);
+
+    if (F.Height > G.Height) {
+      C.Child2 = IF;
+      A.Child2 = IG;
+      G.Parent = IA;
+      A.Box = UnionBoxes(B.Box, G.Box);
+      C.Box = UnionBoxes(A.Box, F.Box);
+      A.Height = 1 + std::max(B.Height, G.Height);
+      C.Height = 1 + std::max(A.Height, F.Height);
+    } else {
+      C.Child2 = IG;
+      A.Child2 = IF;
+      F.Parent = IA;
+      A.Box = UnionBoxes(B.Box, F.Box);
+      C.Box = UnionBoxes(A.Box, G.Box);
+      A.Height = 1 + std::max(B.Height, F.Height);
+      C.Height = 1 + std::max(A.Height, G.Height);
+    }
+    return (IC);
+  }
+
+  // B is too tall: the mirror image
+  if (Difference < -1) {
+    uint32_t ID = B.Child1;
+    uint32_t IE = B.Child2;
+    TreeNode& D = Nodes_[ID];
+    TreeNode& E = Nodes_[IE];
+
+    B.Child1 = IA;
+    B.Parent = A.Parent;
+    A.Parent = IB;
+    Replace(B.Parent, IB);
+
+    if (D.Height > E.Height) {
+      B.Child2 = ID;
+      A.Child1 = IE;
+      E.Parent = IA;
+      A.Box = UnionBoxes(C.Box, E.Box);
+      B.Box = UnionBoxes(A.Box, D.Box);
+      A.Height = 1 + std::max(C.Height, E.Height);
+      B.Height = 1 + std::max(A.Height, D.Height);
+    } else {
+      B.Child2 = IE;
+      A.Child1 = ID;
+      D.Parent = IA;
+      A.Box = UnionBoxes(C.Box, D.Box);
+      B.Box = UnionBoxes(A.Box, E.Box);
+      A.Height = 1 + std::max(C.Height, D.Height);
+      B.Height = 1 + std::max(A.Height, E.Height);
+    }
+    return (IB);
+  }
+
+  return (IA);
+}
+
+bool SpatialIndex::Validate() const
+{
+  if (Root_ == NullNode) {
+    return (ProxyCount_ == 0);
+  }
+  if (Nodes_[Root_].Parent != NullNode) {
+    return (false);
+  }
+
+  uint32_t Leaves = 0;
+  std::vector<uint32_t> Stack(1, Root_);
+  while (!Stack.empty()) {
+    uint32_t Index = Stack.back();
+    Stack.pop_back();
+    const TreeNode& Current = Nodes_[Index];
+
+    if (Current.Child1 == NullNode) {
+      const Proxy& Leaf = Proxies_[Current.Child2];
+      if (Current.Height != 0 || Leaf.Leaf != Index || !Leaf.Owner ||
+          !BoxContains(Current.Box, Leaf.Bounds)) {
+        return (false);
+      }
+      Leaves++;
+      continue;
+    }
+
+    const TreeNode& A = Nodes_[Current.Child1];
+    const TreeNode& B = Nodes_[Current.Child2];
+    if (A.Parent != Index || B.Parent != Index ||
+        Current.Height != 1 + std::max(A.Height, B.Height) ||
+        !BoxContains(Current.Box, A.Box) || !BoxContains(Current.Box, B.Box)) {
+      return (false);
+    }
+    Stack.push_back(Current.Child1);
+    Stack.push_back(Current.Child2);
+  }
+
+  return (Leaves == ProxyCount_);
+}
+
+//=============================================================================
+// Queries
+//=============================================================================
+
+bool SpatialIndex::RaycastClosest(const SpatialRay& Ray, SpatialRayHit* OutHit) const
+{
+  SpatialRayHit Best = {nullptr, Ray.MaxDistance};
+  if (Root_ != NullNode) {
+    AxVec3 InvDir = InverseDirection(Ray.Direction);
+    QueryStack<uint32_t> Stack;
+    Stack.Push(Root_);
+    while (!Stack.IsEmpty()) {
+      const TreeNode& Current = Nodes_[Stack.Pop()];
+      float T;
+      // Each hit shortens the segment, pruning everything farther away
+      if (!RayEntersBox(Ray.Origin, InvDir, Best.Distance, Current.Box, &T)) {
+        continue;
+      }
+      if (Current.Child1 == NullNode) {
+        const Proxy& Leaf = Proxies_[Current.Child2];
+        if (RayEntersBox(Ray.Origin, InvDir, Best.Distance, Leaf.Bounds, &T) &&
+            (!Best.Target || T < Best.Distance)) {
+          Best = {Leaf.Owner, T};
+        }
+        continue;
+      }
+
+      // Visit the nearer child first so it can prune the farther one
+      float T1 = INFINITY;
+      float T2 = INFINITY;
+      bool Hit1 = RayEntersBox(Ray.Origin, InvDir, Best.Distance, Nodes_[Current.Child1].Box, &T1);
+      bool Hit2 = RayEntersBox(Ray.Origin, InvDir, Best.Distance, Nodes_[Current.Child2].Box, &T2);
+      if (Hit1 && Hit2) {
+        if (T1 <= T2) {
+          Stack.Push(Current.Child2);
+          Stack.Push(Current.Child1);
+        } else {
+          Stack.Push(Current.Child1);
+          Stack.Push(Current.Child2);
+        }
+      } else if (Hit1) {
+        Stack.Push(Current.Child1);
+      } else if (Hit2) {
+        Stack.Push(Current.Child2);
+      }
+    }
+  }
+
+  if (OutHit) {
+    *OutHit = Best.Target ? Best : SpatialRayHit{nullptr, Ray.MaxDistance};
+  }
+  return (Best.Target != nullptr);
+}
+
+uint32_t SpatialIndex::QueryAABB(const AxAABB& Box, std::vector<Node*>& OutNodes) const
+{
+  OutNodes.clear();
+  QueryAABB(Box, [&OutNodes](Node* Found) { OutNodes.push_back(Found); });
+  return (static_cast<uint32_t>(OutNodes.size()));
+}
+
+uint32_t SpatialIndex::QuerySphere(const AxSphere& Sphere, std::vector<Node*>& OutNodes) const
+{
+  OutNodes.clear();
+  QuerySphere(Sphere, [&OutNodes](Node* Found) { OutNodes.push_back(Found); });
+  return (static_cast<uint32_t>(OutNodes.size()));
+}
+
+uint32_t SpatialIndex::QueryFrustum(const AxFrustum& Frustum, std::vector<Node*>& OutNodes) const
+{
+  OutNodes.clear();
+  QueryFrustum(Frustum, [&OutNodes](Node* Found) { OutNodes.push_back(Found); });
+  return (static_cast<uint32_t>(OutNodes.size()));
+}
+
+uint32_t SpatialIndex::Raycast(const SpatialRay& Ray, std::vector<SpatialRayHit>& OutHits) const
+{
+  OutHits.clear();
+  Raycast(Ray, [&OutHits](Node* Found, float Distance) { OutHits.push_back({Found, Distance}); });
+  std::sort(OutHits.begin(), OutHits.end(), [](const SpatialRayHit& A, const SpatialRayHit& B) {
+    return (A.Distance < B.Distance);
+  });
+  return (static_cast<uint32_t>(OutHits.size()));
+}
+
+void SpatialIndex::QueryAABBs(const AxAABB* Boxes, uint32_t Count, std::vector<Node*>& OutNodes,
+                              std::vector<uint32_t>& OutOffsets) const
+{
+  QueryBatch(Boxes, Count, OutNodes, OutOffsets);
+}
+
+void SpatialIndex::QuerySpheres(const AxSphere* Spheres, uint32_t Count, std::vector<Node*>& OutNodes,
+                                std::vector<uint32_t>& OutOffsets) const
+{
+  QueryBatch(Spheres, Count, OutNodes, OutOffsets);
+}
+
+void SpatialIndex::QueryFrustums(const AxFrustum* Frustums, uint32_t Count,
+                                 std::vector<Node*>& OutNodes, std::vector<uint32_t>& OutOffsets) const
+{
+  QueryBatch(Frustums, Count, OutNodes, OutOffsets);
+}
+
+void SpatialIndex::RaycastClosest(const SpatialRay* Rays, uint32_t Count, SpatialRayHit* OutHits,
+                                  WorkerPool* Pool) const
+{
+  if (!Rays || !OutHits || Count == 0) {
+    return;
+  }
+
+  // Each ray writes only its own result, so batches need no locking
+  auto Cast = [this, Rays, OutHits](uint32_t Begin, uint32_t End) {
+    for (uint32_t i = Begin; i < End; ++i) {
+      RaycastClosest(Rays[i], &OutHits[i]);
+    }
+  };
+
+  if (Pool && Pool->GetWorkerCount() > 0 && Count > AX_SPATIAL_RAY_BATCH) {
+    Pool->ParallelFor(Count, AX_SPATIAL_RAY_BATCH, Cast);
+  } else {
+    Cast(0, Count);
+  }
+}
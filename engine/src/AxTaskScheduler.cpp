@@ -0,0 +1,331 @@
+/**
+ * AxTaskScheduler.cpp - Runs the ScriptTasks of one SceneTree
+ *
+ * Wheels, signal hooks and predicates only ever push a task key (slot and
+ * generation) onto the ready list; resuming happens in Step. A key whose
+ * generation no longer matches names a task that was cancelled after its
+ * wait ended, and is skipped.
+ */
+
+#include "AxEngine/AxTaskScheduler.h"
+#include "AxEngine/AxSceneTree.h"
+#include "AxEngine/AxScriptLog.h"
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+TaskScheduler::TaskScheduler(SceneTree& Tree)
+  : Tree_(Tree)
+  , TaskCount_(0)
+  , LastResumeCount_(0)
+{
+}
+
+TaskScheduler::~TaskScheduler()
+{
+  CancelAll();
+}
+
+//=============================================================================
+// Starting and Cancelling
+//=============================================================================
+
+void TaskScheduler::Start(Node* Owner, ScriptTask Task)
+{
+  if (!Owner || !Task.IsValid()) {
+    return;
+  }
+
+  uint32_t Slot;
+  if (!FreeRecords_.empty()) {
+    Slot = FreeRecords_.back();
+    FreeRecords_.pop_back();
+  } else {
+    Slot = static_cast<uint32_t>(Records_.size());
+    Records_.push_back({});
+  }
+
+  TaskRecord& Record = Records_[Slot];
+  uint32_t Generation = Record.Generation + 1;
+  Record = {};
+  Record.Handle = Task.Release();
+  Record.Owner = Owner;
+  Record.Generation = Generation;
+  Record.PollSlot = NoTask;
+
+  // Push onto the owner's chain
+  Record.PrevOfOwner = Node::NotInList;
+  Record.NextOfOwner = Owner->TaskHead_;
+  if (Owner->TaskHead_ != Node::NotInList) {
+    Records_[Owner->TaskHead_].PrevOfOwner = Slot;
+  }
+  Owner->TaskHead_ = Slot;
+
+  ScriptTask::promise_type& Promise = Record.Handle.promise();
+  Promise.Scheduler = this;
+  Promise.Slot = Slot;
+  TaskCount_++;
+
+  Resume(Slot);
+}
+
+void TaskScheduler::CancelOwner(Node* Owner)
+{
+  // Cancel unlinks the head, so this visits the chain once
+  while (Owner->TaskHead_ != Node::NotInList) {
+    Cancel(Owner->TaskHead_);
+  }
+}
+
+void TaskScheduler::CancelAll()
+{
+  // Re-read the size: a destroyed frame may start tasks of its own
+  for (uint32_t Slot = 0; Slot < Records_.size(); ++Slot) {
+    if ((Records_[Slot].Generation & 1) != 0 && !Records_[Slot].Cancelled) {
+      Cancel(Slot);
+    }
+  }
+}
+
+void TaskScheduler::Cancel(uint32_t Slot)
+{
+  TaskRecord& Record = Records_[Slot];
+  UnlinkOwner(Record);
+
+  if (Record.Running) {
+    Record.Cancelled = true;
+    return;
+  }
+  Destroy(Slot);
+}
+
+void TaskScheduler::Destroy(uint32_t Slot)
+{
+  TaskRecord& Record = Records_[Slot];
+  UnlinkOwner(Record);
+  ClearWait(Record);
+
+  ScriptTask::Handle Handle = Record.Handle;
+  Record.Handle = nullptr;
+  Record.Generation++;
+  FreeRecords_.push_back(Slot);
+  TaskCount_--;
+
+  // Last: destructors of the frame's locals may call back into the tree
+  Handle.destroy();
+}
+
+void TaskScheduler::UnlinkOwner(TaskRecord& Record)
+{
+  if (!Record.Owner) {
+    return;
+  }
+
+  if (Record.PrevOfOwner != Node::NotInList) {
+    Records_[Record.PrevOfOwner].NextOfOwner = Record.NextOfOwner;
+  } else {
+    Record.Owner->TaskHead_ = Record.NextOfOwner;
+  }
+  if (Record.NextOfOwner != Node::NotInList) {
+    Records_[Record.NextOfOwner].PrevOfOwner = Record.PrevOfOwner;
+  }
+
+  Record.Owner = nullptr;
+  Record.NextOfOwner = Node::NotInList;
+  Record.PrevOfOwner = Node::NotInList;
+}
+
+void TaskScheduler::ClearWait(TaskRecord& Record)
+{
+  if (Record.Timer) {
+    Record.Wheel->Cancel(Record.Timer);
+    Record.Timer = 0;
+  }
+
+  if (Record.Connection) {
+    // Gone if the emitter was destroyed; its connections went with it
+    Node* Emitter = Tree_.Resolve(Record.Emitter);
+    if (Emitter) {
+      Emitter->Disconnect(Record.SignalName, Record.Connection);
+    }
+    Record.Connection = 0;
+  }
+
+  if (Record.PollSlot != NoTask) {
+    uint32_t Moved = Polled_.back();
+    Polled_[Record.PollSlot] = Moved;
+    Records_[Moved].PollSlot = Record.PollSlot;
+    Polled_.pop_back();
+    Record.PollSlot = NoTask;
+  }
+
+  Record.Wait = WaitKind::None;
+}
+
+//=============================================================================
+// Resuming
+//=============================================================================
+
+void TaskScheduler::MakeReady(uint64_t Key, WaitKind Kind)
+{
+  uint32_t Slot = static_cast<uint32_t>(Key);
+  if (Slot >= Records_.size()) {
+    return;
+  }
+
+  TaskRecord& Record = Records_[Slot];
+  if (Record.Generation != static_cast<uint32_t>(Key >> 32) || Record.Wait != Kind) {
+    return;
+  }
+
+  // A fired timer's ID is already dead; keep the signal connection for
+  // Resume to drop, outside the emission that readied the task
+  if (Kind == WaitKind::Timer) {
+    Record.Timer = 0;
+  }
+  Record.Wait = WaitKind::Ready;
+  Ready_.push_back(Key);
+}
+
+void TaskScheduler::OnSignal(uint64_t Key, const SignalArgs& Args)
+{
+  uint32_t Slot = static_cast<uint32_t>(Key);
+  if (Slot < Records_.size() && Records_[Slot].Generation == static_cast<uint32_t>(Key >> 32) &&
+      Records_[Slot].Wait == WaitKind::Signal) {
+    *Records_[Slot].ArgsOut = Args;
+    MakeReady(Key, WaitKind::Signal);
+  }
+}
+
+void TaskScheduler::Resume(uint32_t Slot)
+{
+  TaskRecord& Record = Records_[Slot];
+  ClearWait(Record);
+  Record.Running = true;
+
+  ScriptTask::Handle Handle = Record.Handle;
+  Handle.resume();
+
+  // The task may have started others, growing Records_
+  TaskRecord& After = Records_[Slot];
+  After.Running = false;
+  if (After.Cancelled || Handle.done()) {
+    Destroy(Slot);
+  }
+}
+
+void TaskScheduler::Step(uint64_t FrameIndex, double Time)
+{
+  LastResumeCount_ = 0;
+
+  auto OnTimer = [this](uint64_t Key) { MakeReady(Key, WaitKind::Timer); };
+  FrameWheel_.Advance(FrameIndex, OnTimer);
+  TimeWheel_.Advance(TimerWheel::SecondsToTick(Time), OnTimer);
+
+  // Predicates may start, end or cancel tasks, so poll from a copy
+  if (!Polled_.empty()) {
+    PollScratch_.clear();
+    for (uint32_t Slot : Polled_) {
+      PollScratch_.push_back(TaskKey(Slot, Records_[Slot].Generation));
+    }
+
+    for (uint64_t Key : PollScratch_) {
+      uint32_t Slot = static_cast<uint32_t>(Key);
+      if (Records_[Slot].Generation != static_cast<uint32_t>(Key >> 32) ||
+          Records_[Slot].Wait != WaitKind::Until) {
+        continue;
+      }
+      if ((*Records_[Slot].Predicate)()) {
+        MakeReady(Key, WaitKind::Until);
+      }
+    }
+  }
+
+  // Waits that end while resuming (signals, mostly) run in this Step too
+  while (!Ready_.empty()) {
+    ReadyScratch_.swap(Ready_);
+    for (uint64_t Key : ReadyScratch_) {
+      uint32_t Slot = static_cast<uint32_t>(Key);
+      if (Records_[Slot].Generation == static_cast<uint32_t>(Key >> 32) &&
+          Records_[Slot].Wait == WaitKind::Ready) {
+        Resume(Slot);
+        LastResumeCount_++;
+      }
+    }
+    ReadyScratch_.clear();
+  }
+}
+
+//=============================================================================
+// Waits (called by the awaitables)
+//=============================================================================
+
+bool TaskScheduler::WaitFrames(uint32_t Slot, uint32_t Frames)
+{
+  TaskRecord& Record = Records_[Slot];
+  if (Record.Cancelled) {
+    return (true);
+  }
+
+  Record.Wheel = &FrameWheel_;
+  Record.Timer = FrameWheel_.Schedule(Tree_.GetFrameContext().FrameIndex + Frames,
+                                      TaskKey(Slot, Record.Generation));
+  Record.Wait = WaitKind::Timer;
+  return (true);
+}
+
+bool TaskScheduler::WaitSeconds(uint32_t Slot, float Seconds)
+{
+  TaskRecord& Record = Records_[Slot];
+  if (Record.Cancelled) {
+    return (true);
+  }
+
+  Record.Wheel = &TimeWheel_;
+  uint64_t Due = TimerWheel::SecondsToTick(Tree_.GetFrameContext().Time + Seconds);
+  Record.Timer = TimeWheel_.Schedule(Due, TaskKey(Slot, Record.Generation));
+  Record.Wait = WaitKind::Timer;
+  return (true);
+}
+
+bool TaskScheduler::WaitForSignal(uint32_t Slot, ::WaitForSignal& Awaiter)
+{
+  TaskRecord& Record = Records_[Slot];
+  if (Record.Cancelled) {
+    return (true);
+  }
+
+  Node* Emitter = Awaiter.EmitterNode ? Awaiter.EmitterNode : Tree_.Resolve(Awaiter.EmitterHandle);
+  if (!Emitter || Emitter->GetOwningTree() != &Tree_) {
+    std::string Msg = "ScriptTask: WaitForSignal '";
+    Msg += Awaiter.SignalName;
+    Msg += "' has no emitter in this scene tree";
+    Log::Warn(Msg);
+    return (false);
+  }
+
+  uint64_t Key = TaskKey(Slot, Record.Generation);
+  Record.Connection = Emitter->Connect(Awaiter.SignalName, [this, Key](const SignalArgs& Args) {
+    OnSignal(Key, Args);
+  }, Record.Owner);
+  Record.Emitter = Emitter->GetHandle();
+  Record.SignalName = Awaiter.SignalName;
+  Record.ArgsOut = &Awaiter.Args;
+  Record.Wait = WaitKind::Signal;
+  return (true);
+}
+
+bool TaskScheduler::WaitUntil(uint32_t Slot, const std::function<bool()>& Predicate)
+{
+  TaskRecord& Record = Records_[Slot];
+  if (Record.Cancelled) {
+    return (true);
+  }
+
+  Record.Predicate = &Predicate;
+  Record.PollSlot = static_cast<uint32_t>(Polled_.size());
+  Polled_.push_back(Slot);
+  Record.Wait = WaitKind::Until;
+  return (true);
+}
@@ -0,0 +1,202 @@
+/**
+ * AxTimerService.cpp - Callback and signal timers of one SceneTree
+ *
+ * The wheel's payload is the record key (slot and generation). Step first
+ * collects every key that came due, then fires them; a key whose
+ * generation no longer matches was cancelled by an earlier callback.
+ */
+
+#include "AxEngine/AxTimerService.h"
+#include "AxEngine/AxSceneTree.h"
+#include "AxEngine/AxScriptLog.h"
+
+static uint64_t TimerKey(uint32_t Slot, uint32_t Generation)
+{
+  return ((static_cast<uint64_t>(Generation) << 32) | Slot);
+}
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+TimerService::TimerService(SceneTree& Tree)
+  : Tree_(Tree)
+  , TimerCount_(0)
+  , LastFireCount_(0)
+{
+}
+
+//=============================================================================
+// Adding and Cancelling
+//=============================================================================
+
+TimerService::TimerHandle TimerService::After(float Seconds, std::function<void()> Fn, Node* Owner)
+{
+  TimerRecord* Record;
+  TimerHandle Handle = Add(Seconds, 0, Owner, "TimerService::After", &Record);
+  if (Handle) {
+    Record->Callback = std::move(Fn);
+  }
+  return (Handle);
+}
+
+TimerService::TimerHandle TimerService::Every(float Interval, std::function<void()> Fn, Node* Owner)
+{
+  uint64_t Ticks = TimerWheel::SecondsToTick(Interval);
+  TimerRecord* Record;
+  TimerHandle Handle = Add(Interval, static_cast<uint32_t>(Ticks ? Ticks : 1), Owner,
+                           "TimerService::Every", &Record);
+  if (Handle) {
+    Record->Callback = std::move(Fn);
+  }
+  return (Handle);
+}
+
+TimerService::TimerHandle TimerService::EmitAfter(float Seconds, Node* Emitter,
+                                                  std::string_view SignalName,
+                                                  const SignalArgs& Args)
+{
+  if (!Emitter || SignalName.empty()) {
+    Log::Warn("TimerService::EmitAfter: needs an emitter and a signal name");
+    return (0);
+  }
+
+  TimerRecord* Record;
+  TimerHandle Handle = Add(Seconds, 0, Emitter, "TimerService::EmitAfter", &Record);
+  if (Handle) {
+    Record->SignalName = SignalName;
+    Record->Args = Args;
+  }
+  return (Handle);
+}
+
+TimerService::TimerHandle TimerService::Add(float Seconds, uint32_t Interval, Node* Target,
+                                            const char* Caller, TimerRecord** OutRecord)
+{
+  if (Target && Target->GetOwningTree() != &Tree_) {
+    std::string Msg = Caller;
+    Msg += ": node is not in this scene tree";
+    Log::Warn(Msg);
+    return (0);
+  }
+
+  uint32_t Slot;
+  if (!FreeRecords_.empty()) {
+    Slot = FreeRecords_.back();
+    FreeRecords_.pop_back();
+  } else {
+    Slot = static_cast<uint32_t>(Records_.size());
+    Records_.push_back({});
+  }
+
+  TimerRecord& Record = Records_[Slot];
+  Record.Generation++;
+  Record.Target = Target ? Target->GetHandle() : NodeHandle{};
+  Record.Due = TimerWheel::SecondsToTick(Tree_.GetFrameContext().Time + Seconds);
+  Record.Interval = Interval;
+
+  uint64_t Key = TimerKey(Slot, Record.Generation);
+  Record.Timer = Wheel_.Schedule(Record.Due, Key);
+  TimerCount_++;
+
+  *OutRecord = &Record;
+  return (Key);
+}
+
+bool TimerService::Cancel(TimerHandle Handle)
+{
+  if (!IsPending(Handle)) {
+    return (false);
+  }
+
+  uint32_t Slot = static_cast<uint32_t>(Handle);
+  Wheel_.Cancel(Records_[Slot].Timer);
+  Release(Slot);
+  return (true);
+}
+
+bool TimerService::IsPending(TimerHandle Handle) const
+{
+  uint32_t Slot = static_cast<uint32_t>(Handle);
+  uint32_t Generation = static_cast<uint32_t>(Handle >> 32);
+  return (Slot < Records_.size() && (Generation & 1) != 0 &&
+          Records_[Slot].Generation == Generation);
+}
+
+void TimerService::Clear()
+{
+  Wheel_.Clear();
+  for (uint32_t Slot = 0; Slot < Records_.size(); ++Slot) {
+    if ((Records_[Slot].Generation & 1) != 0) {
+      Release(Slot);
+    }
+  }
+}
+
+void TimerService::Release(uint32_t Slot)
+{
+  TimerRecord& Record = Records_[Slot];
+  Record.Callback = nullptr;
+  Record.SignalName.clear();
+  Record.Timer = 0;
+  Record.Generation++;
+  FreeRecords_.push_back(Slot);
+  TimerCount_--;
+}
+
+//=============================================================================
+// Firing
+//=============================================================================
+
+void TimerService::Step(double Time)
+{
+  LastFireCount_ = 0;
+  Fired_.clear();
+  Wheel_.Advance(TimerWheel::SecondsToTick(Time), [this](uint64_t Key) { Fired_.push_back(Key); });
+
+  // Callbacks may add records, so no reference into Records_ is held
+  // across a call
+  for (uint64_t Key : Fired_) {
+    uint32_t Slot = static_cast<uint32_t>(Key);
+    uint32_t Generation = static_cast<uint32_t>(Key >> 32);
+    if (Records_[Slot].Generation != Generation) {
+      continue;
+    }
+
+    TimerRecord& Record = Records_[Slot];
+    Record.Timer = 0;
+
+    Node* Target = nullptr;
+    if (!Record.Target.IsNull()) {
+      Target = Tree_.Resolve(Record.Target);
+      if (!Target) {
+        Release(Slot);
+        continue;
+      }
+    }
+    LastFireCount_++;
+
+    if (!Record.SignalName.empty()) {
+      std::string SignalName = std::move(Record.SignalName);
+      SignalArgs Args = Record.Args;
+      Release(Slot);
+      Target->EmitSignalArgs(SignalName, Args);
+      continue;
+    }
+
+    std::function<void()> Callback = std::move(Record.Callback);
+    if (Record.Interval == 0) {
+      Release(Slot);
+      Callback();
+      continue;
+    }
+
+    // Re-arm first so the callback can cancel its own timer
+    Record.Due += Record.Interval;
+    Record.Timer = Wheel_.Schedule(Record.Due, Key);
+    Callback();
+    if (Records_[Slot].Generation == Generation) {
+      Records_[Slot].Callback = std::move(Callback);
+    }
+  }
+}
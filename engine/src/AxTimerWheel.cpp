@@ -0,0 +1,180 @@
+/**
+ * AxTimerWheel.cpp - Hierarchical timer wheel over an integer tick
+ *
+ * Slot lists are doubly linked through entry indices, so a timer can be
+ * unlinked from the middle of a slot in O(1). A timer is filed at the level
+ * of the highest 6-bit digit in which its due tick differs from the current
+ * tick; when the current tick reaches the start of that slot the timer is
+ * re-filed against the new tick and lands at a lower level.
+ */
+
+#include "AxEngine/AxTimerWheel.h"
+
+// Ticks the wheels can hold relative to the current one
+static constexpr uint32_t WheelBits = TimerWheel::LevelBits * TimerWheel::LevelCount;
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+TimerWheel::TimerWheel(uint64_t StartTick)
+  : Current_(StartTick)
+  , PendingCount_(0)
+{
+  for (uint32_t Level = 0; Level <= LevelCount; ++Level) {
+    for (uint32_t Slot = 0; Slot < SlotsPerLevel; ++Slot) {
+      Heads_[Level][Slot] = NoEntry;
+      Tails_[Level][Slot] = NoEntry;
+    }
+    Occupied_[Level] = 0;
+  }
+}
+
+//=============================================================================
+// Scheduling
+//=============================================================================
+
+TimerWheel::TimerId TimerWheel::Schedule(uint64_t DueTick, uint64_t Payload)
+{
+  uint32_t Index;
+  if (!FreeEntries_.empty()) {
+    Index = FreeEntries_.back();
+    FreeEntries_.pop_back();
+  } else {
+    Index = static_cast<uint32_t>(Entries_.size());
+    Entries_.push_back({0, 0, NoEntry, NoEntry, 0, 0, 0});
+  }
+
+  Entry& E = Entries_[Index];
+  E.Due = (DueTick > Current_) ? DueTick : Current_ + 1;
+  E.Payload = Payload;
+  E.Generation++;
+  Place(Index);
+  PendingCount_++;
+
+  return ((static_cast<uint64_t>(E.Generation) << 32) | Index);
+}
+
+bool TimerWheel::Cancel(TimerId ID)
+{
+  uint32_t Index = static_cast<uint32_t>(ID);
+  uint32_t Generation = static_cast<uint32_t>(ID >> 32);
+  if (Index >= Entries_.size() || Entries_[Index].Generation != Generation ||
+      (Generation & 1) == 0) {
+    return (false);
+  }
+
+  Unlink(Index);
+  Release(Index);
+  return (true);
+}
+
+void TimerWheel::Clear()
+{
+  for (uint32_t Level = 0; Level <= LevelCount; ++Level) {
+    for (uint64_t Mask = Occupied_[Level]; Mask; Mask &= Mask - 1) {
+      uint32_t Slot = static_cast<uint32_t>(std::countr_zero(Mask));
+      uint32_t Index;
+      while ((Index = Heads_[Level][Slot]) != NoEntry) {
+        Unlink(Index);
+        Release(Index);
+      }
+    }
+  }
+}
+
+//=============================================================================
+// Slot Lists
+//=============================================================================
+
+void TimerWheel::Cascade(uint64_t Tick)
+{
+  if ((Tick & ((1ull << WheelBits) - 1)) == 0) {
+    Refile(OverflowLevel, 0);
+  }
+
+  // Highest level first, so timers dropping from level 2 into the level-1
+  // slot starting at Tick move on to level 0 in the same step
+  for (uint32_t Level = LevelCount - 1; Level > 0; --Level) {
+    uint32_t Shift = Level * LevelBits;
+    if ((Tick & ((1ull << Shift) - 1)) == 0) {
+      Refile(Level, static_cast<uint32_t>((Tick >> Shift) & (SlotsPerLevel - 1)));
+    }
+  }
+}
+
+void TimerWheel::Refile(uint32_t Level, uint32_t Slot)
+{
+  // Detach the whole list first: overflow timers still out of range go
+  // back to the list they came from
+  uint32_t Index = Heads_[Level][Slot];
+  Heads_[Level][Slot] = NoEntry;
+  Tails_[Level][Slot] = NoEntry;
+  Occupied_[Level] &= ~(1ull << Slot);
+
+  while (Index != NoEntry) {
+    uint32_t Next = Entries_[Index].Next;
+    Place(Index);
+    Index = Next;
+  }
+}
+
+void TimerWheel::Place(uint32_t Index)
+{
+  Entry& E = Entries_[Index];
+
+  // Level of the highest digit that differs; beyond the top level the
+  // timer waits in the overflow list for the next top-level turn
+  uint64_t Diff = E.Due ^ Current_;
+  uint32_t Level = Diff ? static_cast<uint32_t>(std::bit_width(Diff) - 1) / LevelBits : 0;
+  uint32_t Slot = 0;
+  if (Level < LevelCount) {
+    Slot = static_cast<uint32_t>((E.Due >> (Level * LevelBits)) & (SlotsPerLevel - 1));
+  } else {
+    Level = OverflowLevel;
+  }
+
+  // Append, so timers due on the same tick fire in scheduling order
+  E.Level = static_cast<uint8_t>(Level);
+  E.Slot = static_cast<uint8_t>(Slot);
+  E.Next = NoEntry;
+  E.Prev = Tails_[Level][Slot];
+  if (E.Prev != NoEntry) {
+    Entries_[E.Prev].Next = Index;
+  } else {
+    Heads_[Level][Slot] = Index;
+    Occupied_[Level] |= (1ull << Slot);
+  }
+  Tails_[Level][Slot] = Index;
+}
+
+void TimerWheel::Unlink(uint32_t Index)
+{
+  Entry& E = Entries_[Index];
+
+  if (E.Prev != NoEntry) {
+    Entries_[E.Prev].Next = E.Next;
+  } else {
+    Heads_[E.Level][E.Slot] = E.Next;
+  }
+
+  if (E.Next != NoEntry) {
+    Entries_[E.Next].Prev = E.Prev;
+  } else {
+    Tails_[E.Level][E.Slot] = E.Prev;
+  }
+
+  if (Heads_[E.Level][E.Slot] == NoEntry) {
+    Occupied_[E.Level] &= ~(1ull << E.Slot);
+  }
+
+  E.Next = NoEntry;
+  E.Prev = NoEntry;
+}
+
+void TimerWheel::Release(uint32_t Index)
+{
+  Entries_[Index].Generation++;
+  FreeEntries_.push_back(Index);
+  PendingCount_--;
+}
@@ -0,0 +1,433 @@
+/**
+ * AxTransformHierarchy.cpp - Flat world transform propagation
+ *
+ * Update() is a single forward scan from the lowest dirty slot. Because
+ * parents precede children, a parent's dirty byte and world matrix are
+ * final by the time any child reads them, so dirtiness flows down the
+ * hierarchy without recursion.
+ *
+ * The parallel path runs the same per-slot step over one depth level at a
+ * time; levels are the only synchronization points.
+ */
+
+#include "AxEngine/AxTransformHierarchy.h"
+#include "AxEngine/AxNode.h"
+#include "AxEngine/AxWorkerPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <immintrin.h>
+
+// Relayout once holes exceed this fraction (1/N) of all slots
+#define AX_HIERARCHY_HOLE_RATIO 4
+
+//=============================================================================
+// File-local Helpers
+//=============================================================================
+
+/**
+ * Out = Parent * Local with the same element order as Mat4::operator*:
+ * Out.E[c] = sum over i of Parent.E[c][i] * Local.E[i].
+ */
+static inline void MultiplyWorld(const Mat4& Parent, const Mat4& Local, Mat4& Out)
+{
+  __m128 L0 = _mm_loadu_ps(Local.E[0]);
+  __m128 L1 = _mm_loadu_ps(Local.E[1]);
+  __m128 L2 = _mm_loadu_ps(Local.E[2]);
+  __m128 L3 = _mm_loadu_ps(Local.E[3]);
+
+  for (int c = 0; c < 4; ++c) {
+    const float* P = Parent.E[c];
+    __m128 R = _mm_mul_ps(_mm_set1_ps(P[0]), L0);
+    R = _mm_add_ps(R, _mm_mul_ps(_mm_set1_ps(P[1]), L1));
+    R = _mm_add_ps(R, _mm_mul_ps(_mm_set1_ps(P[2]), L2));
+    R = _mm_add_ps(R, _mm_mul_ps(_mm_set1_ps(P[3]), L3));
+    _mm_storeu_ps(Out.E[c], R);
+  }
+}
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+TransformHierarchy::TransformHierarchy()
+  : FirstDirty_(InvalidIndex)
+  , HoleCount_(0)
+  , WatchedCount_(0)
+  , NeedsRelayout_(false)
+  , LevelsDirty_(false)
+{
+}
+
+//=============================================================================
+// Slot Management
+//=============================================================================
+
+uint32_t TransformHierarchy::Insert(Node* Owner, uint32_t ParentIndex)
+{
+  if (!Owner) {
+    return (InvalidIndex);
+  }
+
+  uint32_t Index = static_cast<uint32_t>(Nodes_.size());
+
+  Nodes_.push_back(Owner);
+  Parents_.push_back(ParentIndex);
+  Locals_.push_back(Mat4::Identity());
+  Worlds_.push_back(Mat4::Identity());
+  Dirty_.push_back(0);
+  Watched_.push_back(0);
+  MarkSlotDirty(Index);
+
+  if (ParentIndex != InvalidIndex && ParentIndex >= Index) {
+    NeedsRelayout_ = true;
+    LevelsDirty_ = true;
+    Depths_.push_back(0);
+  } else {
+    uint32_t Depth = (ParentIndex != InvalidIndex) ? Depths_[ParentIndex] + 1 : 0;
+    Depths_.push_back(Depth);
+    if (!LevelsDirty_) {
+      if (Depth >= Levels_.size()) {
+        Levels_.resize(Depth + 1);
+      }
+      Levels_[Depth].push_back(Index);
+    }
+  }
+
+  Owner->HierarchyIndex_ = Index;
+
+  return (Index);
+}
+
+void TransformHierarchy::Reserve(uint32_t Count)
+{
+  // Never less than doubling, so a run of small reserves still grows
+  // geometrically instead of reallocating on each one
+  size_t Size = Nodes_.size() + Count;
+  if (Size <= Nodes_.capacity()) {
+    return;
+  }
+  Size = std::max(Size, Nodes_.capacity() * 2);
+
+  Nodes_.reserve(Size);
+  Parents_.reserve(Size);
+  Locals_.reserve(Size);
+  Worlds_.reserve(Size);
+  Dirty_.reserve(Size);
+  Depths_.reserve(Size);
+  Watched_.reserve(Size);
+}
+
+void TransformHierarchy::Remove(uint32_t Index)
+{
+  if (Index >= Nodes_.size() || !Nodes_[Index]) {
+    return;
+  }
+
+  Nodes_[Index]->HierarchyIndex_ = InvalidIndex;
+  Nodes_[Index] = nullptr;
+  Parents_[Index] = InvalidIndex;
+  Dirty_[Index] = 0;
+  SetWatched(Index, false);
+  HoleCount_++;
+
+  if (HoleCount_ > 1024 && HoleCount_ * AX_HIERARCHY_HOLE_RATIO > Nodes_.size()) {
+    NeedsRelayout_ = true;
+  }
+}
+
+void TransformHierarchy::SetParent(uint32_t Index, uint32_t ParentIndex)
+{
+  if (Index >= Nodes_.size() || !Nodes_[Index]) {
+    return;
+  }
+
+  Parents_[Index] = ParentIndex;
+  MarkSlotDirty(Index);
+
+  if (ParentIndex != InvalidIndex && ParentIndex > Index) {
+    NeedsRelayout_ = true;
+  }
+
+  // Moving to a different depth shifts the whole subtree between levels
+  uint32_t NewDepth = (ParentIndex != InvalidIndex) ? Depths_[ParentIndex] + 1 : 0;
+  if (NeedsRelayout_ || NewDepth != Depths_[Index]) {
+    LevelsDirty_ = true;
+  }
+}
+
+void TransformHierarchy::SetLocal(uint32_t Index, const Mat4& Local)
+{
+  if (Index >= Nodes_.size()) {
+    return;
+  }
+
+  Locals_[Index] = Local;
+  MarkSlotDirty(Index);
+}
+
+void TransformHierarchy::SetWatched(uint32_t Index, bool Watched)
+{
+  if (Index >= Nodes_.size() || (Watched_[Index] != 0) == Watched) {
+    return;
+  }
+
+  Watched_[Index] = Watched ? 1 : 0;
+  WatchedCount_ += Watched ? 1 : static_cast<uint32_t>(-1);
+}
+
+void TransformHierarchy::MarkSlotDirty(uint32_t Index)
+{
+  Dirty_[Index] = 1;
+  if (FirstDirty_ == InvalidIndex || Index < FirstDirty_) {
+    FirstDirty_ = Index;
+  }
+}
+
+//=============================================================================
+// Propagation
+//=============================================================================
+
+// Adds B's counters into A
+static inline void AccumulateStats(TransformUpdateStats& A, const TransformUpdateStats& B)
+{
+  A.ChangedSlots += B.ChangedSlots;
+  A.DirtyRoots += B.DirtyRoots;
+  A.Recomputed += B.Recomputed;
+  A.MultipliesSaved += B.MultipliesSaved;
+}
+
+TransformUpdateStats TransformHierarchy::UpdateSlots(const uint32_t* Slots, uint32_t Begin, uint32_t End)
+{
+  const uint32_t* Parents = Parents_.data();
+  const Mat4* Locals = Locals_.data();
+  Mat4* Worlds = Worlds_.data();
+  uint8_t* Dirty = Dirty_.data();
+
+  TransformUpdateStats Stats;
+  uint64_t SeparateWalkCost = 0;
+
+  for (uint32_t k = Begin; k < End; ++k) {
+    uint32_t i = Slots ? Slots[k] : k;
+    uint32_t Parent = Parents[i];
+    uint32_t Self = Dirty[i];
+    uint32_t Inherited = (Parent != InvalidIndex) ? Dirty[Parent] : 0;
+
+    if (!(Self | Inherited)) {
+      continue;
+    }
+
+    // Changed slots on the ancestor path, saturated to fit the byte; the
+    // nonzero value also tells this slot's children to recompute
+    uint32_t PathChanges = Self + Inherited;
+    Dirty[i] = static_cast<uint8_t>((PathChanges < 255) ? PathChanges : 255);
+
+    if (Parent != InvalidIndex) {
+      MultiplyWorld(Worlds[Parent], Locals[i], Worlds[i]);
+    } else {
+      Worlds[i] = Locals[i];
+    }
+
+    Stats.ChangedSlots += Self;
+    Stats.DirtyRoots += (Self && !Inherited) ? 1 : 0;
+    Stats.Recomputed++;
+    SeparateWalkCost += Dirty[i];
+  }
+
+  Stats.MultipliesSaved = SeparateWalkCost - Stats.Recomputed;
+  return (Stats);
+}
+
+uint32_t TransformHierarchy::Update(WorkerPool* Pool)
+{
+  if (NeedsRelayout_) {
+    Relayout();
+  }
+
+  LastStats_ = TransformUpdateStats();
+  MovedWatched_.clear();
+  if (FirstDirty_ == InvalidIndex) {
+    return (0);
+  }
+
+  uint32_t Count = static_cast<uint32_t>(Nodes_.size());
+
+  if (Pool && Pool->GetWorkerCount() > 0 && Count - FirstDirty_ >= ParallelMinSlots) {
+    LastStats_ = UpdateParallel(Pool);
+  } else {
+    LastStats_ = UpdateSlots(nullptr, FirstDirty_, Count);
+  }
+
+  // Every recomputed slot was left with a nonzero dirty byte
+  if (WatchedCount_ > 0) {
+    const uint8_t* Dirty = Dirty_.data();
+    const uint8_t* Watched = Watched_.data();
+    for (uint32_t i = FirstDirty_; i < Count; ++i) {
+      if (Watched[i] && Dirty[i]) {
+        MovedWatched_.push_back(i);
+      }
+    }
+  }
+
+  memset(Dirty_.data() + FirstDirty_, 0, Count - FirstDirty_);
+  FirstDirty_ = InvalidIndex;
+
+  return (LastStats_.Recomputed);
+}
+
+TransformUpdateStats TransformHierarchy::UpdateParallel(WorkerPool* Pool)
+{
+  if (LevelsDirty_) {
+    RebuildLevels();
+  }
+
+  TransformUpdateStats Total;
+  std::mutex StatsMutex;
+
+  for (const std::vector<uint32_t>& Level : Levels_) {
+    const uint32_t* Slots = Level.data();
+    uint32_t LevelCount = static_cast<uint32_t>(Level.size());
+
+    // Small levels are not worth waking the pool for
+    if (LevelCount < ParallelBatchSlots * 2) {
+      AccumulateStats(Total, UpdateSlots(Slots, 0, LevelCount));
+      continue;
+    }
+
+    Pool->ParallelFor(LevelCount, ParallelBatchSlots, [&](uint32_t Begin, uint32_t End) {
+      TransformUpdateStats BatchStats = UpdateSlots(Slots, Begin, End);
+      std::lock_guard<std::mutex> Lock(StatsMutex);
+      AccumulateStats(Total, BatchStats);
+    });
+  }
+
+  return (Total);
+}
+
+//=============================================================================
+// Relayout
+//=============================================================================
+
+void TransformHierarchy::Relayout()
+{
+  NeedsRelayout_ = false;
+
+  uint32_t Count = static_cast<uint32_t>(Nodes_.size());
+  if (Count == 0) {
+    return;
+  }
+
+  std::vector<uint32_t> Depth;
+  uint32_t MaxDepth = ComputeDepths(Depth);
+
+  // Stable counting sort by depth; holes are dropped
+  std::vector<uint32_t> LevelStart(MaxDepth + 2, 0);
+  for (uint32_t i = 0; i < Count; ++i) {
+    if (Nodes_[i]) {
+      LevelStart[Depth[i] + 1]++;
+    }
+  }
+  for (uint32_t d = 1; d < LevelStart.size(); ++d) {
+    LevelStart[d] += LevelStart[d - 1];
+  }
+
+  uint32_t LiveCount = LevelStart.back();
+  std::vector<uint32_t> NewIndex(Count, InvalidIndex);
+  for (uint32_t i = 0; i < Count; ++i) {
+    if (Nodes_[i]) {
+      NewIndex[i] = LevelStart[Depth[i]]++;
+    }
+  }
+
+  std::vector<Node*> Nodes(LiveCount);
+  std::vector<uint32_t> Parents(LiveCount);
+  std::vector<Mat4> Locals(LiveCount);
+  std::vector<Mat4> Worlds(LiveCount);
+  std::vector<uint8_t> Dirty(LiveCount);
+  std::vector<uint8_t> Watched(LiveCount);
+  uint32_t FirstDirty = InvalidIndex;
+
+  for (uint32_t i = 0; i < Count; ++i) {
+    uint32_t To = NewIndex[i];
+    if (To == InvalidIndex) {
+      continue;
+    }
+
+    Nodes[To] = Nodes_[i];
+    Parents[To] = (Parents_[i] != InvalidIndex) ? NewIndex[Parents_[i]] : InvalidIndex;
+    Locals[To] = Locals_[i];
+    Worlds[To] = Worlds_[i];
+    Dirty[To] = Dirty_[i];
+    Watched[To] = Watched_[i];
+    if (Dirty[To] && To < FirstDirty) {
+      FirstDirty = To;
+    }
+    Nodes[To]->HierarchyIndex_ = To;
+  }
+
+  Nodes_.swap(Nodes);
+  Parents_.swap(Parents);
+  Locals_.swap(Locals);
+  Worlds_.swap(Worlds);
+  Dirty_.swap(Dirty);
+  Watched_.swap(Watched);
+  FirstDirty_ = FirstDirty;
+  HoleCount_ = 0;
+
+  // Slots are now depth-sorted, so each level is a contiguous run
+  Depths_.assign(LiveCount, 0);
+  Levels_.assign(MaxDepth + 1, std::vector<uint32_t>());
+  for (uint32_t d = 0; d <= MaxDepth; ++d) {
+    uint32_t Begin = (d == 0) ? 0 : LevelStart[d - 1];
+    for (uint32_t i = Begin; i < LevelStart[d]; ++i) {
+      Depths_[i] = d;
+      Levels_[d].push_back(i);
+    }
+  }
+  LevelsDirty_ = false;
+}
+
+uint32_t TransformHierarchy::ComputeDepths(std::vector<uint32_t>& OutDepths) const
+{
+  // Parents may currently come after children, so walk up to the nearest
+  // slot with a known depth and fill in the chain on the way back.
+  uint32_t Count = static_cast<uint32_t>(Nodes_.size());
+  OutDepths.assign(Count, InvalidIndex);
+  std::vector<uint32_t> Chain;
+  uint32_t MaxDepth = 0;
+
+  for (uint32_t i = 0; i < Count; ++i) {
+    if (!Nodes_[i] || OutDepths[i] != InvalidIndex) {
+      continue;
+    }
+
+    Chain.clear();
+    uint32_t Current = i;
+    while (Current != InvalidIndex && OutDepths[Current] == InvalidIndex) {
+      Chain.push_back(Current);
+      Current = Parents_[Current];
+    }
+
+    uint32_t Base = (Current == InvalidIndex) ? 0 : OutDepths[Current] + 1;
+    for (size_t j = Chain.size(); j-- > 0;) {
+      OutDepths[Chain[j]] = Base++;
+    }
+    MaxDepth = (Base - 1 > MaxDepth) ? Base - 1 : MaxDepth;
+  }
+
+  return (MaxDepth);
+}
+
+void TransformHierarchy::RebuildLevels()
+{
+  uint32_t MaxDepth = ComputeDepths(Depths_);
+
+  Levels_.assign(MaxDepth + 1, std::vector<uint32_t>());
+  for (uint32_t i = 0; i < Depths_.size(); ++i) {
+    if (Nodes_[i]) {
+      Levels_[Depths_[i]].push_back(i);
+    }
+  }
+  LevelsDirty_ = false;
+}
@@ -21,12 +21,10 @@ Transform::Transform()
   , Rotation()  // identity: (0, 0, 0, 1)
   , Scale(1, 1, 1)
   , ForwardMatrixDirty_(true)
-  , InverseMatrixDirty_(true)
   , IsIdentity_(true)
   , OwningNode_(nullptr)
 {
   CachedForwardMatrix_ = Mat4::Identity();
-  CachedInverseMatrix_ = Mat4::Identity();
 }
 
 Transform::Transform(const AxTransform& T)
@@ -34,9 +32,7 @@ Transform::Transform(const AxTransform& T)
   , Rotation(T.Rotation)
   , Scale(T.Scale)
   , CachedForwardMatrix_(T.CachedForwardMatrix)
-  , CachedInverseMatrix_(T.CachedInverseMatrix)
   , ForwardMatrixDirty_(T.ForwardMatrixDirty)
-  , InverseMatrixDirty_(T.InverseMatrixDirty)
   , IsIdentity_(T.IsIdentity)
   , OwningNode_(nullptr)
 {
@@ -189,38 +185,31 @@ const Mat4& Transform::GetForwardMatrix() const
   return (CachedForwardMatrix_);
 }
 
-const Mat4& Transform::GetInverseMatrix() const
+Mat4 Transform::GetInverseMatrix() const
 {
-  if (InverseMatrixDirty_) {
-    // Inverse scale
-    float InvSX = (Scale.X != 0.0f) ? (1.0f / Scale.X) : 1.0f;
-    float InvSY = (Scale.Y != 0.0f) ? (1.0f / Scale.Y) : 1.0f;
-    float InvSZ = (Scale.Z != 0.0f) ? (1.0f / Scale.Z) : 1.0f;
-
-    AxMat4x4 InvScaleMatrix = ::Identity();
-    InvScaleMatrix.E[0][0] = InvSX;
-    InvScaleMatrix.E[1][1] = InvSY;
-    InvScaleMatrix.E[2][2] = InvSZ;
-
-    // Inverse rotation
-    AxQuat InvRot = QuatConjugate(Rotation);
-    AxMat4x4 InvRotMatrix = QuatToMat4x4(InvRot);
-
-    // Inverse translation
-    AxMat4x4 InvTransMatrix = ::Identity();
-    InvTransMatrix.E[3][0] = -Translation.X;
-    InvTransMatrix.E[3][1] = -Translation.Y;
-    InvTransMatrix.E[3][2] = -Translation.Z;
-
-    // S^-1 * R^-1 * T^-1 (note: Mat4x4Mul(A,B) computes B*A)
-    AxMat4x4 SR = Mat4x4Mul(InvRotMatrix, InvScaleMatrix);
-    AxMat4x4 Result = Mat4x4Mul(InvTransMatrix, SR);
-
-    CachedInverseMatrix_ = Mat4(Result);
-    InverseMatrixDirty_ = false;
-  }
-
-  return (CachedInverseMatrix_);
+  // Inverse scale
+  float InvSX = (Scale.X != 0.0f) ? (1.0f / Scale.X) : 1.0f;
+  float InvSY = (Scale.Y != 0.0f) ? (1.0f / Scale.Y) : 1.0f;
+  float InvSZ = (Scale.Z != 0.0f) ? (1.0f / Scale.Z) : 1.0f;
+
+  AxMat4x4 InvScaleMatrix = ::Identity();
+  InvScaleMatrix.E[0][0] = InvSX;
+  InvScaleMatrix.E[1][1] = InvSY;
+  InvScaleMatrix.E[2][2] = InvSZ;
+
+  // Inverse rotation
+  AxQuat InvRot = QuatConjugate(Rotation);
+  AxMat4x4 InvRotMatrix = QuatToMat4x4(InvRot);
+
+  // Inverse translation
+  AxMat4x4 InvTransMatrix = ::Identity();
+  InvTransMatrix.E[3][0] = -Translation.X;
+  InvTransMatrix.E[3][1] = -Translation.Y;
+  InvTransMatrix.E[3][2] = -Translation.Z;
+
+  // S^-1 * R^-1 * T^-1 (note: Mat4x4Mul(A,B) computes B*A)
+  AxMat4x4 SR = Mat4x4Mul(InvRotMatrix, InvScaleMatrix);
+  return (Mat4(Mat4x4Mul(InvTransMatrix, SR)));
 }
 
 //=============================================================================
@@ -264,7 +253,6 @@ Mat4 Transform::GetViewMatrix() const
 void Transform::MarkDirty()
 {
   ForwardMatrixDirty_ = true;
-  InverseMatrixDirty_ = true;
   IsIdentity_ = false;
   NotifyDirty();
 }
@@ -311,10 +299,9 @@ Transform::operator AxTransform() const
   Result.Rotation = Rotation;
   Result.Scale = Scale;
   Result.ForwardMatrixDirty = ForwardMatrixDirty_;
-  Result.InverseMatrixDirty = InverseMatrixDirty_;
+  Result.InverseMatrixDirty = true;
   Result.IsIdentity = IsIdentity_;
   memcpy(Result.CachedForwardMatrix.E, CachedForwardMatrix_.E, sizeof(Result.CachedForwardMatrix.E));
-  memcpy(Result.CachedInverseMatrix.E, CachedInverseMatrix_.E, sizeof(Result.CachedInverseMatrix.E));
   return (Result);
 }
 
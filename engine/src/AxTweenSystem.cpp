@@ -0,0 +1,388 @@
+/**
+ * AxTweenSystem.cpp - Property tweens of one SceneTree
+ *
+ * Step keeps the arithmetic in branch-free loops over contiguous floats so
+ * the compiler can vectorize them; the curve is chosen once per lane set,
+ * not per tween. Only the final write-back touches nodes.
+ */
+
+#include "AxEngine/AxTweenSystem.h"
+#include "AxEngine/AxSceneTree.h"
+#include "AxEngine/AxScriptLog.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <string>
+
+//=============================================================================
+// Easing Curves
+//=============================================================================
+
+namespace
+{
+
+inline float EaseInQuad(float T) { return (T * T); }
+inline float EaseOutQuad(float T) { return (T * (2.0f - T)); }
+inline float EaseInCubic(float T) { return (T * T * T); }
+inline float SmoothStepCurve(float T) { return (T * T * (3.0f - 2.0f * T)); }
+
+inline float EaseOutCubic(float T)
+{
+  float U = 1.0f - T;
+  return (1.0f - U * U * U);
+}
+
+// Both halves are computed and one is selected, which keeps the loop free
+// of branches
+inline float EaseInOutQuad(float T)
+{
+  float U = 1.0f - T;
+  float In = 2.0f * T * T;
+  float Out = 1.0f - 2.0f * U * U;
+  return ((T < 0.5f) ? In : Out);
+}
+
+inline float EaseInOutCubic(float T)
+{
+  float U = 1.0f - T;
+  float In = 4.0f * T * T * T;
+  float Out = 1.0f - 4.0f * U * U * U;
+  return ((T < 0.5f) ? In : Out);
+}
+
+template<typename CurveType>
+void ApplyCurve(float* Progress, uint32_t Count, CurveType Curve)
+{
+  for (uint32_t i = 0; i < Count; ++i) {
+    Progress[i] = Curve(Progress[i]);
+  }
+}
+
+} // namespace
+
+float TweenSystem::Evaluate(EaseType Ease, float T)
+{
+  T = std::clamp(T, 0.0f, 1.0f);
+  switch (Ease) {
+    case EaseType::InQuad:     return (EaseInQuad(T));
+    case EaseType::OutQuad:    return (EaseOutQuad(T));
+    case EaseType::InOutQuad:  return (EaseInOutQuad(T));
+    case EaseType::InCubic:    return (EaseInCubic(T));
+    case EaseType::OutCubic:   return (EaseOutCubic(T));
+    case EaseType::InOutCubic: return (EaseInOutCubic(T));
+    case EaseType::SmoothStep: return (SmoothStepCurve(T));
+    default:                   return (T);
+  }
+}
+
+//=============================================================================
+// Construction
+//=============================================================================
+
+TweenSystem::TweenSystem(SceneTree& Tree)
+  : Tree_(Tree)
+  , ActiveCount_(0)
+{
+}
+
+//=============================================================================
+// Starting and Cancelling
+//=============================================================================
+
+TweenSystem::TweenHandle TweenSystem::Start(Node* Target, const PropDescriptor* Prop,
+                                            const Vec4& To, float Duration, EaseType Ease,
+                                            std::function<void()> OnComplete)
+{
+  if (!Target || Target->GetOwningTree() != &Tree_) {
+    Log::Warn("TweenSystem::Start: target node is not in this scene tree");
+    return (0);
+  }
+  if (!Prop || (Prop->Type != PropType::Float && Prop->Type != PropType::Vec3 &&
+                Prop->Type != PropType::Vec4)) {
+    Log::Warn("TweenSystem::Start: only Float, Vec3 and Vec4 properties can be tweened");
+    return (0);
+  }
+  if (Ease >= EaseType::Count) {
+    Ease = EaseType::Linear;
+  }
+
+  // Current value, widened to four lanes
+  float From[LaneCount] = {0.0f, 0.0f, 0.0f, 0.0f};
+  if (Prop->Type == PropType::Float) {
+    From[0] = GetPropertyFloat(Target, Prop);
+  } else if (Prop->Type == PropType::Vec3) {
+    Vec3 V = GetPropertyVec3(Target, Prop);
+    From[0] = V.X;
+    From[1] = V.Y;
+    From[2] = V.Z;
+  } else {
+    Vec4 V = GetPropertyVec4(Target, Prop);
+    From[0] = V.X;
+    From[1] = V.Y;
+    From[2] = V.Z;
+    From[3] = V.W;
+  }
+  const float ToLanes[LaneCount] = {To.X, To.Y, To.Z, To.W};
+
+  uint32_t Slot;
+  if (!FreeSlots_.empty()) {
+    Slot = FreeSlots_.back();
+    FreeSlots_.pop_back();
+  } else {
+    Slot = static_cast<uint32_t>(Slots_.size());
+    Slots_.push_back({});
+  }
+
+  TweenLanes& Lanes = Lanes_[static_cast<uint32_t>(Ease)];
+  TweenSlot& Entry = Slots_[Slot];
+  Entry.Generation++;
+  Entry.Ease = static_cast<uint8_t>(Ease);
+  Entry.Index = static_cast<uint32_t>(Lanes.Slot.size());
+  Entry.OnComplete = std::move(OnComplete);
+
+  Lanes.Elapsed.push_back(0.0f);
+  Lanes.InvDuration.push_back((Duration > 0.0f) ? 1.0f / Duration : FLT_MAX);
+  for (uint32_t Lane = 0; Lane < LaneCount; ++Lane) {
+    Lanes.From[Lane].push_back(From[Lane]);
+    Lanes.Delta[Lane].push_back(ToLanes[Lane] - From[Lane]);
+  }
+  Lanes.Target.push_back(Target->GetHandle());
+  Lanes.Offset.push_back(Prop->Offset);
+  Lanes.Type.push_back(Prop->Type);
+  Lanes.Slot.push_back(Slot);
+  ActiveCount_++;
+
+  return ((static_cast<uint64_t>(Entry.Generation) << 32) | Slot);
+}
+
+TweenSystem::TweenHandle TweenSystem::Start(Node* Target, std::string_view PropName, float To,
+                                            float Duration, EaseType Ease,
+                                            std::function<void()> OnComplete)
+{
+  const PropDescriptor* Prop = FindTweenable(Target, PropName, PropType::Float);
+  return (Prop ? Start(Target, Prop, Vec4(To, 0.0f, 0.0f, 0.0f), Duration, Ease, std::move(OnComplete)) : 0);
+}
+
+TweenSystem::TweenHandle TweenSystem::Start(Node* Target, std::string_view PropName, const Vec3& To,
+                                            float Duration, EaseType Ease,
+                                            std::function<void()> OnComplete)
+{
+  const PropDescriptor* Prop = FindTweenable(Target, PropName, PropType::Vec3);
+  return (Prop ? Start(Target, Prop, Vec4(To, 0.0f), Duration, Ease, std::move(OnComplete)) : 0);
+}
+
+TweenSystem::TweenHandle TweenSystem::Start(Node* Target, std::string_view PropName, const Vec4& To,
+                                            float Duration, EaseType Ease,
+                                            std::function<void()> OnComplete)
+{
+  const PropDescriptor* Prop = FindTweenable(Target, PropName, PropType::Vec4);
+  return (Prop ? Start(Target, Prop, To, Duration, Ease, std::move(OnComplete)) : 0);
+}
+
+const PropDescriptor* TweenSystem::FindTweenable(Node* Target, std::string_view PropName,
+                                                 PropType Type) const
+{
+  if (!Target) {
+    Log::Warn("TweenSystem::Start: no target node");
+    return (nullptr);
+  }
+
+  const PropDescriptor* Prop = PropertyRegistry::Get().FindProperty(Target->GetType(), PropName);
+  if (!Prop || Prop->Type != Type) {
+    std::string Msg = "TweenSystem::Start: node '";
+    Msg += Target->GetName();
+    Msg += "' has no property '";
+    Msg += PropName;
+    Msg += "' of the tweened type";
+    Log::Warn(Msg);
+    return (nullptr);
+  }
+  return (Prop);
+}
+
+bool TweenSystem::Cancel(TweenHandle Handle)
+{
+  if (!IsActive(Handle)) {
+    return (false);
+  }
+  Remove(static_cast<uint32_t>(Handle));
+  return (true);
+}
+
+void TweenSystem::CancelTarget(Node* Target)
+{
+  if (!Target) {
+    return;
+  }
+
+  NodeHandle Handle = Target->GetHandle();
+  for (TweenLanes& Lanes : Lanes_) {
+    // Backwards: removal swaps a later tween into Index
+    for (uint32_t Index = static_cast<uint32_t>(Lanes.Slot.size()); Index-- > 0;) {
+      if (Lanes.Target[Index] == Handle) {
+        Remove(Lanes.Slot[Index]);
+      }
+    }
+  }
+}
+
+bool TweenSystem::IsActive(TweenHandle Handle) const
+{
+  uint32_t Slot = static_cast<uint32_t>(Handle);
+  uint32_t Generation = static_cast<uint32_t>(Handle >> 32);
+  return (Slot < Slots_.size() && (Generation & 1) != 0 &&
+          Slots_[Slot].Generation == Generation);
+}
+
+void TweenSystem::Clear()
+{
+  for (uint32_t Slot = 0; Slot < Slots_.size(); ++Slot) {
+    if ((Slots_[Slot].Generation & 1) != 0) {
+      Remove(Slot);
+    }
+  }
+}
+
+void TweenSystem::Remove(uint32_t Slot)
+{
+  TweenSlot& Entry = Slots_[Slot];
+  TweenLanes& Lanes = Lanes_[Entry.Ease];
+  uint32_t Index = Entry.Index;
+  uint32_t Last = static_cast<uint32_t>(Lanes.Slot.size()) - 1;
+
+  if (Index != Last) {
+    Lanes.Elapsed[Index] = Lanes.Elapsed[Last];
+    Lanes.InvDuration[Index] = Lanes.InvDuration[Last];
+    for (uint32_t Lane = 0; Lane < LaneCount; ++Lane) {
+      Lanes.From[Lane][Index] = Lanes.From[Lane][Last];
+      Lanes.Delta[Lane][Index] = Lanes.Delta[Lane][Last];
+    }
+    Lanes.Target[Index] = Lanes.Target[Last];
+    Lanes.Offset[Index] = Lanes.Offset[Last];
+    Lanes.Type[Index] = Lanes.Type[Last];
+    Lanes.Slot[Index] = Lanes.Slot[Last];
+    Slots_[Lanes.Slot[Index]].Index = Index;
+  }
+
+  Lanes.Elapsed.pop_back();
+  Lanes.InvDuration.pop_back();
+  for (uint32_t Lane = 0; Lane < LaneCount; ++Lane) {
+    Lanes.From[Lane].pop_back();
+    Lanes.Delta[Lane].pop_back();
+  }
+  Lanes.Target.pop_back();
+  Lanes.Offset.pop_back();
+  Lanes.Type.pop_back();
+  Lanes.Slot.pop_back();
+
+  Entry.OnComplete = nullptr;
+  Entry.Generation++;
+  FreeSlots_.push_back(Slot);
+  ActiveCount_--;
+}
+
+//=============================================================================
+// Stepping
+//=============================================================================
+
+void TweenSystem::Step(float DeltaT)
+{
+  if (ActiveCount_ == 0) {
+    return;
+  }
+
+  Completed_.clear();
+
+  for (uint32_t Curve = 0; Curve < static_cast<uint32_t>(EaseType::Count); ++Curve) {
+    TweenLanes& Lanes = Lanes_[Curve];
+    uint32_t Count = static_cast<uint32_t>(Lanes.Slot.size());
+    if (Count == 0) {
+      continue;
+    }
+
+    Progress_.resize(Count);
+    float* Progress = Progress_.data();
+    float* Elapsed = Lanes.Elapsed.data();
+    const float* InvDuration = Lanes.InvDuration.data();
+
+    // Progress, clamped at the end
+    for (uint32_t i = 0; i < Count; ++i) {
+      Elapsed[i] += DeltaT;
+      Progress[i] = std::min(Elapsed[i] * InvDuration[i], 1.0f);
+    }
+
+    // Finished tweens are exactly 1 here; collect them before easing
+    Finished_.clear();
+    for (uint32_t i = 0; i < Count; ++i) {
+      if (Progress[i] >= 1.0f) {
+        Finished_.push_back(i);
+      }
+    }
+
+    switch (static_cast<EaseType>(Curve)) {
+      case EaseType::InQuad:     ApplyCurve(Progress, Count, EaseInQuad); break;
+      case EaseType::OutQuad:    ApplyCurve(Progress, Count, EaseOutQuad); break;
+      case EaseType::InOutQuad:  ApplyCurve(Progress, Count, EaseInOutQuad); break;
+      case EaseType::InCubic:    ApplyCurve(Progress, Count, EaseInCubic); break;
+      case EaseType::OutCubic:   ApplyCurve(Progress, Count, EaseOutCubic); break;
+      case EaseType::InOutCubic: ApplyCurve(Progress, Count, EaseInOutCubic); break;
+      case EaseType::SmoothStep: ApplyCurve(Progress, Count, SmoothStepCurve); break;
+      default: break;
+    }
+
+    // Interpolate every component lane
+    for (uint32_t Lane = 0; Lane < LaneCount; ++Lane) {
+      Values_[Lane].resize(Count);
+      float* Value = Values_[Lane].data();
+      const float* From = Lanes.From[Lane].data();
+      const float* Delta = Lanes.Delta[Lane].data();
+      for (uint32_t i = 0; i < Count; ++i) {
+        Value[i] = From[i] + Delta[i] * Progress[i];
+      }
+    }
+
+    // Write back through each node; tweens of destroyed nodes are dropped
+    // without completing
+    for (uint32_t i = 0; i < Count; ++i) {
+      Node* Target = Tree_.Resolve(Lanes.Target[i]);
+      if (!Target) {
+        Slots_[Lanes.Slot[i]].OnComplete = nullptr;
+        if (Elapsed[i] * InvDuration[i] < 1.0f) {
+          Finished_.push_back(i);   // not collected above
+        }
+        continue;
+      }
+
+      char* Base = reinterpret_cast<char*>(Target) + Lanes.Offset[i];
+      switch (Lanes.Type[i]) {
+        case PropType::Float:
+          *reinterpret_cast<Property<float>*>(Base) = Values_[0][i];
+          break;
+        case PropType::Vec3:
+          *reinterpret_cast<Property<Vec3>*>(Base) = Vec3(Values_[0][i], Values_[1][i], Values_[2][i]);
+          break;
+        default:
+          *reinterpret_cast<Property<Vec4>*>(Base) =
+            Vec4(Values_[0][i], Values_[1][i], Values_[2][i], Values_[3][i]);
+          break;
+      }
+    }
+
+    // Highest index first, so every swap-remove moves a tween that is
+    // still running
+    std::sort(Finished_.begin(), Finished_.end());
+    for (size_t n = Finished_.size(); n-- > 0;) {
+      uint32_t Slot = Lanes.Slot[Finished_[n]];
+      if (Slots_[Slot].OnComplete) {
+        Completed_.push_back(std::move(Slots_[Slot].OnComplete));
+      }
+      Remove(Slot);
+    }
+  }
+
+  // After the pass: callbacks may start and cancel tweens
+  for (std::function<void()>& Callback : Completed_) {
+    Callback();
+  }
+  Completed_.clear();
+}
@@ -0,0 +1,144 @@
+/**
+ * AxWorkerPool.cpp - Persistent fork/join worker pool
+ *
+ * Workers sleep on WakeCV_ until Generation_ changes, then claim batches
+ * from an atomic counter. The caller claims batches as well and waits on
+ * DoneCV_ until every batch has finished and every worker has left the
+ * job, so the next job can safely reset the counters.
+ */
+
+#include "AxEngine/AxWorkerPool.h"
+
+//=============================================================================
+// Construction / Destruction
+//=============================================================================
+
+WorkerPool::WorkerPool(uint32_t WorkerCount)
+  : Body_(nullptr)
+  , Count_(0)
+  , BatchSize_(0)
+  , BatchCount_(0)
+  , Generation_(0)
+  , ActiveWorkers_(0)
+  , Stopping_(false)
+  , NextBatch_(0)
+  , FinishedBatches_(0)
+{
+  Threads_.reserve(WorkerCount);
+  for (uint32_t i = 0; i < WorkerCount; ++i) {
+    Threads_.emplace_back(&WorkerPool::WorkerMain, this);
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> Lock(Mutex_);
+    Stopping_ = true;
+  }
+  WakeCV_.notify_all();
+
+  for (std::thread& Thread : Threads_) {
+    Thread.join();
+  }
+}
+
+uint32_t WorkerPool::DefaultWorkerCount()
+{
+  uint32_t HardwareThreads = std::thread::hardware_concurrency();
+  return ((HardwareThreads > 1) ? HardwareThreads - 1 : 0);
+}
+
+//=============================================================================
+// Parallel Loop
+//=============================================================================
+
+void WorkerPool::ParallelFor(uint32_t Count, uint32_t MinBatch, const RangeFunction& Body)
+{
+  if (Count == 0) {
+    return;
+  }
+
+  uint32_t Parallelism = GetWorkerCount() + 1;
+  uint32_t MinSize = (MinBatch > 0) ? MinBatch : 1;
+
+  // Roughly four batches per thread for load balancing, never below MinBatch
+  uint32_t BatchSize = (Count + Parallelism * 4 - 1) / (Parallelism * 4);
+  BatchSize = (BatchSize < MinSize) ? MinSize : BatchSize;
+  uint32_t BatchCount = (Count + BatchSize - 1) / BatchSize;
+
+  if (Threads_.empty() || BatchCount < 2) {
+    Body(0, Count);
+    return;
+  }
+
+  {
+    // A worker that woke too late for the previous job may still be
+    // leaving it; let it go before the counters are reset
+    std::unique_lock<std::mutex> Lock(Mutex_);
+    DoneCV_.wait(Lock, [this]() { return (ActiveWorkers_ == 0); });
+
+    Body_ = &Body;
+    Count_ = Count;
+    BatchSize_ = BatchSize;
+    BatchCount_ = BatchCount;
+    NextBatch_.store(0, std::memory_order_relaxed);
+    FinishedBatches_.store(0, std::memory_order_relaxed);
+    Generation_++;
+  }
+  WakeCV_.notify_all();
+
+  RunBatches();
+
+  std::unique_lock<std::mutex> Lock(Mutex_);
+  DoneCV_.wait(Lock, [this]() {
+    return (FinishedBatches_.load(std::memory_order_acquire) == BatchCount_ && ActiveWorkers_ == 0);
+  });
+  Body_ = nullptr;
+}
+
+void WorkerPool::RunBatches()
+{
+  for (;;) {
+    uint32_t Batch = NextBatch_.fetch_add(1, std::memory_order_relaxed);
+    if (Batch >= BatchCount_) {
+      return;
+    }
+
+    uint32_t Begin = Batch * BatchSize_;
+    uint32_t End = (Begin + BatchSize_ < Count_) ? Begin + BatchSize_ : Count_;
+    (*Body_)(Begin, End);
+
+    FinishedBatches_.fetch_add(1, std::memory_order_release);
+  }
+}
+
+//=============================================================================
+// Worker Thread
+//=============================================================================
+
+void WorkerPool::WorkerMain()
+{
+  uint64_t SeenGeneration = 0;
+
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> Lock(Mutex_);
+      WakeCV_.wait(Lock, [&]() { return (Stopping_ || Generation_ != SeenGeneration); });
+      if (Stopping_) {
+        return;
+      }
+
+      SeenGeneration = Generation_;
+      ActiveWorkers_++;
+    }
+
+    RunBatches();
+
+    {
+      std::lock_guard<std::mutex> Lock(Mutex_);
+      ActiveWorkers_--;
+    }
+    DoneCV_.notify_one();
+  }
+}
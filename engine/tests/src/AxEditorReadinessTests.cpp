@@ -602,6 +602,54 @@ TEST_F(SnapshotRestoreTest, SnapshotPreservesHierarchy)
   delete Restored;
 }
 
+TEST_F(SnapshotRestoreTest, HandlesSurviveSnapshotRestore)
+{
+  // Give the tree some slot history so handles are not just 1..N
+  SceneTree* Original = new SceneTree(TableAPI_, nullptr);
+  Original->Name = "HandleSnapshot";
+  Original->DestroyNode(Original->CreateNode("Scratch", NodeType::Node3D, nullptr));
+
+  Node* Parent = Original->CreateNode("Parent", NodeType::Node3D, nullptr);
+  Node* Child  = Original->CreateNode("Child", NodeType::Light, Parent);
+  Node* Other  = Original->CreateNode("Other", NodeType::Node3D, nullptr);
+  NodeHandle ParentHandle = Parent->GetHandle();
+  NodeHandle ChildHandle  = Child->GetHandle();
+  NodeHandle OtherHandle  = Other->GetHandle();
+
+  // Snapshot as AxEngine::SnapshotScene does
+  std::string Snapshot = Parser_.SaveSceneToString(Original);
+  std::vector<NodeHandle> Handles;
+  Original->CaptureHandles(Handles);
+
+  // Play: destroy a node and spawn one that reuses its slot
+  Original->DestroyNode(Other);
+  NodeHandle PlayHandle = Original->CreateNode("Spawned", NodeType::Node3D, nullptr)->GetHandle();
+  uint32_t PlayGeneration = Original->GetHandleGeneration();
+  delete Original;
+
+  // Restore as AxEngine::RestoreSnapshot does
+  SceneTree* Restored = Parser_.LoadSceneFromString(Snapshot.c_str());
+  ASSERT_NE(Restored, nullptr);
+  ASSERT_TRUE(Restored->RestoreHandles(Handles, PlayGeneration));
+
+  EXPECT_EQ(Restored->Resolve(ParentHandle), Restored->FindNode("Parent"));
+  EXPECT_EQ(Restored->Resolve<LightNode>(ChildHandle), Restored->FindNode("Child"));
+  EXPECT_EQ(Restored->Resolve(OtherHandle), Restored->FindNode("Other"));
+  EXPECT_EQ(Restored->Resolve(PlayHandle), nullptr) << "Play-time node did not survive";
+
+  // New nodes never reuse a generation handed out during play
+  Node* Fresh = Restored->CreateNode("Fresh", NodeType::Node3D, nullptr);
+  EXPECT_GT(Fresh->GetHandle().Generation, PlayGeneration);
+  EXPECT_EQ(Restored->GetHandleCount(), Restored->GetNodeCount());
+
+  // A tree of a different shape is rejected untouched
+  Handles.pop_back();
+  EXPECT_FALSE(Restored->RestoreHandles(Handles, 0));
+  EXPECT_EQ(Restored->Resolve(ParentHandle), Restored->FindNode("Parent"));
+
+  delete Restored;
+}
+
 //=============================================================================
 // Task Group 5: Scene Serialization (Save) tests
 //
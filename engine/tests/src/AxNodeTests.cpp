@@ -2,10 +2,14 @@
  * AxNodeTests.cpp - Tests for Node hierarchy operations and script slot
  *
  * Tests the Node base class: creation, parent-child linking,
- * sibling order, reparenting, recursive child count, and removal.
+ * sibling order, reparenting, recursive child count, removal, and the
+ * doubly-linked sibling list (tail pointer and cached count).
  *
  * Also tests the Node script slot: AttachScript, DetachScript,
  * active-state integration, and ownership/destruction semantics.
+ *
+ * Ends with the layout audit: size budgets for Node, Transform, Property<T>
+ * and every typed node, and the cache-line placement of pooled nodes.
  */
 
 #include "gtest/gtest.h"
@@ -14,8 +18,13 @@
 #include "Foundation/AxAPIRegistry.h"
 #include "Foundation/AxMath.h"
 #include "AxEngine/AxNode.h"
+#include "AxEngine/AxNodePool.h"
+#include "AxEngine/AxProperty.h"
 #include "AxEngine/AxScriptBase.h"
+#include "AxEngine/AxTypedNodes.h"
 
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <vector>
 #include <string>
@@ -272,6 +281,55 @@ TEST_F(NodeTest, RemovalCleansUpSiblingLinks)
   EXPECT_EQ(childC.GetParent(), nullptr);
 }
 
+//=============================================================================
+// Test 7: Prev/Last links and cached count stay consistent through edits
+//=============================================================================
+TEST_F(NodeTest, DoublyLinkedChildListStaysConsistent)
+{
+  Node parent("Parent", NodeType::Node3D, TableAPI_);
+  Node other("Other", NodeType::Node3D, TableAPI_);
+  std::vector<Node*> children;
+  for (int i = 0; i < 5; ++i) {
+    children.push_back(new Node("Child", NodeType::Node3D, TableAPI_));
+    parent.AddChild(children.back());
+  }
+
+  // Walk the list backwards from the tail and check it mirrors the forward walk
+  auto ExpectLinks = [](Node& P, const std::vector<Node*>& Expected) {
+    EXPECT_EQ(P.GetChildCount(), static_cast<uint32_t>(Expected.size()));
+    EXPECT_EQ(P.GetFirstChild(), Expected.empty() ? nullptr : Expected.front());
+    EXPECT_EQ(P.GetLastChild(), Expected.empty() ? nullptr : Expected.back());
+    size_t i = Expected.size();
+    for (Node* C = P.GetLastChild(); C; C = C->GetPrevSibling()) {
+      ASSERT_GT(i, 0u);
+      EXPECT_EQ(C, Expected[--i]);
+    }
+    EXPECT_EQ(i, 0u);
+  };
+  ExpectLinks(parent, children);
+
+  // Remove last, first, then middle
+  parent.RemoveChild(children[4]);
+  parent.RemoveChild(children[0]);
+  parent.RemoveChild(children[2]);
+  ExpectLinks(parent, {children[1], children[3]});
+  EXPECT_EQ(children[2]->GetPrevSibling(), nullptr);
+
+  // Reparent appends at the new parent's tail
+  other.AddChild(children[4]);
+  children[3]->SetParent(&other);
+  ExpectLinks(parent, {children[1]});
+  ExpectLinks(other, {children[4], children[3]});
+
+  children[1]->SetParent(nullptr);
+  ExpectLinks(parent, {});
+
+  for (Node* C : children) {
+    delete C;
+  }
+  ExpectLinks(other, {});
+}
+
 //=============================================================================
 // Script Slot Tests
 //=============================================================================
@@ -443,3 +501,88 @@ TEST_F(NodeTest, DetachScript_ClearsOwner)
   delete Returned;
 }
 
+
+//=============================================================================
+// Layout audit
+//=============================================================================
+
+// Budgets on 64-bit targets, at the sizes after the hot/cold split (Node
+// was 512 bytes before it, Transform 184). Growing past one is a layout
+// decision: hot data goes within Node::HotBytes (checked in AxNode.cpp),
+// anything else after the transform or in Node::ColdData.
+#if INTPTR_MAX == INT64_MAX
+static_assert(sizeof(Transform) <= 120, "Transform grew past its layout budget");
+static_assert(sizeof(Node) <= 352, "Node grew past its layout budget");
+static_assert(sizeof(MeshInstance) <= 456, "MeshInstance grew past its layout budget");
+static_assert(sizeof(CameraNode) <= 392, "CameraNode grew past its layout budget");
+static_assert(sizeof(LightNode) <= 408, "LightNode grew past its layout budget");
+static_assert(sizeof(RigidBodyNode) <= 400, "RigidBodyNode grew past its layout budget");
+static_assert(sizeof(ColliderNode) <= 400, "ColliderNode grew past its layout budget");
+static_assert(sizeof(AudioSourceNode) <= 416, "AudioSourceNode grew past its layout budget");
+static_assert(sizeof(AudioListenerNode) <= 352, "AudioListenerNode grew past its layout budget");
+static_assert(sizeof(AnimatorNode) <= 408, "AnimatorNode grew past its layout budget");
+static_assert(sizeof(ParticleEmitterNode) <= 392, "ParticleEmitterNode grew past its layout budget");
+static_assert(sizeof(SpriteNode) <= 424, "SpriteNode grew past its layout budget");
+#endif
+
+// Properties hold a 32-bit owner offset next to the value, not a pointer
+static_assert(sizeof(Property<float>) == 8, "Property<float> must stay 8 bytes");
+static_assert(sizeof(Property<bool>) == 8, "Property<bool> must stay 8 bytes");
+static_assert(sizeof(Property<Vec3>) == 16, "Property<Vec3> must stay 16 bytes");
+static_assert(sizeof(Property<Vec4>) == 20, "Property<Vec4> must stay 20 bytes");
+static_assert(sizeof(Property<std::string>) <= sizeof(std::string) + 8,
+              "Property<std::string> must add at most one word to the string");
+
+//=============================================================================
+// Layout Test 1: pooled nodes start on a cache line
+//=============================================================================
+TEST_F(NodeTest, PooledNodesStartOnACacheLine)
+{
+  NodePool Pool;
+  std::vector<Node*> Nodes;
+  for (int i = 0; i < 4; ++i) {
+    Nodes.push_back(Pool.Create<Node3D>(NodeType::Node3D, nullptr, "N", TableAPI_));
+    Nodes.push_back(Pool.Create<MeshInstance>(NodeType::MeshInstance, nullptr, "M", TableAPI_));
+    Nodes.push_back(Pool.Create<LightNode>(NodeType::Light, nullptr, "L", TableAPI_));
+  }
+
+  // The first HotBytes of every node then cover exactly two cache lines
+  EXPECT_EQ(Node::HotBytes, 128u);
+  for (Node* Each : Nodes) {
+    ASSERT_NE(Each, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(Each) % 64, 0u);
+  }
+}
+
+//=============================================================================
+// Layout Test 2: per-type sizes, printed on demand (the budgets above are
+// enforced by static_assert; run with --gtest_also_run_disabled_tests)
+//=============================================================================
+TEST_F(NodeTest, DISABLED_LayoutAudit_ReportsTypeSizes)
+{
+  struct SizeRow
+  {
+    const char* Name;
+    size_t Size;
+  };
+  const SizeRow Rows[] = {
+    {"Transform", sizeof(Transform)},
+    {"Node", sizeof(Node)},
+    {"MeshInstance", sizeof(MeshInstance)},
+    {"CameraNode", sizeof(CameraNode)},
+    {"LightNode", sizeof(LightNode)},
+    {"RigidBodyNode", sizeof(RigidBodyNode)},
+    {"ColliderNode", sizeof(ColliderNode)},
+    {"AudioSourceNode", sizeof(AudioSourceNode)},
+    {"AudioListenerNode", sizeof(AudioListenerNode)},
+    {"AnimatorNode", sizeof(AnimatorNode)},
+    {"ParticleEmitterNode", sizeof(ParticleEmitterNode)},
+    {"SpriteNode", sizeof(SpriteNode)},
+  };
+
+  printf("  [Layout] hot bytes per node: %zu\n", Node::HotBytes);
+  for (const SizeRow& Row : Rows) {
+    printf("  [Layout] %-20s %4zu bytes\n", Row.Name, Row.Size);
+    EXPECT_GE(Row.Size, sizeof(Transform));
+  }
+}
@@ -10,6 +10,8 @@
  * - Multiple nodes with mixed typed node types
  * - .axp prefab loading creates standalone subtree
  * - Prefab instantiation creates deep copy
+ * - Compiled prefabs are cached by content, shared across scenes, and
+ *   malformed prefabs are rejected without being cached
  * - Parser produces SceneTree with correct light and node data
  * - Parser calls SceneTree->CreateNode for typed nodes directly
  */
@@ -25,6 +27,7 @@
 #include "AxEngine/AxTypedNodes.h"
 #include "AxEngine/AxSceneTree.h"
 #include "AxEngine/AxSceneParser.h"
+#include "AxEngine/AxPrefabTemplate.h"
 
 #include <string>
 #include <string_view>
@@ -474,3 +477,74 @@ TEST_F(ParserExTest, TG5_ParserExCallsSceneTreeDirectlyForTypedNodes)
 
   delete Tree;
 }
+
+//=============================================================================
+// Test 8: Compiled prefabs are cached by content and shared across scenes
+//=============================================================================
+TEST_F(ParserExTest, CompiledPrefabIsCachedAndSharedAcrossScenes)
+{
+  const char* PrefabData = R"(node "Crate" RigidBody {
+    mass: 12.0
+    bodyType: kinematic
+    transform {
+      translation: 0.0, 2.0, 0.0
+    }
+    node "Lid" MeshInstance {
+      mesh: "res://lid.glb"
+      renderLayer: 3
+    }
+  })";
+
+  const PrefabTemplate* Template = Parser_.CompilePrefab(PrefabData);
+  ASSERT_NE(Template, nullptr);
+  ASSERT_EQ(Template->GetNodeCount(), 2u);
+  EXPECT_EQ(Template->GetRecord(1).Parent, 0u);
+  EXPECT_FLOAT_EQ(Template->GetRecord(0).Local.Translation.Y, 2.0f);
+
+  // Same text (even from another buffer) hits the cache; other text does not
+  std::string Copy(PrefabData);
+  EXPECT_EQ(Parser_.CompilePrefab(Copy.c_str()), Template);
+  EXPECT_NE(Parser_.CompilePrefab(R"(node "Other" { })"), Template);
+  EXPECT_EQ(Parser_.GetPrefabCacheSize(), 2u);
+
+  // One template, two scenes, no live copy source in either
+  SceneTree* First = new SceneTree(TableAPI_, Allocator_);
+  SceneTree* Second = new SceneTree(TableAPI_, Allocator_);
+  Node* A = Parser_.InstantiatePrefab(First, *Template, nullptr);
+  Node* B = Parser_.ParsePrefab(PrefabData, Second);
+  ASSERT_NE(A, nullptr);
+  ASSERT_NE(B, nullptr);
+  EXPECT_EQ(First->GetNodeCount(), 3u);
+  EXPECT_EQ(Second->GetNodeCount(), 3u);
+  EXPECT_EQ(Parser_.GetPrefabCacheSize(), 2u);
+
+  for (Node* Crate : {A, B}) {
+    auto* Body = static_cast<RigidBodyNode*>(Crate);
+    EXPECT_FLOAT_EQ(Body->Mass, 12.0f);
+    EXPECT_TRUE(Body->BodyKind == BodyType::Kinematic);
+    EXPECT_FLOAT_EQ(Crate->GetTransform().Translation.Y, 2.0f);
+
+    auto* Lid = static_cast<MeshInstance*>(Crate->FindChild("Lid"));
+    ASSERT_NE(Lid, nullptr);
+    EXPECT_TRUE(Lid->MeshPath == "res://lid.glb");
+    EXPECT_EQ(Lid->RenderLayer.Get(), 3);
+  }
+
+  Parser_.ClearPrefabCache();
+  EXPECT_EQ(Parser_.GetPrefabCacheSize(), 0u);
+
+  delete First;
+  delete Second;
+}
+
+//=============================================================================
+// Test 9: A prefab that fails to compile is reported and not cached
+//=============================================================================
+TEST_F(ParserExTest, CompilePrefabRejectsMalformedText)
+{
+  EXPECT_EQ(Parser_.CompilePrefab(R"(scene "NotAPrefab" { })"), nullptr);
+  EXPECT_EQ(Parser_.CompilePrefab(R"(node "Broken" Spaceship { })"), nullptr);
+  EXPECT_NE(std::string(Parser_.GetLastError()).find("Spaceship"), std::string::npos);
+  EXPECT_EQ(Parser_.CompilePrefab(R"(node "Open" { node "Child" { )"), nullptr);
+  EXPECT_EQ(Parser_.GetPrefabCacheSize(), 0u);
+}
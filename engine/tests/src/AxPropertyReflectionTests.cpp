@@ -105,6 +105,30 @@ TEST_F(PropertyTest, ClearPropertiesDirty_Resets)
   EXPECT_FALSE(Owner.IsPropertiesDirty());
 }
 
+TEST_F(PropertyTest, PropertyToProperty_MarksOnlyTargetOwnerDirty)
+{
+  LightNode Source("Source", TableAPI_);
+  LightNode Target("Target", TableAPI_);
+  Source.Intensity = 3.0f;
+  Source.Color = Vec3(1.0f, 0.0f, 0.0f);
+  Source.ClearPropertiesDirty();
+
+  Target.Intensity = Source.Intensity;
+  Target.Color = Source.Color;
+  EXPECT_FLOAT_EQ(Target.Intensity, 3.0f);
+  EXPECT_FLOAT_EQ(Target.Color.X, 1.0f);
+  EXPECT_TRUE(Target.IsPropertiesDirty());
+  EXPECT_FALSE(Source.IsPropertiesDirty());
+
+  // A copy keeps the value but has no owner to mark
+  Target.ClearPropertiesDirty();
+  Property<float> Copy = Target.Intensity;
+  Copy = 7.0f;
+  EXPECT_FLOAT_EQ(Copy, 7.0f);
+  EXPECT_FLOAT_EQ(Target.Intensity, 3.0f);
+  EXPECT_FALSE(Target.IsPropertiesDirty());
+}
+
 //=============================================================================
 // Property<T> — Equality
 //=============================================================================
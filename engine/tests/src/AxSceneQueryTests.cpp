@@ -2,7 +2,8 @@
  * AxSceneQueryTests.cpp - Tests for Scene Query APIs
  *
  * Tests: GetChildren iteration, GetNode path resolution, GetNode<T> typed
- * variant, FindChildByType<T>, string-based groups, and ScriptBase wrappers.
+ * variant, FindChildByType<T>, groups by name and by ID, name/ID indices,
+ * precompiled NodePath caching, and ScriptBase wrappers.
  */
 
 #include "gtest/gtest.h"
@@ -13,6 +14,7 @@
 #include "AxEngine/AxTypedNodes.h"
 #include "AxEngine/AxSceneTree.h"
 #include "AxEngine/AxScriptBase.h"
+#include "AxEngine/AxNodePath.h"
 
 #include <string>
 #include <vector>
@@ -355,6 +357,263 @@ TEST_F(SceneQueryTest, DestroyNode_SubtreeRemovesFromGroups)
   EXPECT_EQ(Tree_->GetGroupSize("group2"), 0u);
 }
 
+TEST_F(SceneQueryTest, GroupIds_AreDenseAndResolveBothWays)
+{
+  GroupId Enemies = Tree_->GetGroupId("enemies");
+  GroupId Pickups = Tree_->GetGroupId("pickups");
+  EXPECT_EQ(Enemies, 0u);
+  EXPECT_EQ(Pickups, 1u);
+  EXPECT_EQ(Tree_->GetGroupId("enemies"), Enemies);
+  EXPECT_EQ(Tree_->FindGroupId("pickups"), Pickups);
+  EXPECT_EQ(Tree_->FindGroupId("missing"), InvalidGroupId);
+  EXPECT_EQ(Tree_->GetGroupId(""), InvalidGroupId);
+  EXPECT_EQ(Tree_->GetGroupName(Pickups), "pickups");
+
+  Node* A = Tree_->CreateNode("A", NodeType::Node3D);
+  A->AddToGroup(Pickups);
+  EXPECT_TRUE(A->IsInGroup("pickups"));
+  EXPECT_TRUE(A->IsInGroup(Pickups));
+  EXPECT_FALSE(A->IsInGroup(Enemies));
+  EXPECT_EQ(Tree_->GetGroupSize(Pickups), 1u);
+
+  // Name-based membership goes through the same IDs
+  A->AddToGroup("enemies");
+  EXPECT_TRUE(A->IsInGroup(Enemies));
+  EXPECT_EQ(A->GetGroupCount(), 2u);
+}
+
+TEST_F(SceneQueryTest, RemoveFromGroup_SwapRemoveKeepsOtherMembersConsistent)
+{
+  GroupId Enemies = Tree_->GetGroupId("enemies");
+  std::vector<Node*> Nodes;
+  for (int i = 0; i < 6; ++i) {
+    Nodes.push_back(Tree_->CreateNode("E", NodeType::Node3D));
+    Nodes.back()->AddToGroup(Enemies);
+  }
+
+  // Remove from the middle, then destroy the node moved into its place
+  Nodes[1]->RemoveFromGroup(Enemies);
+  const std::vector<Node*>& Members = Tree_->GetNodesInGroup(Enemies);
+  ASSERT_EQ(Members.size(), 5u);
+  EXPECT_EQ(Members[1], Nodes[5]);
+  Tree_->DestroyNode(Nodes[5]);
+  Nodes[3]->RemoveFromGroup(Enemies);
+
+  std::vector<Node*> Expected = {Nodes[0], Nodes[4], Nodes[2]};
+  EXPECT_EQ(Members, Expected);
+  for (Node* Member : Expected) {
+    EXPECT_TRUE(Member->IsInGroup(Enemies));
+  }
+  EXPECT_FALSE(Nodes[1]->IsInGroup(Enemies));
+  EXPECT_FALSE(Nodes[3]->IsInGroup(Enemies));
+
+  // Every remaining member can still leave
+  for (Node* Member : Expected) {
+    Member->RemoveFromGroup(Enemies);
+  }
+  EXPECT_EQ(Tree_->GetGroupSize(Enemies), 0u);
+}
+
+TEST_F(SceneQueryTest, GroupIds_BeyondTheMaskStillTrackMembership)
+{
+  Node* A = Tree_->CreateNode("A", NodeType::Node3D);
+  std::vector<GroupId> Ids;
+  for (int i = 0; i < 70; ++i) {
+    Ids.push_back(Tree_->GetGroupId("g" + std::to_string(i)));
+  }
+
+  A->AddToGroup(Ids[69]);
+  A->AddToGroup(Ids[3]);
+  A->AddToGroup(Ids[66]);
+  EXPECT_TRUE(A->IsInGroup(Ids[69]));
+  EXPECT_TRUE(A->IsInGroup(Ids[66]));
+  EXPECT_TRUE(A->IsInGroup(Ids[3]));
+  EXPECT_FALSE(A->IsInGroup(Ids[67]));
+  EXPECT_FALSE(A->IsInGroup(Ids[64]));
+
+  A->RemoveFromGroup(Ids[66]);
+  EXPECT_FALSE(A->IsInGroup("g66"));
+  EXPECT_TRUE(A->IsInGroup("g69"));
+
+  Tree_->DestroyNode(A);
+  EXPECT_EQ(Tree_->GetGroupSize(Ids[69]), 0u);
+  EXPECT_EQ(Tree_->GetGroupSize(Ids[3]), 0u);
+}
+
+//=============================================================================
+// Name and ID Index Tests
+//=============================================================================
+
+TEST_F(SceneQueryTest, FindNode_DuplicateNames_ReturnsEarliestCreated)
+{
+  Node* Holder = Tree_->CreateNode("Holder", NodeType::Node3D);
+  Node* Later  = Tree_->CreateNode("Enemy", NodeType::Node3D, Holder);
+  Node* First  = Tree_->CreateNode("Enemy", NodeType::Node3D);
+  (void)Later;
+
+  // First was created after Later, so Later wins
+  EXPECT_EQ(Tree_->FindNode("Enemy"), Later);
+
+  std::vector<Node*> All;
+  Tree_->FindNodesByName("Enemy", All);
+  ASSERT_EQ(All.size(), 2u);
+  EXPECT_EQ(All[0], Later);
+  EXPECT_EQ(All[1], First);
+
+  Tree_->DestroyNode(Holder);
+  EXPECT_EQ(Tree_->FindNode("Enemy"), First);
+  EXPECT_EQ(Tree_->FindNode("Holder"), nullptr);
+}
+
+TEST_F(SceneQueryTest, SetName_UpdatesNameIndex)
+{
+  Node* A = Tree_->CreateNode("Old", NodeType::Node3D);
+  Node* Child = Tree_->CreateNode("Child", NodeType::Node3D, A);
+
+  Child->SetName("Renamed");
+  EXPECT_EQ(Child->GetName(), "Renamed");
+  EXPECT_EQ(Tree_->FindNode("Child"), nullptr);
+  EXPECT_EQ(Tree_->FindNode("Renamed"), Child);
+  EXPECT_EQ(A->GetNode("Renamed"), Child);
+
+  Node3D Standalone("Loose", TableAPI_);
+  Standalone.SetName("StillLoose");
+  EXPECT_EQ(Standalone.GetName(), "StillLoose");
+  EXPECT_EQ(Tree_->FindNode("StillLoose"), nullptr);
+}
+
+TEST_F(SceneQueryTest, GetNodeByID_TracksCreateAndDestroy)
+{
+  Node* A = Tree_->CreateNode("A", NodeType::Node3D);
+  Node* B = Tree_->CreateNode("B", NodeType::Node3D, A);
+  uint32_t BID = B->GetNodeID();
+
+  EXPECT_EQ(Tree_->GetNodeByID(Tree_->GetRootNode()->GetNodeID()), Tree_->GetRootNode());
+  EXPECT_EQ(Tree_->GetNodeByID(A->GetNodeID()), A);
+  EXPECT_EQ(Tree_->GetNodeByID(BID), B);
+  EXPECT_EQ(Tree_->GetNodeByID(0), nullptr);
+  EXPECT_EQ(Tree_->GetNodeByID(9999), nullptr);
+
+  Tree_->DestroyNode(A);
+  EXPECT_EQ(Tree_->GetNodeByID(BID), nullptr);
+}
+
+TEST_F(SceneQueryTest, FindChild_DuplicateSiblings_ReturnsFirstInSiblingOrder)
+{
+  Node* Parent = Tree_->CreateNode("Parent", NodeType::Node3D);
+  Node* Other  = Tree_->CreateNode("Other", NodeType::Node3D);
+  Tree_->CreateNode("Slot", NodeType::Node3D, Other);
+  Node* Second = Tree_->CreateNode("Slot", NodeType::Node3D, Parent);
+  Node* Third  = Tree_->CreateNode("Slot", NodeType::Node3D, Parent);
+  (void)Third;
+
+  EXPECT_EQ(Parent->FindChild("Slot"), Second);
+
+  // Standalone children are not indexed but are still found
+  Node3D Loose("Loose", TableAPI_);
+  Parent->AddChild(&Loose);
+  EXPECT_EQ(Parent->GetNode("Loose"), &Loose);
+  Parent->RemoveChild(&Loose);
+}
+
+TEST_F(SceneQueryTest, FindChild_CommonName_FallsBackToSiblings)
+{
+  // More same-named nodes than the index inspects before falling back
+  for (int i = 0; i < 40; ++i) {
+    Node* Limb = Tree_->CreateNode("Limb", NodeType::Node3D);
+    Tree_->CreateNode("Bone", NodeType::Node3D, Limb);
+  }
+  Node* Last = Tree_->CreateNode("Limb", NodeType::Node3D);
+  Node* Bone = Tree_->CreateNode("Bone", NodeType::Node3D, Last);
+
+  EXPECT_EQ(Last->FindChild("Bone"), Bone);
+  EXPECT_EQ(Last->GetNode("Bone"), Bone);
+}
+
+//=============================================================================
+// NodePath Tests
+//=============================================================================
+
+TEST_F(SceneQueryTest, NodePath_ParsesSegmentsOnce)
+{
+  NodePath Path("../Arm/Hand/");
+  EXPECT_EQ(Path.GetPath(), "../Arm/Hand");
+  EXPECT_EQ(Path.GetSegmentCount(), 3u);
+  EXPECT_TRUE(NodePath("").IsEmpty());
+}
+
+TEST_F(SceneQueryTest, NodePath_ResolvesLikeGetNode)
+{
+  Node* Body = Tree_->CreateNode("Body", NodeType::Node3D);
+  Node* Arm  = Tree_->CreateNode("Arm", NodeType::Node3D, Body);
+  Node* Hand = Tree_->CreateNode("Hand", NodeType::MeshInstance, Arm);
+  Node* Leg  = Tree_->CreateNode("Leg", NodeType::Node3D, Body);
+
+  NodePath ToHand("../Arm/Hand");
+  EXPECT_EQ(ToHand.Resolve(Leg), Hand);
+  EXPECT_EQ(Leg->GetNode(ToHand), Leg->GetNode("../Arm/Hand"));
+  EXPECT_EQ(ToHand.Resolve<MeshInstance>(Leg), static_cast<MeshInstance*>(Hand));
+  EXPECT_EQ(ToHand.Resolve<CameraNode>(Leg), nullptr);
+  EXPECT_EQ(NodePath().Resolve(Leg), Leg);
+  EXPECT_EQ(ToHand.Resolve(nullptr), nullptr);
+}
+
+TEST_F(SceneQueryTest, NodePath_CacheInvalidatedByStructureChanges)
+{
+  Node* Body = Tree_->CreateNode("Body", NodeType::Node3D);
+  Node* Arm  = Tree_->CreateNode("Arm", NodeType::Node3D, Body);
+  Node* Hand = Tree_->CreateNode("Hand", NodeType::Node3D, Arm);
+
+  NodePath ToHand("Arm/Hand");
+  EXPECT_EQ(ToHand.Resolve(Body), Hand);
+
+  uint64_t Version = Tree_->GetStructureVersion();
+  EXPECT_EQ(ToHand.Resolve(Body), Hand);
+  EXPECT_EQ(Tree_->GetStructureVersion(), Version) << "Lookups do not change structure";
+
+  // Rename
+  Hand->SetName("Claw");
+  EXPECT_NE(Tree_->GetStructureVersion(), Version);
+  EXPECT_EQ(ToHand.Resolve(Body), nullptr);
+
+  // Create
+  Node* NewHand = Tree_->CreateNode("Hand", NodeType::Node3D, Arm);
+  EXPECT_EQ(ToHand.Resolve(Body), NewHand);
+
+  // Reparent
+  Body->AddChild(NewHand);
+  EXPECT_EQ(ToHand.Resolve(Body), nullptr);
+  Arm->AddChild(NewHand);
+  EXPECT_EQ(ToHand.Resolve(Body), NewHand);
+
+  // Destroy
+  Tree_->DestroyNode(NewHand);
+  EXPECT_EQ(ToHand.Resolve(Body), nullptr);
+
+  // Another starting node
+  Node* OtherBody = Tree_->CreateNode("OtherBody", NodeType::Node3D);
+  Node* OtherArm  = Tree_->CreateNode("Arm", NodeType::Node3D, OtherBody);
+  Node* OtherHand = Tree_->CreateNode("Hand", NodeType::Node3D, OtherArm);
+  EXPECT_EQ(ToHand.Resolve(OtherBody), OtherHand);
+}
+
+TEST_F(SceneQueryTest, NodePath_NotCachedAcrossTrees)
+{
+  NodePath ToChild("Child");
+  {
+    SceneTree First(TableAPI_, nullptr);
+    Node* Parent = First.CreateNode("Parent", NodeType::Node3D);
+    First.CreateNode("Child", NodeType::Node3D, Parent);
+    ASSERT_NE(ToChild.Resolve(Parent), nullptr);
+  }
+
+  SceneTree Second(TableAPI_, nullptr);
+  Node* Parent = Second.CreateNode("Parent", NodeType::Node3D);
+  EXPECT_EQ(ToChild.Resolve(Parent), nullptr);
+  Node* Child = Second.CreateNode("Child", NodeType::Node3D, Parent);
+  EXPECT_EQ(ToChild.Resolve(Parent), Child);
+}
+
 //=============================================================================
 // Integration Tests: ScriptBase Wrappers
 //=============================================================================
@@ -392,6 +651,37 @@ TEST_F(SceneQueryTest, Script_GetNode_DelegatesToOwner)
   EXPECT_TRUE(Script->InGroup);
 }
 
+struct QueryPathTestScript : public ScriptBase
+{
+  NodePath SiblingPath{"../Sibling"};
+  Node* FoundNode = nullptr;
+  CameraNode* FoundCamera = nullptr;
+
+  void OnUpdate(float DeltaT) override
+  {
+    (void)DeltaT;
+    FoundNode = GetNode(SiblingPath);
+    FoundCamera = GetNode<CameraNode>(NodePath("../Cam"));
+  }
+};
+
+TEST_F(SceneQueryTest, Script_GetNodeWithNodePath_DelegatesToOwner)
+{
+  Node* Parent = Tree_->CreateNode("Parent", NodeType::Node3D);
+  Node* A = Tree_->CreateNode("A", NodeType::Node3D, Parent);
+  Node* Sibling = Tree_->CreateNode("Sibling", NodeType::Node3D, Parent);
+  Node* Cam = Tree_->CreateNode("Cam", NodeType::Camera, Parent);
+
+  auto* Script = new QueryPathTestScript();
+  A->AttachScript(Script);
+
+  Tree_->Update(0.016f);
+  Tree_->Update(0.016f);
+
+  EXPECT_EQ(Script->FoundNode, Sibling);
+  EXPECT_EQ(Script->FoundCamera, static_cast<CameraNode*>(Cam));
+}
+
 //=============================================================================
 // Integration: Combined Workflow
 //=============================================================================
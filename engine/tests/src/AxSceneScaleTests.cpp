@@ -0,0 +1,1194 @@
+/**
+ * AxSceneScaleTests.cpp - Large-scene correctness tests and benchmarks
+ *
+ * Checks SceneTree past any historical fixed capacity and times its hot
+ * paths at scale; the benchmarks are disabled (run them with
+ * --gtest_also_run_disabled_tests).
+ *
+ * Hierarchies use a bounded fan-out so build cost stays linear.
+ *
+ * NOTE: Script subclass names must be unique across all TUs linked into
+ * AxEngineTests to avoid ODR violations.
+ */
+
+#include "gtest/gtest.h"
+#include "Foundation/AxTypes.h"
+#include "Foundation/AxHashTable.h"
+#include "Foundation/AxAPIRegistry.h"
+#include "Foundation/AxMath.h"
+#include "AxEngine/AxSceneTree.h"
+#include "AxEngine/AxNode.h"
+#include "AxEngine/AxScriptBase.h"
+#include "AxEngine/AxNodePath.h"
+#include "AxEngine/AxWorkerPool.h"
+#include "AxEngine/AxSceneParser.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+//=============================================================================
+// SceneScaleCountingScript - counts init and per-frame callbacks
+//=============================================================================
+
+struct SceneScaleCountingScript : public ScriptBase
+{
+  int InitCount   = 0;
+  int UpdateCount = 0;
+
+  void OnInit()        override { ++InitCount; }
+  void OnUpdate(float) override { ++UpdateCount; }
+};
+
+// Some per-entity math on its own node, e.g. cosmetic bobbing
+struct SceneScaleBobScript : public ScriptBase
+{
+  static constexpr ScriptAccess UpdateAccess = ScriptAccess::OwnNode;
+
+  float Phase = 0.0f;
+
+  SceneScaleBobScript() { DeclareAccess(DetectAccess<SceneScaleBobScript>()); }
+
+  void OnUpdate(float DeltaT) override
+  {
+    float Height = 0.0f;
+    for (int i = 0; i < 64; ++i) {
+      Phase += DeltaT;
+      Height += std::sin(Phase * static_cast<float>(i + 1)) / static_cast<float>(i + 1);
+    }
+    Vec3 Pos = GetOwner()->GetTransform().Translation;
+    GetOwner()->SetPosition(Pos.X, Height, Pos.Z);
+  }
+};
+
+// Owns coroutine tasks and has no per-frame callbacks of its own
+struct SceneScaleTaskScript : public ScriptBase
+{
+  using ScriptBase::StartTask;
+  using ScriptBase::StopAllTasks;
+
+  uint32_t Wakeups = 0;
+
+  SceneScaleTaskScript() { DeclareCallbacks(ScriptCallbacks::None); }
+
+  ScriptTask Sleep(float Seconds)
+  {
+    co_await WaitSeconds(Seconds);
+    ++Wakeups;
+  }
+
+  ScriptTask Repeat(uint32_t Frames)
+  {
+    for (;;) {
+      co_await WaitFrames(Frames);
+      ++Wakeups;
+    }
+  }
+};
+
+//=============================================================================
+// Helpers
+//=============================================================================
+
+using SceneScaleClock = std::chrono::high_resolution_clock;
+
+static double SceneScaleMs(SceneScaleClock::time_point Start, SceneScaleClock::time_point End)
+{
+  return (std::chrono::duration<double, std::milli>(End - Start).count());
+}
+
+/**
+ * Builds Count nodes under Root in breadth-first order with at most FanOut
+ * children per parent. Nodes are appended to Out in creation order.
+ */
+static void BuildFanOutTree(SceneTree* Tree, uint32_t Count, uint32_t FanOut,
+                            NodeType Type, std::vector<Node*>& Out)
+{
+  Out.reserve(Out.size() + Count);
+  size_t First = Out.size();
+  for (uint32_t i = 0; i < Count; ++i) {
+    Node* Parent = (i < FanOut) ? nullptr : Out[First + (i / FanOut) - 1];
+    Out.push_back(Tree->CreateNode("N", Type, Parent));
+  }
+}
+
+//=============================================================================
+// Test Fixture
+//=============================================================================
+
+class SceneScaleTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    AxonInitGlobalAPIRegistry();
+    AxonRegisterAllFoundationAPIs(AxonGlobalAPIRegistry);
+
+    TableAPI_ = static_cast<AxHashTableAPI*>(
+      AxonGlobalAPIRegistry->Get(AXON_HASH_TABLE_API_NAME));
+    ASSERT_NE(TableAPI_, nullptr);
+
+    Tree_ = new SceneTree(TableAPI_, nullptr);
+    Tree_->Name = "ScaleSceneTree";
+  }
+
+  void TearDown() override
+  {
+    delete Tree_;
+    Tree_ = nullptr;
+
+    AxonTermGlobalAPIRegistry();
+  }
+
+  // Builds, flushes, re-dirties and destroys a NodeCount scene, printing timings
+  void RunTransformBenchmark(uint32_t NodeCount)
+  {
+    std::vector<Node*> Nodes;
+
+    auto BuildStart = SceneScaleClock::now();
+    BuildFanOutTree(Tree_, NodeCount, 10, NodeType::Node3D, Nodes);
+    auto BuildEnd = SceneScaleClock::now();
+
+    Tree_->Update(0.016f);
+    auto FlushEnd = SceneScaleClock::now();
+
+    for (uint32_t i = 0; i < NodeCount; ++i) {
+      Nodes[i]->SetPosition(static_cast<float>(i & 7), 0.0f, 0.0f);
+    }
+    auto DirtyEnd = SceneScaleClock::now();
+    Tree_->Update(0.016f);
+    auto ReflushEnd = SceneScaleClock::now();
+
+    // Every node must have been reached, including the last one created
+    Node* Last = Nodes.back();
+    EXPECT_FALSE(Last->GetTransform().IsDirty());
+    EXPECT_EQ(Tree_->GetNodeCount(), NodeCount + 1);
+
+    auto TeardownStart = SceneScaleClock::now();
+    delete Tree_;
+    Tree_ = nullptr;
+    auto TeardownEnd = SceneScaleClock::now();
+
+    printf("SceneTree %u nodes: build %.2f ms, initial flush %.2f ms, "
+           "dirty-all %.2f ms, re-flush %.2f ms, teardown %.2f ms\n",
+           NodeCount, SceneScaleMs(BuildStart, BuildEnd), SceneScaleMs(BuildEnd, FlushEnd),
+           SceneScaleMs(FlushEnd, DirtyEnd), SceneScaleMs(DirtyEnd, ReflushEnd),
+           SceneScaleMs(TeardownStart, TeardownEnd));
+  }
+
+  AxHashTableAPI* TableAPI_{nullptr};
+  SceneTree* Tree_{nullptr};
+};
+
+//=============================================================================
+// Capacity
+//=============================================================================
+
+TEST_F(SceneScaleTest, DirtyRootsPast1024AreAllFlushed)
+{
+  const uint32_t Count = 5000;
+  std::vector<Node*> Nodes;
+  for (uint32_t i = 0; i < Count; ++i) {
+    Nodes.push_back(Tree_->CreateNode("Flat", NodeType::Node3D, nullptr));
+  }
+  Tree_->Update(0.016f);
+
+  for (uint32_t i = 0; i < Count; ++i) {
+    Nodes[i]->SetPosition(static_cast<float>(i), 0.0f, 0.0f);
+  }
+  Tree_->Update(0.016f);
+
+  for (uint32_t i = 0; i < Count; ++i) {
+    ASSERT_FLOAT_EQ(Nodes[i]->GetWorldTransform().E[3][0], static_cast<float>(i))
+      << "Node " << i << " was not flushed";
+  }
+}
+
+TEST_F(SceneScaleTest, ScriptsPast1024AreAllInitializedAndDispatched)
+{
+  const uint32_t Count = 3000;
+  std::vector<Node*> Nodes;
+  std::vector<SceneScaleCountingScript*> Scripts;
+  BuildFanOutTree(Tree_, Count, 10, NodeType::Node3D, Nodes);
+  for (Node* N : Nodes) {
+    auto* Script = new SceneScaleCountingScript();
+    N->AttachScript(Script);
+    Scripts.push_back(Script);
+  }
+
+  Tree_->Update(0.016f);
+  Tree_->Update(0.016f);
+
+  for (uint32_t i = 0; i < Count; ++i) {
+    ASSERT_EQ(Scripts[i]->InitCount, 1) << "Script " << i;
+    ASSERT_EQ(Scripts[i]->UpdateCount, 2) << "Script " << i;
+  }
+}
+
+TEST_F(SceneScaleTest, TypedNodesPast1024AreTrackedInOrder)
+{
+  const uint32_t Count = 2500;
+  std::vector<Node*> Meshes;
+  for (uint32_t i = 0; i < Count; ++i) {
+    Meshes.push_back(Tree_->CreateNode("Mesh", NodeType::MeshInstance, nullptr));
+  }
+
+  uint32_t TrackedCount = 0;
+  Node** Tracked = Tree_->GetNodesByType(NodeType::MeshInstance, &TrackedCount);
+  ASSERT_EQ(TrackedCount, Count);
+  EXPECT_EQ(Tracked[Count - 1], Meshes[Count - 1]);
+
+  // Removing from the middle keeps creation order for the rest
+  Tree_->DestroyNode(Meshes[1200]);
+  Tracked = Tree_->GetNodesByType(NodeType::MeshInstance, &TrackedCount);
+  ASSERT_EQ(TrackedCount, Count - 1);
+  EXPECT_EQ(Tracked[1199], Meshes[1199]);
+  EXPECT_EQ(Tracked[1200], Meshes[1201]);
+}
+
+TEST_F(SceneScaleTest, EmptyTreeReportsNoTypedNodes)
+{
+  uint32_t Count = 123;
+  EXPECT_EQ(Tree_->GetNodesByType(NodeType::Light, &Count), nullptr);
+  EXPECT_EQ(Count, 0u);
+}
+
+//=============================================================================
+// Spatial index
+//=============================================================================
+
+TEST_F(SceneScaleTest, SpatialIndexFollowsMovingNodes)
+{
+  const uint32_t NodeCount = 2000;
+  const float WorldSize = 100.0f;
+
+  std::mt19937 Rng(5);
+  std::uniform_real_distribution<float> Coord(0.0f, WorldSize);
+  std::uniform_real_distribution<float> Speed(-2.0f, 2.0f);
+  AxAABB Unit = AABBFromCenterExtents(AxVec3{0.0f, 0.0f, 0.0f}, AxVec3{0.5f, 0.5f, 0.5f});
+  std::vector<Node*> Nodes;
+  for (uint32_t i = 0; i < NodeCount; ++i) {
+    Nodes.push_back(Tree_->CreateNode("Mover", NodeType::Node3D, nullptr));
+    Nodes.back()->SetPosition(Vec3(Coord(Rng), Coord(Rng), Coord(Rng)));
+    Tree_->SetNodeBounds(Nodes.back(), Unit);
+  }
+  Tree_->Update(0.016f);
+
+  SpatialIndex& Index = Tree_->GetSpatialIndex();
+  uint64_t ReinsertsBefore = Index.GetReinsertCount();
+  for (int f = 0; f < 5; ++f) {
+    for (Node* N : Nodes) {
+      Vec3 Pos = N->GetTransform().Translation;
+      N->SetPosition(Pos + Vec3(Speed(Rng), Speed(Rng), Speed(Rng)));
+    }
+    Tree_->Update(0.016f);
+  }
+  EXPECT_TRUE(Index.Validate());
+  EXPECT_GT(Index.GetReinsertCount(), ReinsertsBefore);
+
+  // Queries after the refit match testing every node's bounds
+  std::vector<Node*> Found;
+  for (int q = 0; q < 50; ++q) {
+    AxSphere Sphere = {AxVec3{Coord(Rng), Coord(Rng), Coord(Rng)}, 10.0f};
+    uint32_t Hits = Index.QuerySphere(Sphere, Found);
+    uint32_t Scanned = 0;
+    for (Node* N : Nodes) {
+      AxAABB Box;
+      Tree_->GetNodeBounds(N, &Box);
+      Scanned += SphereOverlapsAABB(Sphere, Box) ? 1 : 0;
+    }
+    ASSERT_EQ(Hits, Scanned) << "Query " << q;
+  }
+}
+
+//=============================================================================
+// Benchmarks
+//=============================================================================
+
+TEST_F(SceneScaleTest, DISABLED_Benchmark100kNodes)
+{
+  RunTransformBenchmark(100000);
+}
+
+TEST_F(SceneScaleTest, DISABLED_Benchmark1MNodes)
+{
+  RunTransformBenchmark(1000000);
+}
+
+TEST_F(SceneScaleTest, DISABLED_BenchmarkLookups100kNodes)
+{
+  const uint32_t NodeCount = 100000;
+  const int Lookups = 100000;
+
+  // Every built node is named "N"; the target hangs off the deepest one
+  std::vector<Node*> Nodes;
+  BuildFanOutTree(Tree_, NodeCount, 10, NodeType::Node3D, Nodes);
+  Node* From = Nodes.back();
+  Node* Holder = Tree_->CreateNode("Holder", NodeType::Node3D, From);
+  Node* Target = Tree_->CreateNode("Target", NodeType::Node3D, Holder);
+  std::string PathText = "Holder/Target";
+
+  Node* Found = nullptr;
+  auto FindStart = SceneScaleClock::now();
+  for (int i = 0; i < Lookups; ++i) {
+    Found = Tree_->FindNode("Target");
+  }
+  auto FindEnd = SceneScaleClock::now();
+  EXPECT_EQ(Found, Target);
+
+  Found = nullptr;
+  uint32_t TargetID = Target->GetNodeID();
+  for (int i = 0; i < Lookups; ++i) {
+    Found = Tree_->GetNodeByID(TargetID);
+  }
+  auto IDEnd = SceneScaleClock::now();
+  EXPECT_EQ(Found, Target);
+
+  Found = nullptr;
+  for (int i = 0; i < Lookups; ++i) {
+    Found = From->GetNode(PathText);
+  }
+  auto PathEnd = SceneScaleClock::now();
+  EXPECT_EQ(Found, Target);
+
+  NodePath Precompiled(PathText);
+  Found = nullptr;
+  for (int i = 0; i < Lookups; ++i) {
+    Found = Precompiled.Resolve(From);
+  }
+  auto CachedEnd = SceneScaleClock::now();
+  EXPECT_EQ(Found, Target);
+
+  printf("SceneTree %u nodes, %d lookups: FindNode %.2f ms, GetNodeByID %.2f ms, "
+         "GetNode(path) %.2f ms, NodePath %.2f ms\n",
+         NodeCount, Lookups, SceneScaleMs(FindStart, FindEnd), SceneScaleMs(FindEnd, IDEnd),
+         SceneScaleMs(IDEnd, PathEnd), SceneScaleMs(PathEnd, CachedEnd));
+}
+
+// 50k children under one parent: build, count, move to another parent,
+// destroy half one by one, then destroy the parent with the rest
+TEST_F(SceneScaleTest, DISABLED_BenchmarkWideHierarchy50kChildren)
+{
+  const uint32_t ChildCount = 50000;
+  Node* Parent = Tree_->CreateNode("Parent", NodeType::Node3D);
+  Node* Other = Tree_->CreateNode("Other", NodeType::Node3D);
+
+  std::vector<Node*> Children;
+  Children.reserve(ChildCount);
+  auto BuildStart = SceneScaleClock::now();
+  for (uint32_t i = 0; i < ChildCount; ++i) {
+    Children.push_back(Tree_->CreateNode("Bullet", NodeType::Node3D, Parent));
+  }
+  auto BuildEnd = SceneScaleClock::now();
+  Tree_->Update(0.016f);
+
+  auto CountStart = SceneScaleClock::now();
+  uint64_t Counted = 0;
+  for (uint32_t i = 0; i < ChildCount; ++i) {
+    Counted += Parent->GetChildCount();
+  }
+  auto CountEnd = SceneScaleClock::now();
+  EXPECT_EQ(Counted, static_cast<uint64_t>(ChildCount) * ChildCount);
+
+  for (Node* Child : Children) {
+    Other->AddChild(Child);
+  }
+  auto MoveEnd = SceneScaleClock::now();
+  EXPECT_EQ(Parent->GetChildCount(), 0u);
+  EXPECT_EQ(Other->GetChildCount(), ChildCount);
+  EXPECT_EQ(Other->GetLastChild(), Children.back());
+
+  for (uint32_t i = 0; i < ChildCount; i += 2) {
+    Tree_->DestroyNode(Children[i]);
+  }
+  auto DestroyHalfEnd = SceneScaleClock::now();
+  EXPECT_EQ(Other->GetChildCount(), ChildCount / 2);
+  EXPECT_EQ(Other->GetFirstChild(), Children[1]);
+
+  Tree_->DestroyNode(Other);
+  auto DestroyRestEnd = SceneScaleClock::now();
+  EXPECT_EQ(Tree_->GetNodeCount(), 2u);
+
+  printf("SceneTree wide hierarchy %u children: build %.2f ms, %u counts %.3f ms, "
+         "reparent all %.2f ms, destroy half %.2f ms, destroy parent %.2f ms\n",
+         ChildCount, SceneScaleMs(BuildStart, BuildEnd), ChildCount, SceneScaleMs(CountStart, CountEnd),
+         SceneScaleMs(CountEnd, MoveEnd), SceneScaleMs(MoveEnd, DestroyHalfEnd),
+         SceneScaleMs(DestroyHalfEnd, DestroyRestEnd));
+}
+
+TEST_F(SceneScaleTest, DISABLED_BenchmarkSpawnDespawnChurn)
+{
+  const uint32_t BatchSize = 10000;
+  const uint32_t Frames = 50;
+  Node* Parent = Tree_->CreateNode("Bullets", NodeType::Node3D);
+
+  std::vector<Node*> Live;
+  Live.reserve(BatchSize);
+  uint32_t ChunksAfterFirst = 0;
+
+  auto Start = SceneScaleClock::now();
+  for (uint32_t Frame = 0; Frame < Frames; ++Frame) {
+    for (uint32_t i = 0; i < BatchSize; ++i) {
+      Live.push_back(Tree_->CreateNode("Bullet", NodeType::Node3D, Parent));
+    }
+    Tree_->Update(0.016f);
+    for (Node* Bullet : Live) {
+      Tree_->DestroyNode(Bullet);
+    }
+    Live.clear();
+
+    if (Frame == 0) {
+      ChunksAfterFirst = Tree_->GetNodePool().GetChunkCount();
+    }
+  }
+  auto End = SceneScaleClock::now();
+
+  // Every later frame reuses the first frame's slots
+  EXPECT_EQ(Tree_->GetNodePool().GetChunkCount(), ChunksAfterFirst);
+  EXPECT_EQ(Tree_->GetNodePool().GetLiveCount(NodeType::Node3D), 1u);
+  EXPECT_EQ(Tree_->GetNodeCount(), 2u);
+
+  printf("SceneTree spawn/despawn %u x %u Node3Ds: %.2f ms (%.1f ns per spawn+despawn), "
+         "%u chunks\n",
+         Frames, BatchSize, SceneScaleMs(Start, End),
+         SceneScaleMs(Start, End) * 1.0e6 / (static_cast<double>(Frames) * BatchSize),
+         ChunksAfterFirst);
+}
+
+TEST_F(SceneScaleTest, DISABLED_BenchmarkScriptedSpawnBurst)
+{
+  const uint32_t Count = 10000;
+
+  // A few levels deep, so bottom-up init has depths to order
+  std::vector<Node*> Spawned;
+  std::vector<SceneScaleCountingScript*> Scripts;
+  Spawned.reserve(Count);
+  Scripts.reserve(Count);
+
+  auto Start = SceneScaleClock::now();
+  for (uint32_t i = 0; i < Count; ++i) {
+    Node* Parent = (i < 8) ? nullptr : Spawned[(i - 8) / 8];
+    Node* N = Tree_->CreateNode("Scripted", NodeType::Node3D, Parent);
+    auto* Script = new SceneScaleCountingScript();
+    N->AttachScript(Script);
+    Spawned.push_back(N);
+    Scripts.push_back(Script);
+  }
+  auto Attached = SceneScaleClock::now();
+  Tree_->Update(0.016f);
+  auto Initialized = SceneScaleClock::now();
+
+  uint32_t InitTotal = 0;
+  for (SceneScaleCountingScript* Script : Scripts) {
+    InitTotal += static_cast<uint32_t>(Script->InitCount);
+  }
+  EXPECT_EQ(InitTotal, Count);
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), Count);
+
+  // Children before their parents, each leaving the dispatch list
+  for (uint32_t i = Count; i-- > 0;) {
+    Tree_->DestroyNode(Spawned[i]);
+  }
+  auto Destroyed = SceneScaleClock::now();
+
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), 0u);
+  EXPECT_EQ(Tree_->GetNodeCount(), 1u);
+
+  printf("SceneTree scripted spawn burst %u nodes: attach %.2f ms, init+update %.2f ms, "
+         "destroy %.2f ms\n",
+         Count, SceneScaleMs(Start, Attached), SceneScaleMs(Attached, Initialized),
+         SceneScaleMs(Initialized, Destroyed));
+}
+
+TEST_F(SceneScaleTest, DISABLED_BenchmarkThrottledScriptDispatch)
+{
+  const uint32_t Count = 100000;
+  const int Frames = 100;
+
+  std::vector<SceneScaleCountingScript*> Scripts;
+  Scripts.reserve(Count);
+  for (uint32_t i = 0; i < Count; ++i) {
+    Node* N = Tree_->CreateNode("Scripted", NodeType::Node3D, nullptr);
+    auto* Script = new SceneScaleCountingScript();
+    N->AttachScript(Script);
+    Scripts.push_back(Script);
+  }
+  Tree_->Update(0.016f);
+
+  auto Start = SceneScaleClock::now();
+  for (int f = 0; f < Frames; ++f) {
+    Tree_->Update(0.016f);
+  }
+  auto EveryFrame = SceneScaleClock::now();
+
+  for (SceneScaleCountingScript* Script : Scripts) {
+    Script->SetTickInterval(4);
+  }
+  auto Throttle = SceneScaleClock::now();
+  for (int f = 0; f < Frames; ++f) {
+    Tree_->Update(0.016f);
+  }
+  auto Throttled = SceneScaleClock::now();
+
+  // Staggered: each frame runs about a quarter of the scripts
+  uint64_t Calls = 0;
+  for (SceneScaleCountingScript* Script : Scripts) {
+    Calls += static_cast<uint64_t>(Script->UpdateCount);
+  }
+  EXPECT_EQ(Calls, static_cast<uint64_t>(Count) * (Frames + 1) + Count * Frames / 4);
+
+  printf("SceneTree OnUpdate dispatch %u scripts x %d frames: every frame %.2f ms, "
+         "every 4th frame %.2f ms\n",
+         Count, Frames, SceneScaleMs(Start, EveryFrame), SceneScaleMs(Throttle, Throttled));
+}
+
+TEST_F(SceneScaleTest, DISABLED_BenchmarkParallelScriptUpdate)
+{
+  const uint32_t Count = 20000;
+  const int Frames = 20;
+
+  for (uint32_t i = 0; i < Count; ++i) {
+    Node* N = Tree_->CreateNode("Bob", NodeType::Node3D, nullptr);
+    N->AttachScript(new SceneScaleBobScript());
+  }
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Tree_->GetParallelScriptCount(), Count);
+
+  auto Start = SceneScaleClock::now();
+  for (int f = 0; f < Frames; ++f) {
+    Tree_->Update(0.016f);
+  }
+  auto Serial = SceneScaleClock::now();
+
+  WorkerPool Pool(WorkerPool::DefaultWorkerCount());
+  Tree_->SetWorkerPool(&Pool);
+  auto ParallelStart = SceneScaleClock::now();
+  for (int f = 0; f < Frames; ++f) {
+    Tree_->Update(0.016f);
+  }
+  auto Parallel = SceneScaleClock::now();
+  Tree_->SetWorkerPool(nullptr);
+
+  printf("SceneTree OwnNode OnUpdate %u scripts x %d frames: serial %.2f ms, "
+         "%u workers %.2f ms\n",
+         Count, Frames, SceneScaleMs(Start, Serial), Pool.GetWorkerCount(),
+         SceneScaleMs(ParallelStart, Parallel));
+}
+
+TEST_F(SceneScaleTest, DISABLED_BenchmarkScriptTasks)
+{
+  const uint32_t NodeCount = 1000;
+  const uint32_t TasksPerNode = 100;
+  const uint32_t Count = NodeCount * TasksPerNode;
+  const int Frames = 100;
+
+  std::vector<SceneScaleTaskScript*> Scripts;
+  for (uint32_t i = 0; i < NodeCount; ++i) {
+    Node* N = Tree_->CreateNode("Tasked", NodeType::Node3D, nullptr);
+    auto* Script = new SceneScaleTaskScript();
+    N->AttachScript(Script);
+    Scripts.push_back(Script);
+  }
+  Tree_->Update(0.016f);
+
+  auto Start = SceneScaleClock::now();
+  for (int f = 0; f < Frames; ++f) {
+    Tree_->Update(0.016f);
+  }
+  auto Empty = SceneScaleClock::now();
+
+  // Sleeping tasks sit in the time wheel and are not visited per frame
+  for (SceneScaleTaskScript* Script : Scripts) {
+    for (uint32_t t = 0; t < TasksPerNode; ++t) {
+      Script->StartTask(Script->Sleep(600.0f + static_cast<float>(t)));
+    }
+  }
+  auto Started = SceneScaleClock::now();
+  EXPECT_EQ(Tree_->GetTaskScheduler().GetTaskCount(), Count);
+
+  for (int f = 0; f < Frames; ++f) {
+    Tree_->Update(0.016f);
+  }
+  auto Sleeping = SceneScaleClock::now();
+
+  // Every task wakes every 1 to 16 frames
+  for (SceneScaleTaskScript* Script : Scripts) {
+    Script->StopAllTasks();
+    for (uint32_t t = 0; t < TasksPerNode; ++t) {
+      Script->StartTask(Script->Repeat(1 + t % 16));
+    }
+  }
+  auto Restart = SceneScaleClock::now();
+  for (int f = 0; f < Frames; ++f) {
+    Tree_->Update(0.016f);
+  }
+  auto Waking = SceneScaleClock::now();
+
+  uint64_t Wakeups = 0;
+  for (SceneScaleTaskScript* Script : Scripts) {
+    Wakeups += Script->Wakeups;
+  }
+  uint64_t Expected = 0;
+  for (uint32_t t = 0; t < TasksPerNode; ++t) {
+    Expected += static_cast<uint64_t>(Frames / (1 + t % 16)) * NodeCount;
+  }
+  EXPECT_EQ(Wakeups, Expected);
+
+  printf("SceneTree %u script tasks x %d frames: no tasks %.2f ms, start %.2f ms, "
+         "all sleeping %.2f ms, waking every 1-16 frames %.2f ms (%.0f resumes/frame)\n",
+         Count, Frames, SceneScaleMs(Start, Empty), SceneScaleMs(Empty, Started),
+         SceneScaleMs(Started, Sleeping), SceneScaleMs(Restart, Waking),
+         static_cast<double>(Wakeups) / Frames);
+}
+
+TEST_F(SceneScaleTest, DISABLED_BenchmarkTimersAndTweens)
+{
+  const uint32_t Count = 100000;
+  const int Frames = 100;
+
+  std::vector<LightNode*> Lights;
+  Lights.reserve(Count);
+  for (uint32_t i = 0; i < Count; ++i) {
+    Lights.push_back(static_cast<LightNode*>(Tree_->CreateNode("Lamp", NodeType::Light, nullptr)));
+  }
+  Tree_->Update(0.016f);
+
+  // Timers due long after the run cost nothing per frame
+  TimerService& Timers = Tree_->GetTimers();
+  uint64_t Fired = 0;
+  auto Start = SceneScaleClock::now();
+  for (uint32_t i = 0; i < Count; ++i) {
+    Timers.After(600.0f + static_cast<float>(i % 1000), [&Fired] { Fired++; }, Lights[i]);
+  }
+  auto Scheduled = SceneScaleClock::now();
+  for (int f = 0; f < Frames; ++f) {
+    Tree_->Update(0.016f);
+  }
+  auto Sleeping = SceneScaleClock::now();
+  EXPECT_EQ(Fired, 0u);
+  Timers.Clear();
+
+  // Repeating timers, 1/16 to 1 second apart
+  for (uint32_t i = 0; i < Count; ++i) {
+    Timers.Every(0.0625f * static_cast<float>(1 + i % 16), [&Fired] { Fired++; });
+  }
+  auto Repeating = SceneScaleClock::now();
+  for (int f = 0; f < Frames; ++f) {
+    Tree_->Update(0.016f);
+  }
+  auto RepeatDone = SceneScaleClock::now();
+  EXPECT_GT(Fired, 0u);
+  Timers.Clear();
+
+  // One running tween per light, spread over every curve
+  TweenSystem& Tweens = Tree_->GetTweens();
+  for (uint32_t i = 0; i < Count; ++i) {
+    EaseType Ease = static_cast<EaseType>(i % static_cast<uint32_t>(EaseType::Count));
+    Tweens.Start(Lights[i], "intensity", 5.0f, 10.0f, Ease);
+  }
+  auto TweensStarted = SceneScaleClock::now();
+  for (int f = 0; f < Frames; ++f) {
+    Tree_->Update(0.016f);
+  }
+  auto Tweened = SceneScaleClock::now();
+  EXPECT_EQ(Tweens.GetActiveCount(), Count);
+  EXPECT_GT(static_cast<float>(Lights[0]->Intensity), 1.0f);
+
+  printf("SceneTree %u timers x %d frames: schedule %.2f ms, all sleeping %.2f ms, "
+         "repeating %.2f ms (%.0f fires/frame)\n",
+         Count, Frames, SceneScaleMs(Start, Scheduled), SceneScaleMs(Scheduled, Sleeping),
+         SceneScaleMs(Repeating, RepeatDone), static_cast<double>(Fired) / Frames);
+  printf("SceneTree %u tweens x %d frames: start %.2f ms, step %.2f ms (%.3f ms/frame)\n",
+         Count, Frames, SceneScaleMs(RepeatDone, TweensStarted),
+         SceneScaleMs(TweensStarted, Tweened), SceneScaleMs(TweensStarted, Tweened) / Frames);
+}
+
+// 20k nodes in 4 of 64 groups each: join, membership and member queries by
+// name and by ID, leave half, then destroy the rest
+TEST_F(SceneScaleTest, DISABLED_BenchmarkGroups)
+{
+  const uint32_t NodeCount = 20000;
+  const uint32_t GroupCount = 64;
+  const uint32_t GroupsPerNode = 4;
+  const int Queries = 400000;
+
+  std::vector<std::string> Names;
+  for (uint32_t g = 0; g < GroupCount; ++g) {
+    Names.push_back("group" + std::to_string(g));
+  }
+  std::vector<Node*> Nodes;
+  for (uint32_t i = 0; i < NodeCount; ++i) {
+    Nodes.push_back(Tree_->CreateNode("Member", NodeType::Node3D, nullptr));
+  }
+
+  auto JoinStart = SceneScaleClock::now();
+  for (uint32_t i = 0; i < NodeCount; ++i) {
+    for (uint32_t k = 0; k < GroupsPerNode; ++k) {
+      Nodes[i]->AddToGroup(Names[(i + k * 16) % GroupCount]);
+    }
+  }
+  auto JoinEnd = SceneScaleClock::now();
+
+  uint32_t Hits = 0;
+  for (int q = 0; q < Queries; ++q) {
+    Hits += Nodes[q % NodeCount]->IsInGroup(Names[q % GroupCount]) ? 1 : 0;
+  }
+  auto ByNameEnd = SceneScaleClock::now();
+
+  std::vector<GroupId> Ids;
+  for (const std::string& Name : Names) {
+    Ids.push_back(Tree_->FindGroupId(Name));
+  }
+  uint32_t IdHits = 0;
+  auto ByIdStart = SceneScaleClock::now();
+  for (int q = 0; q < Queries; ++q) {
+    IdHits += Nodes[q % NodeCount]->IsInGroup(Ids[q % GroupCount]) ? 1 : 0;
+  }
+  auto ByIdEnd = SceneScaleClock::now();
+  EXPECT_EQ(Hits, IdHits);
+
+  size_t Listed = 0;
+  for (int r = 0; r < 1000; ++r) {
+    Listed += Tree_->GetNodesInGroup(Names[r % GroupCount]).size();
+  }
+  auto ListEnd = SceneScaleClock::now();
+  EXPECT_EQ(Listed, static_cast<size_t>(NodeCount) * GroupsPerNode / GroupCount * 1000);
+
+  for (uint32_t i = 0; i < NodeCount; i += 2) {
+    Nodes[i]->RemoveFromGroup(Names[i % GroupCount]);
+  }
+  auto LeaveEnd = SceneScaleClock::now();
+
+  for (Node* N : Nodes) {
+    Tree_->DestroyNode(N);
+  }
+  auto DestroyEnd = SceneScaleClock::now();
+  for (const std::string& Name : Names) {
+    EXPECT_EQ(Tree_->GetGroupSize(Name), 0u);
+  }
+
+  printf("SceneTree %u nodes in %u of %u groups: join %.2f ms, %d IsInGroup by name %.2f ms, "
+         "by ID %.2f ms, 1000 GetNodesInGroup %.2f ms, leave half %.2f ms, destroy %.2f ms\n",
+         NodeCount, GroupsPerNode, GroupCount, SceneScaleMs(JoinStart, JoinEnd), Queries,
+         SceneScaleMs(JoinEnd, ByNameEnd), SceneScaleMs(ByIdStart, ByIdEnd),
+         SceneScaleMs(ByIdEnd, ListEnd), SceneScaleMs(ListEnd, LeaveEnd),
+         SceneScaleMs(LeaveEnd, DestroyEnd));
+}
+
+TEST_F(SceneScaleTest, DISABLED_BenchmarkTypedViews)
+{
+  const uint32_t SpatialCount = 60000;
+  const uint32_t TypedCount = 20000;
+  const int Passes = 100;
+
+  std::vector<Node*> Spatial;
+  BuildFanOutTree(Tree_, SpatialCount, 8, NodeType::Node3D, Spatial);
+  std::vector<Node*> Lights;
+  for (uint32_t i = 0; i < TypedCount; ++i) {
+    Node* Body = Tree_->CreateNode("Body", NodeType::RigidBody, Spatial[(i * 3) % SpatialCount]);
+    Tree_->CreateNode("Shape", NodeType::Collider, Body);
+    Lights.push_back(Tree_->CreateNode("Light", NodeType::Light, Spatial[(i * 3 + 1) % SpatialCount]));
+  }
+
+  uint32_t NodeCount = Tree_->GetNodeCount();
+
+  // Find the lights by walking the hierarchy and checking each node's type
+  auto WalkStart = SceneScaleClock::now();
+  double WalkSum = 0.0;
+  std::vector<Node*> Stack;
+  for (int p = 0; p < Passes; ++p) {
+    Stack.assign(1, Tree_->GetRootNode());
+    while (!Stack.empty()) {
+      Node* Current = Stack.back();
+      Stack.pop_back();
+      if (LightNode* Light = Current->As<LightNode>()) {
+        WalkSum += Light->Intensity;
+      }
+      for (Node* Child = Current->GetFirstChild(); Child; Child = Child->GetNextSibling()) {
+        Stack.push_back(Child);
+      }
+    }
+  }
+  auto WalkEnd = SceneScaleClock::now();
+
+  double ViewSum = 0.0;
+  for (int p = 0; p < Passes; ++p) {
+    for (LightNode* Light : Tree_->View<LightNode>()) {
+      ViewSum += Light->Intensity;
+    }
+  }
+  auto ViewEnd = SceneScaleClock::now();
+  EXPECT_DOUBLE_EQ(WalkSum, ViewSum);
+
+  uint32_t Pairs = 0;
+  for (int p = 0; p < Passes; ++p) {
+    Tree_->JoinChildren<RigidBodyNode, ColliderNode>().ForEach(
+      [&Pairs](RigidBodyNode*, ColliderNode*) { Pairs++; });
+  }
+  auto JoinEnd = SceneScaleClock::now();
+  EXPECT_EQ(Pairs, TypedCount * Passes);
+
+  // Oldest first: the worst case for an ordered erase
+  for (Node* Light : Lights) {
+    Tree_->DestroyNode(Light);
+  }
+  auto DestroyEnd = SceneScaleClock::now();
+  EXPECT_EQ(Tree_->GetTypedNodeCount(NodeType::Light), 0u);
+
+  printf("SceneTree %u lights among %u nodes, %d passes: tree walk %.2f ms, View %.2f ms, "
+         "%u body/collider joins %.2f ms, destroy lights %.2f ms\n",
+         TypedCount, NodeCount, Passes, SceneScaleMs(WalkStart, WalkEnd),
+         SceneScaleMs(WalkEnd, ViewEnd), TypedCount, SceneScaleMs(ViewEnd, JoinEnd),
+         SceneScaleMs(JoinEnd, DestroyEnd));
+}
+
+TEST_F(SceneScaleTest, DISABLED_BenchmarkSpatialIndex100kMoving)
+{
+  const uint32_t NodeCount = 100000;
+  const float WorldSize = 1000.0f;
+  const int Frames = 20;
+  const int Queries = 1000;
+
+  std::mt19937 Rng(5);
+  std::uniform_real_distribution<float> Coord(0.0f, WorldSize);
+  std::uniform_real_distribution<float> Speed(-0.5f, 0.5f);
+  std::vector<Node*> Nodes;
+  std::vector<Vec3> Positions;
+  std::vector<Vec3> Velocities;
+  for (uint32_t i = 0; i < NodeCount; ++i) {
+    Nodes.push_back(Tree_->CreateNode("Mover", NodeType::Node3D, nullptr));
+    Positions.push_back(Vec3(Coord(Rng), Coord(Rng), Coord(Rng)));
+    Velocities.push_back(Vec3(Speed(Rng), Speed(Rng), Speed(Rng)));
+    Nodes.back()->SetPosition(Positions.back());
+  }
+  Tree_->Update(0.016f);
+
+  auto MoveAll = [&]() {
+    for (uint32_t i = 0; i < NodeCount; ++i) {
+      Positions[i] = Positions[i] + Velocities[i];
+      Nodes[i]->SetPosition(Positions[i]);
+    }
+  };
+
+  // Moving without bounds: the flush alone
+  double PlainMs = 0.0;
+  for (int f = 0; f < Frames; ++f) {
+    MoveAll();
+    auto Start = SceneScaleClock::now();
+    Tree_->Update(0.016f);
+    PlainMs += SceneScaleMs(Start, SceneScaleClock::now());
+  }
+
+  auto BuildStart = SceneScaleClock::now();
+  AxAABB Unit = AABBFromCenterExtents(AxVec3{0.0f, 0.0f, 0.0f}, AxVec3{0.5f, 0.5f, 0.5f});
+  for (Node* N : Nodes) {
+    Tree_->SetNodeBounds(N, Unit);
+  }
+  auto BuildEnd = SceneScaleClock::now();
+
+  SpatialIndex& Index = Tree_->GetSpatialIndex();
+  uint64_t ReinsertsBefore = Index.GetReinsertCount();
+  double IndexedMs = 0.0;
+  for (int f = 0; f < Frames; ++f) {
+    MoveAll();
+    auto Start = SceneScaleClock::now();
+    Tree_->Update(0.016f);
+    IndexedMs += SceneScaleMs(Start, SceneScaleClock::now());
+  }
+  uint64_t Reinserts = Index.GetReinsertCount() - ReinsertsBefore;
+  EXPECT_TRUE(Index.Validate());
+
+  std::vector<AxSphere> Spheres;
+  std::vector<AxAABB> Boxes;
+  std::vector<SpatialRay> Rays;
+  for (int q = 0; q < Queries; ++q) {
+    AxVec3 Center = {Coord(Rng), Coord(Rng), Coord(Rng)};
+    Spheres.push_back({Center, 25.0f});
+    Boxes.push_back(AABBFromCenterExtents(Center, AxVec3{20.0f, 20.0f, 20.0f}));
+    Rays.push_back({AxVec3{Center.X, Center.Y, 0.0f}, AxVec3{0.0f, 0.0f, 1.0f}, WorldSize});
+  }
+
+  std::vector<Node*> Found;
+  size_t SphereHits = 0;
+  size_t ScannedSphereHits = 0;
+  auto SphereStart = SceneScaleClock::now();
+  for (int q = 0; q < Queries; ++q) {
+    uint32_t Count = Index.QuerySphere(Spheres[q], Found);
+    SphereHits += Count;
+    ScannedSphereHits += (q < Queries / 10) ? Count : 0;
+  }
+  auto SphereEnd = SceneScaleClock::now();
+
+  // The same spheres by testing every node's world position
+  size_t ScanHits = 0;
+  for (int q = 0; q < Queries / 10; ++q) {
+    const AxSphere& Sphere = Spheres[q];
+    for (Node* N : Nodes) {
+      AxAABB Box;
+      Tree_->GetNodeBounds(N, &Box);
+      ScanHits += SphereOverlapsAABB(Sphere, Box) ? 1 : 0;
+    }
+  }
+  auto ScanEnd = SceneScaleClock::now();
+  EXPECT_EQ(ScanHits, ScannedSphereHits);
+
+  size_t BoxHits = 0;
+  for (const AxAABB& Box : Boxes) {
+    BoxHits += Index.QueryAABB(Box, Found);
+  }
+  auto BoxEnd = SceneScaleClock::now();
+
+  std::vector<SpatialRayHit> Hits(Queries);
+  Index.RaycastClosest(Rays.data(), Queries, Hits.data());
+  auto RayEnd = SceneScaleClock::now();
+  uint32_t RayHits = 0;
+  for (const SpatialRayHit& Hit : Hits) {
+    RayHits += Hit.Target ? 1 : 0;
+  }
+
+  AxFrustum Frustum;
+  Frustum.Planes[AX_FRUSTUM_PLANE_LEFT] = {AxVec3{1.0f, 0.0f, 0.0f}, -400.0f};
+  Frustum.Planes[AX_FRUSTUM_PLANE_RIGHT] = {AxVec3{-1.0f, 0.0f, 0.0f}, 600.0f};
+  Frustum.Planes[AX_FRUSTUM_PLANE_BOTTOM] = {AxVec3{0.0f, 1.0f, 0.0f}, -400.0f};
+  Frustum.Planes[AX_FRUSTUM_PLANE_TOP] = {AxVec3{0.0f, -1.0f, 0.0f}, 600.0f};
+  Frustum.Planes[AX_FRUSTUM_PLANE_NEAR] = {AxVec3{0.0f, 0.0f, 1.0f}, 0.0f};
+  Frustum.Planes[AX_FRUSTUM_PLANE_FAR] = {AxVec3{0.0f, 0.0f, -1.0f}, WorldSize};
+  auto FrustumStart = SceneScaleClock::now();
+  uint32_t Visible = 0;
+  for (int r = 0; r < 10; ++r) {
+    Visible = Index.QueryFrustum(Frustum, Found);
+  }
+  auto FrustumEnd = SceneScaleClock::now();
+
+  printf("SpatialIndex %u moving nodes (height %u): insert %.2f ms, flush %.2f ms/frame without "
+         "bounds vs %.2f ms/frame with (%.1f%% reinserted), %d sphere queries %.2f ms (%zu hits; "
+         "full scan %.2f ms per 100), %d box queries %.2f ms (%zu hits), %d closest rays %.2f ms "
+         "(%u hits), frustum %.2f ms (%u visible)\n",
+         NodeCount, Index.GetHeight(), SceneScaleMs(BuildStart, BuildEnd), PlainMs / Frames,
+         IndexedMs / Frames, 100.0 * Reinserts / (static_cast<double>(NodeCount) * Frames), Queries,
+         SceneScaleMs(SphereStart, SphereEnd), SphereHits, SceneScaleMs(SphereEnd, ScanEnd),
+         Queries, SceneScaleMs(ScanEnd, BoxEnd), BoxHits, Queries, SceneScaleMs(BoxEnd, RayEnd),
+         RayHits, SceneScaleMs(FrustumStart, FrustumEnd) / 10, Visible);
+}
+
+static void SceneScaleCountEvent(const AxEvent*, void* UserData)
+{
+  ++*static_cast<uint32_t*>(UserData);
+}
+
+TEST_F(SceneScaleTest, DISABLED_BenchmarkCommandBufferSpawn)
+{
+  const uint32_t ParentCount = 1000;
+  const uint32_t SpawnCount = 50000;
+
+  std::vector<Node*> Parents;
+  BuildFanOutTree(Tree_, ParentCount, 8, NodeType::Node3D, Parents);
+  Tree_->Update(0.016f);
+
+  uint32_t Events = 0;
+  Tree_->GetEventBus()->Subscribe(AX_EVENT_NODE_CREATED, SceneScaleCountEvent, &Events);
+  Tree_->GetEventBus()->Subscribe(AX_EVENT_NODE_DESTROYED, SceneScaleCountEvent, &Events);
+
+  // Direct calls: each create registers, dirties and publishes on its own
+  auto DirectStart = SceneScaleClock::now();
+  std::vector<Node*> Spawned;
+  Spawned.reserve(SpawnCount);
+  for (uint32_t i = 0; i < SpawnCount; ++i) {
+    auto* Light = static_cast<LightNode*>(
+      Tree_->CreateNode("Spark", NodeType::Light, Parents[i % ParentCount]));
+    Light->Intensity = 2.0f;
+    Spawned.push_back(Light);
+  }
+  auto DirectCreateEnd = SceneScaleClock::now();
+  Tree_->Update(0.016f);
+  auto DirectFlushEnd = SceneScaleClock::now();
+  for (Node* N : Spawned) {
+    Tree_->DestroyNode(N);
+  }
+  auto DirectEnd = SceneScaleClock::now();
+  EXPECT_EQ(Events, SpawnCount * 2);
+
+  // Close the holes the destroys left, so both runs start from a packed tree
+  Tree_->Update(0.016f);
+
+  // The same through a command buffer
+  Events = 0;
+  SceneCommandBuffer Buffer;
+  auto RecordStart = SceneScaleClock::now();
+  for (uint32_t i = 0; i < SpawnCount; ++i) {
+    SceneCommandBuffer::NodeRef Spark = Buffer.Create("Spark", NodeType::Light, Parents[i % ParentCount]);
+    Buffer.SetProperty(Spark, "intensity", 2.0f);
+  }
+  auto RecordEnd = SceneScaleClock::now();
+  Tree_->ApplyCommands(Buffer);
+  auto ApplyEnd = SceneScaleClock::now();
+  Tree_->Update(0.016f);
+  auto BufferFlushEnd = SceneScaleClock::now();
+  EXPECT_EQ(Tree_->GetTypedNodeCount(NodeType::Light), SpawnCount);
+
+  Spawned.clear();
+  for (LightNode* Light : Tree_->View<LightNode>()) {
+    EXPECT_FLOAT_EQ(Light->Intensity, 2.0f);
+    Spawned.push_back(Light);
+  }
+  auto DestroyRecordStart = SceneScaleClock::now();
+  for (Node* N : Spawned) {
+    Buffer.Destroy(N);
+  }
+  Tree_->ApplyCommands(Buffer);
+  auto BufferEnd = SceneScaleClock::now();
+  EXPECT_EQ(Events, SpawnCount * 2);
+  EXPECT_EQ(Tree_->GetTypedNodeCount(NodeType::Light), 0u);
+
+  printf("SceneTree %u configured spawns under %u parents: direct create %.2f ms, flush %.2f ms, "
+         "destroy %.2f ms; command buffer record %.2f ms, apply %.2f ms, flush %.2f ms, "
+         "destroy (record + apply) %.2f ms\n",
+         SpawnCount, ParentCount, SceneScaleMs(DirectStart, DirectCreateEnd),
+         SceneScaleMs(DirectCreateEnd, DirectFlushEnd), SceneScaleMs(DirectFlushEnd, DirectEnd),
+         SceneScaleMs(RecordStart, RecordEnd), SceneScaleMs(RecordEnd, ApplyEnd),
+         SceneScaleMs(ApplyEnd, BufferFlushEnd), SceneScaleMs(DestroyRecordStart, BufferEnd));
+
+  Tree_->GetEventBus()->Unsubscribe(AX_EVENT_NODE_CREATED, SceneScaleCountEvent, &Events);
+  Tree_->GetEventBus()->Unsubscribe(AX_EVENT_NODE_DESTROYED, SceneScaleCountEvent, &Events);
+}
+
+TEST_F(SceneScaleTest, DISABLED_BenchmarkPrefabInstantiation10k)
+{
+  const uint32_t InstanceCount = 10000;
+
+  // Turret: a root, a mesh and a light, the mesh and light configured
+  PrefabTransform BarrelLocal;
+  BarrelLocal.Translation = Vec3(0.0f, 1.0f, 0.0f);
+  PrefabTemplate Turret;
+  uint32_t Barrel = Turret.AddNode("Barrel", NodeType::MeshInstance, Turret.AddNode("Turret", NodeType::Node3D),
+                                   BarrelLocal);
+  uint32_t Muzzle = Turret.AddNode("Muzzle", NodeType::Light, Barrel);
+  Turret.SetProperty(Barrel, "mesh", "turret.obj");
+  Turret.SetProperty(Barrel, "renderLayer", 2);
+  Turret.SetProperty(Muzzle, "intensity", 3.0f);
+  Turret.SetProperty(Muzzle, "type", "spot");
+
+  std::vector<PrefabTransform> Placements(InstanceCount);
+  for (uint32_t i = 0; i < InstanceCount; ++i) {
+    Placements[i].Translation = Vec3(static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100));
+  }
+
+  uint32_t Events = 0;
+  Tree_->GetEventBus()->Subscribe(AX_EVENT_NODE_CREATED, SceneScaleCountEvent, &Events);
+  Tree_->GetEventBus()->Subscribe(AX_EVENT_NODES_INSTANTIATED, SceneScaleCountEvent, &Events);
+
+  // Node by node, as a recursive deep copy does: every node registers,
+  // dirties and publishes on its own, and properties go through setters
+  const PropertyRegistry& Props = PropertyRegistry::Get();
+  const PropDescriptor* MeshProp = Props.FindProperty(NodeType::MeshInstance, "mesh");
+  const PropDescriptor* LayerProp = Props.FindProperty(NodeType::MeshInstance, "renderLayer");
+  const PropDescriptor* IntensityProp = Props.FindProperty(NodeType::Light, "intensity");
+  const PropDescriptor* TypeProp = Props.FindProperty(NodeType::Light, "type");
+  std::vector<Node*> Roots(InstanceCount);
+  auto DirectStart = SceneScaleClock::now();
+  for (uint32_t i = 0; i < InstanceCount; ++i) {
+    Node* Root = Tree_->CreateNode("Turret", NodeType::Node3D, nullptr);
+    Root->GetTransform().SetTranslation(Placements[i].Translation);
+    Node* Mesh = Tree_->CreateNode("Barrel", NodeType::MeshInstance, Root);
+    Mesh->GetTransform().SetTranslation(BarrelLocal.Translation);
+    SetPropertyString(Mesh, MeshProp, "turret.obj");
+    SetPropertyInt32(Mesh, LayerProp, 2);
+    Node* Light = Tree_->CreateNode("Muzzle", NodeType::Light, Mesh);
+    SetPropertyFloat(Light, IntensityProp, 3.0f);
+    SetPropertyEnum(Light, TypeProp, "spot");
+    Roots[i] = Root;
+  }
+  auto DirectCreateEnd = SceneScaleClock::now();
+  Tree_->Update(0.016f);
+  auto DirectFlushEnd = SceneScaleClock::now();
+  EXPECT_EQ(Events, InstanceCount * 3);
+
+  for (Node* Root : Roots) {
+    Tree_->DestroyNode(Root);
+  }
+  Tree_->Update(0.016f);
+
+  // One batch
+  Events = 0;
+  auto BatchStart = SceneScaleClock::now();
+  uint32_t Made = Tree_->InstantiateBatch(Turret, InstanceCount, Placements.data(), nullptr, Roots.data());
+  auto BatchCreateEnd = SceneScaleClock::now();
+  Tree_->Update(0.016f);
+  auto BatchFlushEnd = SceneScaleClock::now();
+  EXPECT_EQ(Made, InstanceCount);
+  EXPECT_EQ(Events, 1u);
+  EXPECT_EQ(Tree_->GetTypedNodeCount(NodeType::Light), InstanceCount);
+
+  const Mat4& Last = Roots.back()->FindChild("Barrel")->FindChild("Muzzle")->GetWorldTransform();
+  EXPECT_FLOAT_EQ(Last.E[3][0], Placements.back().Translation.X);
+  EXPECT_FLOAT_EQ(Last.E[3][1], 1.0f);
+
+  printf("SceneTree %u prefab instances of %u nodes: node by node create %.2f ms, flush %.2f ms; "
+         "InstantiateBatch create %.2f ms, flush %.2f ms\n",
+         InstanceCount, Turret.GetNodeCount(), SceneScaleMs(DirectStart, DirectCreateEnd),
+         SceneScaleMs(DirectCreateEnd, DirectFlushEnd), SceneScaleMs(BatchStart, BatchCreateEnd),
+         SceneScaleMs(BatchCreateEnd, BatchFlushEnd));
+
+  Tree_->GetEventBus()->Unsubscribe(AX_EVENT_NODE_CREATED, SceneScaleCountEvent, &Events);
+  Tree_->GetEventBus()->Unsubscribe(AX_EVENT_NODES_INSTANTIATED, SceneScaleCountEvent, &Events);
+}
+
+TEST_F(SceneScaleTest, DISABLED_BenchmarkCompiledPrefabCache)
+{
+  const uint32_t LoadCount = 10000;
+  const char* PrefabData = R"(node "Turret" {
+    transform {
+      translation: 0.0, 0.5, 0.0
+    }
+    node "Barrel" MeshInstance {
+      mesh: "res://turret.glb"
+      renderLayer: 2
+      transform {
+        translation: 0.0, 1.0, 0.0
+      }
+      node "Muzzle" Light {
+        type: spot
+        intensity: 3.0
+        color: 1.0, 0.8, 0.6
+      }
+    }
+  })";
+
+  SceneParser Parser;
+  Parser.Init(AxonGlobalAPIRegistry);
+
+  // Parsing the text for every load, as each ParsePrefab used to
+  auto ParseStart = SceneScaleClock::now();
+  for (uint32_t i = 0; i < LoadCount; ++i) {
+    Parser.ClearPrefabCache();
+    ASSERT_NE(Parser.ParsePrefab(PrefabData, Tree_), nullptr);
+  }
+  auto ParseEnd = SceneScaleClock::now();
+
+  // Compiled once, then every load is a hash lookup and a linear pass
+  Parser.ClearPrefabCache();
+  auto CachedStart = SceneScaleClock::now();
+  for (uint32_t i = 0; i < LoadCount; ++i) {
+    ASSERT_NE(Parser.ParsePrefab(PrefabData, Tree_), nullptr);
+  }
+  auto CachedEnd = SceneScaleClock::now();
+  EXPECT_EQ(Parser.GetPrefabCacheSize(), 1u);
+  EXPECT_EQ(Tree_->GetTypedNodeCount(NodeType::Light), LoadCount * 2);
+
+  // And stamped out from the template directly in one batch
+  const PrefabTemplate* Template = Parser.CompilePrefab(PrefabData);
+  ASSERT_NE(Template, nullptr);
+  auto BatchStart = SceneScaleClock::now();
+  EXPECT_EQ(Tree_->InstantiateBatch(*Template, LoadCount), LoadCount);
+  auto BatchEnd = SceneScaleClock::now();
+
+  printf("SceneParser %u loads of a 3-node prefab: parsed every load %.2f ms, compiled once and "
+         "cached %.2f ms, one InstantiateBatch %.2f ms\n",
+         LoadCount, SceneScaleMs(ParseStart, ParseEnd), SceneScaleMs(CachedStart, CachedEnd),
+         SceneScaleMs(BatchStart, BatchEnd));
+
+  Parser.Term();
+}
@@ -10,9 +10,28 @@
  *   - OwningTree_ back-pointer assignment and clearing
  *   - Transform dirty list: SetPosition/SetRotation/SetScale notify SceneTree
  *   - Pending init queue: AttachScript registers for init
- *   - Script process list: initialized scripts dispatched, detach removes
+ *   - Script process list: initialized scripts dispatched, detach removes,
+ *     inactive subtrees (via SetActive or reparenting) leave the list
+ *   - Tick control: frame and seconds intervals, tick group order, time
+ *     budgets and distance LOD
+ *   - Parallel OnUpdate phases for declared script access, with structural
+ *     changes queued to the sync point
+ *   - Script tasks: WaitFrames, WaitSeconds, WaitForSignal and WaitUntil
+ *     resumption, cancellation with the script or node, pooled frames
+ *   - Timers and tweens: one-shot, repeating and signal timers on frame
+ *     time, eased property tweens, cancellation and destroyed targets
+ *   - Command buffers: pending refs, kind-by-kind apply order, one event
+ *     flush, and commands whose targets are gone
+ *   - Prefab instantiation: batched copies with properties, scripts and
+ *     placements under one event, captured templates, invalid records
+ *   - Frame statistics: per-phase timings and work counters, the ring
+ *     buffer of recent frames
  *   - DestroyNode cleanup from all optimization lists
  *   - Integration: full frame cycle with all optimizations active
+ *   - Node handles: O(1) resolve, invalidation on destroy, slot reuse,
+ *     script and signal integration
+ *   - Node pools: per-type slot reuse, chunks from the scene allocator,
+ *     teardown of scripts, signals and heap-allocated children
  *
  * Uses real Node objects and ScriptBase subclasses (no mocks).
  *
@@ -41,8 +60,15 @@
 #include "AxEngine/AxSceneTree.h"
 #include "AxEngine/AxNode.h"
 #include "AxEngine/AxScriptBase.h"
+#include "AxEngine/AxScriptRegistry.h"
+#include "AxEngine/AxTypedNodes.h"
+#include "AxEngine/AxWorkerPool.h"
+#include "Foundation/AxAllocatorAPI.h"
 
+#include <atomic>
+#include <chrono>
 #include <string>
+#include <thread>
 #include <vector>
 #include <cmath>
 
@@ -619,6 +645,81 @@ TEST_F(SceneTreeTest, PendingInitEnableAfterInit)
     << "OnEnable should fire immediately after OnInit for active nodes";
 }
 
+TEST_F(SceneTreeTest, NodeDepthFollowsReparenting)
+{
+  Node* A = Tree_->CreateNode("A", NodeType::Node3D, nullptr);
+  Node* B = Tree_->CreateNode("B", NodeType::Node3D, A);
+  Node* C = Tree_->CreateNode("C", NodeType::Node3D, B);
+  Node* Other = Tree_->CreateNode("Other", NodeType::Node3D, nullptr);
+
+  EXPECT_EQ(Tree_->GetRootNode()->GetDepth(), 0u);
+  EXPECT_EQ(A->GetDepth(), 1u);
+  EXPECT_EQ(C->GetDepth(), 3u);
+
+  // Moving B carries its subtree
+  Other->AddChild(B);
+  EXPECT_EQ(B->GetDepth(), 2u);
+  EXPECT_EQ(C->GetDepth(), 3u);
+  C->AddChild(A);
+  EXPECT_EQ(A->GetDepth(), 4u);
+
+  C->RemoveChild(A);
+  EXPECT_EQ(A->GetDepth(), 0u);
+  Tree_->GetRootNode()->AddChild(A);
+}
+
+TEST_F(SceneTreeTest, PendingInitUsesDepthAfterReparent)
+{
+  // Both start at depth 1; the child is moved under the parent before init
+  Node* Parent = Tree_->CreateNode("Parent", NodeType::Node3D, nullptr);
+  Node* Child  = Tree_->CreateNode("Child",  NodeType::Node3D, nullptr);
+  Child->AttachScript(new SceneTreeTrackingScript("C"));
+  Parent->AttachScript(new SceneTreeTrackingScript("P"));
+  Parent->AddChild(Child);
+
+  gSceneTreeCallLog.clear();
+  Tree_->Update(0.016f);
+
+  EXPECT_LT(SceneTreeLogIndex("C.OnInit"), SceneTreeLogIndex("P.OnInit"));
+  EXPECT_EQ(Tree_->GetPendingInitCount(), 0u);
+}
+
+struct SceneTreeSpawningScript : public ScriptBase
+{
+  SceneTreeCountingScript* Spawned = nullptr;
+  Node* Victim = nullptr;
+  void OnInit() override
+  {
+    // A deeper child, whose depth bucket this sweep has already passed
+    Node* Child = GetSceneTree()->CreateNode("Spawned", NodeType::Node3D, GetOwner());
+    Spawned = new SceneTreeCountingScript();
+    Child->AttachScript(Spawned);
+
+    if (Victim) {
+      GetSceneTree()->DestroyNode(Victim);
+    }
+  }
+};
+
+TEST_F(SceneTreeTest, ScriptsAttachedDuringInitAreInitializedSameFrame)
+{
+  Node* Spawner = Tree_->CreateNode("Spawner", NodeType::Node3D, nullptr);
+  Node* Victim = Tree_->CreateNode("Victim", NodeType::Node3D, nullptr);
+  auto* Script = new SceneTreeSpawningScript();
+  Script->Victim = Victim;
+  Spawner->AttachScript(Script);
+  Victim->AttachScript(new SceneTreeCountingScript());
+  EXPECT_EQ(Tree_->GetPendingInitCount(), 2u);
+
+  Tree_->Update(0.016f);
+
+  ASSERT_NE(Script->Spawned, nullptr);
+  EXPECT_EQ(Script->Spawned->InitCount, 1);
+  EXPECT_EQ(Script->Spawned->UpdateCount, 1);
+  EXPECT_EQ(Tree_->GetPendingInitCount(), 0u);
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), 2u);
+}
+
 //=============================================================================
 // TASK GROUP 4: Script process list tests
 //=============================================================================
@@ -718,6 +819,114 @@ TEST_F(SceneTreeTest, InactiveParentSkipsChildDuringDispatch)
     << "Child of inactive parent must not receive OnUpdate";
 }
 
+// Deactivates another node from inside OnUpdate
+struct SceneTreeDeactivatingScript : public ScriptBase
+{
+  Node* Victim = nullptr;
+  int UpdateCount = 0;
+
+  void OnUpdate(float) override
+  {
+    ++UpdateCount;
+    if (Victim) {
+      Victim->SetActive(false);
+    }
+  }
+};
+
+TEST_F(SceneTreeTest, InactiveSubtreeLeavesDispatchList)
+{
+  Node* Parent = Tree_->CreateNode("Parent", NodeType::Node3D, nullptr);
+  Node* Child  = Tree_->CreateNode("Child",  NodeType::Node3D, Parent);
+  Node* Grand  = Tree_->CreateNode("Grand",  NodeType::Node3D, Child);
+
+  auto* CScript = new SceneTreeCountingScript();
+  auto* GScript = new SceneTreeCountingScript();
+  Child->AttachScript(CScript);
+  Grand->AttachScript(GScript);
+
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), 2u);
+
+  Parent->SetActive(false);
+  EXPECT_FALSE(Grand->IsActiveInHierarchy());
+  EXPECT_TRUE(Grand->IsActive()) << "Own flag is untouched";
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), 0u);
+
+  // An inactive grandparent keeps the subtree out when an inner node toggles
+  Child->SetActive(false);
+  Child->SetActive(true);
+  EXPECT_FALSE(Grand->IsActiveInHierarchy());
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), 0u);
+
+  Parent->SetActive(true);
+  EXPECT_TRUE(Grand->IsActiveInHierarchy());
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), 2u);
+
+  Tree_->Update(0.016f);
+  EXPECT_EQ(CScript->UpdateCount, 2);
+  EXPECT_EQ(GScript->UpdateCount, 2);
+}
+
+TEST_F(SceneTreeTest, ReparentingUpdatesActiveInHierarchy)
+{
+  Node* Hidden = Tree_->CreateNode("Hidden", NodeType::Node3D, nullptr);
+  Hidden->SetActive(false);
+
+  Node* Mover = Tree_->CreateNode("Mover", NodeType::Node3D, nullptr);
+  auto* Script = new SceneTreeCountingScript();
+  Mover->AttachScript(Script);
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), 1u);
+
+  Hidden->AddChild(Mover);
+  EXPECT_FALSE(Mover->IsActiveInHierarchy());
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), 0u);
+
+  Tree_->GetRootNode()->AddChild(Mover);
+  EXPECT_TRUE(Mover->IsActiveInHierarchy());
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), 1u);
+
+  // Created under an inactive parent: initialized, but never dispatched
+  Node* Late = Tree_->CreateNode("Late", NodeType::Node3D, Hidden);
+  auto* LateScript = new SceneTreeCountingScript();
+  Late->AttachScript(LateScript);
+  Tree_->Update(0.016f);
+  EXPECT_EQ(LateScript->InitCount, 1);
+  EXPECT_EQ(LateScript->UpdateCount, 0);
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), 1u);
+
+  // Destroying an inactive subtree must not bring its scripts back
+  Tree_->DestroyNode(Hidden);
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), 1u);
+}
+
+TEST_F(SceneTreeTest, DeactivationDuringDispatchSkipsNoOtherScript)
+{
+  const int Count = 8;
+  std::vector<SceneTreeDeactivatingScript*> Scripts;
+  std::vector<Node*> Nodes;
+  for (int i = 0; i < Count; ++i) {
+    Node* N = Tree_->CreateNode("N", NodeType::Node3D, nullptr);
+    auto* Script = new SceneTreeDeactivatingScript();
+    N->AttachScript(Script);
+    Nodes.push_back(N);
+    Scripts.push_back(Script);
+  }
+  Tree_->Update(0.016f);
+
+  // The first script to run removes the node that would otherwise be
+  // swapped into its place
+  Scripts[0]->Victim = Nodes[1];
+  Tree_->Update(0.016f);
+
+  EXPECT_EQ(Scripts[1]->UpdateCount, 1) << "Victim ran only in the first frame";
+  for (int i = 2; i < Count; ++i) {
+    EXPECT_EQ(Scripts[i]->UpdateCount, 2) << "Script " << i;
+  }
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), static_cast<uint32_t>(Count - 1));
+}
+
 TEST_F(SceneTreeTest, MainCameraAndMouseDeltaPropagatedToScripts)
 {
   Node* CamNode = Tree_->CreateNode("Cam", NodeType::Camera, nullptr);
@@ -735,8 +944,8 @@ TEST_F(SceneTreeTest, MainCameraAndMouseDeltaPropagatedToScripts)
     AxVec2 CapturedMouse = {0, 0};
     void OnUpdate(float) override
     {
-      CapturedCamera = MainCamera;
-      CapturedMouse = MouseDelta;
+      CapturedCamera = GetMainCamera();
+      CapturedMouse = GetMouseDelta();
     }
   };
 
@@ -752,6 +961,452 @@ TEST_F(SceneTreeTest, MainCameraAndMouseDeltaPropagatedToScripts)
     << "MouseDelta.Y must be propagated to scripts";
 }
 
+struct SceneTreeFrameReadScript : public ScriptBase
+{
+  CameraNode* CapturedCamera = nullptr;
+  float CapturedDeltaT = 0.0f;
+  uint64_t CapturedFrame = 0;
+  const ScriptFrameContext* CapturedContext = nullptr;
+  void OnUpdate(float) override
+  {
+    CapturedContext = &GetFrame();
+    CapturedCamera = GetMainCamera();
+    CapturedDeltaT = GetFrame().DeltaT;
+    CapturedFrame = GetFrame().FrameIndex;
+  }
+};
+
+TEST_F(SceneTreeTest, FrameContextChangesReachInitializedScripts)
+{
+  Node* N = Tree_->CreateNode("Scripted", NodeType::Node3D, nullptr);
+  auto* Script = new SceneTreeFrameReadScript();
+  N->AttachScript(Script);
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Script->CapturedCamera, nullptr);
+
+  // Set after OnInit: scripts share the tree's context, nothing is copied
+  CameraNode* Cam = static_cast<CameraNode*>(Tree_->CreateNode("Cam", NodeType::Camera, nullptr));
+  Tree_->SetMainCamera(Cam);
+  Tree_->Update(0.25f);
+
+  EXPECT_EQ(Script->CapturedCamera, Cam);
+  EXPECT_TRUE(SceneTreeFloatNear(Script->CapturedDeltaT, 0.25f));
+  EXPECT_EQ(Script->CapturedFrame, 2u);
+  EXPECT_EQ(Script->CapturedContext, &Tree_->GetFrameContext());
+}
+
+struct SceneTreeUpdateOnlyScript : public ScriptBase
+{
+  int UpdateCount = 0;
+  void OnUpdate(float) override { UpdateCount++; }
+};
+
+struct SceneTreeLateOnlyScript : public ScriptBase
+{
+  int LateCount = 0;
+  void OnLateUpdate(float) override { LateCount++; }
+};
+
+// Overrides in a protected section cannot be inspected; they count as overridden
+class SceneTreeHiddenFixedScript : public ScriptBase
+{
+protected:
+  void OnFixedUpdate(float) override {}
+};
+
+TEST_F(SceneTreeTest, DetectCallbacksFindsOverrides)
+{
+  EXPECT_EQ(ScriptBase::DetectCallbacks<SceneTreeUpdateOnlyScript>(), ScriptCallbacks::Update);
+  EXPECT_EQ(ScriptBase::DetectCallbacks<SceneTreeLateOnlyScript>(), ScriptCallbacks::LateUpdate);
+  EXPECT_EQ(ScriptBase::DetectCallbacks<SceneTreeHiddenFixedScript>(), ScriptCallbacks::FixedUpdate);
+}
+
+TEST_F(SceneTreeTest, ScriptsJoinOnlyDeclaredCallbackLists)
+{
+  Node* A = Tree_->CreateNode("A", NodeType::Node3D, nullptr);
+  Node* B = Tree_->CreateNode("B", NodeType::Node3D, nullptr);
+  Node* C = Tree_->CreateNode("C", NodeType::Node3D, nullptr);
+
+  auto* UpdateOnly = new SceneTreeUpdateOnlyScript();
+  UpdateOnly->DeclareCallbacks(ScriptBase::DetectCallbacks<SceneTreeUpdateOnlyScript>());
+  auto* LateOnly = new SceneTreeLateOnlyScript();
+  LateOnly->DeclareCallbacks(ScriptCallbacks::LateUpdate);
+  A->AttachScript(UpdateOnly);
+  B->AttachScript(LateOnly);
+  C->AttachScript(new SceneTreeUpdateOnlyScript());   // undeclared: every list
+
+  Tree_->Update(0.016f);
+  Tree_->FixedUpdate(0.016f);
+  Tree_->LateUpdate(0.016f);
+
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), 3u);
+  EXPECT_EQ(Tree_->GetDispatchCount(ScriptCallbacks::Update), 2u);
+  EXPECT_EQ(Tree_->GetDispatchCount(ScriptCallbacks::FixedUpdate), 1u);
+  EXPECT_EQ(Tree_->GetDispatchCount(ScriptCallbacks::LateUpdate), 2u);
+  EXPECT_EQ(UpdateOnly->UpdateCount, 1);
+  EXPECT_EQ(LateOnly->LateCount, 1);
+
+  // Declaring after registration moves the script between lists
+  UpdateOnly->DeclareCallbacks(ScriptCallbacks::Update | ScriptCallbacks::FixedUpdate);
+  EXPECT_EQ(Tree_->GetDispatchCount(ScriptCallbacks::FixedUpdate), 2u);
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), 3u);
+
+  A->DetachScript();
+  delete UpdateOnly;
+  EXPECT_EQ(Tree_->GetDispatchCount(ScriptCallbacks::Update), 1u);
+  EXPECT_EQ(Tree_->GetDispatchCount(ScriptCallbacks::FixedUpdate), 1u);
+  EXPECT_EQ(Tree_->GetActiveScriptCount(), 2u);
+}
+
+TEST_F(SceneTreeTest, DispatchListsGroupScriptsByClass)
+{
+  std::vector<SceneTreeUpdateOnlyScript*> UpdateScripts;
+  for (int i = 0; i < 6; ++i) {
+    Node* N = Tree_->CreateNode("N" + std::to_string(i), NodeType::Node3D, nullptr);
+    if (i % 2 == 0) {
+      auto* Script = new SceneTreeUpdateOnlyScript();
+      Script->DeclareCallbacks(ScriptCallbacks::Update);
+      UpdateScripts.push_back(Script);
+      N->AttachScript(Script);
+    } else {
+      auto* Script = new SceneTreeLateOnlyScript();
+      Script->DeclareCallbacks(ScriptCallbacks::Update | ScriptCallbacks::LateUpdate);
+      N->AttachScript(Script);
+    }
+  }
+
+  Tree_->Update(0.016f);
+
+  EXPECT_EQ(Tree_->GetDispatchCount(ScriptCallbacks::Update), 6u);
+  EXPECT_EQ(Tree_->GetDispatchGroupCount(ScriptCallbacks::Update), 2u);
+  EXPECT_EQ(Tree_->GetDispatchGroupCount(ScriptCallbacks::LateUpdate), 1u);
+  EXPECT_EQ(Tree_->GetDispatchGroupCount(ScriptCallbacks::FixedUpdate), 0u);
+  for (SceneTreeUpdateOnlyScript* Script : UpdateScripts) {
+    EXPECT_EQ(Script->UpdateCount, 1);
+  }
+}
+
+struct SceneTreeTickScript : public ScriptBase
+{
+  std::string Tag;
+  std::vector<float> Deltas;
+  uint32_t SpinMicros = 0;
+
+  explicit SceneTreeTickScript(std::string_view TagIn = "") : Tag(TagIn) {}
+
+  void OnUpdate(float DeltaT) override
+  {
+    Deltas.push_back(DeltaT);
+    if (!Tag.empty()) {
+      gSceneTreeCallLog.push_back(Tag);
+    }
+
+    auto Start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - Start < std::chrono::microseconds(SpinMicros)) {
+    }
+  }
+};
+
+TEST_F(SceneTreeTest, FrameTickIntervalAccumulatesDeltaT)
+{
+  Node* N = Tree_->CreateNode("Throttled", NodeType::Node3D, nullptr);
+  auto* Script = new SceneTreeTickScript();
+  Script->SetTickInterval(3);
+  N->AttachScript(Script);
+
+  for (int i = 0; i < 9; ++i) {
+    Tree_->Update(0.01f);
+  }
+
+  EXPECT_EQ(Tree_->GetDispatchCount(ScriptCallbacks::Update), 1u);
+  ASSERT_EQ(Script->Deltas.size(), 3u);
+  EXPECT_TRUE(SceneTreeFloatNear(Script->Deltas[1], 0.03f));
+  EXPECT_TRUE(SceneTreeFloatNear(Script->Deltas[2], 0.03f));
+
+  // Back to every frame: the next call gets only the time since the change
+  Script->SetTickInterval(1);
+  Tree_->Update(0.01f);
+  Tree_->Update(0.01f);
+  ASSERT_EQ(Script->Deltas.size(), 5u);
+  EXPECT_TRUE(SceneTreeFloatNear(Script->Deltas[3], 0.01f));
+  EXPECT_TRUE(SceneTreeFloatNear(Script->Deltas[4], 0.01f));
+}
+
+TEST_F(SceneTreeTest, SecondsTickIntervalUsesFrameTime)
+{
+  Node* N = Tree_->CreateNode("Throttled", NodeType::Node3D, nullptr);
+  auto* Script = new SceneTreeTickScript();
+  N->AttachScript(Script);
+  Tree_->Update(0.01f);
+
+  Script->SetTickIntervalSeconds(0.05f);
+  for (int i = 0; i < 20; ++i) {
+    Tree_->Update(0.01f);
+  }
+
+  // One call from the first frame, then one per 0.05s
+  ASSERT_EQ(Script->Deltas.size(), 5u);
+  for (size_t i = 1; i < Script->Deltas.size(); ++i) {
+    EXPECT_TRUE(SceneTreeFloatNear(Script->Deltas[i], 0.05f)) << "Call " << i;
+  }
+}
+
+TEST_F(SceneTreeTest, TickGroupsRunInOrder)
+{
+  uint32_t Late = Tree_->AddTickGroup("Late", 10);
+  uint32_t Early = Tree_->AddTickGroup("Early", -10);
+  EXPECT_EQ(Tree_->FindTickGroup("Early"), Early);
+  EXPECT_EQ(Tree_->FindTickGroup("Missing"), SceneTree::InvalidTickGroup);
+  EXPECT_EQ(Tree_->AddTickGroup("Late", 20), Late) << "Existing names keep their ID";
+
+  const char* Tags[] = {"Late", "Default", "Early", "Unknown"};
+  uint32_t Groups[] = {Late, SceneTree::DefaultTickGroup, Early, 99};
+  for (int i = 0; i < 4; ++i) {
+    auto* Script = new SceneTreeTickScript(Tags[i]);
+    Script->SetTickGroup(Groups[i]);
+    Tree_->CreateNode(Tags[i], NodeType::Node3D, nullptr)->AttachScript(Script);
+  }
+
+  Tree_->Update(0.016f);
+
+  // The unknown group falls back to Default
+  std::vector<std::string> Expected = {"Early", "Default", "Unknown", "Late"};
+  EXPECT_EQ(gSceneTreeCallLog, Expected);
+  EXPECT_EQ(Tree_->GetTickGroupUpdateCount(SceneTree::DefaultTickGroup), 2u);
+  EXPECT_EQ(Tree_->GetTickGroupUpdateCount(Early), 1u);
+
+  // Reordering applies from the next pass
+  gSceneTreeCallLog.clear();
+  Tree_->AddTickGroup("Late", -20);
+  Tree_->Update(0.016f);
+  EXPECT_EQ(gSceneTreeCallLog.front(), "Late");
+}
+
+TEST_F(SceneTreeTest, BudgetedTickGroupIsTimeSliced)
+{
+  uint32_t Group = Tree_->AddTickGroup("AI", 0);
+  Tree_->SetTickGroupBudget(Group, 1);
+
+  std::vector<SceneTreeTickScript*> Scripts;
+  for (int i = 0; i < 4; ++i) {
+    auto* Script = new SceneTreeTickScript();
+    Script->SpinMicros = 20;
+    Script->SetTickGroup(Group);
+    Tree_->CreateNode("AI" + std::to_string(i), NodeType::Node3D, nullptr)->AttachScript(Script);
+    Scripts.push_back(Script);
+  }
+
+  // Every script overruns the budget, so one runs per frame, round-robin
+  for (int Frame = 0; Frame < 8; ++Frame) {
+    Tree_->Update(0.01f);
+    EXPECT_EQ(Tree_->GetTickGroupUpdateCount(Group), 1u) << "Frame " << Frame;
+  }
+
+  for (SceneTreeTickScript* Script : Scripts) {
+    ASSERT_EQ(Script->Deltas.size(), 2u);
+    EXPECT_TRUE(SceneTreeFloatNear(Script->Deltas[1], 0.04f)) << "Skipped frames accumulate";
+  }
+}
+
+TEST_F(SceneTreeTest, TickLODStretchesIntervalWithDistance)
+{
+  CameraNode* Cam = static_cast<CameraNode*>(Tree_->CreateNode("Cam", NodeType::Camera, nullptr));
+  Tree_->SetMainCamera(Cam);
+
+  TickLODSettings LOD;
+  LOD.NearDistance = 10.0f;
+  LOD.FarDistance = 100.0f;
+  LOD.FarScale = 4;
+  Tree_->SetTickGroupLOD(SceneTree::DefaultTickGroup, LOD);
+
+  Node* NearNode = Tree_->CreateNode("Near", NodeType::Node3D, nullptr);
+  NearNode->SetPosition(0.0f, 0.0f, -5.0f);
+  Node* FarNode = Tree_->CreateNode("Far", NodeType::Node3D, nullptr);
+  FarNode->SetPosition(0.0f, 0.0f, -500.0f);
+
+  auto* NearScript = new SceneTreeTickScript();
+  auto* FarScript = new SceneTreeTickScript();
+  NearNode->AttachScript(NearScript);
+  FarNode->AttachScript(FarScript);
+
+  for (int i = 0; i < 8; ++i) {
+    Tree_->Update(0.01f);
+  }
+
+  EXPECT_EQ(NearScript->Deltas.size(), 8u);
+  ASSERT_EQ(FarScript->Deltas.size(), 2u);
+  EXPECT_TRUE(SceneTreeFloatNear(FarScript->Deltas[1], 0.04f));
+
+  // Without LOD the far script runs every frame again
+  Tree_->SetTickGroupLOD(SceneTree::DefaultTickGroup, TickLODSettings{});
+  Tree_->Update(0.01f);
+  Tree_->Update(0.01f);
+  EXPECT_EQ(FarScript->Deltas.size(), 4u);
+}
+
+struct SceneTreeOwnNodeScript : public ScriptBase
+{
+  static constexpr ScriptAccess UpdateAccess = ScriptAccess::OwnNode;
+
+  std::atomic<int> UpdateCount{0};
+
+  SceneTreeOwnNodeScript() { DeclareAccess(DetectAccess<SceneTreeOwnNodeScript>()); }
+
+  void OnUpdate(float) override
+  {
+    const Vec3 Pos = GetOwner()->GetTransform().Translation;
+    GetOwner()->SetPosition(Pos.X + 1.0f, Pos.Y, Pos.Z);
+    UpdateCount++;
+  }
+};
+
+struct SceneTreeReadOnlyScript : public ScriptBase
+{
+  static constexpr ScriptAccess UpdateAccess = ScriptAccess::ReadOnlyScene;
+
+  NodeHandle Watched;
+  float SeenX = -1.0f;
+
+  SceneTreeReadOnlyScript() { DeclareAccess(DetectAccess<SceneTreeReadOnlyScript>()); }
+
+  void OnUpdate(float) override
+  {
+    Node* Target = GetSceneTree()->Resolve(Watched);
+    SeenX = Target ? Target->GetTransform().Translation.X : -1.0f;
+  }
+};
+
+// Destroys its own node and spawns another from the parallel phase
+struct SceneTreeParallelSpawnScript : public ScriptBase
+{
+  Node* CreatedDuringPhase = reinterpret_cast<Node*>(1);
+  bool OwnerAliveAfterDestroy = false;
+
+  SceneTreeParallelSpawnScript() { DeclareAccess(ScriptAccess::OwnNode); }
+
+  void OnUpdate(float) override
+  {
+    NodeHandle Self = GetOwner()->GetHandle();
+    CreatedDuringPhase = GetSceneTree()->CreateNode("Spawned", NodeType::Node3D);
+    GetSceneTree()->DestroyNode(GetOwner());
+    OwnerAliveAfterDestroy = GetSceneTree()->Resolve(Self) != nullptr;
+  }
+};
+
+struct SceneTreeSyncObserverScript : public ScriptBase
+{
+  bool SawSpawned = false;
+
+  void OnUpdate(float) override { SawSpawned = GetSceneTree()->FindNode("Spawned") != nullptr; }
+};
+
+TEST_F(SceneTreeTest, DetectAccessReadsStaticDeclaration)
+{
+  EXPECT_EQ(ScriptBase::DetectAccess<SceneTreeOwnNodeScript>(), ScriptAccess::OwnNode);
+  EXPECT_EQ(ScriptBase::DetectAccess<SceneTreeReadOnlyScript>(), ScriptAccess::ReadOnlyScene);
+  EXPECT_EQ(ScriptBase::DetectAccess<SceneTreeUpdateOnlyScript>(), ScriptAccess::Exclusive);
+}
+
+TEST_F(SceneTreeTest, DeclaredAccessRunsScriptsInParallelPhases)
+{
+  WorkerPool Pool(3);
+  Tree_->SetWorkerPool(&Pool);
+
+  Node* Watched = Tree_->CreateNode("Watched", NodeType::Node3D, nullptr);
+  auto* WatchedScript = new SceneTreeOwnNodeScript();
+  Watched->AttachScript(WatchedScript);
+
+  const int Count = 400;
+  std::vector<SceneTreeOwnNodeScript*> Writers;
+  std::vector<SceneTreeReadOnlyScript*> Readers;
+  for (int i = 0; i < Count; ++i) {
+    auto* Writer = new SceneTreeOwnNodeScript();
+    Tree_->CreateNode("W" + std::to_string(i), NodeType::Node3D, nullptr)->AttachScript(Writer);
+    Writers.push_back(Writer);
+
+    auto* Reader = new SceneTreeReadOnlyScript();
+    Reader->Watched = Watched->GetHandle();
+    Tree_->CreateNode("R" + std::to_string(i), NodeType::Node3D, nullptr)->AttachScript(Reader);
+    Readers.push_back(Reader);
+  }
+  auto* Serial = new SceneTreeUpdateOnlyScript();
+  Tree_->CreateNode("Serial", NodeType::Node3D, nullptr)->AttachScript(Serial);
+
+  Tree_->Update(0.016f);
+  Tree_->Update(0.016f);
+
+  EXPECT_EQ(Tree_->GetParallelScriptCount(), static_cast<uint32_t>(Count * 2 + 1));
+  EXPECT_EQ(Tree_->GetDispatchCount(ScriptCallbacks::Update), static_cast<uint32_t>(Count * 2 + 2));
+  EXPECT_EQ(Serial->UpdateCount, 2);
+  for (int i = 0; i < Count; ++i) {
+    EXPECT_EQ(Writers[i]->UpdateCount.load(), 2);
+    EXPECT_TRUE(SceneTreeFloatNear(Writers[i]->GetOwner()->GetTransform().Translation.X, 2.0f));
+  }
+
+  // Readers run before writers, so they see the previous frame's value
+  for (SceneTreeReadOnlyScript* Reader : Readers) {
+    EXPECT_TRUE(SceneTreeFloatNear(Reader->SeenX, 1.0f));
+  }
+
+  // Back to the calling thread once declared exclusive
+  Writers[0]->DeclareAccess(ScriptAccess::Exclusive);
+  EXPECT_EQ(Tree_->GetParallelScriptCount(), static_cast<uint32_t>(Count * 2));
+
+  Tree_->SetWorkerPool(nullptr);
+}
+
+TEST_F(SceneTreeTest, StructuralChangesInParallelPhaseApplyAtSyncPoint)
+{
+  WorkerPool Pool(2);
+  Tree_->SetWorkerPool(&Pool);
+
+  Node* Spawner = Tree_->CreateNode("Spawner", NodeType::Node3D, nullptr);
+  NodeHandle SpawnerHandle = Spawner->GetHandle();
+  auto* SpawnScript = new SceneTreeParallelSpawnScript();
+  Spawner->AttachScript(SpawnScript);
+
+  auto* Observer = new SceneTreeSyncObserverScript();
+  Tree_->CreateNode("Observer", NodeType::Node3D, nullptr)->AttachScript(Observer);
+
+  Tree_->Update(0.016f);
+
+  // Queued during the phase, applied before the serial scripts ran
+  EXPECT_EQ(SpawnScript->CreatedDuringPhase, nullptr);
+  EXPECT_TRUE(SpawnScript->OwnerAliveAfterDestroy);
+  EXPECT_TRUE(Observer->SawSpawned);
+  EXPECT_EQ(Tree_->Resolve(SpawnerHandle), nullptr);
+  EXPECT_NE(Tree_->FindNode("Spawned"), nullptr);
+  EXPECT_EQ(Tree_->GetQueuedCommandCount(), 0u);
+  EXPECT_FALSE(Tree_->IsInParallelPhase());
+
+  Tree_->SetWorkerPool(nullptr);
+}
+
+TEST_F(SceneTreeTest, QueuedCommandsFromOtherThreadsApplyAtNextUpdate)
+{
+  Node* Parent = Tree_->CreateNode("Parent", NodeType::Node3D, nullptr);
+  Node* Doomed = Tree_->CreateNode("Doomed", NodeType::Node3D, nullptr);
+
+  Node* Created = nullptr;
+  std::thread Producer([&]() {
+    Tree_->QueueCreateNode("Child", NodeType::Node3D, Parent, [&](Node* N) { Created = N; });
+    Tree_->QueueDestroyNode(Doomed);
+    Tree_->QueueCreateNode("Orphan", NodeType::Node3D, Doomed);
+  });
+  Producer.join();
+
+  EXPECT_EQ(Tree_->GetQueuedCommandCount(), 3u);
+  EXPECT_EQ(Tree_->FindNode("Child"), nullptr);
+
+  Tree_->Update(0.016f);
+
+  ASSERT_NE(Created, nullptr);
+  EXPECT_EQ(Created->GetParent(), Parent);
+  EXPECT_EQ(Tree_->FindNode("Doomed"), nullptr);
+  EXPECT_EQ(Tree_->FindNode("Orphan"), nullptr) << "Destroys apply last, taking Orphan along";
+  EXPECT_EQ(Tree_->GetQueuedCommandCount(), 0u);
+}
+
 //=============================================================================
 // TASK GROUP 5: DestroyNode cleanup for all new lists
 //=============================================================================
@@ -791,7 +1446,7 @@ TEST_F(SceneTreeTest, DestroyNodeWithDirtyTransformRemovesFromDirtyRoots)
   Node* N = Tree_->CreateNode("Dirty", NodeType::Node3D, nullptr);
 
   // Node is already in dirty list from CreateNode.
-  // SetPosition would add again, but InDirtyList_ prevents duplicates.
+  // SetPosition would add again, but DirtyListSlot_ prevents duplicates.
   N->SetPosition(1.0f, 2.0f, 3.0f);
 
   // Destroy before dirty list is processed
@@ -977,3 +1632,966 @@ TEST_F(SceneTreeTest, MultipleScriptsAllReceiveCallbacks)
   EXPECT_EQ(SB->LateUpdateCount, 1);
   EXPECT_EQ(SC->LateUpdateCount, 1);
 }
+
+//=============================================================================
+// TASK GROUP 7: Node handles
+//=============================================================================
+
+// Holds its target by handle and records what Resolve returns each frame
+struct SceneTreeHandleScript : public ScriptBase
+{
+  NodeHandle Target;
+  Node* LastResolved = nullptr;
+  int Received = 0;
+
+  void OnInit() override
+  {
+    Target = GetNodeHandle("../Target");
+    Connect(Target, "ping", [this](const SignalArgs&) { Received++; });
+  }
+
+  void OnUpdate(float DeltaT) override
+  {
+    (void)DeltaT;
+    LastResolved = Resolve(Target);
+  }
+};
+
+TEST_F(SceneTreeTest, HandleResolvesUntilNodeDestroyed)
+{
+  Node* A = Tree_->CreateNode("A", NodeType::Camera, nullptr);
+  NodeHandle Handle = A->GetHandle();
+
+  ASSERT_FALSE(Handle.IsNull());
+  EXPECT_EQ(Tree_->Resolve(Handle), A);
+  EXPECT_EQ(Tree_->Resolve<CameraNode>(Handle), static_cast<CameraNode*>(A));
+  EXPECT_EQ(Tree_->Resolve<LightNode>(Handle), nullptr);
+  EXPECT_EQ(Tree_->FindNodeHandle("A"), Handle);
+  EXPECT_EQ(Tree_->Resolve(NodeHandle()), nullptr);
+  EXPECT_EQ(Tree_->GetHandleCount(), Tree_->GetNodeCount());
+
+  Tree_->DestroyNode(A);
+  EXPECT_EQ(Tree_->Resolve(Handle), nullptr);
+  EXPECT_TRUE(Tree_->FindNodeHandle("A").IsNull());
+  EXPECT_EQ(Tree_->GetHandleCount(), Tree_->GetNodeCount());
+}
+
+TEST_F(SceneTreeTest, ReusedSlotDoesNotResolveStaleHandle)
+{
+  Node* A = Tree_->CreateNode("A", NodeType::Node3D, nullptr);
+  NodeHandle Stale = A->GetHandle();
+  Tree_->DestroyNode(A);
+
+  Node* B = Tree_->CreateNode("B", NodeType::Node3D, nullptr);
+  NodeHandle Fresh = B->GetHandle();
+
+  EXPECT_EQ(Fresh.Index, Stale.Index) << "Freed slot is reused";
+  EXPECT_NE(Fresh.Generation, Stale.Generation);
+  EXPECT_EQ(Tree_->Resolve(Stale), nullptr);
+  EXPECT_EQ(Tree_->Resolve(Fresh), B);
+}
+
+TEST_F(SceneTreeTest, DestroySubtreeInvalidatesAllHandles)
+{
+  Node* Parent = Tree_->CreateNode("Parent", NodeType::Node3D, nullptr);
+  Node* Child = Tree_->CreateNode("Child", NodeType::Node3D, Parent);
+  Node* Grand = Tree_->CreateNode("Grand", NodeType::Node3D, Child);
+  NodeHandle Handles[3] = {Parent->GetHandle(), Child->GetHandle(), Grand->GetHandle()};
+
+  Tree_->DestroyNode(Parent);
+  for (const NodeHandle& Handle : Handles) {
+    EXPECT_EQ(Tree_->Resolve(Handle), nullptr);
+  }
+
+  Node3D Standalone("Standalone", TableAPI_);
+  EXPECT_TRUE(Standalone.GetHandle().IsNull());
+}
+
+TEST_F(SceneTreeTest, ScriptHoldsHandleAndConnectsThroughIt)
+{
+  Node* Parent = Tree_->CreateNode("Parent", NodeType::Node3D, nullptr);
+  Node* Holder = Tree_->CreateNode("Holder", NodeType::Node3D, Parent);
+  Node* Target = Tree_->CreateNode("Target", NodeType::Node3D, Parent);
+
+  auto* Script = new SceneTreeHandleScript();
+  Holder->AttachScript(Script);
+  EXPECT_EQ(Script->GetOwnerHandle(), Holder->GetHandle());
+
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Script->LastResolved, Target);
+
+  Target->EmitSignal("ping");
+  EXPECT_EQ(Script->Received, 1);
+
+  Tree_->DestroyNode(Target);
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Script->LastResolved, nullptr) << "Handle went stale instead of dangling";
+
+  // Connecting through a stale handle is refused
+  EXPECT_EQ(Holder->Connect("ping", [](const SignalArgs&) {}, Script->Target), 0u);
+}
+
+//=============================================================================
+// TASK GROUP 8: Node pools
+//=============================================================================
+
+// Records, on teardown, whether its owner's parent was still reachable
+struct SceneTreePoolScript : public ScriptBase
+{
+  int* DetachCount = nullptr;
+  int* ParentAliveCount = nullptr;
+
+  void OnDetach() override
+  {
+    (*DetachCount)++;
+    Node* Parent = GetOwner()->GetParent();
+    if (Parent && Parent->GetName() == "Parent") {
+      (*ParentAliveCount)++;
+    }
+  }
+};
+
+TEST_F(SceneTreeTest, DestroyedNodeSlotIsReusedBySameType)
+{
+  const NodePool& Pool = Tree_->GetNodePool();
+  EXPECT_EQ(Pool.GetLiveCount(NodeType::Root), 1u);
+
+  Node* A = Tree_->CreateNode("A", NodeType::MeshInstance, nullptr);
+  Node* Light = Tree_->CreateNode("Light", NodeType::Light, nullptr);
+  EXPECT_EQ(Pool.GetLiveCount(NodeType::MeshInstance), 1u);
+  EXPECT_EQ(Pool.GetFreeCount(NodeType::MeshInstance), NodePool::SlotsPerChunk - 1);
+  uint32_t Chunks = Pool.GetChunkCount();
+
+  Tree_->DestroyNode(A);
+  EXPECT_EQ(Pool.GetLiveCount(NodeType::MeshInstance), 0u);
+
+  // A different type never takes the freed slot; the same type does
+  Node* Camera = Tree_->CreateNode("Camera", NodeType::Camera, nullptr);
+  EXPECT_NE(static_cast<void*>(Camera), static_cast<void*>(A));
+  Node* B = Tree_->CreateNode("B", NodeType::MeshInstance, nullptr);
+  EXPECT_EQ(static_cast<void*>(B), static_cast<void*>(A));
+  EXPECT_EQ(B->As<MeshInstance>()->MeshPath.Get(), "") << "Reused slot is freshly constructed";
+  EXPECT_EQ(B->GetName(), "B");
+  EXPECT_EQ(Pool.GetChunkCount(), Chunks + 1) << "Only the camera needed a chunk";
+  EXPECT_EQ(Tree_->GetNodeByID(B->GetNodeID()), B);
+  EXPECT_NE(Light, nullptr);
+}
+
+TEST_F(SceneTreeTest, PoolChunksComeFromSceneAllocator)
+{
+  AxAllocatorAPI* AllocatorAPI = static_cast<AxAllocatorAPI*>(
+    AxonGlobalAPIRegistry->Get(AXON_ALLOCATOR_API_NAME));
+  ASSERT_NE(AllocatorAPI, nullptr);
+  AxAllocator* Arena = AllocatorAPI->CreateLinear("PoolTestArena", 1024 * 1024);
+  ASSERT_NE(Arena, nullptr);
+
+  SceneTree* Scene = new SceneTree(TableAPI_, Arena);
+  Scene->OwnsAllocator = true;
+  uint64_t RootAllocations = Arena->AllocationCount;
+  EXPECT_EQ(RootAllocations, 1u) << "Root chunk";
+
+  const uint32_t Count = NodePool::SlotsPerChunk * 3;
+  for (uint32_t i = 0; i < Count; ++i) {
+    Scene->CreateNode("N", NodeType::Node3D, nullptr);
+  }
+  EXPECT_EQ(Arena->AllocationCount, RootAllocations + 3) << "One allocation per chunk, not per node";
+  EXPECT_EQ(Scene->GetNodePool().GetChunkCount(), 4u);
+  EXPECT_EQ(Scene->GetNodePool().GetLiveCount(NodeType::Node3D), Count);
+
+  // The tree destroys the arena it owns
+  delete Scene;
+}
+
+TEST_F(SceneTreeTest, TeardownDetachesScriptsAndDeletesHeapChildren)
+{
+  int DetachCount = 0;
+  int ParentAliveCount = 0;
+
+  SceneTree* Scene = new SceneTree(TableAPI_, nullptr);
+  Node* Parent = Scene->CreateNode("Parent", NodeType::Node3D, nullptr);
+  Node* Emitter = Scene->CreateNode("Emitter", NodeType::Node3D, nullptr);
+
+  for (int i = 0; i < 3; ++i) {
+    Node* Child = Scene->CreateNode("Child", NodeType::Node3D, Parent);
+    auto* Script = new SceneTreePoolScript();
+    Script->DetachCount = &DetachCount;
+    Script->ParentAliveCount = &ParentAliveCount;
+    Child->AttachScript(Script);
+    Emitter->Connect("ping", [](const SignalArgs&) {}, Child);
+  }
+
+  // A node made with new and parented in is owned (and deleted) by the tree
+  Node* HeapChild = new Node3D("Heap", TableAPI_);
+  Parent->AddChild(HeapChild);
+  auto* HeapScript = new SceneTreePoolScript();
+  HeapScript->DetachCount = &DetachCount;
+  HeapScript->ParentAliveCount = &ParentAliveCount;
+  HeapChild->AttachScript(HeapScript);
+
+  Scene->Update(0.016f);
+  delete Scene;
+
+  EXPECT_EQ(DetachCount, 4);
+  EXPECT_EQ(ParentAliveCount, 4) << "Scripts detach while the hierarchy is intact";
+}
+
+//=============================================================================
+// TASK GROUP 9: Script tasks (coroutines)
+//=============================================================================
+
+// Bumps a counter when the coroutine frame holding it is destroyed
+struct SceneTreeTaskFrameGuard
+{
+  int* Destroyed;
+  ~SceneTreeTaskFrameGuard() { (*Destroyed)++; }
+};
+
+struct SceneTreeTaskScript : public ScriptBase
+{
+  using ScriptBase::StartTask;
+  using ScriptBase::StopAllTasks;
+
+  std::vector<std::string> Steps;
+  float ReceivedArg = 0.0f;
+  bool Flag = false;
+  int FramesDestroyed = 0;
+
+  ScriptTask FrameSteps()
+  {
+    Steps.push_back("start");
+    co_await WaitFrames(2);
+    Steps.push_back("two");
+    co_await WaitFrames(0);
+    co_await WaitFrames(1);
+    Steps.push_back("three");
+  }
+
+  ScriptTask SecondSteps()
+  {
+    co_await WaitSeconds(0.5f);
+    Steps.push_back("half");
+  }
+
+  ScriptTask SignalSteps(Node* Emitter)
+  {
+    SignalArgs Args = co_await WaitForSignal(Emitter, "hit");
+    ReceivedArg = Args.Get<float>(0);
+    Steps.push_back("hit");
+  }
+
+  ScriptTask UntilSteps()
+  {
+    co_await WaitUntil([this] { return (Flag); });
+    Steps.push_back("flag");
+  }
+
+  ScriptTask SleepForever()
+  {
+    SceneTreeTaskFrameGuard Guard{&FramesDestroyed};
+    co_await WaitSeconds(1000.0f);
+    Steps.push_back("woke");
+  }
+
+  // Counts into Destroyed rather than a member: the script is gone by the
+  // time the frame is
+  ScriptTask DestroyOwnNode(int* Destroyed)
+  {
+    SceneTreeTaskFrameGuard Guard{Destroyed};
+    co_await WaitFrames(1);
+    GetSceneTree()->DestroyNode(GetOwner());
+    co_await WaitFrames(1);   // the task ends here
+  }
+};
+
+TEST_F(SceneTreeTest, WaitFramesResumesAfterThatManyUpdates)
+{
+  Node* N = Tree_->CreateNode("Tasked", NodeType::Node3D, nullptr);
+  auto* Script = new SceneTreeTaskScript();
+  N->AttachScript(Script);
+  Tree_->Update(0.016f);
+
+  // Runs to its first wait right away
+  Script->StartTask(Script->FrameSteps());
+  EXPECT_EQ(Script->Steps, std::vector<std::string>({"start"}));
+  EXPECT_EQ(Tree_->GetTaskScheduler().GetTaskCount(), 1u);
+
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Script->Steps.size(), 1u);
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Script->Steps, std::vector<std::string>({"start", "two"}));
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Script->Steps, std::vector<std::string>({"start", "two", "three"}));
+  EXPECT_EQ(Tree_->GetTaskScheduler().GetTaskCount(), 0u) << "Finished tasks are destroyed";
+}
+
+TEST_F(SceneTreeTest, WaitSecondsFollowsFrameTime)
+{
+  Node* N = Tree_->CreateNode("Tasked", NodeType::Node3D, nullptr);
+  auto* Script = new SceneTreeTaskScript();
+  N->AttachScript(Script);
+  Tree_->Update(0.1f);
+
+  Script->StartTask(Script->SecondSteps());
+  for (int i = 0; i < 4; ++i) {
+    Tree_->Update(0.1f);
+  }
+  EXPECT_TRUE(Script->Steps.empty());
+  Tree_->Update(0.1f);
+  EXPECT_EQ(Script->Steps, std::vector<std::string>({"half"}));
+
+  // Frame time stands still while scripts are disabled
+  Script->StartTask(Script->SecondSteps());
+  Tree_->SetScriptsEnabled(false);
+  for (int i = 0; i < 10; ++i) {
+    Tree_->Update(0.1f);
+  }
+  Tree_->SetScriptsEnabled(true);
+  EXPECT_EQ(Script->Steps.size(), 1u);
+}
+
+TEST_F(SceneTreeTest, WaitForSignalResumesWithItsArguments)
+{
+  Node* Emitter = Tree_->CreateNode("Emitter", NodeType::Node3D, nullptr);
+  Node* N = Tree_->CreateNode("Tasked", NodeType::Node3D, nullptr);
+  auto* Script = new SceneTreeTaskScript();
+  N->AttachScript(Script);
+  Tree_->Update(0.016f);
+
+  Script->StartTask(Script->SignalSteps(Emitter));
+  Tree_->Update(0.016f);
+  EXPECT_TRUE(Script->Steps.empty()) << "Nothing was emitted";
+
+  // The first emission wins; the task resumes at the next Update
+  Emitter->EmitSignal("hit", 2.5f);
+  Emitter->EmitSignal("hit", 7.0f);
+  EXPECT_TRUE(Script->Steps.empty());
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Script->Steps, std::vector<std::string>({"hit"}));
+  EXPECT_FLOAT_EQ(Script->ReceivedArg, 2.5f);
+
+  // The connection went with the wait
+  Emitter->EmitSignal("hit", 9.0f);
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Script->Steps.size(), 1u);
+  EXPECT_FLOAT_EQ(Script->ReceivedArg, 2.5f);
+}
+
+TEST_F(SceneTreeTest, WaitUntilPollsItsPredicateEachUpdate)
+{
+  Node* N = Tree_->CreateNode("Tasked", NodeType::Node3D, nullptr);
+  auto* Script = new SceneTreeTaskScript();
+  N->AttachScript(Script);
+  Tree_->Update(0.016f);
+
+  Script->StartTask(Script->UntilSteps());
+  EXPECT_EQ(Tree_->GetTaskScheduler().GetPolledCount(), 1u);
+  Tree_->Update(0.016f);
+  EXPECT_TRUE(Script->Steps.empty());
+
+  Script->Flag = true;
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Script->Steps, std::vector<std::string>({"flag"}));
+  EXPECT_EQ(Tree_->GetTaskScheduler().GetPolledCount(), 0u);
+
+  // A predicate already true does not suspend at all
+  Script->StartTask(Script->UntilSteps());
+  EXPECT_EQ(Script->Steps.size(), 2u);
+}
+
+TEST_F(SceneTreeTest, TasksEndWithTheirScriptAndNode)
+{
+  Node* Emitter = Tree_->CreateNode("Emitter", NodeType::Node3D, nullptr);
+  Node* A = Tree_->CreateNode("A", NodeType::Node3D, nullptr);
+  Node* B = Tree_->CreateNode("B", NodeType::Node3D, nullptr);
+  auto* ScriptA = new SceneTreeTaskScript();
+  auto* ScriptB = new SceneTreeTaskScript();
+  A->AttachScript(ScriptA);
+  B->AttachScript(ScriptB);
+  Tree_->Update(0.016f);
+
+  ScriptA->StartTask(ScriptA->SleepForever());
+  ScriptA->StartTask(ScriptA->SignalSteps(Emitter));
+  ScriptB->StartTask(ScriptB->SleepForever());
+  ScriptB->StartTask(ScriptB->UntilSteps());
+  EXPECT_EQ(Tree_->GetTaskScheduler().GetTaskCount(), 4u);
+
+  // Detaching ends the script's tasks, running their frames' destructors
+  ScriptBase* Detached = A->DetachScript();
+  EXPECT_EQ(ScriptA->FramesDestroyed, 1);
+  EXPECT_EQ(Tree_->GetTaskScheduler().GetTaskCount(), 2u);
+  delete Detached;
+
+  // Nothing is left listening on the emitter
+  Emitter->EmitSignal("hit", 1.0f);
+  Tree_->Update(0.016f);
+
+  EXPECT_EQ(ScriptB->FramesDestroyed, 0);
+  Tree_->DestroyNode(B);
+  EXPECT_EQ(Tree_->GetTaskScheduler().GetTaskCount(), 0u);
+  EXPECT_EQ(Tree_->GetTaskScheduler().GetPolledCount(), 0u);
+}
+
+TEST_F(SceneTreeTest, TaskDestroyingItsOwnNodeEndsAtItsNextWait)
+{
+  Node* N = Tree_->CreateNode("Tasked", NodeType::Node3D, nullptr);
+  auto* Script = new SceneTreeTaskScript();
+  N->AttachScript(Script);
+  Tree_->Update(0.016f);
+
+  // A capture-less lambda taking its state by value is safe as a task
+  int SiblingDestroyed = 0;
+  int OwnDestroyed = 0;
+  Script->StartTask([](int* Destroyed) -> ScriptTask {
+    SceneTreeTaskFrameGuard Guard{Destroyed};
+    co_await WaitSeconds(1000.0f);
+  }(&SiblingDestroyed));
+  Script->StartTask(Script->DestroyOwnNode(&OwnDestroyed));
+  EXPECT_EQ(Tree_->GetTaskScheduler().GetTaskCount(), 2u);
+
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Tree_->FindNode("Tasked"), nullptr);
+  EXPECT_EQ(SiblingDestroyed, 1) << "The sibling task was cancelled with the node";
+  EXPECT_EQ(OwnDestroyed, 1) << "The running task ended at its next wait";
+  EXPECT_EQ(Tree_->GetTaskScheduler().GetTaskCount(), 0u);
+}
+
+TEST_F(SceneTreeTest, TaskFramesAreReusedFromThePool)
+{
+  Node* N = Tree_->CreateNode("Tasked", NodeType::Node3D, nullptr);
+  auto* Script = new SceneTreeTaskScript();
+  N->AttachScript(Script);
+  Tree_->Update(0.016f);
+
+  uint32_t LiveBefore = ScriptTaskFramePool::GetLiveFrameCount();
+  for (int i = 0; i < 8; ++i) {
+    Script->StartTask(Script->SleepForever());
+  }
+  EXPECT_EQ(ScriptTaskFramePool::GetLiveFrameCount(), LiveBefore + 8);
+  Script->StopAllTasks();
+  EXPECT_EQ(Script->FramesDestroyed, 8);
+  EXPECT_EQ(ScriptTaskFramePool::GetLiveFrameCount(), LiveBefore);
+
+  // Warm: the same number of tasks again takes no new chunks
+  size_t Reserved = ScriptTaskFramePool::GetReservedBytes();
+  for (int i = 0; i < 8; ++i) {
+    Script->StartTask(Script->SleepForever());
+  }
+  EXPECT_EQ(ScriptTaskFramePool::GetReservedBytes(), Reserved);
+}
+
+//=============================================================================
+// TASK GROUP 10: Timers and tweens
+//=============================================================================
+
+TEST_F(SceneTreeTest, TimersFireOnFrameTimeAndRepeatUntilCancelled)
+{
+  TimerService& Timers = Tree_->GetTimers();
+  int OneShot = 0;
+  int Repeats = 0;
+  Timers.After(0.25f, [&] { OneShot++; });
+  TimerService::TimerHandle Repeat = Timers.Every(0.125f, [&] { Repeats++; });
+  EXPECT_EQ(Timers.GetTimerCount(), 2u);
+
+  Tree_->Update(0.125f);
+  EXPECT_EQ(OneShot, 0);
+  EXPECT_EQ(Repeats, 1);
+
+  Tree_->Update(0.125f);
+  EXPECT_EQ(OneShot, 1);
+  EXPECT_EQ(Repeats, 2);
+  EXPECT_EQ(Timers.GetLastFireCount(), 2u);
+
+  // A long frame fires a repeating timer once, not once per missed interval
+  Tree_->Update(0.5f);
+  EXPECT_EQ(Repeats, 3);
+
+  EXPECT_TRUE(Timers.Cancel(Repeat));
+  EXPECT_FALSE(Timers.Cancel(Repeat));
+  Tree_->Update(0.125f);
+  EXPECT_EQ(Repeats, 3);
+  EXPECT_EQ(Timers.GetTimerCount(), 0u);
+}
+
+TEST_F(SceneTreeTest, TimersEmitSignalsAndDieWithTheirNode)
+{
+  Node* Emitter = Tree_->CreateNode("Emitter", NodeType::Node3D, nullptr);
+  Node* Owner = Tree_->CreateNode("Owner", NodeType::Node3D, nullptr);
+  float Received = 0.0f;
+  Emitter->Connect("ring", [&](const SignalArgs& Args) { Received = Args.Get<float>(0); });
+
+  SignalArgs Args;
+  Args.Args[0].ArgType = SignalArg::Type::Float;
+  Args.Args[0].AsFloat = 7.0f;
+  Args.Count = 1;
+  Tree_->GetTimers().EmitAfter(0.125f, Emitter, "ring", Args);
+
+  int OwnedFired = 0;
+  TimerService::TimerHandle Owned = Tree_->GetTimers().Every(0.125f, [&] { OwnedFired++; }, Owner);
+  Tree_->DestroyNode(Owner);
+
+  Tree_->Update(0.125f);
+  EXPECT_FLOAT_EQ(Received, 7.0f);
+  EXPECT_EQ(OwnedFired, 0) << "The owner was destroyed first";
+  EXPECT_FALSE(Tree_->GetTimers().IsPending(Owned));
+  EXPECT_EQ(Tree_->GetTimers().GetTimerCount(), 0u);
+}
+
+TEST_F(SceneTreeTest, TweensEaseReflectedPropertiesToTheirTarget)
+{
+  auto* Light = static_cast<LightNode*>(Tree_->CreateNode("Lamp", NodeType::Light, nullptr));
+  ASSERT_NE(Light, nullptr);
+  Light->Intensity = 1.0f;
+  Light->Color = Vec3(1.0f, 1.0f, 1.0f);
+
+  TweenSystem& Tweens = Tree_->GetTweens();
+  int Completed = 0;
+  TweenSystem::TweenHandle Fade = Tweens.Start(Light, "intensity", 3.0f, 1.0f, EaseType::Linear,
+                                               [&] { Completed++; });
+  TweenSystem::TweenHandle Tint = Tweens.Start(Light, "color", Vec3(0.0f, 0.5f, 1.0f), 1.0f,
+                                               EaseType::InQuad);
+  ASSERT_NE(Fade, 0u);
+  ASSERT_NE(Tint, 0u);
+  EXPECT_EQ(Tweens.GetActiveCount(), 2u);
+
+  // Wrong type and unknown names are refused
+  EXPECT_EQ(Tweens.Start(Light, "intensity", Vec3(1.0f), 1.0f), 0u);
+  EXPECT_EQ(Tweens.Start(Light, "missing", 1.0f, 1.0f), 0u);
+
+  Light->ClearPropertiesDirty();
+  Tree_->Update(0.25f);
+  EXPECT_FLOAT_EQ(Light->Intensity, 1.5f);
+  EXPECT_FLOAT_EQ(Light->Color.X, 1.0f - 0.0625f);
+  EXPECT_FLOAT_EQ(Light->Color.Y, 1.0f - 0.5f * 0.0625f);
+  EXPECT_FLOAT_EQ(Light->Color.Z, 1.0f);
+  EXPECT_TRUE(Light->IsPropertiesDirty()) << "Tweens write through Property<T>";
+
+  Tree_->Update(0.5f);
+  Tree_->Update(0.5f);
+  EXPECT_FLOAT_EQ(Light->Intensity, 3.0f) << "Clamped to the end value";
+  EXPECT_FLOAT_EQ(Light->Color.Y, 0.5f);
+  EXPECT_EQ(Completed, 1);
+  EXPECT_FALSE(Tweens.IsActive(Fade));
+  EXPECT_EQ(Tweens.GetActiveCount(), 0u);
+
+  EXPECT_FLOAT_EQ(TweenSystem::Evaluate(EaseType::OutCubic, 0.0f), 0.0f);
+  EXPECT_FLOAT_EQ(TweenSystem::Evaluate(EaseType::InOutQuad, 0.5f), 0.5f);
+  EXPECT_FLOAT_EQ(TweenSystem::Evaluate(EaseType::SmoothStep, 1.0f), 1.0f);
+}
+
+TEST_F(SceneTreeTest, TweensStopOnCancelAndWithTheirNode)
+{
+  auto* A = static_cast<LightNode*>(Tree_->CreateNode("A", NodeType::Light, nullptr));
+  auto* B = static_cast<LightNode*>(Tree_->CreateNode("B", NodeType::Light, nullptr));
+  A->Intensity = 0.0f;
+  B->Intensity = 0.0f;
+
+  TweenSystem& Tweens = Tree_->GetTweens();
+  int Completed = 0;
+  TweenSystem::TweenHandle First = Tweens.Start(A, "intensity", 4.0f, 1.0f);
+  Tweens.Start(A, "range", 4.0f, 1.0f);
+  Tweens.Start(B, "intensity", 4.0f, 1.0f, EaseType::Linear, [&] { Completed++; });
+
+  Tree_->Update(0.25f);
+  EXPECT_TRUE(Tweens.Cancel(First));
+  EXPECT_FALSE(Tweens.Cancel(First));
+  Tree_->Update(0.25f);
+  EXPECT_FLOAT_EQ(A->Intensity, 1.0f) << "Cancelled tweens stay where they were";
+  EXPECT_FLOAT_EQ(A->Range, 2.0f);
+
+  Tweens.CancelTarget(A);
+  EXPECT_EQ(Tweens.GetActiveCount(), 1u);
+
+  Tree_->DestroyNode(B);
+  Tree_->Update(1.0f);
+  EXPECT_EQ(Tweens.GetActiveCount(), 0u);
+  EXPECT_EQ(Completed, 0) << "Tweens of destroyed nodes do not complete";
+}
+
+//=============================================================================
+// TASK GROUP 11: Command buffers
+//=============================================================================
+
+namespace
+{
+
+struct SceneTreeEventLog
+{
+  std::vector<std::pair<AxEventType, std::string>> Entries;
+};
+
+void SceneTreeLogEvent(const AxEvent* Event, void* UserData)
+{
+  auto* Log = static_cast<SceneTreeEventLog*>(UserData);
+  Log->Entries.emplace_back(Event->Type, std::string(Event->Sender->GetName()));
+}
+
+} // namespace
+
+TEST_F(SceneTreeTest, CommandBufferBuildsPendingSubtreesFromAnyThread)
+{
+  Node* Existing = Tree_->CreateNode("Existing", NodeType::Node3D, nullptr);
+  Node* Lamp = nullptr;
+
+  SceneCommandBuffer Buffer;
+  std::thread Producer([&]() {
+    SceneCommandBuffer::NodeRef Rig = Buffer.Create("Rig", NodeType::Node3D);
+    SceneCommandBuffer::NodeRef Light = Buffer.Create("Lamp", NodeType::Light, Rig,
+                                                      [&](Node* N) { Lamp = N; });
+    Buffer.SetProperty(Light, "intensity", 2.5f);
+    Buffer.SetProperty(Light, "color", Vec3(0.25f, 0.5f, 1.0f));
+    Buffer.SetProperty(Light, "type", "spot");
+    Buffer.Reparent(Existing, Rig);
+  });
+  Producer.join();
+
+  EXPECT_EQ(Buffer.GetCommandCount(), 6u);
+  EXPECT_EQ(Tree_->FindNode("Rig"), nullptr) << "Nothing changes before the sync point";
+
+  Tree_->ApplyCommands(Buffer);
+  EXPECT_TRUE(Buffer.IsEmpty());
+
+  Node* Rig = Tree_->FindNode("Rig");
+  ASSERT_NE(Rig, nullptr);
+  ASSERT_NE(Lamp, nullptr);
+  EXPECT_EQ(Lamp->GetParent(), Rig);
+  EXPECT_EQ(Existing->GetParent(), Rig);
+  EXPECT_EQ(Tree_->GetTypedNodeCount(NodeType::Light), 1u);
+
+  auto* Light = static_cast<LightNode*>(Lamp);
+  EXPECT_FLOAT_EQ(Light->Intensity, 2.5f);
+  EXPECT_FLOAT_EQ(Light->Color.Y, 0.5f);
+  EXPECT_EQ(static_cast<int32_t>(Light->LightType), AX_LIGHT_TYPE_SPOT);
+
+  // New and moved nodes pick up their parent's transform at the next flush
+  Rig->GetTransform().SetTranslation(3.0f, 0.0f, 0.0f);
+  Tree_->Update(0.016f);
+  EXPECT_TRUE(SceneTreeFloatNear(Lamp->GetWorldTransform().E[3][0], 3.0f));
+  EXPECT_TRUE(SceneTreeFloatNear(Existing->GetWorldTransform().E[3][0], 3.0f));
+}
+
+TEST_F(SceneTreeTest, CommandBufferAppliesByKindWithOneEventFlush)
+{
+  Node* Doomed = Tree_->CreateNode("Doomed", NodeType::Node3D, nullptr);
+  Tree_->CreateNode("DoomedChild", NodeType::Node3D, Doomed);
+  Node* Mover = Tree_->CreateNode("Mover", NodeType::Light, nullptr);
+
+  SceneTreeEventLog Events;
+  Tree_->GetEventBus()->Subscribe(AX_EVENT_NODE_CREATED, SceneTreeLogEvent, &Events);
+  Tree_->GetEventBus()->Subscribe(AX_EVENT_NODE_DESTROYED, SceneTreeLogEvent, &Events);
+
+  // Recorded destroy-first; applied create, reparent, property, destroy
+  SceneCommandBuffer& Buffer = Tree_->GetCommandBuffer();
+  Buffer.Destroy(Doomed);
+  Buffer.Destroy(Doomed);
+  Buffer.SetProperty(Mover, "intensity", 4.0f);
+  Buffer.Reparent(Mover, Doomed);
+  Buffer.Create("Late", NodeType::Node3D, Doomed);
+  Buffer.Create("Survivor", NodeType::Node3D);
+  EXPECT_EQ(Tree_->GetQueuedCommandCount(), 6u);
+
+  Tree_->FlushQueuedCommands();
+
+  EXPECT_EQ(Tree_->FindNode("Doomed"), nullptr);
+  EXPECT_EQ(Tree_->FindNode("Mover"), nullptr) << "Moved under Doomed before the destroy";
+  EXPECT_EQ(Tree_->FindNode("Late"), nullptr);
+  EXPECT_NE(Tree_->FindNode("Survivor"), nullptr);
+  EXPECT_EQ(Tree_->GetNodeCount(), 2u);
+
+  // Creates first, then each destroyed node once, parents before children.
+  // Late was attached before Mover moved in, so it comes first.
+  std::vector<std::pair<AxEventType, std::string>> Expected = {
+    {AX_EVENT_NODE_CREATED, "Late"},
+    {AX_EVENT_NODE_CREATED, "Survivor"},
+    {AX_EVENT_NODE_DESTROYED, "Doomed"},
+    {AX_EVENT_NODE_DESTROYED, "DoomedChild"},
+    {AX_EVENT_NODE_DESTROYED, "Late"},
+    {AX_EVENT_NODE_DESTROYED, "Mover"},
+  };
+  EXPECT_EQ(Events.Entries, Expected);
+
+  Tree_->GetEventBus()->Unsubscribe(AX_EVENT_NODE_CREATED, SceneTreeLogEvent, &Events);
+  Tree_->GetEventBus()->Unsubscribe(AX_EVENT_NODE_DESTROYED, SceneTreeLogEvent, &Events);
+}
+
+TEST_F(SceneTreeTest, CommandBufferSkipsCommandsWhoseTargetsAreGone)
+{
+  Node* Parent = Tree_->CreateNode("Parent", NodeType::Node3D, nullptr);
+  Node* Child = Tree_->CreateNode("Child", NodeType::Light, Parent);
+  Node* Gone = Tree_->CreateNode("Gone", NodeType::Node3D, nullptr);
+  NodeHandle GoneHandle = Gone->GetHandle();
+  Tree_->DestroyNode(Gone);
+
+  SceneCommandBuffer Buffer;
+  SceneCommandBuffer::NodeRef Early = Buffer.Create("Early", NodeType::Node3D);
+  Tree_->ApplyCommands(Buffer);
+  ASSERT_NE(Tree_->FindNode("Early"), nullptr);
+
+  // A pending ref only names a node within the pass it was recorded for
+  Buffer.Create("Stale", NodeType::Node3D, Early);
+  Buffer.Reparent(Early, Child);
+  Buffer.Create("Lost", NodeType::Node3D, GoneHandle);
+  Buffer.Reparent(Parent, Child);                      // into its own subtree
+  Buffer.SetProperty(Child, "intensity", 7);           // int for a float property
+  Buffer.SetProperty(Child, "missing", 1.0f);
+  Buffer.Destroy(GoneHandle);
+  Tree_->ApplyCommands(Buffer);
+
+  EXPECT_EQ(Tree_->FindNode("Stale"), nullptr);
+  EXPECT_EQ(Tree_->FindNode("Lost"), nullptr);
+  Node* RootNode = static_cast<Node*>(Tree_->GetRootNode());
+  EXPECT_EQ(Tree_->FindNode("Early")->GetParent(), RootNode);
+  EXPECT_EQ(Parent->GetParent(), RootNode);
+  EXPECT_FLOAT_EQ(static_cast<LightNode*>(Child)->Intensity, 1.0f);
+  EXPECT_EQ(Tree_->GetNodeCount(), 4u);
+}
+
+TEST_F(SceneTreeTest, UpdateAppliesQueuedCommandsWithScriptsDisabled)
+{
+  Node* Parent = Tree_->CreateNode("Parent", NodeType::Node3D, nullptr);
+  Parent->GetTransform().SetTranslation(2.0f, 0.0f, 0.0f);
+  Tree_->SetScriptsEnabled(false);
+
+  Tree_->GetCommandBuffer().Create("Queued", NodeType::Node3D, Parent);
+  Tree_->Update(0.016f);
+
+  Node* Created = Tree_->FindNode("Queued");
+  ASSERT_NE(Created, nullptr);
+  EXPECT_EQ(Tree_->GetQueuedCommandCount(), 0u);
+  EXPECT_TRUE(SceneTreeFloatNear(Created->GetWorldTransform().E[3][0], 2.0f))
+    << "Placed by the same Update that created it";
+  Tree_->SetScriptsEnabled(true);
+}
+
+//=============================================================================
+// TASK GROUP 12: Prefab instantiation
+//=============================================================================
+
+namespace
+{
+
+struct SceneTreeBatchLog
+{
+  uint32_t CreatedEvents = 0;
+  uint32_t BatchEvents = 0;
+  Node* Sender = nullptr;
+  std::vector<Node*> Roots;
+  uint32_t NodesPerInstance = 0;
+};
+
+void SceneTreeLogCreated(const AxEvent*, void* UserData)
+{
+  static_cast<SceneTreeBatchLog*>(UserData)->CreatedEvents++;
+}
+
+void SceneTreeLogBatch(const AxEvent* Event, void* UserData)
+{
+  auto* Log = static_cast<SceneTreeBatchLog*>(UserData);
+  auto* Payload = static_cast<const AxNodesInstantiatedEvent*>(Event->Data);
+  Log->BatchEvents++;
+  Log->Sender = Event->Sender;
+  Log->Roots.assign(Payload->Roots, Payload->Roots + Payload->InstanceCount);
+  Log->NodesPerInstance = Payload->NodesPerInstance;
+}
+
+ScriptBase* SceneTreeMakeCountingScript()
+{
+  return (new SceneTreeCountingScript());
+}
+
+} // namespace
+
+TEST_F(SceneTreeTest, InstantiateBatchBuildsCopiesWithPropertiesAndScripts)
+{
+  ScriptRegistry::Get().Register("SceneTreePrefabScript", SceneTreeMakeCountingScript);
+
+  PrefabTransform BarrelLocal;
+  BarrelLocal.Translation = Vec3(0.0f, 1.0f, 0.0f);
+
+  PrefabTemplate Turret;
+  uint32_t Base = Turret.AddNode("Turret", NodeType::Node3D);
+  uint32_t Barrel = Turret.AddNode("Barrel", NodeType::MeshInstance, Base, BarrelLocal);
+  uint32_t Muzzle = Turret.AddNode("Muzzle", NodeType::Light, Barrel);
+  EXPECT_TRUE(Turret.SetProperty(Barrel, "mesh", "barrel.obj"));
+  EXPECT_TRUE(Turret.SetProperty(Barrel, "renderLayer", 2));
+  EXPECT_TRUE(Turret.SetProperty(Muzzle, "intensity", 1.5f));
+  EXPECT_TRUE(Turret.SetProperty(Muzzle, "intensity", 3.0f));
+  EXPECT_TRUE(Turret.SetProperty(Muzzle, "type", "spot"));
+  Turret.SetScript(Base, "SceneTreePrefabScript");
+  ASSERT_EQ(Turret.GetNodeCount(), 3u);
+
+  Node* Parent = Tree_->CreateNode("Turrets", NodeType::Node3D, nullptr);
+
+  SceneTreeBatchLog Events;
+  Tree_->GetEventBus()->Subscribe(AX_EVENT_NODE_CREATED, SceneTreeLogCreated, &Events);
+  Tree_->GetEventBus()->Subscribe(AX_EVENT_NODES_INSTANTIATED, SceneTreeLogBatch, &Events);
+
+  PrefabTransform Placements[3];
+  for (int i = 0; i < 3; ++i) {
+    Placements[i].Translation = Vec3(10.0f * i, 0.0f, 0.0f);
+  }
+  Node* Roots[3] = {};
+  EXPECT_EQ(Tree_->InstantiateBatch(Turret, 3, Placements, Parent, Roots), 3u);
+
+  // One batch event instead of one event per node
+  EXPECT_EQ(Events.CreatedEvents, 0u);
+  EXPECT_EQ(Events.BatchEvents, 1u);
+  EXPECT_EQ(Events.Sender, Parent);
+  EXPECT_EQ(Events.Roots, std::vector<Node*>(Roots, Roots + 3));
+  EXPECT_EQ(Events.NodesPerInstance, 3u);
+
+  EXPECT_EQ(Tree_->GetNodeCount(), 11u);
+  EXPECT_EQ(Tree_->GetTypedNodeCount(NodeType::MeshInstance), 3u);
+  EXPECT_EQ(Tree_->GetTypedNodeCount(NodeType::Light), 3u);
+
+  Tree_->Update(0.016f);
+
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_NE(Roots[i], nullptr);
+    EXPECT_EQ(Roots[i]->GetParent(), Parent);
+    EXPECT_EQ(Roots[i]->GetName(), "Turret");
+
+    auto* Mesh = static_cast<MeshInstance*>(Roots[i]->FindChild("Barrel"));
+    ASSERT_NE(Mesh, nullptr);
+    EXPECT_EQ(Mesh->MeshPath.Get(), "barrel.obj");
+    EXPECT_EQ(Mesh->RenderLayer.Get(), 2);
+
+    auto* Light = static_cast<LightNode*>(Mesh->FindChild("Muzzle"));
+    ASSERT_NE(Light, nullptr);
+    EXPECT_FLOAT_EQ(Light->Intensity, 3.0f);
+    EXPECT_EQ(static_cast<int32_t>(Light->LightType), AX_LIGHT_TYPE_SPOT);
+    EXPECT_TRUE(Light->IsPropertiesDirty());
+
+    // Instance placement composes with the record's local transform
+    EXPECT_TRUE(SceneTreeFloatNear(Light->GetWorldTransform().E[3][0], 10.0f * i));
+    EXPECT_TRUE(SceneTreeFloatNear(Light->GetWorldTransform().E[3][1], 1.0f));
+
+    auto* Script = static_cast<SceneTreeCountingScript*>(Roots[i]->GetScript());
+    ASSERT_NE(Script, nullptr);
+    EXPECT_EQ(Script->InitCount, 1);
+    EXPECT_EQ(Script->UpdateCount, 1);
+  }
+
+  Tree_->GetEventBus()->Unsubscribe(AX_EVENT_NODE_CREATED, SceneTreeLogCreated, &Events);
+  Tree_->GetEventBus()->Unsubscribe(AX_EVENT_NODES_INSTANTIATED, SceneTreeLogBatch, &Events);
+  ScriptRegistry::Get().Unregister("SceneTreePrefabScript");
+}
+
+TEST_F(SceneTreeTest, PrefabTemplateCapturesSubtreesAndRejectsBadRecords)
+{
+  auto* Lamp = static_cast<LightNode*>(Tree_->CreateNode("Lamp", NodeType::Light, nullptr));
+  Lamp->Intensity = 5.0f;
+  Lamp->GetTransform().SetTranslation(1.0f, 2.0f, 3.0f);
+  Tree_->CreateNode("Socket", NodeType::Node3D, Lamp);
+
+  PrefabTemplate Captured = PrefabTemplate::Capture(Lamp);
+  ASSERT_EQ(Captured.GetNodeCount(), 2u);
+  EXPECT_EQ(Captured.GetString(Captured.GetRecord(1).NameId), "Socket");
+  EXPECT_EQ(Captured.GetRecord(1).Parent, 0u);
+  EXPECT_FLOAT_EQ(Captured.GetRecord(0).Local.Translation.Y, 2.0f);
+
+  Node* Copy = nullptr;
+  EXPECT_EQ(Tree_->InstantiateBatch(Captured, 1, nullptr, nullptr, &Copy), 1u);
+  ASSERT_NE(Copy, nullptr);
+  ASSERT_NE(Copy, Lamp);
+  EXPECT_FLOAT_EQ(static_cast<LightNode*>(Copy)->Intensity, 5.0f);
+  EXPECT_NE(Copy->FindChild("Socket"), nullptr);
+
+  Tree_->Update(0.016f);
+  EXPECT_TRUE(SceneTreeFloatNear(Copy->GetWorldTransform().E[3][2], 3.0f));
+
+  // Invalid records and values are refused without touching the template
+  PrefabTemplate Bad;
+  EXPECT_EQ(Bad.AddNode("Scene", NodeType::Root), PrefabTemplate::NoParent);
+  EXPECT_EQ(Bad.AddNode("Orphan", NodeType::Node3D, 4), PrefabTemplate::NoParent);
+  uint32_t First = Bad.AddNode("First", NodeType::Light);
+  EXPECT_EQ(First, 0u);
+  EXPECT_EQ(Bad.AddNode("Second", NodeType::Node3D), PrefabTemplate::NoParent);
+  EXPECT_FALSE(Bad.SetProperty(First, "intensity", 7));
+  EXPECT_FALSE(Bad.SetProperty(First, "missing", 1.0f));
+  EXPECT_FALSE(Bad.SetProperty(First, "type", "laser"));
+  EXPECT_EQ(Bad.GetNodeCount(), 1u);
+  EXPECT_EQ(Bad.GetRecord(0).ValueCount, 0u);
+}
+
+//=============================================================================
+// TASK GROUP 13: Frame statistics
+//=============================================================================
+
+TEST_F(SceneTreeTest, FrameStatsCountTreeWork)
+{
+  Node* Parent = Tree_->CreateNode("Parent", NodeType::Node3D, nullptr);
+  Node* Child  = Tree_->CreateNode("Child",  NodeType::Node3D, Parent);
+  auto* PScript = new SceneTreeCountingScript();
+  auto* CScript = new SceneTreeCountingScript();
+  Parent->AttachScript(PScript);
+  Child->AttachScript(CScript);
+
+  Tree_->ResetFrameStats();
+  Tree_->Update(0.016f);
+
+  const FrameStats& Stats = Tree_->GetFrameStats();
+#if AX_FRAME_STATS
+  EXPECT_EQ(Stats.InitScripts, 2u);
+  EXPECT_EQ(Stats.UpdateScripts, 2u);
+  EXPECT_GE(Stats.DirtyRoots, 1u);
+  EXPECT_GE(Stats.NodesRecomputed, 2u);
+  EXPECT_GE(Stats.GetPhaseMicros(FramePhase::TransformFlush), 0.0f);
+#endif
+
+  // Moving the parent alone recomputes it and its child from one root;
+  // the tree never counts the engine-level phases
+  Tree_->ResetFrameStats();
+  Parent->GetTransform().SetTranslation(1.0f, 0.0f, 0.0f);
+  Tree_->FixedUpdate(0.02f);
+  Tree_->FixedUpdate(0.02f);
+  Tree_->Update(0.016f);
+  Tree_->LateUpdate(0.016f);
+
+  EXPECT_EQ(CScript->FixedUpdateCount, 2);
+#if AX_FRAME_STATS
+  EXPECT_EQ(Stats.InitScripts, 0u);
+  EXPECT_EQ(Stats.FixedUpdateScripts, 4u);
+  EXPECT_EQ(Stats.UpdateScripts, 2u);
+  EXPECT_EQ(Stats.LateUpdateScripts, 2u);
+  EXPECT_EQ(Stats.DirtyRoots, 1u);
+  EXPECT_EQ(Stats.NodesRecomputed, 2u);
+#endif
+  EXPECT_EQ(Stats.FixedSteps, 0u);
+  EXPECT_EQ(Stats.ResourcesReleased, 0u);
+  EXPECT_EQ(Stats.GetPhaseMicros(FramePhase::Render), 0.0f);
+
+  Tree_->ResetFrameStats();
+  EXPECT_EQ(Stats.UpdateScripts, 0u);
+  EXPECT_EQ(Stats.GetPhaseMicros(FramePhase::Scripts), 0.0f);
+}
+
+TEST(FrameStatsHistoryTest, KeepsTheNewestFramesAndAverages)
+{
+  FrameStatsHistory History;
+  EXPECT_EQ(History.GetCount(), 0u);
+  EXPECT_EQ(History.GetAveragePhaseMicros(FramePhase::Update), 0.0f);
+
+  const uint32_t Pushed = FrameStatsHistory::Capacity + 5;
+  for (uint32_t i = 0; i < Pushed; ++i) {
+    FrameStats Frame;
+    Frame.FrameIndex = i;
+    Frame.PhaseMicros[static_cast<uint32_t>(FramePhase::Update)] = (i % 2 == 0) ? 10.0f : 30.0f;
+    History.Push(Frame);
+  }
+
+  ASSERT_EQ(History.GetCount(), FrameStatsHistory::Capacity);
+  EXPECT_EQ(History.Get(0).FrameIndex, Pushed - 1);
+  EXPECT_EQ(History.Get(FrameStatsHistory::Capacity - 1).FrameIndex, 5u);
+  EXPECT_FLOAT_EQ(History.GetAveragePhaseMicros(FramePhase::Update), 20.0f);
+  EXPECT_EQ(History.GetAveragePhaseMicros(FramePhase::Render), 0.0f);
+
+  FrameStats Sum;
+  Sum.Accumulate(History.Get(0));
+  Sum.Accumulate(History.Get(1));
+  EXPECT_FLOAT_EQ(Sum.GetPhaseMicros(FramePhase::Update), 40.0f);
+  EXPECT_EQ(Sum.FrameIndex, 0u);
+
+  History.Clear();
+  EXPECT_EQ(History.GetCount(), 0u);
+  EXPECT_STREQ(GetFramePhaseName(FramePhase::TransformFlush), "TransformFlush");
+}
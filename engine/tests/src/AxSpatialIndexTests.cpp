@@ -0,0 +1,320 @@
+/**
+ * AxSpatialIndexTests.cpp - Tests for the dynamic AABB tree and SceneTree bounds
+ *
+ * Tests SpatialIndex directly and through SceneTree:
+ *   - Box and sphere queries match a brute-force scan after inserts, moves
+ *     and removals, and the tree stays valid and shallow
+ *   - Frustum queries match per-box FrustumTestAABB
+ *   - Ray hits are sorted, the closest hit is the first of them, and the
+ *     batched (pooled) form matches single rays
+ *   - Batched shape queries fill per-query offsets
+ *   - SceneTree: bounds follow the node (and its parent) through the
+ *     transform flush, and destroyed or cleared nodes leave the index
+ */
+
+#include "gtest/gtest.h"
+#include "Foundation/AxTypes.h"
+#include "Foundation/AxHashTable.h"
+#include "Foundation/AxAPIRegistry.h"
+#include "Foundation/AxBounds.h"
+#include "AxEngine/AxSceneTree.h"
+#include "AxEngine/AxNode.h"
+#include "AxEngine/AxSpatialIndex.h"
+#include "AxEngine/AxWorkerPool.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+//=============================================================================
+// Helpers
+//=============================================================================
+
+static AxAABB SpatialTestBox(float X, float Y, float Z, float HalfSize)
+{
+  return (AABBFromCenterExtents(AxVec3{X, Y, Z}, AxVec3{HalfSize, HalfSize, HalfSize}));
+}
+
+static std::vector<Node*> SortedNodes(std::vector<Node*> Nodes)
+{
+  std::sort(Nodes.begin(), Nodes.end());
+  return (Nodes);
+}
+
+// Standalone nodes as proxy owners, with each one's placement kept for a
+// brute-force reference
+class SpatialIndexTest : public testing::Test
+{
+protected:
+  void AddRandom(uint32_t Count, float Extent)
+  {
+    std::uniform_real_distribution<float> Pos(-Extent, Extent);
+    std::uniform_real_distribution<float> Size(0.1f, 2.0f);
+    for (uint32_t i = 0; i < Count; ++i) {
+      Owners_.push_back(std::make_unique<Node3D>("Owner", nullptr));
+      Worlds_.push_back(Mat4::Translation(Vec3(Pos(Rng_), Pos(Rng_), Pos(Rng_))));
+      Locals_.push_back(SpatialTestBox(0.0f, 0.0f, 0.0f, Size(Rng_)));
+      Ids_.push_back(Index_.Insert(Owners_.back().get(), Locals_.back(), Worlds_.back()));
+    }
+  }
+
+  // Nodes whose world box passes Test, found by checking every box
+  template<typename TestFn>
+  std::vector<Node*> BruteForce(TestFn&& Test) const
+  {
+    std::vector<Node*> Found;
+    for (size_t i = 0; i < Ids_.size(); ++i) {
+      if (Ids_[i] != SpatialIndex::InvalidProxy &&
+          Test(AABBTransform(Locals_[i], static_cast<AxMat4x4>(Worlds_[i])))) {
+        Found.push_back(Owners_[i].get());
+      }
+    }
+    std::sort(Found.begin(), Found.end());
+    return (Found);
+  }
+
+  SpatialIndex Index_;
+  std::mt19937 Rng_{11};
+  std::vector<std::unique_ptr<Node>> Owners_;
+  std::vector<Mat4> Worlds_;
+  std::vector<AxAABB> Locals_;
+  std::vector<SpatialIndex::ProxyId> Ids_;
+};
+
+//=============================================================================
+// SpatialIndex
+//=============================================================================
+
+TEST_F(SpatialIndexTest, ShapeQueriesMatchBruteForceAfterMovesAndRemovals)
+{
+  AddRandom(3000, 100.0f);
+  EXPECT_TRUE(Index_.Validate());
+  EXPECT_EQ(Index_.GetProxyCount(), 3000u);
+  EXPECT_LE(Index_.GetHeight(), 24u) << "Rotations keep the tree logarithmic";
+
+  // Move everything: most by a small step, every 10th far away
+  std::uniform_real_distribution<float> Step(-0.3f, 0.3f);
+  std::uniform_real_distribution<float> Jump(-100.0f, 100.0f);
+  for (size_t i = 0; i < Ids_.size(); ++i) {
+    Vec3 To = (i % 10 == 0) ? Vec3(Jump(Rng_), Jump(Rng_), Jump(Rng_))
+                            : Vec3(Worlds_[i].E[3][0] + Step(Rng_), Worlds_[i].E[3][1], Worlds_[i].E[3][2]);
+    Worlds_[i] = Mat4::Translation(To);
+    Index_.Update(Ids_[i], Worlds_[i]);
+  }
+  EXPECT_GT(Index_.GetReinsertCount(), 0u);
+  EXPECT_LT(Index_.GetReinsertCount(), 3000u) << "Small steps stay inside their fat boxes";
+
+  for (size_t i = 0; i < Ids_.size(); i += 3) {
+    Index_.Remove(Ids_[i]);
+    Ids_[i] = SpatialIndex::InvalidProxy;
+  }
+  EXPECT_TRUE(Index_.Validate());
+  EXPECT_EQ(Index_.GetProxyCount(), 2000u);
+
+  std::vector<Node*> Found;
+  for (int q = 0; q < 50; ++q) {
+    AxAABB Box = SpatialTestBox(Jump(Rng_), Jump(Rng_), Jump(Rng_), 15.0f);
+    Index_.QueryAABB(Box, Found);
+    EXPECT_EQ(SortedNodes(Found),
+              BruteForce([&Box](const AxAABB& Other) { return (AABBOverlaps(Box, Other)); }));
+
+    AxSphere Sphere = {AxVec3{Jump(Rng_), Jump(Rng_), Jump(Rng_)}, 20.0f};
+    Index_.QuerySphere(Sphere, Found);
+    EXPECT_EQ(SortedNodes(Found),
+              BruteForce([&Sphere](const AxAABB& Other) { return (SphereOverlapsAABB(Sphere, Other)); }));
+  }
+
+  // A callback returning false stops the query
+  uint32_t Visits = 0;
+  Index_.QueryAABB(SpatialTestBox(0.0f, 0.0f, 0.0f, 1000.0f), [&Visits](Node*) {
+    Visits++;
+    return (Visits < 5);
+  });
+  EXPECT_EQ(Visits, 5u);
+}
+
+TEST_F(SpatialIndexTest, FrustumQueryMatchesPerBoxTest)
+{
+  AddRandom(2000, 100.0f);
+
+  // A slab box with one tilted side: planes point inwards
+  AxFrustum Frustum;
+  Frustum.Planes[AX_FRUSTUM_PLANE_LEFT] = {AxVec3{1.0f, 0.0f, 0.0f}, 40.0f};     // X >= -40
+  Frustum.Planes[AX_FRUSTUM_PLANE_RIGHT] = {AxVec3{-1.0f, 0.0f, 0.0f}, 30.0f};   // X <= 30
+  Frustum.Planes[AX_FRUSTUM_PLANE_BOTTOM] = {AxVec3{0.0f, 1.0f, 0.0f}, 50.0f};
+  Frustum.Planes[AX_FRUSTUM_PLANE_TOP] = {AxVec3{0.0f, -1.0f, 0.0f}, 50.0f};
+  Frustum.Planes[AX_FRUSTUM_PLANE_NEAR] = {AxVec3{0.0f, 0.70710678f, 0.70710678f}, 20.0f};
+  Frustum.Planes[AX_FRUSTUM_PLANE_FAR] = {AxVec3{0.0f, 0.0f, -1.0f}, 60.0f};
+
+  std::vector<Node*> Found;
+  uint32_t Count = Index_.QueryFrustum(Frustum, Found);
+  EXPECT_GT(Count, 0u);
+  EXPECT_LT(Count, 2000u);
+  EXPECT_EQ(SortedNodes(Found),
+            BruteForce([&Frustum](const AxAABB& Other) { return (FrustumTestAABB(&Frustum, Other)); }));
+}
+
+TEST_F(SpatialIndexTest, RaycastsAreSortedAndClosestMatches)
+{
+  AddRandom(2000, 50.0f);
+
+  std::uniform_real_distribution<float> Coord(-60.0f, 60.0f);
+  std::vector<SpatialRay> Rays;
+  for (int r = 0; r < 200; ++r) {
+    AxVec3 From = {Coord(Rng_), Coord(Rng_), -80.0f};
+    AxVec3 To = {Coord(Rng_), Coord(Rng_), 80.0f};
+    AxVec3 Direction = {To.X - From.X, To.Y - From.Y, To.Z - From.Z};
+    Rays.push_back({From, Direction, 1.0f});
+  }
+  Rays.push_back({AxVec3{0.0f, 0.0f, 0.0f}, AxVec3{0.0f, 0.0f, 1.0f}, 0.0f});   // zero-length
+
+  std::vector<SpatialRayHit> Hits;
+  uint32_t HitRays = 0;
+  std::vector<SpatialRayHit> Closest(Rays.size());
+  for (size_t r = 0; r < Rays.size(); ++r) {
+    Index_.Raycast(Rays[r], Hits);
+    for (size_t h = 1; h < Hits.size(); ++h) {
+      EXPECT_LE(Hits[h - 1].Distance, Hits[h].Distance);
+    }
+
+    bool Hit = Index_.RaycastClosest(Rays[r], &Closest[r]);
+    EXPECT_EQ(Hit, !Hits.empty());
+    if (Hit) {
+      HitRays++;
+      EXPECT_FLOAT_EQ(Closest[r].Distance, Hits[0].Distance);
+    } else {
+      EXPECT_EQ(Closest[r].Target, nullptr);
+    }
+  }
+  EXPECT_GT(HitRays, 0u);
+
+  // Batched, across a pool, gives the same answers
+  WorkerPool Pool(2);
+  std::vector<SpatialRayHit> Batched(Rays.size());
+  Index_.RaycastClosest(Rays.data(), static_cast<uint32_t>(Rays.size()), Batched.data(), &Pool);
+  for (size_t r = 0; r < Rays.size(); ++r) {
+    EXPECT_EQ(Batched[r].Target, Closest[r].Target);
+    EXPECT_EQ(Batched[r].Distance, Closest[r].Distance);
+  }
+}
+
+TEST_F(SpatialIndexTest, BatchedQueriesFillOffsets)
+{
+  AddRandom(1000, 50.0f);
+
+  std::vector<AxSphere> Spheres = {
+    {AxVec3{0.0f, 0.0f, 0.0f}, 10.0f},
+    {AxVec3{500.0f, 0.0f, 0.0f}, 1.0f},     // empty
+    {AxVec3{20.0f, -20.0f, 5.0f}, 15.0f},
+  };
+  std::vector<Node*> Nodes;
+  std::vector<uint32_t> Offsets;
+  Index_.QuerySpheres(Spheres.data(), static_cast<uint32_t>(Spheres.size()), Nodes, Offsets);
+
+  ASSERT_EQ(Offsets.size(), 4u);
+  EXPECT_EQ(Offsets[0], 0u);
+  EXPECT_EQ(Offsets[1], Offsets[2]);
+  EXPECT_EQ(Offsets[3], Nodes.size());
+
+  std::vector<Node*> Single;
+  for (size_t i = 0; i < Spheres.size(); ++i) {
+    Index_.QuerySphere(Spheres[i], Single);
+    std::vector<Node*> Slice(Nodes.begin() + Offsets[i], Nodes.begin() + Offsets[i + 1]);
+    EXPECT_EQ(SortedNodes(Slice), SortedNodes(Single));
+  }
+}
+
+//=============================================================================
+// SceneTree
+//=============================================================================
+
+class SceneSpatialTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    AxonInitGlobalAPIRegistry();
+    AxonRegisterAllFoundationAPIs(AxonGlobalAPIRegistry);
+    TableAPI_ = static_cast<AxHashTableAPI*>(AxonGlobalAPIRegistry->Get(AXON_HASH_TABLE_API_NAME));
+    ASSERT_NE(TableAPI_, nullptr);
+    Tree_ = new SceneTree(TableAPI_, nullptr);
+  }
+
+  void TearDown() override
+  {
+    delete Tree_;
+    AxonTermGlobalAPIRegistry();
+  }
+
+  AxHashTableAPI* TableAPI_{nullptr};
+  SceneTree* Tree_{nullptr};
+};
+
+TEST_F(SceneSpatialTest, BoundsFollowTransformFlush)
+{
+  Node* Parent = Tree_->CreateNode("Parent", NodeType::Node3D, nullptr);
+  Node* Crate = Tree_->CreateNode("Crate", NodeType::Node3D, Parent);
+  Parent->SetPosition(10.0f, 0.0f, 0.0f);
+  Crate->SetPosition(0.0f, 5.0f, 0.0f);
+  Tree_->SetNodeBounds(Crate, SpatialTestBox(0.0f, 0.0f, 0.0f, 1.0f));
+  Tree_->Update(0.016f);
+
+  AxAABB Box;
+  ASSERT_TRUE(Tree_->GetNodeBounds(Crate, &Box));
+  EXPECT_FLOAT_EQ(Box.Min.X, 9.0f);
+  EXPECT_FLOAT_EQ(Box.Max.Y, 6.0f);
+  EXPECT_FALSE(Tree_->GetNodeBounds(Parent, &Box));
+
+  std::vector<Node*> Found;
+  EXPECT_EQ(Tree_->GetSpatialIndex().QuerySphere({AxVec3{10.0f, 5.0f, 0.0f}, 0.5f}, Found), 1u);
+
+  // Moving the parent moves the indexed child
+  Parent->SetPosition(-20.0f, 0.0f, 0.0f);
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Tree_->GetSpatialIndex().QuerySphere({AxVec3{10.0f, 5.0f, 0.0f}, 0.5f}, Found), 0u);
+  EXPECT_EQ(Tree_->GetSpatialIndex().QuerySphere({AxVec3{-20.0f, 5.0f, 0.0f}, 0.5f}, Found), 1u);
+
+  SpatialRayHit Hit;
+  ASSERT_TRUE(Tree_->GetSpatialIndex().RaycastClosest(
+    {AxVec3{-20.0f, 5.0f, -10.0f}, AxVec3{0.0f, 0.0f, 1.0f}, 100.0f}, &Hit));
+  EXPECT_EQ(Hit.Target, Crate);
+  EXPECT_FLOAT_EQ(Hit.Distance, 9.0f);
+
+  // New bounds replace the old
+  Tree_->SetNodeBounds(Crate, SpatialTestBox(0.0f, 0.0f, 0.0f, 3.0f));
+  ASSERT_TRUE(Tree_->GetNodeBounds(Crate, &Box));
+  EXPECT_FLOAT_EQ(Box.Min.X, -23.0f);
+  EXPECT_EQ(Tree_->GetSpatialIndex().GetProxyCount(), 1u);
+}
+
+TEST_F(SceneSpatialTest, DestroyedAndClearedNodesLeaveTheIndex)
+{
+  Node* Group = Tree_->CreateNode("Group", NodeType::Node3D, nullptr);
+  std::vector<Node*> Members;
+  for (int i = 0; i < 10; ++i) {
+    Node* Member = Tree_->CreateNode("Member", NodeType::Node3D, Group);
+    Member->SetPosition(static_cast<float>(i) * 3.0f, 0.0f, 0.0f);
+    Tree_->SetNodeBounds(Member, SpatialTestBox(0.0f, 0.0f, 0.0f, 1.0f));
+    Members.push_back(Member);
+  }
+  Node* Loner = Tree_->CreateNode("Loner", NodeType::Node3D, nullptr);
+  Tree_->SetNodeBounds(Loner, SpatialTestBox(0.0f, 0.0f, 0.0f, 1.0f));
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Tree_->GetSpatialIndex().GetProxyCount(), 11u);
+
+  Tree_->ClearNodeBounds(Members[0]);
+  EXPECT_FALSE(Tree_->GetNodeBounds(Members[0], nullptr));
+  Members[0]->SetPosition(100.0f, 0.0f, 0.0f);
+  Tree_->Update(0.016f);   // no longer watched; nothing to refit
+
+  Tree_->DestroyNode(Group);
+  Tree_->Update(0.016f);
+  EXPECT_EQ(Tree_->GetSpatialIndex().GetProxyCount(), 1u);
+  EXPECT_TRUE(Tree_->GetSpatialIndex().Validate());
+
+  std::vector<Node*> Found;
+  Tree_->GetSpatialIndex().QueryAABB(SpatialTestBox(0.0f, 0.0f, 0.0f, 1000.0f), Found);
+  ASSERT_EQ(Found.size(), 1u);
+  EXPECT_EQ(Found[0], Loner);
+}
@@ -0,0 +1,133 @@
+/**
+ * AxTimerWheelTests.cpp - Tests for the hierarchical timer wheel
+ *
+ * Tests:
+ *   - Timers fire on their due tick, in tick order, across every level
+ *   - Timers due on the same tick fire in scheduling order
+ *   - Cancel is O(1), and a fired or reused ID cancels nothing
+ *   - Timers beyond the wheels' range wait and still fire on time
+ *   - Callbacks may schedule and cancel timers while the wheel advances
+ */
+
+#include "gtest/gtest.h"
+#include "AxEngine/AxTimerWheel.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+TEST(TimerWheelTest, TimersFireOnTheirDueTickAcrossLevels)
+{
+  TimerWheel Wheel;
+  std::mt19937_64 Rng(7);
+
+  // Spread over levels 0 through 3, advanced in uneven steps
+  std::vector<uint64_t> DueTicks;
+  for (uint32_t i = 0; i < 2000; ++i) {
+    uint64_t Due = 1 + Rng() % 300000;
+    DueTicks.push_back(Due);
+    Wheel.Schedule(Due, i);
+  }
+  EXPECT_EQ(Wheel.GetPendingCount(), 2000u);
+
+  std::vector<std::pair<uint64_t, uint64_t>> Fired;   // (tick, payload)
+  uint64_t Now = 0;
+  while (Wheel.GetPendingCount() > 0) {
+    Now += 1 + Rng() % 700;
+    Wheel.Advance(Now, [&](uint64_t Payload) { Fired.push_back({Now, Payload}); });
+  }
+
+  ASSERT_EQ(Fired.size(), 2000u);
+  uint64_t PrevDue = 0;
+  for (const auto& [Tick, Payload] : Fired) {
+    uint64_t Due = DueTicks[Payload];
+    EXPECT_GE(Tick, Due) << "Timer " << Payload << " fired early";
+    EXPECT_LT(Tick - Due, 700u) << "Timer " << Payload << " fired after a later Advance";
+    EXPECT_GE(Due, PrevDue) << "Timers fire in tick order";
+    PrevDue = Due;
+  }
+}
+
+TEST(TimerWheelTest, SameTickFiresInSchedulingOrder)
+{
+  TimerWheel Wheel(100);
+  for (uint64_t i = 0; i < 5; ++i) {
+    Wheel.Schedule(5000, i);
+  }
+  Wheel.Schedule(50, 99);   // already past: next Advance
+
+  std::vector<uint64_t> Order;
+  Wheel.Advance(101, [&](uint64_t Payload) { Order.push_back(Payload); });
+  EXPECT_EQ(Order, std::vector<uint64_t>({99}));
+
+  Order.clear();
+  Wheel.Advance(4999, [&](uint64_t Payload) { Order.push_back(Payload); });
+  EXPECT_TRUE(Order.empty());
+  Wheel.Advance(5000, [&](uint64_t Payload) { Order.push_back(Payload); });
+  EXPECT_EQ(Order, std::vector<uint64_t>({0, 1, 2, 3, 4}));
+}
+
+TEST(TimerWheelTest, CancelRemovesOnlyPendingTimers)
+{
+  TimerWheel Wheel;
+  TimerWheel::TimerId A = Wheel.Schedule(10, 1);
+  TimerWheel::TimerId B = Wheel.Schedule(10, 2);
+  TimerWheel::TimerId Far = Wheel.Schedule(1000000, 3);
+  EXPECT_NE(A, 0u);
+
+  EXPECT_TRUE(Wheel.Cancel(A));
+  EXPECT_FALSE(Wheel.Cancel(A)) << "Second cancel is a no-op";
+  EXPECT_TRUE(Wheel.Cancel(Far));
+
+  std::vector<uint64_t> Fired;
+  Wheel.Advance(10, [&](uint64_t Payload) { Fired.push_back(Payload); });
+  EXPECT_EQ(Fired, std::vector<uint64_t>({2}));
+  EXPECT_FALSE(Wheel.Cancel(B)) << "A fired timer cannot be cancelled";
+
+  // The freed entry is reused; the old ID must not cancel the new timer
+  TimerWheel::TimerId C = Wheel.Schedule(20, 4);
+  EXPECT_FALSE(Wheel.Cancel(B));
+  EXPECT_EQ(Wheel.GetPendingCount(), 1u);
+  EXPECT_TRUE(Wheel.Cancel(C));
+  EXPECT_EQ(Wheel.GetPendingCount(), 0u);
+}
+
+TEST(TimerWheelTest, TimersBeyondRangeStillFireOnTime)
+{
+  TimerWheel Wheel;
+  uint64_t Due = (1ull << 37) + 12345;
+  Wheel.Schedule(Due, 1);
+
+  uint64_t FiredAt = 0;
+  Wheel.Advance(Due - 1, [&](uint64_t) { FiredAt = 1; });
+  EXPECT_EQ(FiredAt, 0u);
+  Wheel.Advance(Due, [&](uint64_t) { FiredAt = Wheel.GetCurrentTick(); });
+  EXPECT_EQ(FiredAt, Due);
+}
+
+TEST(TimerWheelTest, CallbacksMayScheduleAndCancel)
+{
+  TimerWheel Wheel;
+  Wheel.Schedule(5, 1);
+  Wheel.Schedule(5, 2);
+  TimerWheel::TimerId Victim = Wheel.Schedule(5, 100);
+
+  // Payload 1 cancels the victim due on the same tick and re-arms itself
+  // every 3 ticks
+  std::vector<std::pair<uint64_t, uint64_t>> Fired;
+  Wheel.Advance(20, [&](uint64_t Payload) {
+    Fired.push_back({Wheel.GetCurrentTick(), Payload});
+    if (Payload == 1) {
+      Wheel.Cancel(Victim);
+      if (Wheel.GetCurrentTick() < 11) {
+        Wheel.Schedule(Wheel.GetCurrentTick() + 3, 1);
+      }
+    }
+  });
+
+  std::vector<std::pair<uint64_t, uint64_t>> Expected = {
+    {5, 1}, {5, 2}, {8, 1}, {11, 1}
+  };
+  EXPECT_EQ(Fired, Expected);
+  EXPECT_EQ(Wheel.GetPendingCount(), 0u);
+}
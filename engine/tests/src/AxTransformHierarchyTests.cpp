@@ -0,0 +1,397 @@
+/**
+ * AxTransformHierarchyTests.cpp - Tests for flat world transform storage
+ *
+ * Tests TransformHierarchy directly and through SceneTree:
+ *   - Linear Update matches Mat4::operator* composition
+ *   - Only dirty slots and their descendants are recomputed
+ *   - Nested changes coalesce to the highest dirty ancestor (stats)
+ *   - Reparenting under a later slot triggers a depth-sorted relayout
+ *   - Removed slots are compacted and node indices rewritten
+ *   - SceneTree: reparent via AddChild/SetParent refreshes world matrices
+ *   - Parallel level-by-level update is bit-identical to the serial pass
+ *   - Benchmarks (disabled; run with --gtest_also_run_disabled_tests):
+ *     100k- and 1M-slot full propagation, and moving-hierarchy scaling
+ *     versus worker count
+ */
+
+#include "gtest/gtest.h"
+#include "Foundation/AxTypes.h"
+#include "Foundation/AxHashTable.h"
+#include "Foundation/AxAPIRegistry.h"
+#include "Foundation/AxMath.h"
+#include "AxEngine/AxSceneTree.h"
+#include "AxEngine/AxNode.h"
+#include "AxEngine/AxTransformHierarchy.h"
+#include "AxEngine/AxWorkerPool.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+//=============================================================================
+// Helpers
+//=============================================================================
+
+static Mat4 HierarchyTestLocal(float X, float Y, float Z, float YawRad)
+{
+  Transform T;
+  T.SetTranslation(X, Y, Z);
+  T.SetRotation(0.0f, YawRad, 0.0f);
+  return (T.GetForwardMatrix());
+}
+
+static void ExpectMat4Near(const Mat4& A, const Mat4& B)
+{
+  for (int c = 0; c < 4; ++c) {
+    for (int r = 0; r < 4; ++r) {
+      EXPECT_NEAR(A.E[c][r], B.E[c][r], 1e-4f) << "E[" << c << "][" << r << "]";
+    }
+  }
+}
+
+// Standalone nodes used as slot owners (no SceneTree involved)
+class TransformHierarchyTest : public testing::Test
+{
+protected:
+  Node* MakeOwner()
+  {
+    Owners_.push_back(std::make_unique<Node3D>("Owner", nullptr));
+    return (Owners_.back().get());
+  }
+
+  TransformHierarchy Hierarchy_;
+  std::vector<std::unique_ptr<Node>> Owners_;
+};
+
+//=============================================================================
+// TransformHierarchy
+//=============================================================================
+
+TEST_F(TransformHierarchyTest, UpdateComposesParentAndLocal)
+{
+  uint32_t Root  = Hierarchy_.Insert(MakeOwner(), TransformHierarchy::InvalidIndex);
+  uint32_t Child = Hierarchy_.Insert(MakeOwner(), Root);
+  uint32_t Grand = Hierarchy_.Insert(MakeOwner(), Child);
+
+  Mat4 RootLocal  = HierarchyTestLocal(1.0f, 2.0f, 3.0f, 0.3f);
+  Mat4 ChildLocal = HierarchyTestLocal(0.0f, 5.0f, 0.0f, 1.1f);
+  Mat4 GrandLocal = HierarchyTestLocal(2.0f, 0.0f, -1.0f, -0.7f);
+  Hierarchy_.SetLocal(Root, RootLocal);
+  Hierarchy_.SetLocal(Child, ChildLocal);
+  Hierarchy_.SetLocal(Grand, GrandLocal);
+
+  EXPECT_EQ(Hierarchy_.Update(), 3u);
+
+  Mat4 ExpectedChild = RootLocal * ChildLocal;
+  ExpectMat4Near(Hierarchy_.GetWorld(Root), RootLocal);
+  ExpectMat4Near(Hierarchy_.GetWorld(Child), ExpectedChild);
+  ExpectMat4Near(Hierarchy_.GetWorld(Grand), ExpectedChild * GrandLocal);
+}
+
+TEST_F(TransformHierarchyTest, OnlyDirtySubtreesAreRecomputed)
+{
+  uint32_t Root = Hierarchy_.Insert(MakeOwner(), TransformHierarchy::InvalidIndex);
+  uint32_t A    = Hierarchy_.Insert(MakeOwner(), Root);
+  uint32_t B    = Hierarchy_.Insert(MakeOwner(), Root);
+  uint32_t AChild = Hierarchy_.Insert(MakeOwner(), A);
+  Hierarchy_.Update();
+
+  EXPECT_EQ(Hierarchy_.Update(), 0u) << "Nothing dirty, nothing recomputed";
+
+  Hierarchy_.SetLocal(A, HierarchyTestLocal(4.0f, 0.0f, 0.0f, 0.0f));
+  EXPECT_EQ(Hierarchy_.Update(), 2u) << "A and its child only";
+  EXPECT_FLOAT_EQ(Hierarchy_.GetWorld(AChild).E[3][0], 4.0f);
+  EXPECT_FLOAT_EQ(Hierarchy_.GetWorld(B).E[3][0], 0.0f);
+}
+
+TEST_F(TransformHierarchyTest, NestedChangesCoalesceToHighestDirtyAncestor)
+{
+  uint32_t Root   = Hierarchy_.Insert(MakeOwner(), TransformHierarchy::InvalidIndex);
+  uint32_t Parent = Hierarchy_.Insert(MakeOwner(), Root);
+  std::vector<uint32_t> Children;
+  for (int i = 0; i < 10; ++i) {
+    Children.push_back(Hierarchy_.Insert(MakeOwner(), Parent));
+  }
+  Hierarchy_.Update();
+
+  // Children marked before their parent: order must not matter
+  for (uint32_t Child : Children) {
+    Hierarchy_.SetLocal(Child, HierarchyTestLocal(1.0f, 0.0f, 0.0f, 0.0f));
+  }
+  Hierarchy_.SetLocal(Parent, HierarchyTestLocal(0.0f, 3.0f, 0.0f, 0.0f));
+
+  EXPECT_EQ(Hierarchy_.Update(), 11u) << "Each slot recomputed once";
+  const TransformUpdateStats& Stats = Hierarchy_.GetLastStats();
+  EXPECT_EQ(Stats.ChangedSlots, 11u);
+  EXPECT_EQ(Stats.DirtyRoots, 1u) << "Children are covered by the parent";
+  EXPECT_EQ(Stats.Recomputed, 11u);
+  EXPECT_EQ(Stats.MultipliesSaved, 10u) << "Separate walks would redo every child";
+
+  for (uint32_t Child : Children) {
+    EXPECT_FLOAT_EQ(Hierarchy_.GetWorld(Child).E[3][0], 1.0f);
+    EXPECT_FLOAT_EQ(Hierarchy_.GetWorld(Child).E[3][1], 3.0f);
+  }
+
+  Hierarchy_.Update();
+  EXPECT_EQ(Hierarchy_.GetLastStats().Recomputed, 0u);
+  EXPECT_EQ(Hierarchy_.GetLastStats().MultipliesSaved, 0u);
+}
+
+TEST_F(TransformHierarchyTest, ReparentUnderLaterSlotRelayoutsByDepth)
+{
+  uint32_t Root = Hierarchy_.Insert(MakeOwner(), TransformHierarchy::InvalidIndex);
+  uint32_t F    = Hierarchy_.Insert(MakeOwner(), Root);
+  uint32_t S    = Hierarchy_.Insert(MakeOwner(), Root);
+  Hierarchy_.SetLocal(S, HierarchyTestLocal(7.0f, 0.0f, 0.0f, 0.0f));
+  Hierarchy_.SetLocal(F, HierarchyTestLocal(0.0f, 1.0f, 0.0f, 0.0f));
+
+  // First now hangs under Second, which currently comes after it
+  Hierarchy_.SetParent(F, S);
+  Hierarchy_.Update();
+
+  // Depth order is now Root, Second, First
+  EXPECT_EQ(Hierarchy_.GetParent(2), 1u)
+    << "After relayout the child slot follows its parent";
+  const Mat4& World = Hierarchy_.GetWorld(2);
+  EXPECT_FLOAT_EQ(World.E[3][0], 7.0f);
+  EXPECT_FLOAT_EQ(World.E[3][1], 1.0f);
+}
+
+TEST_F(TransformHierarchyTest, RemovedSlotsAreCompacted)
+{
+  uint32_t Root = Hierarchy_.Insert(MakeOwner(), TransformHierarchy::InvalidIndex);
+  std::vector<uint32_t> Slots;
+  for (int i = 0; i < 4000; ++i) {
+    Slots.push_back(Hierarchy_.Insert(MakeOwner(), Root));
+  }
+  Hierarchy_.Update();
+
+  for (int i = 0; i < 3000; ++i) {
+    Hierarchy_.Remove(Slots[i]);
+  }
+  EXPECT_EQ(Hierarchy_.GetLiveCount(), 1001u);
+
+  Hierarchy_.Update();
+  EXPECT_EQ(Hierarchy_.GetSlotCount(), 1001u) << "Holes dropped on relayout";
+}
+
+/**
+ * Builds Characters hierarchies of BonesPerCharacter slots each under a
+ * shared root: every character is a root bone with four chains hanging off
+ * it. Characters are interleaved so levels are not contiguous.
+ */
+static void BuildCharacters(TransformHierarchy& Hierarchy, std::vector<std::unique_ptr<Node>>& Owners,
+                            uint32_t Characters, uint32_t BonesPerCharacter,
+                            std::vector<uint32_t>& OutCharacterRoots)
+{
+  auto Add = [&](uint32_t Parent) {
+    Owners.push_back(std::make_unique<Node3D>("Bone", nullptr));
+    return (Hierarchy.Insert(Owners.back().get(), Parent));
+  };
+
+  uint32_t Root = Add(TransformHierarchy::InvalidIndex);
+  std::vector<uint32_t> ChainTips;
+  for (uint32_t c = 0; c < Characters; ++c) {
+    uint32_t CharacterRoot = Add(Root);
+    OutCharacterRoots.push_back(CharacterRoot);
+    for (uint32_t Chain = 0; Chain < 4; ++Chain) {
+      ChainTips.push_back(CharacterRoot);
+    }
+  }
+
+  // Grow chains breadth-first across characters
+  uint32_t BonesPerChain = (BonesPerCharacter - 1) / 4;
+  for (uint32_t Bone = 0; Bone < BonesPerChain; ++Bone) {
+    for (uint32_t& Tip : ChainTips) {
+      Tip = Add(Tip);
+      Hierarchy.SetLocal(Tip, HierarchyTestLocal(0.0f, 0.25f, 0.0f, 0.05f));
+    }
+  }
+}
+
+TEST_F(TransformHierarchyTest, ParallelUpdateMatchesSerialBitwise)
+{
+  WorkerPool Pool(3);
+  TransformHierarchy Parallel;
+  std::vector<std::unique_ptr<Node>> ParallelOwners;
+  std::vector<uint32_t> SerialRoots;
+  std::vector<uint32_t> ParallelRoots;
+
+  BuildCharacters(Hierarchy_, Owners_, 512, 33, SerialRoots);
+  BuildCharacters(Parallel, ParallelOwners, 512, 33, ParallelRoots);
+
+  for (int Frame = 0; Frame < 3; ++Frame) {
+    for (size_t c = 0; c < SerialRoots.size(); c += 2) {
+      Mat4 Local = HierarchyTestLocal(static_cast<float>(c), static_cast<float>(Frame), 0.0f, 0.1f * Frame);
+      Hierarchy_.SetLocal(SerialRoots[c], Local);
+      Parallel.SetLocal(ParallelRoots[c], Local);
+    }
+
+    // Change depths on frame 1 so the parallel path rebuilds its levels
+    if (Frame == 1) {
+      Hierarchy_.SetParent(SerialRoots[3], SerialRoots[1] + 1);
+      Parallel.SetParent(ParallelRoots[3], ParallelRoots[1] + 1);
+    }
+
+    uint32_t SerialCount = Hierarchy_.Update();
+    uint32_t ParallelCount = Parallel.Update(&Pool);
+    ASSERT_EQ(SerialCount, ParallelCount);
+    EXPECT_EQ(Hierarchy_.GetLastStats().DirtyRoots, Parallel.GetLastStats().DirtyRoots);
+    EXPECT_EQ(Hierarchy_.GetLastStats().MultipliesSaved, Parallel.GetLastStats().MultipliesSaved);
+    ASSERT_GE(ParallelCount, TransformHierarchy::ParallelMinSlots);
+  }
+
+  ASSERT_EQ(Hierarchy_.GetSlotCount(), Parallel.GetSlotCount());
+  for (uint32_t i = 0; i < Hierarchy_.GetSlotCount(); ++i) {
+    ASSERT_EQ(memcmp(&Hierarchy_.GetWorld(i), &Parallel.GetWorld(i), sizeof(Mat4)), 0) << "Slot " << i;
+  }
+}
+
+//=============================================================================
+// SceneTree integration
+//=============================================================================
+
+class TransformHierarchySceneTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    AxonInitGlobalAPIRegistry();
+    AxonRegisterAllFoundationAPIs(AxonGlobalAPIRegistry);
+
+    TableAPI_ = static_cast<AxHashTableAPI*>(
+      AxonGlobalAPIRegistry->Get(AXON_HASH_TABLE_API_NAME));
+    ASSERT_NE(TableAPI_, nullptr);
+
+    Tree_ = new SceneTree(TableAPI_, nullptr);
+  }
+
+  void TearDown() override
+  {
+    delete Tree_;
+    Tree_ = nullptr;
+
+    AxonTermGlobalAPIRegistry();
+  }
+
+  AxHashTableAPI* TableAPI_{nullptr};
+  SceneTree* Tree_{nullptr};
+};
+
+TEST_F(TransformHierarchySceneTest, ReparentRefreshesWorldTransform)
+{
+  Node* Child  = Tree_->CreateNode("Child", NodeType::Node3D, nullptr);
+  Node* Parent = Tree_->CreateNode("Parent", NodeType::Node3D, nullptr);
+  Parent->SetPosition(10.0f, 0.0f, 0.0f);
+  Child->SetPosition(0.0f, 2.0f, 0.0f);
+  Tree_->Update(0.016f);
+  EXPECT_FLOAT_EQ(Child->GetWorldTransform().E[3][0], 0.0f);
+
+  // Parent was created after Child, so this forces a relayout
+  Parent->AddChild(Child);
+  Tree_->Update(0.016f);
+  EXPECT_FLOAT_EQ(Child->GetWorldTransform().E[3][0], 10.0f);
+  EXPECT_FLOAT_EQ(Child->GetWorldTransform().E[3][1], 2.0f);
+
+  // Detaching leaves the node as its own hierarchy root
+  Child->SetParent(nullptr);
+  Tree_->Update(0.016f);
+  EXPECT_FLOAT_EQ(Child->GetWorldTransform().E[3][0], 0.0f);
+}
+
+TEST_F(TransformHierarchySceneTest, DestroyFreesSlotsAndStandaloneNodesReportIdentity)
+{
+  Node* A = Tree_->CreateNode("A", NodeType::Node3D, nullptr);
+  Tree_->CreateNode("B", NodeType::Node3D, A);
+  uint32_t Before = Tree_->GetTransformHierarchy().GetLiveCount();
+
+  Tree_->DestroyNode(A);
+  EXPECT_EQ(Tree_->GetTransformHierarchy().GetLiveCount(), Before - 2);
+
+  Node3D Standalone("Standalone", TableAPI_);
+  Standalone.SetPosition(3.0f, 0.0f, 0.0f);
+  ExpectMat4Near(Standalone.GetWorldTransform(), Mat4::Identity());
+}
+
+//=============================================================================
+// Benchmark
+//=============================================================================
+
+// Full propagation of a FanOut-8 hierarchy of Count slots (root dirty)
+static void RunHierarchyBenchmark(TransformHierarchy& Hierarchy, std::vector<std::unique_ptr<Node>>& Owners,
+                                  uint32_t Count)
+{
+  const uint32_t FanOut = 8;
+  const int Iterations = 5;
+
+  Owners.reserve(Count);
+  for (uint32_t i = 0; i < Count; ++i) {
+    uint32_t Parent = (i == 0) ? TransformHierarchy::InvalidIndex : (i - 1) / FanOut;
+    Owners.push_back(std::make_unique<Node3D>("Owner", nullptr));
+    Hierarchy.Insert(Owners.back().get(), Parent);
+  }
+  Hierarchy.Update();
+
+  Mat4 Local = HierarchyTestLocal(0.1f, 0.0f, 0.0f, 0.01f);
+  double TotalMs = 0.0;
+  uint32_t Recomputed = 0;
+  for (int It = 0; It < Iterations; ++It) {
+    Hierarchy.SetLocal(0, Local);
+    auto Start = std::chrono::high_resolution_clock::now();
+    Recomputed = Hierarchy.Update();
+    auto End = std::chrono::high_resolution_clock::now();
+    TotalMs += std::chrono::duration<double, std::milli>(End - Start).count();
+  }
+
+  printf("TransformHierarchy: %u slots, full propagation %.2f ms\n", Recomputed, TotalMs / Iterations);
+  EXPECT_EQ(Recomputed, Count);
+}
+
+TEST_F(TransformHierarchyTest, DISABLED_Benchmark100kSlotPropagation)
+{
+  RunHierarchyBenchmark(Hierarchy_, Owners_, 100000);
+}
+
+TEST_F(TransformHierarchyTest, DISABLED_Benchmark1MSlotPropagation)
+{
+  RunHierarchyBenchmark(Hierarchy_, Owners_, 1000000);
+}
+
+TEST_F(TransformHierarchyTest, DISABLED_BenchmarkMovingHierarchiesByWorkerCount)
+{
+  const uint32_t BonesPerCharacter = 65;
+  const int Iterations = 10;
+  uint32_t MaxWorkers = WorkerPool::DefaultWorkerCount();
+  MaxWorkers = (MaxWorkers < 3) ? 3 : MaxWorkers;
+
+  for (uint32_t Characters : {256u, 1024u, 4096u}) {
+    TransformHierarchy Hierarchy;
+    std::vector<std::unique_ptr<Node>> Owners;
+    std::vector<uint32_t> Roots;
+    BuildCharacters(Hierarchy, Owners, Characters, BonesPerCharacter, Roots);
+    Hierarchy.Update();
+
+    double SerialMs = 0.0;
+    for (uint32_t Workers = 0; Workers <= MaxWorkers; Workers = (Workers == 0) ? 1 : Workers * 2) {
+      WorkerPool Pool(Workers);
+      double TotalMs = 0.0;
+      for (int It = 0; It < Iterations; ++It) {
+        for (uint32_t Root : Roots) {
+          Hierarchy.SetLocal(Root, HierarchyTestLocal(static_cast<float>(It), 0.0f, 0.0f, 0.01f * It));
+        }
+        auto Start = std::chrono::high_resolution_clock::now();
+        Hierarchy.Update(&Pool);
+        auto End = std::chrono::high_resolution_clock::now();
+        TotalMs += std::chrono::duration<double, std::milli>(End - Start).count();
+      }
+
+      double AverageMs = TotalMs / Iterations;
+      SerialMs = (Workers == 0) ? AverageMs : SerialMs;
+      printf("TransformHierarchy: %u characters (%u slots), %u workers: %.3f ms (%.2fx)\n",
+             Characters, Hierarchy.GetSlotCount(), Workers, AverageMs,
+             AverageMs > 0.0 ? SerialMs / AverageMs : 0.0);
+    }
+  }
+}
@@ -585,3 +585,126 @@ TEST_F(TypedNodeTest, As_NullptrPattern_WorksWithIf)
     FAIL() << "Should not enter if-block for wrong type";
   }
 }
+
+//=============================================================================
+// Typed views
+//=============================================================================
+
+TEST_F(TypedNodeTest, ViewIteratesEveryTrackedType)
+{
+  SceneTree* Tree = new SceneTree(TableAPI_, nullptr);
+
+  Tree->CreateNode("Body1", NodeType::RigidBody, nullptr);
+  Tree->CreateNode("Body2", NodeType::RigidBody, nullptr);
+  Tree->CreateNode("Shape", NodeType::Collider, nullptr);
+  Tree->CreateNode("Speaker", NodeType::AudioSource, nullptr);
+  Tree->CreateNode("Ears", NodeType::AudioListener, nullptr);
+  Tree->CreateNode("Rig", NodeType::Animator, nullptr);
+  Tree->CreateNode("Sparks", NodeType::ParticleEmitter, nullptr);
+  Tree->CreateNode("Icon", NodeType::Sprite, nullptr);
+
+  std::string Names;
+  for (RigidBodyNode* Body : Tree->View<RigidBodyNode>()) {
+    Names += Body->GetName();
+    Names += ";";
+  }
+  EXPECT_EQ(Names, "Body1;Body2;");
+  EXPECT_EQ(Tree->View<RigidBodyNode>().GetCount(), 2u);
+
+  EXPECT_EQ(Tree->View<ColliderNode>().GetCount(), 1u);
+  EXPECT_EQ(Tree->View<AudioSourceNode>().GetCount(), 1u);
+  EXPECT_EQ(Tree->View<AudioListenerNode>().GetCount(), 1u);
+  EXPECT_EQ(Tree->View<AnimatorNode>().GetCount(), 1u);
+  EXPECT_EQ(Tree->View<ParticleEmitterNode>().GetCount(), 1u);
+  EXPECT_EQ(Tree->View<SpriteNode>().GetCount(), 1u);
+  EXPECT_TRUE(Tree->View<MeshInstance>().IsEmpty());
+
+  // The new types are also reachable through GetNodesByType
+  uint32_t Count = 0;
+  Node** Sprites = Tree->GetNodesByType(NodeType::Sprite, &Count);
+  ASSERT_EQ(Count, 1u);
+  EXPECT_EQ(Sprites[0]->GetName(), "Icon");
+
+  delete Tree;
+}
+
+TEST_F(TypedNodeTest, ViewSkipsDestroyedNodesUntilCompacted)
+{
+  SceneTree* Tree = new SceneTree(TableAPI_, nullptr);
+
+  Node* A = Tree->CreateNode("A", NodeType::Light, nullptr);
+  Node* B = Tree->CreateNode("B", NodeType::Light, nullptr);
+  Node* C = Tree->CreateNode("C", NodeType::Light, nullptr);
+  (void)A;
+  (void)C;
+
+  NodeView<LightNode> LightView = Tree->View<LightNode>();
+  EXPECT_EQ(LightView.GetCount(), 3u);
+  Tree->DestroyNode(B);
+  EXPECT_EQ(Tree->GetTypedNodeCount(NodeType::Light), 2u);
+  EXPECT_EQ(LightView.GetCount(), 2u) << "A view reads the tree's live counts";
+
+  std::string Names;
+  Tree->View<LightNode>().ForEach([&Names](LightNode* Light) {
+    Names += Light->GetName();
+  });
+  EXPECT_EQ(Names, "AC");
+
+  // A node created mid-iteration lands after the cursor and is visited
+  Names.clear();
+  for (LightNode* Light : Tree->View<LightNode>()) {
+    Names += Light->GetName();
+    if (Light->GetName() == "A") {
+      Tree->CreateNode("D", NodeType::Light, nullptr);
+    }
+  }
+  EXPECT_EQ(Names, "ACD");
+
+  // GetNodesByType closes the hole and keeps creation order
+  uint32_t Count = 0;
+  Node** Lights = Tree->GetNodesByType(NodeType::Light, &Count);
+  ASSERT_EQ(Count, 3u);
+  EXPECT_EQ(Lights[0]->GetName(), "A");
+  EXPECT_EQ(Lights[1]->GetName(), "C");
+  EXPECT_EQ(Lights[2]->GetName(), "D");
+  EXPECT_EQ(LightView.GetCount(), 3u) << "Compaction must not subtract the hole twice";
+
+  // Slots were renumbered, so a later removal still finds its entry
+  Tree->DestroyNode(Lights[1]);
+  Lights = Tree->GetNodesByType(NodeType::Light, &Count);
+  ASSERT_EQ(Count, 2u);
+  EXPECT_EQ(Lights[0]->GetName(), "A");
+  EXPECT_EQ(Lights[1]->GetName(), "D");
+
+  delete Tree;
+}
+
+TEST_F(TypedNodeTest, JoinChildrenPairsMatchingParents)
+{
+  SceneTree* Tree = new SceneTree(TableAPI_, nullptr);
+
+  Node* Body = Tree->CreateNode("Body", NodeType::RigidBody, nullptr);
+  Node* Plain = Tree->CreateNode("Plain", NodeType::Node3D, nullptr);
+  Tree->CreateNode("BodyShape", NodeType::Collider, Body);
+  Tree->CreateNode("LooseShape", NodeType::Collider, Plain);
+  Tree->CreateNode("RootShape", NodeType::Collider, nullptr);
+
+  std::string Pairs;
+  for (auto [Parent, Shape] : Tree->JoinChildren<RigidBodyNode, ColliderNode>()) {
+    Pairs += Parent->GetName();
+    Pairs += "/";
+    Pairs += Shape->GetName();
+  }
+  EXPECT_EQ(Pairs, "Body/BodyShape");
+
+  uint32_t Visits = 0;
+  Tree->JoinChildren<RigidBodyNode, ColliderNode>().ForEach(
+    [&Visits, Body](RigidBodyNode* Parent, ColliderNode* Shape) {
+      EXPECT_EQ(Parent, Body);
+      EXPECT_EQ(Shape->GetParent(), Body);
+      Visits++;
+    });
+  EXPECT_EQ(Visits, 1u);
+
+  delete Tree;
+}
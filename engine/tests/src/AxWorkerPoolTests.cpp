@@ -0,0 +1,81 @@
+/**
+ * AxWorkerPoolTests.cpp - Tests for the persistent fork/join worker pool
+ *
+ * Tests:
+ *   - ParallelFor visits every index exactly once
+ *   - A pool with no workers runs the loop inline on the caller
+ *   - Ranges that fit one MinBatch run as a single call
+ *   - Back-to-back jobs reuse the same threads
+ */
+
+#include "gtest/gtest.h"
+#include "AxEngine/AxWorkerPool.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(WorkerPoolTest, ParallelForVisitsEveryIndexOnce)
+{
+  WorkerPool Pool(3);
+  std::vector<std::atomic<uint32_t>> Visits(100000);
+
+  Pool.ParallelFor(static_cast<uint32_t>(Visits.size()), 256, [&](uint32_t Begin, uint32_t End) {
+    for (uint32_t i = Begin; i < End; ++i) {
+      Visits[i].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+
+  for (size_t i = 0; i < Visits.size(); ++i) {
+    ASSERT_EQ(Visits[i].load(), 1u) << "Index " << i;
+  }
+}
+
+TEST(WorkerPoolTest, NoWorkersRunsInlineOnCaller)
+{
+  WorkerPool Pool(0);
+  EXPECT_EQ(Pool.GetWorkerCount(), 0u);
+
+  std::thread::id Caller = std::this_thread::get_id();
+  bool AllOnCaller = true;
+  uint32_t Calls = 0;
+  Pool.ParallelFor(5000, 16, [&](uint32_t Begin, uint32_t End) {
+    AllOnCaller = AllOnCaller && (std::this_thread::get_id() == Caller);
+    Calls++;
+    EXPECT_EQ(Begin, 0u);
+    EXPECT_EQ(End, 5000u);
+  });
+
+  EXPECT_TRUE(AllOnCaller);
+  EXPECT_EQ(Calls, 1u);
+}
+
+TEST(WorkerPoolTest, RangeOfOneBatchIsNotSplit)
+{
+  WorkerPool Pool(2);
+  std::atomic<uint32_t> Calls(0);
+
+  Pool.ParallelFor(64, 64, [&](uint32_t, uint32_t) { Calls++; });
+  EXPECT_EQ(Calls.load(), 1u);
+
+  Pool.ParallelFor(0, 64, [&](uint32_t, uint32_t) { Calls++; });
+  EXPECT_EQ(Calls.load(), 1u) << "Empty range never calls the body";
+}
+
+TEST(WorkerPoolTest, BackToBackJobsComplete)
+{
+  WorkerPool Pool(2);
+  std::atomic<uint64_t> Sum(0);
+
+  for (int Job = 0; Job < 500; ++Job) {
+    Pool.ParallelFor(4096, 128, [&](uint32_t Begin, uint32_t End) {
+      uint64_t Local = 0;
+      for (uint32_t i = Begin; i < End; ++i) {
+        Local += i;
+      }
+      Sum.fetch_add(Local, std::memory_order_relaxed);
+    });
+  }
+
+  EXPECT_EQ(Sum.load(), 500ull * (4095ull * 4096ull / 2));
+}
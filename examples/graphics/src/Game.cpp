@@ -26,6 +26,7 @@ class Game : public ScriptBase
 public:
     void OnInit() override
     {
+        CameraNode* MainCamera = GetMainCamera();
         MainCamera->SetPosition(11.12f, 1.7f, 1.83f);
         MainCamera->SetRotation(
             -2.06f * (AX_PI / 180.0f),
@@ -53,8 +54,9 @@ public:
             -V * CameraSpeed * DeltaT
         );
 
+        CameraNode* MainCamera = GetMainCamera();
         MainCamera->GetTransform().Translate(Movement);
-        MainCamera->GetTransform().RotateFromMouseDelta(MouseDelta, MouseSensitivity);
+        MainCamera->GetTransform().RotateFromMouseDelta(GetMouseDelta(), MouseSensitivity);
 
         AnimateBox(DeltaT);
         AnimateSphere(DeltaT);
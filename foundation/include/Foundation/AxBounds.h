@@ -0,0 +1,192 @@
+#pragma once
+
+/**
+ * AxBounds.h - Bounding Volumes and Frustum Culling
+ *
+ * Axis-aligned boxes, spheres, planes and view frustums, plus batched
+ * visibility tests over structure-of-arrays inputs. The batch functions
+ * process eight volumes per iteration (AVX when the compiler targets it,
+ * two SSE lanes of four otherwise) and write one visibility bit per volume.
+ *
+ * Shared by the renderer (frustum culling), physics broadphase (AABB
+ * overlap) and scene queries (AABB/sphere containment).
+ *
+ * Conventions match AxMath.h: matrices are column-major (E[column][row])
+ * and operate on column vectors, so a view-projection matrix is
+ * Projection * View, i.e. Mat4x4Mul(View, Projection).
+ *
+ * Usage:
+ *   AxFrustum Frustum = FrustumFromViewProjection(ViewProjection);
+ *   uint8_t Mask[AX_BOUNDS_MASK_BYTES(BoxCount)];
+ *   uint32_t Visible = FrustumCullAABBs(&Frustum, &Boxes, Mask);
+ *   if (BoundsMaskTest(Mask, i)) { ... draw box i ... }
+ */
+
+#include "Foundation/AxTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of bytes needed to hold one visibility bit per volume. */
+#define AX_BOUNDS_MASK_BYTES(Count) (((Count) + 7) / 8)
+
+/** Number of volumes tested per SIMD batch. */
+#define AX_BOUNDS_BATCH_WIDTH 8
+
+typedef struct AxAABB
+{
+    AxVec3 Min;
+    AxVec3 Max;
+} AxAABB;
+
+typedef struct AxSphere
+{
+    AxVec3 Center;
+    float Radius;
+} AxSphere;
+
+// Plane in the form Dot(Normal, P) + D = 0, Normal points to the inside
+typedef struct AxPlane
+{
+    AxVec3 Normal;
+    float D;
+} AxPlane;
+
+typedef enum AxFrustumPlane
+{
+    AX_FRUSTUM_PLANE_LEFT = 0,
+    AX_FRUSTUM_PLANE_RIGHT,
+    AX_FRUSTUM_PLANE_BOTTOM,
+    AX_FRUSTUM_PLANE_TOP,
+    AX_FRUSTUM_PLANE_NEAR,
+    AX_FRUSTUM_PLANE_FAR,
+    AX_FRUSTUM_PLANE_COUNT
+} AxFrustumPlane;
+
+typedef struct AxFrustum
+{
+    AxPlane Planes[AX_FRUSTUM_PLANE_COUNT];
+} AxFrustum;
+
+/**
+ * Structure-of-arrays box set in center/half-extent form. Arrays are owned
+ * by the caller and must each hold Count floats.
+ */
+typedef struct AxAABBSoA
+{
+    const float *CenterX;
+    const float *CenterY;
+    const float *CenterZ;
+    const float *ExtentX;
+    const float *ExtentY;
+    const float *ExtentZ;
+    uint32_t Count;
+} AxAABBSoA;
+
+/**
+ * Structure-of-arrays sphere set. Arrays are owned by the caller and must
+ * each hold Count floats.
+ */
+typedef struct AxSphereSoA
+{
+    const float *CenterX;
+    const float *CenterY;
+    const float *CenterZ;
+    const float *Radius;
+    uint32_t Count;
+} AxSphereSoA;
+
+//=============================================================================
+// AABB
+//=============================================================================
+
+/** Returns an inverted box that any Expand/Union call will overwrite. */
+AxAABB AABBEmpty(void);
+
+/** Builds a box from a center point and half extents. */
+AxAABB AABBFromCenterExtents(AxVec3 Center, AxVec3 Extents);
+
+/** Builds the tightest box around a set of points. Returns AABBEmpty() if Count is zero. */
+AxAABB AABBFromPoints(const AxVec3 *Points, uint32_t Count);
+
+AxVec3 AABBCenter(AxAABB Box);
+AxVec3 AABBExtents(AxAABB Box);
+
+/** Returns true if Min <= Max on every axis. */
+bool AABBIsValid(AxAABB Box);
+
+/** Grows the box to include Point. */
+AxAABB AABBExpand(AxAABB Box, AxVec3 Point);
+
+/** Returns the smallest box containing both A and B. */
+AxAABB AABBUnion(AxAABB A, AxAABB B);
+
+/** Returns true if the boxes overlap or touch. */
+bool AABBOverlaps(AxAABB A, AxAABB B);
+
+/** Returns true if Point lies inside or on the box. */
+bool AABBContainsPoint(AxAABB Box, AxVec3 Point);
+
+/**
+ * Transforms a box by an affine matrix and returns the enclosing
+ * axis-aligned box (Arvo's method). Projective matrices are not supported.
+ */
+AxAABB AABBTransform(AxAABB Box, AxMat4x4 Matrix);
+
+//=============================================================================
+// Sphere
+//=============================================================================
+
+/** Returns the sphere enclosing a box. */
+AxSphere SphereFromAABB(AxAABB Box);
+
+/** Returns true if the sphere and box overlap or touch. */
+bool SphereOverlapsAABB(AxSphere Sphere, AxAABB Box);
+
+//=============================================================================
+// Frustum
+//=============================================================================
+
+/**
+ * Extracts the six normalized frustum planes from a view-projection matrix
+ * (Gribb/Hartmann). Assumes OpenGL clip space (-W <= Z <= W), which is what
+ * CalcPerspectiveProjection and Mat4::Perspective produce.
+ */
+AxFrustum FrustumFromViewProjection(AxMat4x4 ViewProjection);
+
+/** Returns true if the box is at least partially inside the frustum. */
+bool FrustumTestAABB(const AxFrustum *Frustum, AxAABB Box);
+
+/** Returns true if the sphere is at least partially inside the frustum. */
+bool FrustumTestSphere(const AxFrustum *Frustum, AxSphere Sphere);
+
+/**
+ * Tests every box against the frustum, eight at a time.
+ * @param Frustum Frustum to test against.
+ * @param Boxes Box set in center/extent SoA form.
+ * @param OutMask Receives one bit per box (bit i % 8 of byte i / 8 set if
+ *                visible). Must hold AX_BOUNDS_MASK_BYTES(Boxes->Count) bytes.
+ * @return Number of visible boxes.
+ */
+uint32_t FrustumCullAABBs(const AxFrustum *Frustum, const AxAABBSoA *Boxes, uint8_t *OutMask);
+
+/**
+ * Tests every sphere against the frustum, eight at a time.
+ * @param Frustum Frustum to test against.
+ * @param Spheres Sphere set in SoA form.
+ * @param OutMask Receives one bit per sphere. Must hold
+ *                AX_BOUNDS_MASK_BYTES(Spheres->Count) bytes.
+ * @return Number of visible spheres.
+ */
+uint32_t FrustumCullSpheres(const AxFrustum *Frustum, const AxSphereSoA *Spheres, uint8_t *OutMask);
+
+/** Reads bit Index from a mask written by FrustumCullAABBs/FrustumCullSpheres. */
+static inline bool BoundsMaskTest(const uint8_t *Mask, uint32_t Index)
+{
+    return ((Mask[Index >> 3] >> (Index & 7)) & 1);
+}
+
+#ifdef __cplusplus
+}
+#endif
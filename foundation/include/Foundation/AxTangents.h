@@ -0,0 +1,102 @@
+#pragma once
+
+/**
+ * AxTangents.h - Batch Tangent-Space Generation
+ *
+ * Builds per-vertex tangents for whole meshes from positions, normals and
+ * texture coordinates. Per-triangle tangent/bitangent directions are
+ * computed with SSE and accumulated per vertex, then each vertex tangent is
+ * Gram-Schmidt orthogonalized against its normal. Handedness is written to
+ * Tangent.W (+1 or -1) so shaders can rebuild the bitangent as
+ * Cross(N, T) * W.
+ *
+ * Vertex attributes are read through byte strides, so interleaved vertex
+ * buffers (e.g. AxVertex) can be processed in place.
+ *
+ * The work is split into two range-based passes so callers with a thread
+ * pool can parallelize without Foundation owning any threads:
+ *   1. TangentAccumulate over disjoint triangle ranges, each into its own
+ *      zeroed sum buffers.
+ *   2. TangentResolve over disjoint vertex ranges, reading every partial
+ *      sum buffer. Partials are added in array order, so the result does
+ *      not depend on how triangles were split.
+ *
+ * Usage (single-threaded):
+ *   AxTangentMeshDesc Mesh = { ... };
+ *   AxVec4 *Scratch = AxAlloc(Allocator, AX_TANGENT_SCRATCH_BYTES(VertexCount));
+ *   CalculateTangents(&Mesh, Scratch);
+ */
+
+#include "Foundation/AxTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Bytes of scratch CalculateTangents needs for a mesh with Count vertices. */
+#define AX_TANGENT_SCRATCH_BYTES(Count) ((size_t)(Count) * 2 * sizeof(AxVec4))
+
+/**
+ * Describes a triangle list mesh. Positions, Normals and TexCoords point at
+ * the first vertex's AxVec3/AxVec3/AxVec2 attribute and Tangents at its
+ * AxVec4 output; each Stride is the byte distance between vertices. If
+ * Indices is NULL the mesh is treated as non-indexed (VertexCount / 3
+ * triangles).
+ */
+typedef struct AxTangentMeshDesc
+{
+    const void *Positions;
+    const void *Normals;
+    const void *TexCoords;
+    void *Tangents;
+    uint32_t PositionStride;
+    uint32_t NormalStride;
+    uint32_t TexCoordStride;
+    uint32_t TangentStride;
+    const uint32_t *Indices;
+    uint32_t IndexCount;
+    uint32_t VertexCount;
+} AxTangentMeshDesc;
+
+/** Returns the number of triangles described by the mesh. */
+uint32_t TangentTriangleCount(const AxTangentMeshDesc *Mesh);
+
+/**
+ * Accumulates unnormalized tangent and bitangent directions for a range of
+ * triangles. Triangles with degenerate UVs or out-of-range indices are
+ * skipped. Sums are AxVec4 so SSE can add them in place; W is unused.
+ * @param Mesh Mesh to read.
+ * @param FirstTriangle Index of the first triangle to process.
+ * @param TriangleCount Number of triangles to process.
+ * @param TangentSums Per-vertex tangent sums, VertexCount entries, zeroed by the caller.
+ * @param BitangentSums Per-vertex bitangent sums, VertexCount entries, zeroed by the caller.
+ */
+void TangentAccumulate(const AxTangentMeshDesc *Mesh, uint32_t FirstTriangle, uint32_t TriangleCount,
+                       AxVec4 *TangentSums, AxVec4 *BitangentSums);
+
+/**
+ * Writes final tangents for a range of vertices from one or more partial sum
+ * buffers. Each tangent is orthogonalized against the vertex normal; if no
+ * usable direction was accumulated an arbitrary perpendicular is chosen.
+ * @param Mesh Mesh to write.
+ * @param TangentSums Array of SumCount tangent sum buffers.
+ * @param BitangentSums Array of SumCount bitangent sum buffers.
+ * @param SumCount Number of partial buffers.
+ * @param FirstVertex Index of the first vertex to resolve.
+ * @param VertexCount Number of vertices to resolve.
+ */
+void TangentResolve(const AxTangentMeshDesc *Mesh,
+                    const AxVec4 *const *TangentSums, const AxVec4 *const *BitangentSums, uint32_t SumCount,
+                    uint32_t FirstVertex, uint32_t VertexCount);
+
+/**
+ * Generates tangents for the whole mesh on the calling thread.
+ * @param Mesh Mesh to process.
+ * @param Scratch At least AX_TANGENT_SCRATCH_BYTES(Mesh->VertexCount) bytes.
+ * @return False if the description is incomplete.
+ */
+bool CalculateTangents(const AxTangentMeshDesc *Mesh, AxVec4 *Scratch);
+
+#ifdef __cplusplus
+}
+#endif
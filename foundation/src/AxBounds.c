@@ -0,0 +1,452 @@
+#include "AxBounds.h"
+#include "AxMath.h"
+
+#include <float.h>
+#include <immintrin.h>
+
+/* ========================================================================
+   Helpers
+   ======================================================================== */
+
+static inline uint32_t CountBits8(uint8_t Bits)
+{
+    uint32_t V = Bits;
+    V = V - ((V >> 1) & 0x55);
+    V = (V & 0x33) + ((V >> 2) & 0x33);
+    return ((V + (V >> 4)) & 0x0F);
+}
+
+static inline AxPlane NormalizePlane(float A, float B, float C, float D)
+{
+    AxPlane Result = { { A, B, C }, D };
+
+    float Length = sqrtf(A * A + B * B + C * C);
+    if (Length > 0.0f) {
+        float InvLength = 1.0f / Length;
+        Result.Normal.X *= InvLength;
+        Result.Normal.Y *= InvLength;
+        Result.Normal.Z *= InvLength;
+        Result.D *= InvLength;
+    }
+
+    return (Result);
+}
+
+// Returns true unless the center/extent box lies fully behind one of the planes
+static inline bool TestCenterExtents(const AxFrustum *Frustum,
+                                     float CX, float CY, float CZ,
+                                     float EX, float EY, float EZ)
+{
+    for (int i = 0; i < AX_FRUSTUM_PLANE_COUNT; ++i)
+    {
+        const AxPlane *P = &Frustum->Planes[i];
+        float Distance = P->Normal.X * CX + P->Normal.Y * CY + P->Normal.Z * CZ + P->D;
+        float Radius = fabsf(P->Normal.X) * EX + fabsf(P->Normal.Y) * EY + fabsf(P->Normal.Z) * EZ;
+        if (Distance + Radius < 0.0f) {
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+static inline bool TestSphere(const AxFrustum *Frustum, float CX, float CY, float CZ, float Radius)
+{
+    for (int i = 0; i < AX_FRUSTUM_PLANE_COUNT; ++i)
+    {
+        const AxPlane *P = &Frustum->Planes[i];
+        float Distance = P->Normal.X * CX + P->Normal.Y * CY + P->Normal.Z * CZ + P->D;
+        if (Distance + Radius < 0.0f) {
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+/* ========================================================================
+   AABB
+   ======================================================================== */
+
+AxAABB AABBEmpty(void)
+{
+    AxAABB Result = {
+        {  FLT_MAX,  FLT_MAX,  FLT_MAX },
+        { -FLT_MAX, -FLT_MAX, -FLT_MAX }
+    };
+
+    return (Result);
+}
+
+AxAABB AABBFromCenterExtents(AxVec3 Center, AxVec3 Extents)
+{
+    AxAABB Result = { Vec3Sub(Center, Extents), Vec3Add(Center, Extents) };
+
+    return (Result);
+}
+
+AxAABB AABBFromPoints(const AxVec3 *Points, uint32_t Count)
+{
+    AxAABB Result = AABBEmpty();
+    if (!Points) {
+        return (Result);
+    }
+
+    for (uint32_t i = 0; i < Count; ++i) {
+        Result = AABBExpand(Result, Points[i]);
+    }
+
+    return (Result);
+}
+
+AxVec3 AABBCenter(AxAABB Box)
+{
+    return (Vec3Mul(Vec3Add(Box.Min, Box.Max), 0.5f));
+}
+
+AxVec3 AABBExtents(AxAABB Box)
+{
+    return (Vec3Mul(Vec3Sub(Box.Max, Box.Min), 0.5f));
+}
+
+bool AABBIsValid(AxAABB Box)
+{
+    return (Box.Min.X <= Box.Max.X && Box.Min.Y <= Box.Max.Y && Box.Min.Z <= Box.Max.Z);
+}
+
+AxAABB AABBExpand(AxAABB Box, AxVec3 Point)
+{
+    AxAABB Result = {
+        { Min(Box.Min.X, Point.X), Min(Box.Min.Y, Point.Y), Min(Box.Min.Z, Point.Z) },
+        { Max(Box.Max.X, Point.X), Max(Box.Max.Y, Point.Y), Max(Box.Max.Z, Point.Z) }
+    };
+
+    return (Result);
+}
+
+AxAABB AABBUnion(AxAABB A, AxAABB B)
+{
+    AxAABB Result = {
+        { Min(A.Min.X, B.Min.X), Min(A.Min.Y, B.Min.Y), Min(A.Min.Z, B.Min.Z) },
+        { Max(A.Max.X, B.Max.X), Max(A.Max.Y, B.Max.Y), Max(A.Max.Z, B.Max.Z) }
+    };
+
+    return (Result);
+}
+
+bool AABBOverlaps(AxAABB A, AxAABB B)
+{
+    return (A.Min.X <= B.Max.X && A.Max.X >= B.Min.X &&
+            A.Min.Y <= B.Max.Y && A.Max.Y >= B.Min.Y &&
+            A.Min.Z <= B.Max.Z && A.Max.Z >= B.Min.Z);
+}
+
+bool AABBContainsPoint(AxAABB Box, AxVec3 Point)
+{
+    return (Point.X >= Box.Min.X && Point.X <= Box.Max.X &&
+            Point.Y >= Box.Min.Y && Point.Y <= Box.Max.Y &&
+            Point.Z >= Box.Min.Z && Point.Z <= Box.Max.Z);
+}
+
+AxAABB AABBTransform(AxAABB Box, AxMat4x4 Matrix)
+{
+    AxVec3 Center = AABBCenter(Box);
+    AxVec3 Extents = AABBExtents(Box);
+
+    // Row R of the matrix is (E[0][R], E[1][R], E[2][R]). The new extent along an axis is
+    // the absolute row dotted with the old extents.
+    AxVec3 NewCenter;
+    AxVec3 NewExtents;
+    for (int R = 0; R < 3; ++R)
+    {
+        NewCenter.XYZ[R] = Matrix.E[0][R] * Center.X +
+                           Matrix.E[1][R] * Center.Y +
+                           Matrix.E[2][R] * Center.Z +
+                           Matrix.E[3][R];
+
+        NewExtents.XYZ[R] = fabsf(Matrix.E[0][R]) * Extents.X +
+                            fabsf(Matrix.E[1][R]) * Extents.Y +
+                            fabsf(Matrix.E[2][R]) * Extents.Z;
+    }
+
+    return (AABBFromCenterExtents(NewCenter, NewExtents));
+}
+
+/* ========================================================================
+   Sphere
+   ======================================================================== */
+
+AxSphere SphereFromAABB(AxAABB Box)
+{
+    AxSphere Result = { AABBCenter(Box), Vec3Length(AABBExtents(Box)) };
+
+    return (Result);
+}
+
+bool SphereOverlapsAABB(AxSphere Sphere, AxAABB Box)
+{
+    float DistanceSq = 0.0f;
+    for (int i = 0; i < 3; ++i)
+    {
+        float C = Sphere.Center.XYZ[i];
+        if (C < Box.Min.XYZ[i]) {
+            DistanceSq += (Box.Min.XYZ[i] - C) * (Box.Min.XYZ[i] - C);
+        } else if (C > Box.Max.XYZ[i]) {
+            DistanceSq += (C - Box.Max.XYZ[i]) * (C - Box.Max.XYZ[i]);
+        }
+    }
+
+    return (DistanceSq <= Sphere.Radius * Sphere.Radius);
+}
+
+/* ========================================================================
+   Frustum
+   ======================================================================== */
+
+AxFrustum FrustumFromViewProjection(AxMat4x4 VP)
+{
+    AxFrustum Result;
+
+    // Row R of a column-major matrix is (E[0][R], E[1][R], E[2][R], E[3][R])
+    #define AX_ROW_SUM(R, S) \
+        (VP.E[0][3] S VP.E[0][R]), (VP.E[1][3] S VP.E[1][R]), (VP.E[2][3] S VP.E[2][R]), (VP.E[3][3] S VP.E[3][R])
+
+    Result.Planes[AX_FRUSTUM_PLANE_LEFT]   = NormalizePlane(AX_ROW_SUM(0, +));
+    Result.Planes[AX_FRUSTUM_PLANE_RIGHT]  = NormalizePlane(AX_ROW_SUM(0, -));
+    Result.Planes[AX_FRUSTUM_PLANE_BOTTOM] = NormalizePlane(AX_ROW_SUM(1, +));
+    Result.Planes[AX_FRUSTUM_PLANE_TOP]    = NormalizePlane(AX_ROW_SUM(1, -));
+    Result.Planes[AX_FRUSTUM_PLANE_NEAR]   = NormalizePlane(AX_ROW_SUM(2, +));
+    Result.Planes[AX_FRUSTUM_PLANE_FAR]    = NormalizePlane(AX_ROW_SUM(2, -));
+
+    #undef AX_ROW_SUM
+
+    return (Result);
+}
+
+bool FrustumTestAABB(const AxFrustum *Frustum, AxAABB Box)
+{
+    if (!Frustum) {
+        return (false);
+    }
+
+    AxVec3 C = AABBCenter(Box);
+    AxVec3 E = AABBExtents(Box);
+    return (TestCenterExtents(Frustum, C.X, C.Y, C.Z, E.X, E.Y, E.Z));
+}
+
+bool FrustumTestSphere(const AxFrustum *Frustum, AxSphere Sphere)
+{
+    if (!Frustum) {
+        return (false);
+    }
+
+    return (TestSphere(Frustum, Sphere.Center.X, Sphere.Center.Y, Sphere.Center.Z, Sphere.Radius));
+}
+
+/* ========================================================================
+   Batched Frustum Culling
+   ======================================================================== */
+
+#if defined(__AVX__)
+
+// Returns an 8-bit visibility mask for boxes [Base, Base + 8)
+static inline uint8_t CullAABBBatch(const AxFrustum *Frustum, const AxAABBSoA *Boxes, uint32_t Base)
+{
+    const __m256 SignMask = _mm256_set1_ps(-0.0f);
+    const __m256 Zero = _mm256_setzero_ps();
+
+    __m256 CX = _mm256_loadu_ps(Boxes->CenterX + Base);
+    __m256 CY = _mm256_loadu_ps(Boxes->CenterY + Base);
+    __m256 CZ = _mm256_loadu_ps(Boxes->CenterZ + Base);
+    __m256 EX = _mm256_loadu_ps(Boxes->ExtentX + Base);
+    __m256 EY = _mm256_loadu_ps(Boxes->ExtentY + Base);
+    __m256 EZ = _mm256_loadu_ps(Boxes->ExtentZ + Base);
+
+    __m256 Inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (int i = 0; i < AX_FRUSTUM_PLANE_COUNT; ++i)
+    {
+        const AxPlane *P = &Frustum->Planes[i];
+        __m256 NX = _mm256_set1_ps(P->Normal.X);
+        __m256 NY = _mm256_set1_ps(P->Normal.Y);
+        __m256 NZ = _mm256_set1_ps(P->Normal.Z);
+
+        __m256 Distance = _mm256_add_ps(_mm256_mul_ps(NX, CX), _mm256_set1_ps(P->D));
+        Distance = _mm256_add_ps(Distance, _mm256_mul_ps(NY, CY));
+        Distance = _mm256_add_ps(Distance, _mm256_mul_ps(NZ, CZ));
+
+        __m256 Radius = _mm256_mul_ps(_mm256_andnot_ps(SignMask, NX), EX);
+        Radius = _mm256_add_ps(Radius, _mm256_mul_ps(_mm256_andnot_ps(SignMask, NY), EY));
+        Radius = _mm256_add_ps(Radius, _mm256_mul_ps(_mm256_andnot_ps(SignMask, NZ), EZ));
+
+        Inside = _mm256_and_ps(Inside, _mm256_cmp_ps(_mm256_add_ps(Distance, Radius), Zero, _CMP_GE_OQ));
+    }
+
+    return ((uint8_t)_mm256_movemask_ps(Inside));
+}
+
+static inline uint8_t CullSphereBatch(const AxFrustum *Frustum, const AxSphereSoA *Spheres, uint32_t Base)
+{
+    const __m256 Zero = _mm256_setzero_ps();
+
+    __m256 CX = _mm256_loadu_ps(Spheres->CenterX + Base);
+    __m256 CY = _mm256_loadu_ps(Spheres->CenterY + Base);
+    __m256 CZ = _mm256_loadu_ps(Spheres->CenterZ + Base);
+    __m256 R = _mm256_loadu_ps(Spheres->Radius + Base);
+
+    __m256 Inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (int i = 0; i < AX_FRUSTUM_PLANE_COUNT; ++i)
+    {
+        const AxPlane *P = &Frustum->Planes[i];
+        __m256 Distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(P->Normal.X), CX), _mm256_set1_ps(P->D));
+        Distance = _mm256_add_ps(Distance, _mm256_mul_ps(_mm256_set1_ps(P->Normal.Y), CY));
+        Distance = _mm256_add_ps(Distance, _mm256_mul_ps(_mm256_set1_ps(P->Normal.Z), CZ));
+
+        Inside = _mm256_and_ps(Inside, _mm256_cmp_ps(_mm256_add_ps(Distance, R), Zero, _CMP_GE_OQ));
+    }
+
+    return ((uint8_t)_mm256_movemask_ps(Inside));
+}
+
+#else
+
+// SSE2 is part of the x64 baseline, so an 8-wide batch is two 4-wide halves
+static inline uint8_t CullAABBHalf(const AxFrustum *Frustum, const AxAABBSoA *Boxes, uint32_t Base)
+{
+    const __m128 SignMask = _mm_set1_ps(-0.0f);
+    const __m128 Zero = _mm_setzero_ps();
+
+    __m128 CX = _mm_loadu_ps(Boxes->CenterX + Base);
+    __m128 CY = _mm_loadu_ps(Boxes->CenterY + Base);
+    __m128 CZ = _mm_loadu_ps(Boxes->CenterZ + Base);
+    __m128 EX = _mm_loadu_ps(Boxes->ExtentX + Base);
+    __m128 EY = _mm_loadu_ps(Boxes->ExtentY + Base);
+    __m128 EZ = _mm_loadu_ps(Boxes->ExtentZ + Base);
+
+    __m128 Inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (int i = 0; i < AX_FRUSTUM_PLANE_COUNT; ++i)
+    {
+        const AxPlane *P = &Frustum->Planes[i];
+        __m128 NX = _mm_set1_ps(P->Normal.X);
+        __m128 NY = _mm_set1_ps(P->Normal.Y);
+        __m128 NZ = _mm_set1_ps(P->Normal.Z);
+
+        __m128 Distance = _mm_add_ps(_mm_mul_ps(NX, CX), _mm_set1_ps(P->D));
+        Distance = _mm_add_ps(Distance, _mm_mul_ps(NY, CY));
+        Distance = _mm_add_ps(Distance, _mm_mul_ps(NZ, CZ));
+
+        __m128 Radius = _mm_mul_ps(_mm_andnot_ps(SignMask, NX), EX);
+        Radius = _mm_add_ps(Radius, _mm_mul_ps(_mm_andnot_ps(SignMask, NY), EY));
+        Radius = _mm_add_ps(Radius, _mm_mul_ps(_mm_andnot_ps(SignMask, NZ), EZ));
+
+        Inside = _mm_and_ps(Inside, _mm_cmpge_ps(_mm_add_ps(Distance, Radius), Zero));
+    }
+
+    return ((uint8_t)_mm_movemask_ps(Inside));
+}
+
+static inline uint8_t CullAABBBatch(const AxFrustum *Frustum, const AxAABBSoA *Boxes, uint32_t Base)
+{
+    return ((uint8_t)(CullAABBHalf(Frustum, Boxes, Base) | (CullAABBHalf(Frustum, Boxes, Base + 4) << 4)));
+}
+
+static inline uint8_t CullSphereHalf(const AxFrustum *Frustum, const AxSphereSoA *Spheres, uint32_t Base)
+{
+    const __m128 Zero = _mm_setzero_ps();
+
+    __m128 CX = _mm_loadu_ps(Spheres->CenterX + Base);
+    __m128 CY = _mm_loadu_ps(Spheres->CenterY + Base);
+    __m128 CZ = _mm_loadu_ps(Spheres->CenterZ + Base);
+    __m128 R = _mm_loadu_ps(Spheres->Radius + Base);
+
+    __m128 Inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (int i = 0; i < AX_FRUSTUM_PLANE_COUNT; ++i)
+    {
+        const AxPlane *P = &Frustum->Planes[i];
+        __m128 Distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(P->Normal.X), CX), _mm_set1_ps(P->D));
+        Distance = _mm_add_ps(Distance, _mm_mul_ps(_mm_set1_ps(P->Normal.Y), CY));
+        Distance = _mm_add_ps(Distance, _mm_mul_ps(_mm_set1_ps(P->Normal.Z), CZ));
+
+        Inside = _mm_and_ps(Inside, _mm_cmpge_ps(_mm_add_ps(Distance, R), Zero));
+    }
+
+    return ((uint8_t)_mm_movemask_ps(Inside));
+}
+
+static inline uint8_t CullSphereBatch(const AxFrustum *Frustum, const AxSphereSoA *Spheres, uint32_t Base)
+{
+    return ((uint8_t)(CullSphereHalf(Frustum, Spheres, Base) | (CullSphereHalf(Frustum, Spheres, Base + 4) << 4)));
+}
+
+#endif
+
+uint32_t FrustumCullAABBs(const AxFrustum *Frustum, const AxAABBSoA *Boxes, uint8_t *OutMask)
+{
+    if (!Frustum || !Boxes || !OutMask) {
+        return (0);
+    }
+
+    uint32_t Visible = 0;
+    uint32_t FullBatches = Boxes->Count / AX_BOUNDS_BATCH_WIDTH;
+
+    for (uint32_t Batch = 0; Batch < FullBatches; ++Batch)
+    {
+        uint8_t Bits = CullAABBBatch(Frustum, Boxes, Batch * AX_BOUNDS_BATCH_WIDTH);
+        OutMask[Batch] = Bits;
+        Visible += CountBits8(Bits);
+    }
+
+    // Remaining boxes do not fill a batch; test them one at a time
+    uint32_t Base = FullBatches * AX_BOUNDS_BATCH_WIDTH;
+    if (Base < Boxes->Count)
+    {
+        uint8_t Bits = 0;
+        for (uint32_t i = Base; i < Boxes->Count; ++i)
+        {
+            if (TestCenterExtents(Frustum,
+                                  Boxes->CenterX[i], Boxes->CenterY[i], Boxes->CenterZ[i],
+                                  Boxes->ExtentX[i], Boxes->ExtentY[i], Boxes->ExtentZ[i])) {
+                Bits |= (uint8_t)(1u << (i - Base));
+            }
+        }
+
+        OutMask[FullBatches] = Bits;
+        Visible += CountBits8(Bits);
+    }
+
+    return (Visible);
+}
+
+uint32_t FrustumCullSpheres(const AxFrustum *Frustum, const AxSphereSoA *Spheres, uint8_t *OutMask)
+{
+    if (!Frustum || !Spheres || !OutMask) {
+        return (0);
+    }
+
+    uint32_t Visible = 0;
+    uint32_t FullBatches = Spheres->Count / AX_BOUNDS_BATCH_WIDTH;
+
+    for (uint32_t Batch = 0; Batch < FullBatches; ++Batch)
+    {
+        uint8_t Bits = CullSphereBatch(Frustum, Spheres, Batch * AX_BOUNDS_BATCH_WIDTH);
+        OutMask[Batch] = Bits;
+        Visible += CountBits8(Bits);
+    }
+
+    // Remaining spheres do not fill a batch; test them one at a time
+    uint32_t Base = FullBatches * AX_BOUNDS_BATCH_WIDTH;
+    if (Base < Spheres->Count)
+    {
+        uint8_t Bits = 0;
+        for (uint32_t i = Base; i < Spheres->Count; ++i)
+        {
+            if (TestSphere(Frustum, Spheres->CenterX[i], Spheres->CenterY[i], Spheres->CenterZ[i], Spheres->Radius[i])) {
+                Bits |= (uint8_t)(1u << (i - Base));
+            }
+        }
+
+        OutMask[FullBatches] = Bits;
+        Visible += CountBits8(Bits);
+    }
+
+    return (Visible);
+}
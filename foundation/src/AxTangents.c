@@ -0,0 +1,214 @@
+#include "AxTangents.h"
+#include "AxMath.h"
+
+#include <string.h>
+#include <immintrin.h>
+
+// UV-space determinants smaller than this are treated as degenerate
+#define AX_TANGENT_DET_EPSILON 1e-12f
+
+/* ========================================================================
+   Attribute Access
+   ======================================================================== */
+
+static inline AxVec3 ReadVec3(const void *Base, uint32_t Stride, uint32_t Index)
+{
+    AxVec3 Result;
+    memcpy(&Result, (const uint8_t *)Base + (size_t)Stride * Index, sizeof(AxVec3));
+    return (Result);
+}
+
+static inline AxVec2 ReadVec2(const void *Base, uint32_t Stride, uint32_t Index)
+{
+    AxVec2 Result;
+    memcpy(&Result, (const uint8_t *)Base + (size_t)Stride * Index, sizeof(AxVec2));
+    return (Result);
+}
+
+static inline void WriteVec4(void *Base, uint32_t Stride, uint32_t Index, AxVec4 Value)
+{
+    memcpy((uint8_t *)Base + (size_t)Stride * Index, &Value, sizeof(AxVec4));
+}
+
+// Returns false if any corner index is outside the vertex buffer
+static inline bool TriangleIndices(const AxTangentMeshDesc *Mesh, uint32_t Triangle, uint32_t Out[3])
+{
+    uint32_t Base = Triangle * 3;
+    if (Mesh->Indices) {
+        Out[0] = Mesh->Indices[Base + 0];
+        Out[1] = Mesh->Indices[Base + 1];
+        Out[2] = Mesh->Indices[Base + 2];
+    } else {
+        Out[0] = Base + 0;
+        Out[1] = Base + 1;
+        Out[2] = Base + 2;
+    }
+
+    return (Out[0] < Mesh->VertexCount && Out[1] < Mesh->VertexCount && Out[2] < Mesh->VertexCount);
+}
+
+static inline __m128 LoadVec3(const void *Base, uint32_t Stride, uint32_t Index)
+{
+    AxVec3 V = ReadVec3(Base, Stride, Index);
+    return (_mm_setr_ps(V.X, V.Y, V.Z, 0.0f));
+}
+
+static inline void AddToVertex(AxVec4 *Sums, uint32_t Vertex, __m128 Value)
+{
+    float *Sum = &Sums[Vertex].X;
+    _mm_storeu_ps(Sum, _mm_add_ps(_mm_loadu_ps(Sum), Value));
+}
+
+/* ========================================================================
+   Accumulation
+   ======================================================================== */
+
+/*
+ * Each triangle's edges and directions are computed with X/Y/Z in SSE lanes
+ * and added to 16-byte per-vertex sums in one load/add/store. A 4-triangle
+ * SoA layout was tried first but the strided gathers and per-lane scatters
+ * cost more than the arithmetic they saved.
+ */
+static inline void AccumulateTriangle(const AxTangentMeshDesc *Mesh, uint32_t Triangle,
+                                      AxVec4 *TangentSums, AxVec4 *BitangentSums)
+{
+    uint32_t Corners[3];
+    if (!TriangleIndices(Mesh, Triangle, Corners)) {
+        return;
+    }
+
+    AxVec2 UV0 = ReadVec2(Mesh->TexCoords, Mesh->TexCoordStride, Corners[0]);
+    AxVec2 UV1 = ReadVec2(Mesh->TexCoords, Mesh->TexCoordStride, Corners[1]);
+    AxVec2 UV2 = ReadVec2(Mesh->TexCoords, Mesh->TexCoordStride, Corners[2]);
+    float DU1 = UV1.X - UV0.X, DV1 = UV1.Y - UV0.Y;
+    float DU2 = UV2.X - UV0.X, DV2 = UV2.Y - UV0.Y;
+
+    float Det = DU1 * DV2 - DU2 * DV1;
+    if (fabsf(Det) <= AX_TANGENT_DET_EPSILON) {
+        return;
+    }
+
+    __m128 P0 = LoadVec3(Mesh->Positions, Mesh->PositionStride, Corners[0]);
+    __m128 Edge1 = _mm_sub_ps(LoadVec3(Mesh->Positions, Mesh->PositionStride, Corners[1]), P0);
+    __m128 Edge2 = _mm_sub_ps(LoadVec3(Mesh->Positions, Mesh->PositionStride, Corners[2]), P0);
+
+    __m128 R = _mm_set1_ps(1.0f / Det);
+    __m128 Tangent = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(Edge1, _mm_set1_ps(DV2)),
+                                           _mm_mul_ps(Edge2, _mm_set1_ps(DV1))), R);
+    __m128 Bitangent = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(Edge2, _mm_set1_ps(DU1)),
+                                             _mm_mul_ps(Edge1, _mm_set1_ps(DU2))), R);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        AddToVertex(TangentSums, Corners[i], Tangent);
+        AddToVertex(BitangentSums, Corners[i], Bitangent);
+    }
+}
+
+uint32_t TangentTriangleCount(const AxTangentMeshDesc *Mesh)
+{
+    if (!Mesh) {
+        return (0);
+    }
+
+    return ((Mesh->Indices ? Mesh->IndexCount : Mesh->VertexCount) / 3);
+}
+
+void TangentAccumulate(const AxTangentMeshDesc *Mesh, uint32_t FirstTriangle, uint32_t TriangleCount,
+                       AxVec4 *TangentSums, AxVec4 *BitangentSums)
+{
+    if (!Mesh || !Mesh->Positions || !Mesh->TexCoords || !TangentSums || !BitangentSums) {
+        return;
+    }
+
+    uint32_t Total = TangentTriangleCount(Mesh);
+    if (FirstTriangle >= Total) {
+        return;
+    }
+
+    uint32_t Remaining = Total - FirstTriangle;
+    uint32_t End = FirstTriangle + ((TriangleCount < Remaining) ? TriangleCount : Remaining);
+
+    for (uint32_t Triangle = FirstTriangle; Triangle < End; ++Triangle) {
+        AccumulateTriangle(Mesh, Triangle, TangentSums, BitangentSums);
+    }
+}
+
+/* ========================================================================
+   Resolve
+   ======================================================================== */
+
+// Returns any unit vector perpendicular to Normal
+static inline AxVec3 PerpendicularTo(AxVec3 Normal)
+{
+    AxVec3 Axis = (fabsf(Normal.X) < 0.9f) ? (AxVec3){ 1.0f, 0.0f, 0.0f } : (AxVec3){ 0.0f, 1.0f, 0.0f };
+    AxVec3 Result = Vec3Cross(Normal, Axis);
+    float Length = Vec3Length(Result);
+    if (Length <= 0.0f) {
+        return ((AxVec3){ 1.0f, 0.0f, 0.0f });
+    }
+
+    return (Vec3Mul(Result, 1.0f / Length));
+}
+
+void TangentResolve(const AxTangentMeshDesc *Mesh,
+                    const AxVec4 *const *TangentSums, const AxVec4 *const *BitangentSums, uint32_t SumCount,
+                    uint32_t FirstVertex, uint32_t VertexCount)
+{
+    if (!Mesh || !Mesh->Normals || !Mesh->Tangents || !TangentSums || !BitangentSums) {
+        return;
+    }
+
+    if (FirstVertex >= Mesh->VertexCount) {
+        return;
+    }
+
+    uint32_t Remaining = Mesh->VertexCount - FirstVertex;
+    uint32_t End = FirstVertex + ((VertexCount < Remaining) ? VertexCount : Remaining);
+    for (uint32_t Vertex = FirstVertex; Vertex < End; ++Vertex)
+    {
+        AxVec3 T = { 0.0f, 0.0f, 0.0f };
+        AxVec3 B = { 0.0f, 0.0f, 0.0f };
+        for (uint32_t i = 0; i < SumCount; ++i)
+        {
+            T = Vec3Add(T, TangentSums[i][Vertex].XYZ);
+            B = Vec3Add(B, BitangentSums[i][Vertex].XYZ);
+        }
+
+        AxVec3 N = ReadVec3(Mesh->Normals, Mesh->NormalStride, Vertex);
+        float NormalLength = Vec3Length(N);
+        N = (NormalLength > 0.0f) ? Vec3Mul(N, 1.0f / NormalLength) : (AxVec3){ 0.0f, 0.0f, 1.0f };
+
+        // Gram-Schmidt: remove the normal component, then renormalize
+        AxVec3 Tangent = Vec3Sub(T, Vec3Mul(N, Vec3Dot(N, T)));
+        float TangentLength = Vec3Length(Tangent);
+        if (TangentLength > 1e-8f) {
+            Tangent = Vec3Mul(Tangent, 1.0f / TangentLength);
+        } else {
+            Tangent = PerpendicularTo(N);
+        }
+
+        float Handedness = (Vec3Dot(Vec3Cross(N, Tangent), B) < 0.0f) ? -1.0f : 1.0f;
+        AxVec4 Result = { Tangent.X, Tangent.Y, Tangent.Z, Handedness };
+        WriteVec4(Mesh->Tangents, Mesh->TangentStride, Vertex, Result);
+    }
+}
+
+bool CalculateTangents(const AxTangentMeshDesc *Mesh, AxVec4 *Scratch)
+{
+    if (!Mesh || !Mesh->Positions || !Mesh->Normals || !Mesh->TexCoords || !Mesh->Tangents || !Scratch) {
+        return (false);
+    }
+
+    AxVec4 *TangentSums = Scratch;
+    AxVec4 *BitangentSums = Scratch + Mesh->VertexCount;
+    memset(Scratch, 0, AX_TANGENT_SCRATCH_BYTES(Mesh->VertexCount));
+
+    TangentAccumulate(Mesh, 0, TangentTriangleCount(Mesh), TangentSums, BitangentSums);
+
+    const AxVec4 *TangentParts[1] = { TangentSums };
+    const AxVec4 *BitangentParts[1] = { BitangentSums };
+    TangentResolve(Mesh, TangentParts, BitangentParts, 1, 0, Mesh->VertexCount);
+
+    return (true);
+}
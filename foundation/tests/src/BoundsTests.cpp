@@ -0,0 +1,261 @@
+#include "gtest/gtest.h"
+#include "Foundation/AxTypes.h"
+#include "Foundation/AxMath.h"
+#include "Foundation/AxBounds.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// Camera at the origin looking down -Z, 90 degree FOV, square aspect, near 1, far 100
+static AxFrustum MakeTestFrustum()
+{
+    AxMat4x4 Projection = CalcPerspectiveProjection(AX_PI * 0.5f, 1.0f, 1.0f, 100.0f);
+    AxMat4x4 View = Identity();
+    return (FrustumFromViewProjection(Mat4x4Mul(View, Projection)));
+}
+
+struct BoundsSoAStorage
+{
+    std::vector<float> CX, CY, CZ, EX, EY, EZ;
+
+    void Push(AxVec3 C, AxVec3 E)
+    {
+        CX.push_back(C.X); CY.push_back(C.Y); CZ.push_back(C.Z);
+        EX.push_back(E.X); EY.push_back(E.Y); EZ.push_back(E.Z);
+    }
+
+    AxAABBSoA View() const
+    {
+        AxAABBSoA Result = { CX.data(), CY.data(), CZ.data(), EX.data(), EY.data(), EZ.data(), (uint32_t)CX.size() };
+        return (Result);
+    }
+};
+
+TEST(Bounds, AABBCenterExtentsRoundTrip)
+{
+    AxAABB Box = AABBFromCenterExtents({ 1.0f, 2.0f, 3.0f }, { 0.5f, 1.0f, 2.0f });
+    EXPECT_FLOAT_EQ(Box.Min.X, 0.5f);
+    EXPECT_FLOAT_EQ(Box.Max.Z, 5.0f);
+
+    AxVec3 C = AABBCenter(Box);
+    AxVec3 E = AABBExtents(Box);
+    EXPECT_FLOAT_EQ(C.Y, 2.0f);
+    EXPECT_FLOAT_EQ(E.Z, 2.0f);
+}
+
+TEST(Bounds, AABBFromPointsAndUnion)
+{
+    AxVec3 Points[] = { { -1.0f, 0.0f, 2.0f }, { 3.0f, -4.0f, 1.0f }, { 0.0f, 5.0f, -2.0f } };
+    AxAABB Box = AABBFromPoints(Points, 3);
+    EXPECT_TRUE(AABBIsValid(Box));
+    EXPECT_FLOAT_EQ(Box.Min.X, -1.0f);
+    EXPECT_FLOAT_EQ(Box.Min.Y, -4.0f);
+    EXPECT_FLOAT_EQ(Box.Max.Y, 5.0f);
+    EXPECT_FLOAT_EQ(Box.Max.Z, 2.0f);
+
+    EXPECT_FALSE(AABBIsValid(AABBFromPoints(NULL, 0)));
+
+    AxAABB Other = AABBFromCenterExtents({ 10.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f });
+    AxAABB U = AABBUnion(Box, Other);
+    EXPECT_FLOAT_EQ(U.Max.X, 11.0f);
+    EXPECT_FLOAT_EQ(U.Min.Y, -4.0f);
+}
+
+TEST(Bounds, AABBOverlapAndContainment)
+{
+    AxAABB A = AABBFromCenterExtents({ 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f });
+    AxAABB B = AABBFromCenterExtents({ 1.5f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f });
+    AxAABB C = AABBFromCenterExtents({ 5.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f });
+
+    EXPECT_TRUE(AABBOverlaps(A, B));
+    EXPECT_FALSE(AABBOverlaps(A, C));
+    EXPECT_TRUE(AABBContainsPoint(A, { 0.5f, -0.5f, 1.0f }));
+    EXPECT_FALSE(AABBContainsPoint(A, { 0.5f, -0.5f, 1.1f }));
+
+    AxSphere S = { { 3.0f, 0.0f, 0.0f }, 1.5f };
+    EXPECT_TRUE(SphereOverlapsAABB(S, B));
+    EXPECT_FALSE(SphereOverlapsAABB(S, A));
+}
+
+TEST(Bounds, AABBTransformTranslateAndRotate)
+{
+    AxAABB Box = AABBFromCenterExtents({ 0.0f, 0.0f, 0.0f }, { 1.0f, 2.0f, 3.0f });
+
+    AxMat4x4 Translation = Translate(Identity(), { 10.0f, 0.0f, -5.0f });
+    AxAABB Moved = AABBTransform(Box, Translation);
+    EXPECT_FLOAT_EQ(Moved.Min.X, 9.0f);
+    EXPECT_FLOAT_EQ(Moved.Max.Z, -2.0f);
+
+    // 90 degrees about Y swaps the X and Z extents
+    AxMat4x4 Rotation = QuatToMat4x4(QuatFromAxisAngle({ 0.0f, 1.0f, 0.0f }, AX_PI * 0.5f));
+    AxAABB Rotated = AABBTransform(Box, Rotation);
+    EXPECT_NEAR(AABBExtents(Rotated).X, 3.0f, 1e-5f);
+    EXPECT_NEAR(AABBExtents(Rotated).Y, 2.0f, 1e-5f);
+    EXPECT_NEAR(AABBExtents(Rotated).Z, 1.0f, 1e-5f);
+
+    // 45 degrees about Z grows X/Y to the rotated box's projection
+    AxMat4x4 Diagonal = QuatToMat4x4(QuatFromAxisAngle({ 0.0f, 0.0f, 1.0f }, AX_PI * 0.25f));
+    AxAABB Grown = AABBTransform(AABBFromCenterExtents({ 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }), Diagonal);
+    EXPECT_NEAR(AABBExtents(Grown).X, sqrtf(2.0f), 1e-5f);
+    EXPECT_NEAR(AABBExtents(Grown).Z, 1.0f, 1e-5f);
+}
+
+TEST(Bounds, FrustumPlanesAreNormalizedAndPointInward)
+{
+    AxFrustum Frustum = MakeTestFrustum();
+
+    for (int i = 0; i < AX_FRUSTUM_PLANE_COUNT; ++i)
+    {
+        const AxPlane &P = Frustum.Planes[i];
+        EXPECT_NEAR(Vec3Length(P.Normal), 1.0f, 1e-5f);
+
+        // A point straight ahead, between near and far, is inside every plane
+        float Distance = Vec3Dot(P.Normal, { 0.0f, 0.0f, -10.0f }) + P.D;
+        EXPECT_GT(Distance, 0.0f);
+    }
+
+    EXPECT_NEAR(Frustum.Planes[AX_FRUSTUM_PLANE_NEAR].D, -1.0f, 1e-4f);
+    EXPECT_NEAR(Frustum.Planes[AX_FRUSTUM_PLANE_FAR].D, 100.0f, 1e-2f);
+}
+
+TEST(Bounds, FrustumTestAABBAndSphere)
+{
+    AxFrustum Frustum = MakeTestFrustum();
+
+    AxAABB Ahead = AABBFromCenterExtents({ 0.0f, 0.0f, -10.0f }, { 1.0f, 1.0f, 1.0f });
+    AxAABB Behind = AABBFromCenterExtents({ 0.0f, 0.0f, 10.0f }, { 1.0f, 1.0f, 1.0f });
+    AxAABB TooFar = AABBFromCenterExtents({ 0.0f, 0.0f, -200.0f }, { 1.0f, 1.0f, 1.0f });
+    AxAABB Left = AABBFromCenterExtents({ -30.0f, 0.0f, -10.0f }, { 1.0f, 1.0f, 1.0f });
+    AxAABB Straddle = AABBFromCenterExtents({ -10.5f, 0.0f, -10.0f }, { 1.0f, 1.0f, 1.0f });
+
+    EXPECT_TRUE(FrustumTestAABB(&Frustum, Ahead));
+    EXPECT_FALSE(FrustumTestAABB(&Frustum, Behind));
+    EXPECT_FALSE(FrustumTestAABB(&Frustum, TooFar));
+    EXPECT_FALSE(FrustumTestAABB(&Frustum, Left));
+    EXPECT_TRUE(FrustumTestAABB(&Frustum, Straddle));
+
+    EXPECT_TRUE(FrustumTestSphere(&Frustum, { { 0.0f, 0.0f, -50.0f }, 1.0f }));
+    EXPECT_FALSE(FrustumTestSphere(&Frustum, { { 0.0f, 0.0f, 5.0f }, 1.0f }));
+    EXPECT_TRUE(FrustumTestSphere(&Frustum, { { 0.0f, 0.0f, 1.5f }, 3.0f }));
+}
+
+TEST(Bounds, FrustumCullAABBsMatchesScalarTest)
+{
+    AxFrustum Frustum = MakeTestFrustum();
+
+    // 37 boxes: four full batches plus a five-box tail
+    BoundsSoAStorage Storage;
+    SeedRandom(1234);
+    for (int i = 0; i < 37; ++i) {
+        Storage.Push({ RandomFloat(-60.0f, 60.0f), RandomFloat(-60.0f, 60.0f), RandomFloat(-120.0f, 20.0f) },
+                     { RandomFloat(0.1f, 4.0f), RandomFloat(0.1f, 4.0f), RandomFloat(0.1f, 4.0f) });
+    }
+
+    AxAABBSoA Boxes = Storage.View();
+    std::vector<uint8_t> Mask(AX_BOUNDS_MASK_BYTES(Boxes.Count), 0xFF);
+    uint32_t Visible = FrustumCullAABBs(&Frustum, &Boxes, Mask.data());
+
+    uint32_t Expected = 0;
+    for (uint32_t i = 0; i < Boxes.Count; ++i)
+    {
+        AxAABB Box = AABBFromCenterExtents({ Boxes.CenterX[i], Boxes.CenterY[i], Boxes.CenterZ[i] },
+                                           { Boxes.ExtentX[i], Boxes.ExtentY[i], Boxes.ExtentZ[i] });
+        bool ScalarVisible = FrustumTestAABB(&Frustum, Box);
+        EXPECT_EQ(BoundsMaskTest(Mask.data(), i), ScalarVisible) << "box " << i;
+        Expected += ScalarVisible ? 1 : 0;
+    }
+
+    EXPECT_EQ(Visible, Expected);
+    EXPECT_GT(Visible, 0u);
+    EXPECT_LT(Visible, Boxes.Count);
+
+    // Tail bits past Count are cleared
+    EXPECT_EQ(Mask.back() >> (Boxes.Count % 8), 0);
+}
+
+TEST(Bounds, FrustumCullSpheresMatchesScalarTest)
+{
+    AxFrustum Frustum = MakeTestFrustum();
+
+    std::vector<float> CX, CY, CZ, R;
+    SeedRandom(4321);
+    for (int i = 0; i < 29; ++i) {
+        CX.push_back(RandomFloat(-60.0f, 60.0f));
+        CY.push_back(RandomFloat(-60.0f, 60.0f));
+        CZ.push_back(RandomFloat(-120.0f, 20.0f));
+        R.push_back(RandomFloat(0.1f, 5.0f));
+    }
+
+    AxSphereSoA Spheres = { CX.data(), CY.data(), CZ.data(), R.data(), (uint32_t)CX.size() };
+    std::vector<uint8_t> Mask(AX_BOUNDS_MASK_BYTES(Spheres.Count), 0);
+    uint32_t Visible = FrustumCullSpheres(&Frustum, &Spheres, Mask.data());
+
+    uint32_t Expected = 0;
+    for (uint32_t i = 0; i < Spheres.Count; ++i)
+    {
+        AxSphere S = { { CX[i], CY[i], CZ[i] }, R[i] };
+        bool ScalarVisible = FrustumTestSphere(&Frustum, S);
+        EXPECT_EQ(BoundsMaskTest(Mask.data(), i), ScalarVisible) << "sphere " << i;
+        Expected += ScalarVisible ? 1 : 0;
+    }
+
+    EXPECT_EQ(Visible, Expected);
+}
+
+TEST(Bounds, FrustumCullHandlesEmptyAndNullInput)
+{
+    AxFrustum Frustum = MakeTestFrustum();
+    AxAABBSoA Empty = { NULL, NULL, NULL, NULL, NULL, NULL, 0 };
+    uint8_t Mask = 0;
+
+    EXPECT_EQ(FrustumCullAABBs(&Frustum, &Empty, &Mask), 0u);
+    EXPECT_EQ(FrustumCullAABBs(NULL, &Empty, &Mask), 0u);
+    EXPECT_EQ(FrustumCullSpheres(&Frustum, NULL, &Mask), 0u);
+}
+
+TEST(Bounds, Benchmark100kBoxes)
+{
+    const uint32_t BoxCount = 100000;
+    const int Iterations = 20;
+    AxFrustum Frustum = MakeTestFrustum();
+
+    BoundsSoAStorage Storage;
+    SeedRandom(42);
+    for (uint32_t i = 0; i < BoxCount; ++i) {
+        Storage.Push({ RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f), RandomFloat(-150.0f, 50.0f) },
+                     { RandomFloat(0.1f, 2.0f), RandomFloat(0.1f, 2.0f), RandomFloat(0.1f, 2.0f) });
+    }
+
+    AxAABBSoA Boxes = Storage.View();
+    std::vector<uint8_t> Mask(AX_BOUNDS_MASK_BYTES(BoxCount));
+
+    // Scalar baseline: one FrustumTestAABB per box
+    uint32_t ScalarVisible = 0;
+    auto ScalarStart = std::chrono::high_resolution_clock::now();
+    for (int It = 0; It < Iterations; ++It)
+    {
+        ScalarVisible = 0;
+        for (uint32_t i = 0; i < BoxCount; ++i)
+        {
+            AxAABB Box = AABBFromCenterExtents({ Boxes.CenterX[i], Boxes.CenterY[i], Boxes.CenterZ[i] },
+                                               { Boxes.ExtentX[i], Boxes.ExtentY[i], Boxes.ExtentZ[i] });
+            ScalarVisible += FrustumTestAABB(&Frustum, Box) ? 1 : 0;
+        }
+    }
+    auto ScalarEnd = std::chrono::high_resolution_clock::now();
+
+    uint32_t BatchVisible = 0;
+    auto BatchStart = std::chrono::high_resolution_clock::now();
+    for (int It = 0; It < Iterations; ++It) {
+        BatchVisible = FrustumCullAABBs(&Frustum, &Boxes, Mask.data());
+    }
+    auto BatchEnd = std::chrono::high_resolution_clock::now();
+
+    double ScalarMs = std::chrono::duration<double, std::milli>(ScalarEnd - ScalarStart).count() / Iterations;
+    double BatchMs = std::chrono::duration<double, std::milli>(BatchEnd - BatchStart).count() / Iterations;
+    printf("FrustumCullAABBs: %u boxes, %u visible, scalar %.3f ms, batched %.3f ms (%.1fx)\n",
+           BoxCount, BatchVisible, ScalarMs, BatchMs, BatchMs > 0.0 ? ScalarMs / BatchMs : 0.0);
+
+    EXPECT_EQ(BatchVisible, ScalarVisible);
+}
@@ -0,0 +1,307 @@
+#include "gtest/gtest.h"
+#include "Foundation/AxTypes.h"
+#include "Foundation/AxMath.h"
+#include "Foundation/AxTangents.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Interleaved layout matching the renderer's vertex format
+struct TestVertex
+{
+    AxVec3 Position;
+    AxVec3 Normal;
+    AxVec2 TexCoord;
+    AxVec4 Tangent;
+};
+
+struct TestMesh
+{
+    std::vector<TestVertex> Vertices;
+    std::vector<uint32_t> Indices;
+
+    AxTangentMeshDesc Desc()
+    {
+        AxTangentMeshDesc Result;
+        memset(&Result, 0, sizeof(Result));
+        Result.Positions = &Vertices[0].Position;
+        Result.Normals = &Vertices[0].Normal;
+        Result.TexCoords = &Vertices[0].TexCoord;
+        Result.Tangents = &Vertices[0].Tangent;
+        Result.PositionStride = sizeof(TestVertex);
+        Result.NormalStride = sizeof(TestVertex);
+        Result.TexCoordStride = sizeof(TestVertex);
+        Result.TangentStride = sizeof(TestVertex);
+        Result.Indices = Indices.empty() ? NULL : Indices.data();
+        Result.IndexCount = (uint32_t)Indices.size();
+        Result.VertexCount = (uint32_t)Vertices.size();
+        return (Result);
+    }
+};
+
+// Flat grid in the XY plane facing +Z, U along +X and V along +Y
+static TestMesh MakeGrid(uint32_t CellsX, uint32_t CellsY, bool MirrorU = false)
+{
+    TestMesh Mesh;
+    for (uint32_t Y = 0; Y <= CellsY; ++Y)
+    {
+        for (uint32_t X = 0; X <= CellsX; ++X)
+        {
+            TestVertex V;
+            memset(&V, 0, sizeof(V));
+            V.Position = { (float)X, (float)Y, 0.0f };
+            V.Normal = { 0.0f, 0.0f, 1.0f };
+            float U = (float)X / CellsX;
+            V.TexCoord = { MirrorU ? 1.0f - U : U, (float)Y / CellsY };
+            Mesh.Vertices.push_back(V);
+        }
+    }
+
+    uint32_t Row = CellsX + 1;
+    for (uint32_t Y = 0; Y < CellsY; ++Y)
+    {
+        for (uint32_t X = 0; X < CellsX; ++X)
+        {
+            uint32_t I = Y * Row + X;
+            uint32_t Quad[6] = { I, I + 1, I + Row + 1, I, I + Row + 1, I + Row };
+            Mesh.Indices.insert(Mesh.Indices.end(), Quad, Quad + 6);
+        }
+    }
+
+    return (Mesh);
+}
+
+// Runs the two passes over WorkerCount triangle/vertex ranges, optionally on threads
+static void CalculateTangentsSplit(AxTangentMeshDesc *Mesh, uint32_t WorkerCount, bool UseThreads)
+{
+    std::vector<AxVec4> Sums((size_t)Mesh->VertexCount * 2 * WorkerCount);
+    std::vector<AxVec4 *> TangentSums(WorkerCount);
+    std::vector<AxVec4 *> BitangentSums(WorkerCount);
+    for (uint32_t i = 0; i < WorkerCount; ++i) {
+        TangentSums[i] = &Sums[(size_t)i * 2 * Mesh->VertexCount];
+        BitangentSums[i] = TangentSums[i] + Mesh->VertexCount;
+    }
+
+    uint32_t TriangleCount = TangentTriangleCount(Mesh);
+    uint32_t TrianglesPer = (TriangleCount + WorkerCount - 1) / WorkerCount;
+    uint32_t VerticesPer = (Mesh->VertexCount + WorkerCount - 1) / WorkerCount;
+
+    std::vector<std::thread> Threads;
+    for (uint32_t i = 0; i < WorkerCount; ++i)
+    {
+        auto Work = [=, &TangentSums, &BitangentSums]() {
+            TangentAccumulate(Mesh, i * TrianglesPer, TrianglesPer, TangentSums[i], BitangentSums[i]);
+        };
+        if (UseThreads) { Threads.emplace_back(Work); } else { Work(); }
+    }
+    for (std::thread &T : Threads) { T.join(); }
+    Threads.clear();
+
+    for (uint32_t i = 0; i < WorkerCount; ++i)
+    {
+        auto Work = [=, &TangentSums, &BitangentSums]() {
+            TangentResolve(Mesh, TangentSums.data(), BitangentSums.data(), WorkerCount, i * VerticesPer, VerticesPer);
+        };
+        if (UseThreads) { Threads.emplace_back(Work); } else { Work(); }
+    }
+    for (std::thread &T : Threads) { T.join(); }
+}
+
+TEST(Tangents, FlatGridTangentsFollowU)
+{
+    TestMesh Mesh = MakeGrid(5, 3);
+    AxTangentMeshDesc Desc = Mesh.Desc();
+    std::vector<uint8_t> Scratch(AX_TANGENT_SCRATCH_BYTES(Desc.VertexCount));
+
+    ASSERT_EQ(TangentTriangleCount(&Desc), 30u);
+    ASSERT_TRUE(CalculateTangents(&Desc, (AxVec4 *)Scratch.data()));
+
+    for (size_t i = 0; i < Mesh.Vertices.size(); ++i)
+    {
+        const AxVec4 &T = Mesh.Vertices[i].Tangent;
+        EXPECT_NEAR(T.X, 1.0f, 1e-5f) << "vertex " << i;
+        EXPECT_NEAR(T.Y, 0.0f, 1e-5f) << "vertex " << i;
+        EXPECT_NEAR(T.Z, 0.0f, 1e-5f) << "vertex " << i;
+        EXPECT_FLOAT_EQ(T.W, 1.0f) << "vertex " << i;
+    }
+}
+
+TEST(Tangents, MirroredUVsFlipHandedness)
+{
+    TestMesh Mesh = MakeGrid(4, 2, true);
+    AxTangentMeshDesc Desc = Mesh.Desc();
+    std::vector<uint8_t> Scratch(AX_TANGENT_SCRATCH_BYTES(Desc.VertexCount));
+    ASSERT_TRUE(CalculateTangents(&Desc, (AxVec4 *)Scratch.data()));
+
+    for (size_t i = 0; i < Mesh.Vertices.size(); ++i)
+    {
+        const AxVec4 &T = Mesh.Vertices[i].Tangent;
+        EXPECT_NEAR(T.X, -1.0f, 1e-5f) << "vertex " << i;
+        EXPECT_FLOAT_EQ(T.W, -1.0f) << "vertex " << i;
+    }
+}
+
+TEST(Tangents, TangentIsOrthogonalizedAgainstNormal)
+{
+    TestMesh Mesh = MakeGrid(2, 2);
+    for (TestVertex &V : Mesh.Vertices) {
+        V.Normal = Vec3Normalize({ 0.5f, 0.0f, 1.0f });
+    }
+
+    AxTangentMeshDesc Desc = Mesh.Desc();
+    std::vector<uint8_t> Scratch(AX_TANGENT_SCRATCH_BYTES(Desc.VertexCount));
+    ASSERT_TRUE(CalculateTangents(&Desc, (AxVec4 *)Scratch.data()));
+
+    for (const TestVertex &V : Mesh.Vertices)
+    {
+        AxVec3 T = { V.Tangent.X, V.Tangent.Y, V.Tangent.Z };
+        EXPECT_NEAR(Vec3Dot(T, V.Normal), 0.0f, 1e-5f);
+        EXPECT_NEAR(Vec3Length(T), 1.0f, 1e-5f);
+        EXPECT_GT(T.X, 0.0f);
+    }
+}
+
+TEST(Tangents, MatchesPerTriangleCalculation)
+{
+    TestMesh Mesh;
+    TestVertex V;
+    memset(&V, 0, sizeof(V));
+    V.Normal = { 0.0f, 1.0f, 0.0f };
+    V.Position = { 0.0f, 0.0f, 0.0f }; V.TexCoord = { 0.0f, 0.0f }; Mesh.Vertices.push_back(V);
+    V.Position = { 0.0f, 0.0f, 2.0f }; V.TexCoord = { 1.0f, 0.0f }; Mesh.Vertices.push_back(V);
+    V.Position = { 3.0f, 0.0f, 0.0f }; V.TexCoord = { 0.0f, 1.0f }; Mesh.Vertices.push_back(V);
+
+    AxTangentMeshDesc Desc = Mesh.Desc();
+    std::vector<uint8_t> Scratch(AX_TANGENT_SCRATCH_BYTES(Desc.VertexCount));
+    ASSERT_TRUE(CalculateTangents(&Desc, (AxVec4 *)Scratch.data()));
+
+    AxVec3 Expected;
+    CalculateTangentBitangent(Mesh.Vertices[0].Position, Mesh.Vertices[1].Position, Mesh.Vertices[2].Position,
+                              Mesh.Vertices[0].TexCoord, Mesh.Vertices[1].TexCoord, Mesh.Vertices[2].TexCoord,
+                              &Expected, NULL);
+
+    for (const TestVertex &Out : Mesh.Vertices)
+    {
+        EXPECT_NEAR(Out.Tangent.X, Expected.X, 1e-5f);
+        EXPECT_NEAR(Out.Tangent.Y, Expected.Y, 1e-5f);
+        EXPECT_NEAR(Out.Tangent.Z, Expected.Z, 1e-5f);
+    }
+}
+
+TEST(Tangents, DegenerateUVsFallBackToPerpendicular)
+{
+    TestMesh Mesh = MakeGrid(3, 3);
+    for (TestVertex &V : Mesh.Vertices) {
+        V.TexCoord = { 0.5f, 0.5f };
+    }
+
+    // An out-of-range index must be skipped, not read
+    Mesh.Indices.push_back(0);
+    Mesh.Indices.push_back(1);
+    Mesh.Indices.push_back(9999);
+
+    AxTangentMeshDesc Desc = Mesh.Desc();
+    std::vector<uint8_t> Scratch(AX_TANGENT_SCRATCH_BYTES(Desc.VertexCount));
+    ASSERT_TRUE(CalculateTangents(&Desc, (AxVec4 *)Scratch.data()));
+
+    for (const TestVertex &V : Mesh.Vertices)
+    {
+        AxVec3 T = { V.Tangent.X, V.Tangent.Y, V.Tangent.Z };
+        EXPECT_NEAR(Vec3Length(T), 1.0f, 1e-5f);
+        EXPECT_NEAR(Vec3Dot(T, V.Normal), 0.0f, 1e-5f);
+    }
+}
+
+TEST(Tangents, NonIndexedAndInvalidInput)
+{
+    TestMesh Grid = MakeGrid(1, 1);
+    TestMesh Mesh;
+    for (uint32_t Index : Grid.Indices) {
+        Mesh.Vertices.push_back(Grid.Vertices[Index]);
+    }
+
+    AxTangentMeshDesc Desc = Mesh.Desc();
+    EXPECT_EQ(TangentTriangleCount(&Desc), 2u);
+
+    std::vector<uint8_t> Scratch(AX_TANGENT_SCRATCH_BYTES(Desc.VertexCount));
+    ASSERT_TRUE(CalculateTangents(&Desc, (AxVec4 *)Scratch.data()));
+    EXPECT_NEAR(Mesh.Vertices[3].Tangent.X, 1.0f, 1e-5f);
+
+    EXPECT_FALSE(CalculateTangents(NULL, (AxVec4 *)Scratch.data()));
+    EXPECT_FALSE(CalculateTangents(&Desc, NULL));
+    Desc.Normals = NULL;
+    EXPECT_FALSE(CalculateTangents(&Desc, (AxVec4 *)Scratch.data()));
+}
+
+TEST(Tangents, SplitPassesMatchSinglePassAndAreDeterministic)
+{
+    // Wavy grid so tangents vary per vertex
+    TestMesh Reference = MakeGrid(37, 11);
+    for (TestVertex &V : Reference.Vertices) {
+        V.Position.Z = sinf(V.Position.X * 0.7f) * cosf(V.Position.Y * 0.4f);
+        V.Normal = Vec3Normalize({ -0.7f * cosf(V.Position.X * 0.7f), 0.3f, 1.0f });
+    }
+    TestMesh SplitA = Reference;
+    TestMesh SplitB = Reference;
+
+    AxTangentMeshDesc RefDesc = Reference.Desc();
+    std::vector<uint8_t> Scratch(AX_TANGENT_SCRATCH_BYTES(RefDesc.VertexCount));
+    ASSERT_TRUE(CalculateTangents(&RefDesc, (AxVec4 *)Scratch.data()));
+
+    AxTangentMeshDesc DescA = SplitA.Desc();
+    AxTangentMeshDesc DescB = SplitB.Desc();
+    CalculateTangentsSplit(&DescA, 3, false);
+    CalculateTangentsSplit(&DescB, 3, true);
+
+    for (size_t i = 0; i < Reference.Vertices.size(); ++i)
+    {
+        EXPECT_NEAR(SplitA.Vertices[i].Tangent.X, Reference.Vertices[i].Tangent.X, 1e-5f);
+        EXPECT_NEAR(SplitA.Vertices[i].Tangent.Y, Reference.Vertices[i].Tangent.Y, 1e-5f);
+        EXPECT_NEAR(SplitA.Vertices[i].Tangent.Z, Reference.Vertices[i].Tangent.Z, 1e-5f);
+        EXPECT_EQ(SplitA.Vertices[i].Tangent.W, Reference.Vertices[i].Tangent.W);
+    }
+
+    // Same split on threads is bit-identical to the same split inline
+    EXPECT_EQ(memcmp(SplitA.Vertices.data(), SplitB.Vertices.data(), SplitA.Vertices.size() * sizeof(TestVertex)), 0);
+}
+
+TEST(Tangents, Benchmark512x512Grid)
+{
+    TestMesh Mesh = MakeGrid(512, 512);
+    AxTangentMeshDesc Desc = Mesh.Desc();
+    std::vector<uint8_t> Scratch(AX_TANGENT_SCRATCH_BYTES(Desc.VertexCount));
+
+    // Reference: per-triangle CalculateTangentBitangent with no per-vertex smoothing
+    auto ScalarStart = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i + 2 < Mesh.Indices.size(); i += 3)
+    {
+        TestVertex &A = Mesh.Vertices[Mesh.Indices[i]];
+        TestVertex &B = Mesh.Vertices[Mesh.Indices[i + 1]];
+        TestVertex &C = Mesh.Vertices[Mesh.Indices[i + 2]];
+        AxVec3 T, Bi;
+        CalculateTangentBitangent(A.Position, B.Position, C.Position, A.TexCoord, B.TexCoord, C.TexCoord, &T, &Bi);
+        A.Tangent = B.Tangent = C.Tangent = { T.X, T.Y, T.Z, 1.0f };
+    }
+    auto ScalarEnd = std::chrono::high_resolution_clock::now();
+
+    auto BatchStart = std::chrono::high_resolution_clock::now();
+    CalculateTangents(&Desc, (AxVec4 *)Scratch.data());
+    auto BatchEnd = std::chrono::high_resolution_clock::now();
+
+    uint32_t Workers = std::thread::hardware_concurrency();
+    Workers = Workers < 1 ? 1 : (Workers > 8 ? 8 : Workers);
+    auto ParallelStart = std::chrono::high_resolution_clock::now();
+    CalculateTangentsSplit(&Desc, Workers, true);
+    auto ParallelEnd = std::chrono::high_resolution_clock::now();
+
+    double ScalarMs = std::chrono::duration<double, std::milli>(ScalarEnd - ScalarStart).count();
+    double BatchMs = std::chrono::duration<double, std::milli>(BatchEnd - BatchStart).count();
+    double ParallelMs = std::chrono::duration<double, std::milli>(ParallelEnd - ParallelStart).count();
+    printf("Tangents: %u triangles, unsmoothed per-triangle %.2f ms, batch %.2f ms, %u workers %.2f ms\n",
+           TangentTriangleCount(&Desc), ScalarMs, BatchMs, Workers, ParallelMs);
+
+    EXPECT_NEAR(Mesh.Vertices[1000].Tangent.X, 1.0f, 1e-5f);
+}
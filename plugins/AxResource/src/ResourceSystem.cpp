@@ -15,15 +15,19 @@
 #include "ResourceSystem.h"
 #include "Foundation/AxAllocatorAPI.h"
 #include "Foundation/AxPlatform.h"
+#include "Foundation/AxTangents.h"
 #include "Foundation/AxTypes.h"
 #include "AxOpenGL/AxOpenGL.h"
 #include "AxOpenGL/AxOpenGLTypes.h"
 #include "AxLog/AxLog.h"
 
+#include <algorithm>
 #include <cstring>
 #include <cstdlib>
 #include <cstdio>
 #include <functional>
+#include <thread>
+#include <vector>
 
 // stb_image for texture loading
 // Define implementation here since AxResource is a standalone plugin
@@ -531,6 +535,88 @@ char* ResourceSystem::ReadFileToString(std::string_view Path, uint64_t* OutSize)
     return Buffer;
 }
 
+// Meshes below this many triangles are not worth the thread startup cost
+static constexpr uint32_t TANGENT_PARALLEL_MIN_TRIANGLES = 32768;
+static constexpr uint32_t TANGENT_MAX_WORKERS = 16;
+
+bool ResourceSystem::GenerateTangents(AxVertex* Vertices, uint32_t VertexCount, const uint32_t* Indices, uint32_t IndexCount)
+{
+    AxTangentMeshDesc Mesh = {};
+    Mesh.Positions = &Vertices[0].Position;
+    Mesh.Normals = &Vertices[0].Normal;
+    Mesh.TexCoords = &Vertices[0].TexCoord;
+    Mesh.Tangents = &Vertices[0].Tangent;
+    Mesh.PositionStride = sizeof(AxVertex);
+    Mesh.NormalStride = sizeof(AxVertex);
+    Mesh.TexCoordStride = sizeof(AxVertex);
+    Mesh.TangentStride = sizeof(AxVertex);
+    Mesh.Indices = Indices;
+    Mesh.IndexCount = IndexCount;
+    Mesh.VertexCount = VertexCount;
+
+    uint32_t TriangleCount = TangentTriangleCount(&Mesh);
+    uint32_t HardwareThreads = std::thread::hardware_concurrency();
+    uint32_t WorkerCount = TriangleCount / TANGENT_PARALLEL_MIN_TRIANGLES;
+    WorkerCount = std::min(WorkerCount, std::min(HardwareThreads, TANGENT_MAX_WORKERS));
+    WorkerCount = std::max(WorkerCount, 1u);
+
+    // Each worker accumulates into its own tangent and bitangent sums
+    size_t ScratchBytes = AX_TANGENT_SCRATCH_BYTES(VertexCount) * WorkerCount;
+    AxVec4* Scratch = static_cast<AxVec4*>(AxAlloc(m_Allocator, ScratchBytes));
+    if (!Scratch) {
+        AX_LOG(ERROR, "Failed to allocate tangent scratch for %u vertices", VertexCount);
+        return false;
+    }
+
+    if (WorkerCount == 1) {
+        CalculateTangents(&Mesh, Scratch);
+        AxFree(m_Allocator, Scratch);
+        return true;
+    }
+
+    memset(Scratch, 0, ScratchBytes);
+
+    AxVec4* TangentSums[TANGENT_MAX_WORKERS];
+    AxVec4* BitangentSums[TANGENT_MAX_WORKERS];
+    for (uint32_t i = 0; i < WorkerCount; ++i) {
+        TangentSums[i] = Scratch + (size_t)i * 2 * VertexCount;
+        BitangentSums[i] = TangentSums[i] + VertexCount;
+    }
+
+    std::vector<std::thread> Workers;
+    Workers.reserve(WorkerCount - 1);
+
+    // Pass 1: disjoint triangle ranges into per-worker sums
+    uint32_t TrianglesPerWorker = (TriangleCount + WorkerCount - 1) / WorkerCount;
+    for (uint32_t i = 1; i < WorkerCount; ++i) {
+        Workers.emplace_back([&, i]() {
+            TangentAccumulate(&Mesh, i * TrianglesPerWorker, TrianglesPerWorker,
+                              TangentSums[i], BitangentSums[i]);
+        });
+    }
+    TangentAccumulate(&Mesh, 0, TrianglesPerWorker,
+                      TangentSums[0], BitangentSums[0]);
+    for (std::thread& Worker : Workers) {
+        Worker.join();
+    }
+    Workers.clear();
+
+    // Pass 2: disjoint vertex ranges, summing partials in worker order
+    uint32_t VerticesPerWorker = (VertexCount + WorkerCount - 1) / WorkerCount;
+    for (uint32_t i = 1; i < WorkerCount; ++i) {
+        Workers.emplace_back([&, i]() {
+            TangentResolve(&Mesh, TangentSums, BitangentSums, WorkerCount, i * VerticesPerWorker, VerticesPerWorker);
+        });
+    }
+    TangentResolve(&Mesh, TangentSums, BitangentSums, WorkerCount, 0, VerticesPerWorker);
+    for (std::thread& Worker : Workers) {
+        Worker.join();
+    }
+
+    AxFree(m_Allocator, Scratch);
+    return true;
+}
+
 
 //=============================================================================
 // Texture Path Cache (for deduplication)
@@ -949,14 +1035,6 @@ AxMeshHandle ResourceSystem::LoadMesh(std::string_view Path,
         for (uint32_t i = 0; i < VertexCount; ++i) {
             cgltf_accessor_read_float(TangentAccessor, i, &Vertices[i].Tangent.X, 4);
         }
-    } else if (Options && Options->CalculateTangents && NormalAccessor && TexCoordAccessor) {
-        // Simple default tangents
-        for (uint32_t i = 0; i < VertexCount; ++i) {
-            Vertices[i].Tangent.X = 1.0f;
-            Vertices[i].Tangent.Y = 0.0f;
-            Vertices[i].Tangent.Z = 0.0f;
-            Vertices[i].Tangent.W = 1.0f;
-        }
     }
 
     // Read indices
@@ -987,6 +1065,11 @@ AxMeshHandle ResourceSystem::LoadMesh(std::string_view Path,
         }
     }
 
+    // Generate tangents from UVs once the final triangle list is known
+    if (!TangentAccessor && Options && Options->CalculateTangents && NormalAccessor && TexCoordAccessor) {
+        GenerateTangents(Vertices, VertexCount, Indices, IndexCount);
+    }
+
     // Allocate a slot for the mesh
     AxMeshHandle Handle = m_Meshes.Allocate();
     if (!AX_HANDLE_IS_VALID(Handle)) {
@@ -1847,9 +1930,9 @@ bool ResourceSystem::LoadModelInternal(std::string_view Path, struct AxModelData
                 for (uint32_t i = 0; i < VertexCount; ++i) {
                     cgltf_accessor_read_float(TangentAccessor, i, &Vertices[i].Tangent.X, 4);
                 }
-            } else if (NormalAccessor) {
-                // Generate default tangents when not provided by the model
-                // This allows normal mapping to work even without explicit tangents
+            } else if (NormalAccessor && !TexCoordAccessor) {
+                // Without UVs there is no texture-space basis, so pick any tangent
+                // perpendicular to the normal to keep normal mapping well-defined
                 for (uint32_t i = 0; i < VertexCount; ++i) {
                     // Choose a tangent perpendicular to the normal
                     AxVec3 n = Vertices[i].Normal;
@@ -1892,6 +1975,11 @@ bool ResourceSystem::LoadModelInternal(std::string_view Path, struct AxModelData
                 }
             }
 
+            // Generate UV-aligned tangents when the model does not provide them
+            if (!TangentAccessor && NormalAccessor && TexCoordAccessor) {
+                GenerateTangents(Vertices, VertexCount, Indices, Indices ? IndexCount : 0);
+            }
+
             // Allocate mesh slot
             AxMeshHandle MeshHandle = m_Meshes.Allocate();
             if (!AX_HANDLE_IS_VALID(MeshHandle)) {
@@ -281,6 +281,9 @@ private:
     // Internal helpers for resource loading
     char* ReadFileToString(std::string_view Path, uint64_t* OutSize);
 
+    // Generates tangents from positions, normals and UVs; large meshes are split across cores
+    bool GenerateTangents(AxVertex* Vertices, uint32_t VertexCount, const uint32_t* Indices, uint32_t IndexCount);
+
     // Internal model loading helper (populates model data)
     bool LoadModelInternal(std::string_view Path, struct AxModelData* OutModel);
 